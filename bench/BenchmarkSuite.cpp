@@ -0,0 +1,796 @@
+#include "BenchmarkSuite.hpp"
+#include <AllocationTracker.hpp>
+#include <AnimationDefines.hpp>
+#include <AnimationEventDispatcher.hpp>
+#include <AnimationLod.hpp>
+#include <BakedClip.hpp>
+#include <algorithm>
+#include <bit>
+#include <BodyPartPool.hpp>
+#include <BufferManager.hpp>
+#include <Camera.hpp>
+#include <chrono>
+#include <cmath>
+#include <FrameArena.hpp>
+#include <fstream>
+#include <iomanip>
+#include <JobDefines.hpp>
+#include <Logger.hpp>
+#include <map>
+#include <memory>
+#include <MotionMatcher.hpp>
+#include <ScriptScheduler.hpp>
+#include <SimulationClock.hpp>
+#include <sstream>
+
+/**
+ * The number of humans of each crowd size of the default scenarios.
+ */
+static constexpr unsigned int DEFAULT_HUMAN_COUNTS[] = {1, 100, 10000};
+
+/**
+ * The number of humans of each size of the crowd scenarios, up to the largest crowd of the default scenarios.
+ */
+static constexpr unsigned int CROWD_HUMAN_COUNTS[] = {1, 100, 10000, 100000};
+
+/**
+ * The animations of the default scenarios (NO_ANIMATION being the static scenario).
+ */
+static constexpr AnimationType DEFAULT_ANIMATIONS[] = {NO_ANIMATION, STAYING_PUT, WALKING, JUMPING, SNOW_ANGEL};
+
+/**
+ * The phase offset in seconds between two consecutive humans playing the same clip.
+ */
+static constexpr float PHASE_STEP = 0.173f;
+
+/**
+ * The distance between two neighbours of the grid the crowd of the LOD scenarios stands on.
+ */
+static constexpr float LOD_GRID_SPACING = 2.0f;
+
+/**
+ * Where the limbs of the IK scenarios reach, from their root in the model space of the torso: the hands forward, the
+ * feet a step ahead with the knees bent.
+ */
+static const Vector4 IK_REACH[HUMAN_LIMB_COUNT] = {
+    Vector4(0.1f, -0.1f, -0.3f, 0.0f),
+    Vector4(-0.1f, -0.1f, -0.3f, 0.0f),
+    Vector4(0.0f, -0.34f, -0.08f, 0.0f),
+    Vector4(0.0f, -0.34f, -0.08f, 0.0f)
+};
+
+/**
+ * The clips of the database searched by the motion matching scenarios.
+ */
+static constexpr AnimationType MOTION_MATCHING_ANIMATIONS[] = {STAYING_PUT, WALKING, JUMPING, SNOW_ANGEL};
+
+/**
+ * The number of frames between two changes of the desired trajectory of a human in the motion matching scenarios.
+ */
+static constexpr unsigned int MOTION_MATCHING_TRAJECTORY_FRAMES = 60;
+
+/**
+ * The desired trajectories of the motion matching scenarios, near then far: standing still, then jumping.
+ */
+static const Vector4 MOTION_MATCHING_TRAJECTORIES[2][2] = {
+    {Vector4(0.0f, 0.0f, 0.0f, 0.0f), Vector4(0.0f, 0.0f, 0.0f, 0.0f)},
+    {Vector4(0.0f, 0.3f, 0.0f, 0.0f), Vector4(0.0f, 0.6f, 0.0f, 0.0f)}
+};
+
+/**
+ * Wave an arm forever, as the humans of the scripted scenarios do.
+ *
+ * @param arm The arm
+ * @param side 1 for the right arm, -1 for the left arm
+ * @param pause The seconds to wait before each wave, different for each human
+ */
+static AnimationScript waveForever(BodyPart& arm, const float side, const float pause)
+{
+    for (;;)
+    {
+        const EasingCurve& ease = EasingCurve::get(SINE_IN_OUT_EASING);
+        co_await AnimationScript::seconds(pause);
+        co_await AnimationScript::tween(arm, Z_ROTATION_PROPERTY, side * static_cast<float>(M_PI) * 3 / 4, 0.4f, ease);
+        co_await AnimationScript::tween(arm, Z_ROTATION_PROPERTY, side * static_cast<float>(M_PI) / 2, 0.2f, ease);
+        co_await AnimationScript::tween(arm, Z_ROTATION_PROPERTY, side * static_cast<float>(M_PI) * 3 / 4, 0.2f, ease);
+        co_await AnimationScript::tween(arm, Z_ROTATION_PROPERTY, 0.0f, 0.4f, EasingCurve::get(BOUNCE_OUT_EASING));
+    }
+}
+
+/**
+ * The length in seconds of the timeline scrubbed by the scrubbing scenarios, one hour.
+ */
+static constexpr unsigned int SCRUBBING_TIMELINE = 3600;
+
+/**
+ * @return The time a human of the scrubbing scenarios seeks to at a frame, spread over the whole timeline
+ */
+static double scrubbingTime(const unsigned int frame, const std::size_t human)
+{
+    // Knuth's multiplicative hash, so consecutive frames and humans land far apart
+    const std::uint64_t hash = (frame * 2654435761ull + human * 40503ull) % (SCRUBBING_TIMELINE * 1000ull);
+    return static_cast<double>(hash) / 1000.0;
+}
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+/**
+ * @return The number of milliseconds elapsed between start and end
+ */
+static double elapsedMs(const BenchmarkClock::time_point start, const BenchmarkClock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a benchmark suite.
+ *
+ * @param frames The number of measured frames per scenario
+ * @param warmupFrames The number of frames simulated before measuring
+ * @param timestep The fixed simulated time step between two frames, in seconds
+ * @param threads The number of threads animating and transforming the humans, the calling thread included
+ */
+BenchmarkSuite::BenchmarkSuite(const unsigned int frames,
+                               const unsigned int warmupFrames,
+                               const float timestep,
+                               const unsigned int threads)
+    : _frames(std::max(frames, 1u)),
+      _warmupFrames(warmupFrames),
+      _timestep(timestep),
+      _threads(std::max(threads, 1u))
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Build the default scenarios: every animation (plus the static pose) for each crowd size, then walking with the
+ * snow angel layered over the upper body, walking from a compressed clip, walking with the animation LOD, scrubbing
+ * the walk in ping-pong, walking with every limb solved by inverse kinematics, motion matching between standing
+ * still and jumping, waving both arms from animation scripts and walking with the footsteps reported as events.<br>
+ * The crowd scenarios come last, one per size of CROWD_HUMAN_COUNTS: the humans of a Crowd, drawn by instancing.
+ *
+ * @param maxHumans Crowd sizes above this value are skipped
+ *
+ * @return The default scenarios, grouped by crowd size
+ */
+std::vector<BenchmarkScenario> BenchmarkSuite::defaultScenarios(const unsigned int maxHumans)
+{
+    std::vector<BenchmarkScenario> scenarios;
+
+    for (const unsigned int humanCount: DEFAULT_HUMAN_COUNTS)
+    {
+        if (humanCount > maxHumans)
+        {
+            continue;
+        }
+        for (const AnimationType animation: DEFAULT_ANIMATIONS)
+        {
+            scenarios.push_back({
+                "humans_" + std::to_string(humanCount) + "_" + _animationName(animation),
+                humanCount,
+                animation
+            });
+        }
+        scenarios.push_back({
+            "humans_" + std::to_string(humanCount) + "_walking_layered",
+            humanCount,
+            WALKING,
+            SNOW_ANGEL
+        });
+        scenarios.push_back({
+            "humans_" + std::to_string(humanCount) + "_walking_compressed",
+            humanCount,
+            WALKING,
+            NO_ANIMATION,
+            true
+        });
+        scenarios.push_back({
+            "humans_" + std::to_string(humanCount) + "_walking_lod",
+            humanCount,
+            WALKING,
+            NO_ANIMATION,
+            false,
+            true
+        });
+        scenarios.push_back({
+            "humans_" + std::to_string(humanCount) + "_walking_scrubbing",
+            humanCount,
+            WALKING,
+            NO_ANIMATION,
+            false,
+            false,
+            true
+        });
+        scenarios.push_back({
+            "humans_" + std::to_string(humanCount) + "_walking_ik",
+            humanCount,
+            WALKING,
+            NO_ANIMATION,
+            false,
+            false,
+            false,
+            true
+        });
+        scenarios.push_back({
+            "humans_" + std::to_string(humanCount) + "_motion_matching",
+            humanCount,
+            WALKING,
+            NO_ANIMATION,
+            false,
+            false,
+            false,
+            false,
+            true
+        });
+        scenarios.push_back({
+            "humans_" + std::to_string(humanCount) + "_scripted",
+            humanCount,
+            NO_ANIMATION,
+            NO_ANIMATION,
+            false,
+            false,
+            false,
+            false,
+            false,
+            true
+        });
+        scenarios.push_back({
+            "humans_" + std::to_string(humanCount) + "_walking_events",
+            humanCount,
+            WALKING,
+            NO_ANIMATION,
+            false,
+            false,
+            false,
+            false,
+            false,
+            false,
+            true
+        });
+    }
+    for (const unsigned int humanCount: CROWD_HUMAN_COUNTS)
+    {
+        if (humanCount > maxHumans)
+        {
+            continue;
+        }
+        BenchmarkScenario scenario{"humans_" + std::to_string(humanCount) + "_crowd", humanCount};
+        scenario.crowd = true;
+        scenarios.push_back(scenario);
+    }
+    return scenarios;
+}
+
+/**
+ * Run the scenarios in order.<br>
+ * Humans are built once per crowd size and shared by the consecutive scenarios using that size, the crowd scenarios
+ * building theirs through a Crowd.
+ *
+ * @param scenarios The scenarios to run
+ *
+ * @return The measurements of each scenario
+ */
+std::vector<BenchmarkResult> BenchmarkSuite::run(const std::vector<BenchmarkScenario>& scenarios) const
+{
+    std::vector<BenchmarkResult> results;
+    // The humans of a crowd are owned by it
+    std::unique_ptr<Crowd> crowd;
+    std::vector<Human*> humans;
+    double humansSetupMs = 0;
+    JobSystem jobs(_threads - 1);
+
+    for (const BenchmarkScenario& scenario: scenarios)
+    {
+        if (humans.size() != scenario.humanCount || (crowd != nullptr) != scenario.crowd)
+        {
+            if (!crowd)
+            {
+                for (const Human* human: humans)
+                {
+                    delete human;
+                }
+            }
+            humans.clear();
+            crowd.reset();
+            BufferManager::reset();
+
+            const auto setupStart = BenchmarkClock::now();
+            if (scenario.crowd)
+            {
+                crowd = std::make_unique<Crowd>(scenario.humanCount);
+                humans.reserve(scenario.humanCount);
+                for (unsigned int i = 0; i < scenario.humanCount; ++i)
+                {
+                    humans.push_back(crowd->getHuman(i));
+                }
+            }
+            else
+            {
+                humans.reserve(scenario.humanCount);
+                // A single chunk holds the body parts of the whole crowd
+                BodyPartPool::getInstance().reserve(static_cast<std::size_t>(scenario.humanCount) * HUMAN_JOINT_COUNT);
+                for (unsigned int i = 0; i < scenario.humanCount; ++i)
+                {
+                    humans.push_back(new Human());
+                }
+            }
+            humansSetupMs = elapsedMs(setupStart, BenchmarkClock::now());
+        }
+        Logger::info("Running scenario %s (%u frames)", scenario.name.c_str(), _frames);
+        results.push_back(_runScenario(scenario, humans, crowd.get(), humansSetupMs, jobs));
+    }
+
+    if (!crowd)
+    {
+        for (const Human* human: humans)
+        {
+            delete human;
+        }
+    }
+    crowd.reset();
+    BufferManager::reset();
+    BodyPartPool::deletePool();
+    AnimationManager::clean();
+    Camera::deleteCamera();
+    return results;
+}
+
+/**
+ * Serialize the results to JSON.
+ *
+ * @param results The results to serialize
+ *
+ * @return The JSON document
+ */
+std::string BenchmarkSuite::toJson(const std::vector<BenchmarkResult>& results) const
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(4);
+    oss << "{\n"
+            << "  \"version\": 1,\n"
+            << "  \"frames\": " << _frames << ",\n"
+            << "  \"warmup_frames\": " << _warmupFrames << ",\n"
+            << "  \"timestep\": " << _timestep << ",\n"
+            << "  \"threads\": " << _threads << ",\n"
+            << "  \"scenarios\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        oss << "    {\n"
+                << "      \"name\": \"" << result.scenario.name << "\",\n"
+                << "      \"humans\": " << result.scenario.humanCount << ",\n"
+                << "      \"animation\": \"" << _animationName(result.scenario.animation) << "\",\n"
+                << "      \"upper_body_layer\": \"" << _layerName(result.scenario.upperBodyLayer) << "\",\n"
+                << "      \"compressed\": " << (result.scenario.compressed ? "true" : "false") << ",\n"
+                << "      \"lod\": " << (result.scenario.lod ? "true" : "false") << ",\n"
+                << "      \"scrubbing\": " << (result.scenario.scrubbing ? "true" : "false") << ",\n"
+                << "      \"ik\": " << (result.scenario.ik ? "true" : "false") << ",\n"
+                << "      \"motion_matching\": " << (result.scenario.motionMatching ? "true" : "false") << ",\n"
+                << "      \"scripted\": " << (result.scenario.scripted ? "true" : "false") << ",\n"
+                << "      \"events\": " << (result.scenario.events ? "true" : "false") << ",\n"
+                << "      \"crowd\": " << (result.scenario.crowd ? "true" : "false") << ",\n"
+                << "      \"visible_humans\": " << result.visibleHumans << ",\n"
+                << "      \"compression_ratio\": " << result.compressionRatio << ",\n"
+                << "      \"compression_max_error\": " << std::setprecision(6) << result.compressionMaxError
+                << std::setprecision(4) << ",\n"
+                << "      \"frames\": " << result.frames << ",\n"
+                << "      \"setup_ms\": " << result.setupMs << ",\n"
+                << "      \"stages\": {\n"
+                << "        \"animation_ms\": " << result.animationMs << ",\n"
+                << "        \"transform_ms\": " << result.transformMs << "\n"
+                << "      },\n"
+                << "      \"frame_ms_mean\": " << result.frameMsMean << ",\n"
+                << "      \"frame_ms_p50\": " << result.frameMsP50 << ",\n"
+                << "      \"frame_ms_p99\": " << result.frameMsP99 << ",\n"
+                << "      \"frame_ms_max\": " << result.frameMsMax << ",\n"
+                << "      \"allocations_per_frame\": " << result.allocationsPerFrame << ",\n"
+                << "      \"allocated_bytes_per_frame\": " << result.allocatedBytesPerFrame << ",\n"
+                << "      \"humans_per_second\": " << result.humansPerSecond << ",\n"
+                << "      \"events_per_frame\": " << result.eventsPerFrame << ",\n"
+                << "      \"vertex_checksum\": " << result.vertexChecksum << "\n"
+                << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    oss << "  ]\n"
+            << "}\n";
+    return oss.str();
+}
+
+/**
+ * Compare the results against a baseline previously written by toJson().<br>
+ * A scenario regresses when its median frame time exceeds the baseline by more than the tolerance, or when it
+ * allocates more per frame than the baseline.
+ *
+ * @param results The results to check
+ * @param baselinePath The path of the baseline JSON file
+ * @param tolerance The accepted relative slowdown (0.1 for 10%)
+ *
+ * @return true if no scenario regressed, false otherwise
+ */
+bool BenchmarkSuite::compareToBaseline(const std::vector<BenchmarkResult>& results,
+                                       const std::string& baselinePath,
+                                       const double tolerance)
+{
+    std::ifstream file(baselinePath);
+    if (!file.is_open())
+    {
+        Logger::error("BenchmarkSuite::compareToBaseline(): Cannot open baseline %s.", baselinePath.c_str());
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    const std::string json = content.str();
+
+    // The baseline is our own output, so each scenario object starts with its "name" key
+    const auto readNumber = [&json](const size_t from, const size_t to, const std::string& key, double& value)
+    {
+        const size_t position = json.find("\"" + key + "\": ", from);
+        if (position == std::string::npos || position >= to)
+        {
+            return false;
+        }
+        value = std::strtod(json.c_str() + position + key.size() + 4, nullptr);
+        return true;
+    };
+    std::map<std::string, std::pair<double, double>> baseline;
+    const std::string nameKey = "\"name\": \"";
+    for (size_t position = json.find(nameKey); position != std::string::npos;)
+    {
+        const size_t nameStart = position + nameKey.size();
+        const std::string name = json.substr(nameStart, json.find('"', nameStart) - nameStart);
+        const size_t next = json.find(nameKey, nameStart);
+        const size_t end = next == std::string::npos ? json.size() : next;
+        double frameMs = 0;
+        double allocations = 0;
+        if (readNumber(nameStart, end, "frame_ms_p50", frameMs)
+            && readNumber(nameStart, end, "allocations_per_frame", allocations))
+        {
+            baseline[name] = {frameMs, allocations};
+        }
+        position = next;
+    }
+
+    bool success = true;
+    for (const BenchmarkResult& result: results)
+    {
+        const auto entry = baseline.find(result.scenario.name);
+        if (entry == baseline.end())
+        {
+            Logger::warning("%s: no baseline entry.", result.scenario.name.c_str());
+            continue;
+        }
+        const auto [baselineFrameMs, baselineAllocations] = entry->second;
+        const double ratio = baselineFrameMs > 0 ? result.frameMsP50 / baselineFrameMs : 1.0;
+        if (ratio > 1.0 + tolerance)
+        {
+            Logger::error("%s: REGRESSION %.4f ms/frame vs %.4f ms/frame baseline (+%.1f%%).",
+                          result.scenario.name.c_str(), result.frameMsP50, baselineFrameMs, (ratio - 1.0) * 100);
+            success = false;
+        }
+        else if (result.allocationsPerFrame > baselineAllocations + 0.5)
+        {
+            Logger::error("%s: REGRESSION %.1f allocations/frame vs %.1f allocations/frame baseline.",
+                          result.scenario.name.c_str(), result.allocationsPerFrame, baselineAllocations);
+            success = false;
+        }
+        else
+        {
+            Logger::info("%s: %.4f ms/frame vs %.4f ms/frame baseline (%+.1f%%).",
+                         result.scenario.name.c_str(), result.frameMsP50, baselineFrameMs, (ratio - 1.0) * 100);
+        }
+    }
+    return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Run one scenario on the simulated clock.
+ *
+ * @param scenario The scenario to run
+ * @param humans The humans of the scene
+ * @param crowd The crowd the humans belong to, giving their animations and transforming them (nullptr if none)
+ * @param setupMs The time spent building the humans
+ * @param jobs The threads animating and transforming the humans
+ *
+ * @return The measurements of the scenario
+ */
+BenchmarkResult BenchmarkSuite::_runScenario(const BenchmarkScenario& scenario,
+                                             const std::vector<Human*>& humans,
+                                             Crowd* crowd,
+                                             const double setupMs,
+                                             JobSystem& jobs) const
+{
+    BenchmarkResult result;
+    result.scenario = scenario;
+    result.frames = _frames;
+
+    const auto setupStart = BenchmarkClock::now();
+    // Every player shares the same clip, each human starts at its own phase
+    std::shared_ptr<const AnimationSource> clip = AnimationManager::getClip(scenario.animation);
+    if (scenario.compressed && clip && !humans.empty())
+    {
+        const std::shared_ptr<const CompressedClip> compressed = AnimationManager::compressClip(scenario.animation,
+                                                                                                *humans.front());
+        if (const auto baked = std::dynamic_pointer_cast<const BakedClip>(clip))
+        {
+            result.compressionRatio = static_cast<double>(baked->getByteSize()) / compressed->getByteSize();
+        }
+        result.compressionMaxError = compressed->getMaxError();
+        clip = compressed;
+    }
+    const std::shared_ptr<const AnimationSource> layerClip = AnimationManager::getClip(scenario.upperBodyLayer);
+    std::vector<AnimationPlayer> players;
+    players.reserve(humans.size());
+    // The LOD scenarios stand the crowd on a square grid in front of the default camera, all the humans keep their
+    // vertices at the origin: only their level of detail depends on their place on the grid
+    std::vector<Vector4> lodPositions;
+    if (scenario.lod)
+    {
+        Camera::resetCamera();
+        const auto columns = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(humans.size()))));
+        lodPositions.reserve(humans.size());
+        for (unsigned int index = 0; index < humans.size(); ++index)
+        {
+            const float column = static_cast<float>(index % columns) - static_cast<float>(columns - 1) / 2.0f;
+            const float row = static_cast<float>(index / columns);
+            lodPositions.emplace_back(column * LOD_GRID_SPACING, 0.0f, row * LOD_GRID_SPACING);
+        }
+    }
+    // The motion matching scenarios search one database shared by the whole crowd, each human from its own frame
+    std::shared_ptr<MotionDatabase> database;
+    std::vector<MotionMatcher> matchers;
+    if (scenario.motionMatching)
+    {
+        database = std::make_shared<MotionDatabase>();
+        for (const AnimationType animation: MOTION_MATCHING_ANIMATIONS)
+        {
+            database->addClip(AnimationManager::getClip(animation));
+        }
+        database->build();
+        matchers.reserve(humans.size());
+    }
+    // The scripted scenarios wave both arms of every human, most scripts waiting in the timer queue at any time
+    ScriptScheduler scripts;
+    if (scenario.scripted)
+    {
+        scripts.reserve(humans.size() * 2);
+    }
+    // The event scenarios count the footsteps of the crowd, each player waiting in the timer wheel for its next one
+    AnimationEventDispatcher events;
+    std::size_t eventCount = 0;
+    if (scenario.events)
+    {
+        events.reserve(humans.size());
+        events.setListener([&eventCount](const std::span<const AnimationNotification> notifications)
+        {
+            eventCount += notifications.size();
+        });
+    }
+    const AnimationLod lod = AnimationLod::fromCamera();
+    for (Human* human: humans)
+    {
+        human->resetMembersRotations();
+        human->resetMembersTranslations();
+        AnimationPlayer& player = players.emplace_back(human);
+        player.setLodPhase(static_cast<unsigned int>(players.size() - 1));
+        if (crowd)
+        {
+            // Each human of a crowd plays its own animation, the players of the same one sharing its clip
+            const CrowdAnimation& animation = crowd->getAnimation(players.size() - 1);
+            player.play(AnimationManager::getClip(animation.type), animation.startTime);
+        }
+        else if (clip)
+        {
+            player.play(clip, static_cast<float>(players.size() - 1) * PHASE_STEP);
+        }
+        if (scenario.scrubbing)
+        {
+            player.setPlaybackMode(PING_PONG_PLAYBACK);
+        }
+        if (layerClip)
+        {
+            player.addLayer(layerClip, OVERRIDE_BLEND, 1.0f, Human::getUpperBodyMask());
+        }
+        if (scenario.ik)
+        {
+            for (std::size_t limb = 0; limb < HUMAN_LIMB_COUNT; ++limb)
+            {
+                player.setIkTarget(static_cast<HumanLimb>(limb),
+                                   {Human::getLimbChains()[limb].root + IK_REACH[limb], Vector4(0, 0, 0, 0), 1.0f});
+            }
+        }
+        if (scenario.motionMatching)
+        {
+            const std::size_t index = players.size() - 1;
+            matchers.emplace_back(database, &player, index * database->getFrameCount() / humans.size())
+                    .setSearchPhase(static_cast<unsigned int>(index));
+        }
+        if (scenario.scripted)
+        {
+            const float pause = 0.5f + std::fmod(static_cast<float>(players.size() - 1) * PHASE_STEP, 2.0f);
+            scripts.start(waveForever(*human->getBodyPart(RIGHT_ARM), 1.0f, pause));
+            scripts.start(waveForever(*human->getBodyPart(LEFT_ARM), -1.0f, pause * 2));
+        }
+        if (scenario.events)
+        {
+            events.watch(&player);
+        }
+    }
+    result.setupMs = setupMs + elapsedMs(setupStart, BenchmarkClock::now());
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(_frames);
+    size_t allocationCount = 0;
+    size_t allocatedBytes = 0;
+    SimulationClock clock(_timestep);
+
+    for (unsigned int frame = 0; frame < _warmupFrames + _frames; ++frame)
+    {
+        const bool measured = frame >= _warmupFrames;
+        // The first frame applies the starting poses, each other frame simulates one step without waiting for it
+        const unsigned int steps = frame == 0 ? 0 : clock.advance(clock.getTimestep());
+        const float deltaTime = static_cast<float>(steps) * clock.getTimestep();
+        AllocationTracker::beginFrame();
+        FrameArena::beginFrame();
+        // Each job only writes to the humans of its chunk, the result does not depend on the number of threads
+        const auto updatePlayers = [&](const size_t begin, const size_t end)
+        {
+            for (size_t index = begin; index < end; ++index)
+            {
+                // Scrubbing seeks each human to a random time of a long timeline, instead of playing on
+                if (scenario.scrubbing)
+                {
+                    players[index].seek(scrubbingTime(frame, index));
+                    continue;
+                }
+                if (!lodPositions.empty())
+                {
+                    players[index].setLod(lod.classify(lodPositions[index], HUMAN_BOUNDING_RADIUS));
+                }
+                if (!matchers.empty())
+                {
+                    const Vector4* trajectory =
+                            MOTION_MATCHING_TRAJECTORIES[(index + frame / MOTION_MATCHING_TRAJECTORY_FRAMES) % 2];
+                    matchers[index].setTrajectory(trajectory[0], trajectory[1]).update();
+                }
+                players[index].update(deltaTime);
+            }
+        };
+        // With the LOD, a human is only transformed again when its player gave it a new pose
+        const bool transformAll = !scenario.lod || frame == 0;
+        const auto transformHumans = [&humans, &players, crowd, transformAll](const size_t begin, const size_t end)
+        {
+            if (crowd)
+            {
+                crowd->applyTransformation(begin, end);
+                return;
+            }
+            for (size_t index = begin; index < end; ++index)
+            {
+                if (transformAll || players[index].hasNewPose())
+                {
+                    humans[index]->getRoot()->applyTransformation();
+                }
+            }
+        };
+        const auto animationStart = BenchmarkClock::now();
+        jobs.parallelFor(players.size(), ANIMATION_JOB_CHUNK_SIZE, updatePlayers);
+        events.update(deltaTime);
+        scripts.update(deltaTime);
+        const auto transformStart = BenchmarkClock::now();
+        jobs.parallelFor(humans.size(), ANIMATION_JOB_CHUNK_SIZE, transformHumans);
+        const auto frameEnd = BenchmarkClock::now();
+        const AllocationStats& frameStats = AllocationTracker::endFrame();
+
+        if (frame + 1 == _warmupFrames)
+        {
+            eventCount = 0;
+        }
+        if (measured)
+        {
+            result.animationMs += elapsedMs(animationStart, transformStart);
+            result.transformMs += elapsedMs(transformStart, frameEnd);
+            frameTimes.push_back(elapsedMs(animationStart, frameEnd));
+            allocationCount += frameStats.allocations;
+            allocatedBytes += frameStats.allocatedBytes;
+        }
+    }
+
+    double totalMs = 0;
+    for (const double frameTime: frameTimes)
+    {
+        totalMs += frameTime;
+    }
+    std::ranges::sort(frameTimes);
+    result.animationMs /= _frames;
+    result.transformMs /= _frames;
+    result.frameMsMean = totalMs / _frames;
+    result.frameMsP50 = frameTimes[frameTimes.size() / 2];
+    result.frameMsP99 = frameTimes[std::min(frameTimes.size() - 1, frameTimes.size() * 99 / 100)];
+    result.frameMsMax = frameTimes.back();
+    result.allocationsPerFrame = static_cast<double>(allocationCount) / _frames;
+    result.allocatedBytesPerFrame = static_cast<double>(allocatedBytes) / _frames;
+    result.eventsPerFrame = static_cast<double>(eventCount) / _frames;
+    result.humansPerSecond = totalMs > 0 ? static_cast<double>(humans.size()) * _frames / (totalMs / 1000.0) : 0;
+    result.vertexChecksum = crowd && crowd->getRendering() == INSTANCED_RENDERING
+                                ? _instanceChecksum(crowd->getInstances())
+                                : _vertexChecksum(humans);
+    result.visibleHumans = static_cast<unsigned int>(std::ranges::count_if(players, [](const AnimationPlayer& player)
+    {
+        return player.getLod() != CULLED_LOD;
+    }));
+    return result;
+}
+
+/**
+ * Hash the world-space vertices of the humans, to check that runs with different thread counts give the same result.
+ *
+ * @param humans The humans to hash
+ *
+ * @return The FNV-1a hash of the bits of every vertex
+ */
+std::uint64_t BenchmarkSuite::_vertexChecksum(const std::vector<Human*>& humans)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const Human* human: humans)
+    {
+        for (int joint = 0; joint < HUMAN_JOINT_COUNT; ++joint)
+        {
+            for (const float value: human->getBodyPart(static_cast<HumanJoint>(joint))->getVertices())
+            {
+                hash = (hash ^ std::bit_cast<std::uint32_t>(value)) * 1099511628211ull;
+            }
+        }
+    }
+    return hash;
+}
+
+/**
+ * Hash the instances of the humans of a crowd, as _vertexChecksum() does for their vertices.
+ *
+ * @param instances The instances to hash
+ *
+ * @return The FNV-1a hash of the bits of every instance
+ */
+std::uint64_t BenchmarkSuite::_instanceChecksum(const std::span<const BodyPartInstance> instances)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const BodyPartInstance& instance: instances)
+    {
+        for (const float value: instance.rows)
+        {
+            hash = (hash ^ std::bit_cast<std::uint32_t>(value)) * 1099511628211ull;
+        }
+        for (const float value: instance.color)
+        {
+            hash = (hash ^ std::bit_cast<std::uint32_t>(value)) * 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @return The name of the animation of a layer used in reports ("none" without layer)
+ */
+std::string BenchmarkSuite::_layerName(const AnimationType animation)
+{
+    return animation == NO_ANIMATION ? "none" : _animationName(animation);
+}
+
+/**
+ * @return The name of the animation used in scenario names
+ */
+std::string BenchmarkSuite::_animationName(const AnimationType animation)
+{
+    const std::string_view name = AnimationManager::getName(animation);
+    return name.empty() ? "static" : std::string(name);
+}
@@ -0,0 +1,104 @@
+#ifndef BENCHMARK_SUITE_HPP
+#define BENCHMARK_SUITE_HPP
+
+#include <AnimationManager.hpp>
+#include <Crowd.hpp>
+#include <cstdint>
+#include <JobSystem.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * A fixed scenario run by the benchmark suite.
+ */
+struct BenchmarkScenario
+{
+    std::string name;
+    unsigned int humanCount = 1;
+    AnimationType animation = NO_ANIMATION;
+    AnimationType upperBodyLayer = NO_ANIMATION;
+    bool compressed = false;
+    bool lod = false;
+    bool scrubbing = false;
+    bool ik = false;
+    bool motionMatching = false;
+    bool scripted = false;
+    bool events = false;
+    bool crowd = false;
+};
+
+/**
+ * The measurements of one scenario. All timings are in milliseconds.
+ */
+struct BenchmarkResult
+{
+    BenchmarkScenario scenario;
+    unsigned int frames = 0;
+    double setupMs = 0;
+    double animationMs = 0;
+    double transformMs = 0;
+    double frameMsMean = 0;
+    double frameMsP50 = 0;
+    double frameMsP99 = 0;
+    double frameMsMax = 0;
+    double allocationsPerFrame = 0;
+    double allocatedBytesPerFrame = 0;
+    double humansPerSecond = 0;
+    double eventsPerFrame = 0;
+    double compressionRatio = 0;
+    double compressionMaxError = 0;
+    std::uint64_t vertexChecksum = 0;
+    unsigned int visibleHumans = 0;
+};
+
+class BenchmarkSuite
+{
+public:
+    // Constructors
+    BenchmarkSuite(unsigned int frames, unsigned int warmupFrames, float timestep, unsigned int threads);
+
+    // Destructor
+    ~BenchmarkSuite() = default;
+
+    // Methods
+    static std::vector<BenchmarkScenario> defaultScenarios(unsigned int maxHumans);
+    std::vector<BenchmarkResult> run(const std::vector<BenchmarkScenario>& scenarios) const;
+    [[nodiscard]] std::string toJson(const std::vector<BenchmarkResult>& results) const;
+    static bool compareToBaseline(const std::vector<BenchmarkResult>& results,
+                                  const std::string& baselinePath,
+                                  double tolerance);
+
+private:
+    /**
+    * The number of measured frames per scenario.
+    */
+    unsigned int _frames;
+
+    /**
+    * The number of frames simulated before measuring, so that lazily grown buffers reach their steady state.
+    */
+    unsigned int _warmupFrames;
+
+    /**
+    * The fixed simulated time step between two frames, in seconds.
+    */
+    float _timestep;
+
+    /**
+    * The number of threads animating and transforming the humans, the calling thread included.
+    */
+    unsigned int _threads;
+
+    // Methods
+    [[nodiscard]] BenchmarkResult _runScenario(const BenchmarkScenario& scenario,
+                                               const std::vector<Human*>& humans,
+                                               Crowd* crowd,
+                                               double setupMs,
+                                               JobSystem& jobs) const;
+    static std::uint64_t _vertexChecksum(const std::vector<Human*>& humans);
+    static std::uint64_t _instanceChecksum(std::span<const BodyPartInstance> instances);
+    static std::string _animationName(AnimationType animation);
+    static std::string _layerName(AnimationType animation);
+};
+
+#endif //BENCHMARK_SUITE_HPP
@@ -0,0 +1,155 @@
+#include "BenchmarkSuite.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <Logger.hpp>
+#include <string>
+#include <thread>
+
+#define DEFAULT_BENCH_FRAMES 30
+#define DEFAULT_BENCH_WARMUP_FRAMES 5
+#define DEFAULT_BENCH_TIMESTEP (1.0f / 60.0f)
+#define DEFAULT_BENCH_TOLERANCE 0.10
+
+static void printUsage()
+{
+    std::cout << "Usage: humangl_bench [options]\n"
+            << "  --frames N          Measured frames per scenario (default " << DEFAULT_BENCH_FRAMES << ")\n"
+            << "  --warmup N          Unmeasured frames before each scenario (default "
+            << DEFAULT_BENCH_WARMUP_FRAMES << ")\n"
+            << "  --timestep S        Simulated seconds between two frames (default 1/60)\n"
+            << "  --max-humans N      Skip the scenarios with more humans than N\n"
+            << "  --threads N         Threads animating the humans, the main thread included (default: one per core)\n"
+            << "  --filter TEXT       Only run the scenarios whose name contains TEXT\n"
+            << "  --output FILE       Write the JSON report to FILE instead of the standard output\n"
+            << "  --baseline FILE     Compare the results against a previous JSON report\n"
+            << "  --tolerance F       Accepted relative slowdown against the baseline (default "
+            << DEFAULT_BENCH_TOLERANCE << ")\n"
+            << "  --strict-allocations Fail when a measured frame allocates\n"
+            << "  --debug             Enable debug logs\n";
+}
+
+int main(const int argc, char** argv)
+{
+    unsigned int frames = DEFAULT_BENCH_FRAMES;
+    unsigned int warmupFrames = DEFAULT_BENCH_WARMUP_FRAMES;
+    float timestep = DEFAULT_BENCH_TIMESTEP;
+    unsigned int maxHumans = -1;
+    unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+    double tolerance = DEFAULT_BENCH_TOLERANCE;
+    std::string filter;
+    std::string outputPath;
+    std::string baselinePath;
+    bool strictAllocations = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (argument == "--debug")
+        {
+            Logger::setDebug(true);
+        }
+        else if (argument == "--strict-allocations")
+        {
+            strictAllocations = true;
+        }
+        else if (argument == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if (argument == "--frames" && hasValue)
+        {
+            frames = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--warmup" && hasValue)
+        {
+            warmupFrames = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--timestep" && hasValue)
+        {
+            timestep = std::strtof(argv[++i], nullptr);
+        }
+        else if (argument == "--max-humans" && hasValue)
+        {
+            maxHumans = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--threads" && hasValue)
+        {
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--filter" && hasValue)
+        {
+            filter = argv[++i];
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            outputPath = argv[++i];
+        }
+        else if (argument == "--baseline" && hasValue)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (argument == "--tolerance" && hasValue)
+        {
+            tolerance = std::strtod(argv[++i], nullptr);
+        }
+        else
+        {
+            Logger::error("main.cpp::main(): Unknown argument %s.", argument.c_str());
+            printUsage();
+            return 2;
+        }
+    }
+
+    std::vector<BenchmarkScenario> scenarios;
+    for (const BenchmarkScenario& scenario: BenchmarkSuite::defaultScenarios(maxHumans))
+    {
+        if (scenario.name.find(filter) != std::string::npos)
+        {
+            scenarios.push_back(scenario);
+        }
+    }
+
+    const BenchmarkSuite suite(frames, warmupFrames, timestep, threads);
+    const std::vector<BenchmarkResult> results = suite.run(scenarios);
+    const std::string json = suite.toJson(results);
+
+    if (outputPath.empty())
+    {
+        std::cout << json;
+    }
+    else
+    {
+        std::ofstream output(outputPath);
+        if (!output.is_open())
+        {
+            Logger::error("main.cpp::main(): Cannot write report to %s.", outputPath.c_str());
+            return 1;
+        }
+        output << json;
+        Logger::info("Report written to %s", outputPath.c_str());
+    }
+
+    bool success = true;
+    if (strictAllocations)
+    {
+        for (const BenchmarkResult& result: results)
+        {
+            if (result.allocationsPerFrame > 0)
+            {
+                Logger::error("%s: %.1f allocations per steady-state frame.",
+                              result.scenario.name.c_str(), result.allocationsPerFrame);
+                success = false;
+            }
+        }
+    }
+    if (!baselinePath.empty() && !BenchmarkSuite::compareToBaseline(results, baselinePath, tolerance))
+    {
+        success = false;
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,370 @@
+#include "ReferenceMaths.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Row by column product of two matrices, as originally written in Matrix4::operator*.
+ *
+ * @param left The left matrix
+ * @param right The right matrix
+ *
+ * @return The product of the two matrices
+ */
+ReferenceMaths::Matrix ReferenceMaths::multiply(const Matrix& left, const Matrix& right)
+{
+    std::array<Vector, 4> rows{};
+    std::array<Vector, 4> columns{};
+    for (int i = 0; i < 4; ++i)
+    {
+        rows[i] = {left[i * 4 + 0], left[i * 4 + 1], left[i * 4 + 2], left[i * 4 + 3]};
+        columns[i] = {right[0 + i], right[4 + i], right[8 + i], right[12 + i]};
+    }
+    std::vector<float> resVector;
+
+    for (const Vector& row: rows)
+    {
+        for (const Vector& col: columns)
+        {
+            resVector.push_back(row[0] * col[0] + row[1] * col[1] + row[2] * col[2] + row[3] * col[3]);
+        }
+    }
+
+    Matrix resultArray{};
+    std::copy(resVector.begin(), resVector.end(), resultArray.begin());
+    return resultArray;
+}
+
+/**
+ * Product of a matrix by a vector, as originally written in Matrix4::operator*.
+ *
+ * @param matrix The matrix
+ * @param vector The vector
+ *
+ * @return The transformed vector
+ */
+ReferenceMaths::Vector ReferenceMaths::transform(const Matrix& matrix, const Vector& vector)
+{
+    const float x = matrix[0] * vector[0] + matrix[1] * vector[1] + matrix[2] * vector[2] + matrix[3] * vector[3];
+    const float y = matrix[4] * vector[0] + matrix[5] * vector[1] + matrix[6] * vector[2] + matrix[7] * vector[3];
+    const float z = matrix[8] * vector[0] + matrix[9] * vector[1] + matrix[10] * vector[2] + matrix[11] * vector[3];
+    const float w = matrix[12] * vector[0] + matrix[13] * vector[1] + matrix[14] * vector[2] + matrix[15] * vector[3];
+
+    return {x, y, z, w};
+}
+
+/**
+ * @return The X * Y * Z rotation matrix built by chained multiplications
+ */
+ReferenceMaths::Matrix ReferenceMaths::createRotationMatrix(const double angleX, const double angleY, const double angleZ)
+{
+    return multiply(multiply(createRotationXMatrix(angleX), createRotationYMatrix(angleY)),
+                    createRotationZMatrix(angleZ));
+}
+
+/**
+ * @return The rotation matrix around the x-axis
+ */
+ReferenceMaths::Matrix ReferenceMaths::createRotationXMatrix(const double angle)
+{
+    const auto cosAngleF = static_cast<float>(cos(angle));
+    const auto sinAngleF = static_cast<float>(sin(angle));
+
+    //@formatter:off
+    return {
+        1,         0,          0, 0,
+        0, cosAngleF, -sinAngleF, 0,
+        0, sinAngleF,  cosAngleF, 0,
+        0,         0,          0, 1
+    };
+    //@formatter:on
+}
+
+/**
+ * @return The rotation matrix around the y-axis
+ */
+ReferenceMaths::Matrix ReferenceMaths::createRotationYMatrix(const double angle)
+{
+    const auto cosAngleF = static_cast<float>(cos(angle));
+    const auto sinAngleF = static_cast<float>(sin(angle));
+
+    //@formatter:off
+    return {
+         cosAngleF, 0, sinAngleF, 0,
+                 0, 1,         0, 0,
+        -sinAngleF, 0, cosAngleF, 0,
+                 0, 0,         0, 1
+    };
+    //@formatter:on
+}
+
+/**
+ * @return The rotation matrix around the z-axis
+ */
+ReferenceMaths::Matrix ReferenceMaths::createRotationZMatrix(const double angle)
+{
+    const auto cosAngleF = static_cast<float>(cos(angle));
+    const auto sinAngleF = static_cast<float>(sin(angle));
+
+    //@formatter:off
+    return {
+        cosAngleF, -sinAngleF, 0, 0,
+        sinAngleF,  cosAngleF, 0, 0,
+                0,          0, 1, 0,
+                0,          0, 0, 1
+    };
+    //@formatter:on
+}
+
+/**
+ * @return The scaling matrix
+ */
+ReferenceMaths::Matrix ReferenceMaths::createScalingMatrix(const float sx, const float sy, const float sz)
+{
+    //@formatter:off
+    return {
+        sx,  0,  0, 0,
+         0, sy,  0, 0,
+         0,  0, sz, 0,
+         0,  0,  0, 1
+    };
+    //@formatter:on
+}
+
+/**
+ * @return The translation matrix
+ */
+ReferenceMaths::Matrix ReferenceMaths::createTranslationMatrix(const float tx, const float ty, const float tz)
+{
+    //@formatter:off
+    return {
+        1, 0, 0, tx,
+        0, 1, 0, ty,
+        0, 0, 1, tz,
+        0, 0, 0, 1,
+    };
+    //@formatter:on
+}
+
+/**
+ * @return The magnitude of the x, y and z components, as originally written in Vector4::magnitude
+ */
+float ReferenceMaths::magnitude(const Vector& vector)
+{
+    return sqrtf(powf(vector[0], 2) + powf(vector[1], 2) + powf(vector[2], 2));
+}
+
+/**
+ * @return The normalized linear interpolation of two quaternions (w, x, y, z), as originally written in
+ * Quaternion::nlerp
+ */
+ReferenceMaths::Vector ReferenceMaths::nlerp(const Vector& from, const Vector& to, const float factor)
+{
+    const float dot = from[0] * to[0] + from[1] * to[1] + from[2] * to[2] + from[3] * to[3];
+    const float sign = dot < 0 ? -1.0f : 1.0f;
+    const float fromWeight = 1 - factor;
+    const float toWeight = factor * sign;
+    const Vector blended = {
+        fromWeight * from[0] + toWeight * to[0],
+        fromWeight * from[1] + toWeight * to[1],
+        fromWeight * from[2] + toWeight * to[2],
+        fromWeight * from[3] + toWeight * to[3]
+    };
+
+    const float length = std::sqrt(blended[0] * blended[0] + blended[1] * blended[1]
+                                   + blended[2] * blended[2] + blended[3] * blended[3]);
+    if (length == 0.0f)
+    {
+        return {1.0f, 0.0f, 0.0f, 0.0f};
+    }
+    return {blended[0] / length, blended[1] / length, blended[2] / length, blended[3] / length};
+}
+
+/**
+ * Solve one two-bone chain, as originally written for a single chain before TwoBoneIkBatch::solve worked on lanes.
+ *
+ * @param chain The root, upper bone, lower bone, target and pole (x, y, z each), the weight, the smallest and largest
+ * angles between the bones, then the upper and lower rotations (w, x, y, z each)
+ *
+ * @return The solved upper and lower rotations (w, x, y, z each)
+ */
+ReferenceMaths::TwoBoneRotations ReferenceMaths::solveTwoBoneIk(const TwoBoneChain& chain)
+{
+    using Vector3 = std::array<float, 3>;
+    const auto dot = [](const Vector3& a, const Vector3& b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    };
+    const auto cross = [](const Vector3& a, const Vector3& b)
+    {
+        return Vector3{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    };
+    const auto multiply = [](const Vector& a, const Vector& b)
+    {
+        return Vector{
+            a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+            a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+            a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+            a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]
+        };
+    };
+    const auto conjugate = [](const Vector& q)
+    {
+        return Vector{q[0], -q[1], -q[2], -q[3]};
+    };
+    const auto rotate = [&multiply, &conjugate](const Vector& q, const Vector3& v)
+    {
+        const Vector rotated = multiply(multiply(q, {0.0f, v[0], v[1], v[2]}), conjugate(q));
+        return Vector3{rotated[1], rotated[2], rotated[3]};
+    };
+    const auto normalize = [&dot](const Vector3& v)
+    {
+        const float length = std::sqrt(dot(v, v));
+        return length == 0.0f ? v : Vector3{v[0] / length, v[1] / length, v[2] / length};
+    };
+    // The rotation around a x b by the angle between a and b
+    const auto rotationBetween = [&dot, &cross, &normalize](const Vector3& a, const Vector3& b)
+    {
+        const Vector3 axis = cross(a, b);
+        const float sine = std::sqrt(dot(axis, axis));
+        if (sine == 0.0f)
+        {
+            return Vector{1.0f, 0.0f, 0.0f, 0.0f};
+        }
+        const float angle = std::atan2(sine, dot(a, b));
+        const Vector3 unit = normalize(axis);
+        const float halfSine = std::sin(angle / 2);
+        return Vector{std::cos(angle / 2), unit[0] * halfSine, unit[1] * halfSine, unit[2] * halfSine};
+    };
+
+    const Vector3 root = {chain[0], chain[1], chain[2]};
+    const Vector3 upperBone = {chain[3], chain[4], chain[5]};
+    const Vector3 lowerBone = {chain[6], chain[7], chain[8]};
+    const Vector3 target = {chain[9], chain[10], chain[11]};
+    const Vector3 pole = {chain[12], chain[13], chain[14]};
+    const float weight = std::clamp(chain[15], 0.0f, 1.0f);
+    const Vector upperRotation = {chain[18], chain[19], chain[20], chain[21]};
+    const Vector lowerRotation = {chain[22], chain[23], chain[24], chain[25]};
+
+    const Vector3 upperAnimated = rotate(upperRotation, upperBone);
+    const Vector3 lowerAnimated = rotate(multiply(upperRotation, lowerRotation), lowerBone);
+    const float upperLength = std::sqrt(dot(upperBone, upperBone));
+    const float lowerLength = std::sqrt(dot(lowerBone, lowerBone));
+    const Vector3 toTarget = {target[0] - root[0], target[1] - root[1], target[2] - root[2]};
+    const float targetLength = std::sqrt(dot(toTarget, toTarget));
+    const Vector3 axis = targetLength > 0.0f
+                             ? normalize(toTarget)
+                             : normalize({upperAnimated[0] + lowerAnimated[0],
+                                          upperAnimated[1] + lowerAnimated[1],
+                                          upperAnimated[2] + lowerAnimated[2]});
+
+    // Law of cosines on the angle between the bones, within the limits
+    const float bendCosine = std::clamp((upperLength * upperLength + lowerLength * lowerLength
+                                         - targetLength * targetLength) / (2 * upperLength * lowerLength),
+                                        std::cos(chain[17]), std::cos(chain[16]));
+    const float reach = std::sqrt(upperLength * upperLength + lowerLength * lowerLength
+                                  - 2 * upperLength * lowerLength * bendCosine);
+    const float bendSine = std::sqrt(std::max(1 - bendCosine * bendCosine, 0.0f));
+
+    Vector3 bend = {
+        pole[0] - axis[0] * dot(pole, axis),
+        pole[1] - axis[1] * dot(pole, axis),
+        pole[2] - axis[2] * dot(pole, axis)
+    };
+    if (dot(bend, bend) == 0.0f)
+    {
+        bend = {
+            upperAnimated[0] - axis[0] * dot(upperAnimated, axis),
+            upperAnimated[1] - axis[1] * dot(upperAnimated, axis),
+            upperAnimated[2] - axis[2] * dot(upperAnimated, axis)
+        };
+    }
+    bend = normalize(bend);
+
+    const float alongAxis = (upperLength - lowerLength * bendCosine) * upperLength / reach;
+    const float alongBend = lowerLength * bendSine * upperLength / reach;
+    const Vector3 upperSolved = {
+        axis[0] * alongAxis + bend[0] * alongBend,
+        axis[1] * alongAxis + bend[1] * alongBend,
+        axis[2] * alongAxis + bend[2] * alongBend
+    };
+    const Vector3 lowerSolved = {
+        axis[0] * reach - upperSolved[0],
+        axis[1] * reach - upperSolved[1],
+        axis[2] * reach - upperSolved[2]
+    };
+    const Vector upperCorrection = rotationBetween(upperAnimated, upperSolved);
+    const Vector lowerCorrection = rotationBetween(rotate(upperCorrection, lowerAnimated), lowerSolved);
+    const Vector upperResult = multiply(upperCorrection, upperRotation);
+    const Vector lowerResult = multiply(conjugate(upperResult),
+                                        multiply(multiply(lowerCorrection, upperCorrection),
+                                                 multiply(upperRotation, lowerRotation)));
+
+    const Vector upper = nlerp(upperRotation, upperResult, weight);
+    const Vector lower = nlerp(lowerRotation, lowerResult, weight);
+    return {upper[0], upper[1], upper[2], upper[3], lower[0], lower[1], lower[2], lower[3]};
+}
+
+/**
+ * Evaluate a cubic Bézier easing curve analytically, as done per channel and per frame without a lookup table: Newton
+ * iterations find the parameter of the progress, falling back to a bisection where the curve is too flat.
+ *
+ * @param x1 The progress of the first control point, in [0, 1]
+ * @param y1 The eased progress of the first control point
+ * @param x2 The progress of the second control point, in [0, 1]
+ * @param y2 The eased progress of the second control point
+ * @param progress The progress, clamped to [0, 1]
+ *
+ * @return The eased progress
+ */
+float ReferenceMaths::evaluateBezier(const float x1,
+                                     const float y1,
+                                     const float x2,
+                                     const float y2,
+                                     const float progress)
+{
+    const float x = std::clamp(progress, 0.0f, 1.0f);
+    const auto bezier = [](const float first, const float second, const float parameter)
+    {
+        const float inverse = 1.0f - parameter;
+        return 3.0f * inverse * inverse * parameter * first
+               + 3.0f * inverse * parameter * parameter * second
+               + parameter * parameter * parameter;
+    };
+    const auto slope = [](const float first, const float second, const float parameter)
+    {
+        const float inverse = 1.0f - parameter;
+        return 3.0f * inverse * inverse * first
+               + 6.0f * inverse * parameter * (second - first)
+               + 3.0f * parameter * parameter * (1.0f - second);
+    };
+
+    float parameter = x;
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        const float error = bezier(x1, x2, parameter) - x;
+        if (std::fabs(error) < 1e-7f)
+        {
+            return bezier(y1, y2, parameter);
+        }
+        const float derivative = slope(x1, x2, parameter);
+        if (std::fabs(derivative) < 1e-6f)
+        {
+            break;
+        }
+        parameter -= error / derivative;
+    }
+    float low = 0.0f;
+    float high = 1.0f;
+    parameter = x;
+    for (int iteration = 0; iteration < 32 && high - low > 1e-7f; ++iteration)
+    {
+        (bezier(x1, x2, parameter) < x ? low : high) = parameter;
+        parameter = (low + high) / 2.0f;
+    }
+    return bezier(y1, y2, parameter);
+}
@@ -0,0 +1,40 @@
+#ifndef REFERENCE_MATHS_HPP
+#define REFERENCE_MATHS_HPP
+
+#include <array>
+
+/**
+ * Frozen copies of the original scalar Matrix4, Vector4, Quaternion and TwoBoneIkBatch code, and the analytic
+ * evaluation of the curves EasingCurve compiles.<br>
+ * The optimized kernels of the engine are checked against these implementations, so they must never be optimized.
+ */
+class ReferenceMaths
+{
+public:
+    using Matrix = std::array<float, 16>;
+    using Vector = std::array<float, 4>;
+    using TwoBoneChain = std::array<float, 26>;
+    using TwoBoneRotations = std::array<float, 8>;
+
+    // Constructors
+    ReferenceMaths() = delete;
+
+    // Destructor
+    ~ReferenceMaths() = delete;
+
+    // Methods
+    static Matrix multiply(const Matrix& left, const Matrix& right);
+    static Vector transform(const Matrix& matrix, const Vector& vector);
+    static Matrix createRotationMatrix(double angleX, double angleY, double angleZ);
+    static Matrix createRotationXMatrix(double angle);
+    static Matrix createRotationYMatrix(double angle);
+    static Matrix createRotationZMatrix(double angle);
+    static Matrix createScalingMatrix(float sx, float sy, float sz);
+    static Matrix createTranslationMatrix(float tx, float ty, float tz);
+    static float magnitude(const Vector& vector);
+    static Vector nlerp(const Vector& from, const Vector& to, float factor);
+    static TwoBoneRotations solveTwoBoneIk(const TwoBoneChain& chain);
+    static float evaluateBezier(float x1, float y1, float x2, float y2, float progress);
+};
+
+#endif //REFERENCE_MATHS_HPP
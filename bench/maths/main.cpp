@@ -0,0 +1,615 @@
+#include "ReferenceMaths.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <EasingCurve.hpp>
+#include <iomanip>
+#include <iostream>
+#include <Logger.hpp>
+#include <Matrix4.hpp>
+#include <Quaternion.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <TwoBoneIk.hpp>
+#include <vector>
+
+#define DEFAULT_MATHS_BENCH_SEED 42
+#define DEFAULT_MATHS_BENCH_ITERATIONS 200000
+#define DEFAULT_MATHS_BENCH_MIN_TIME_MS 20.0
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+/**
+ * The batch sizes at which every kernel is timed.
+ */
+static constexpr std::size_t BATCH_SIZES[] = {1, 16, 256, 4096, 65536};
+
+/**
+ * The timing of one kernel at one batch size, in nanoseconds per element.
+ */
+struct KernelTiming
+{
+    std::size_t batchSize = 0;
+    double referenceNs = 0;
+    double optimizedNs = 0;
+};
+
+/**
+ * The outcome of the differential check and of the timings of one kernel.
+ */
+struct KernelReport
+{
+    std::string name;
+    std::size_t checkedValues = 0;
+    std::size_t failures = 0;
+    std::uint32_t maxUlps = 0;
+    std::uint32_t worstUlps = 0;
+    std::vector<KernelTiming> timings;
+};
+
+/**
+ * Sink written by every timed loop so that the compiler cannot drop the computations.
+ */
+static volatile float benchmarkSink = 0;
+
+/**
+ * @return The distance in units in the last place between a and b (0 for +0 and -0)
+ */
+static std::uint32_t ulpDistance(const float a, const float b)
+{
+    if (a == b)
+    {
+        return 0;
+    }
+    if (std::isnan(a) || std::isnan(b))
+    {
+        return UINT32_MAX;
+    }
+    // Map the sign-magnitude representation onto a monotonic integer line
+    const auto toOrdered = [](const float value)
+    {
+        const auto bits = std::bit_cast<std::int32_t>(value);
+        return bits < 0 ? static_cast<std::int64_t>(INT32_MIN) - bits : static_cast<std::int64_t>(bits);
+    };
+    const std::int64_t distance = std::llabs(toOrdered(a) - toOrdered(b));
+    return distance > UINT32_MAX ? UINT32_MAX : static_cast<std::uint32_t>(distance);
+}
+
+/**
+ * Fuzz a kernel against its reference implementation, then time both at every batch size.
+ *
+ * @param name The name of the kernel
+ * @param maxUlps The accepted distance in units in the last place
+ * @param absoluteTolerance Differences below this value are accepted whatever their distance in ULP (cancellations)
+ * @param iterations The number of random inputs to check
+ * @param minTimeMs The minimal duration of each timed loop
+ * @param random The random number generator
+ * @param generate Fill one random input
+ * @param reference Run the reference implementation on a batch of inputs
+ * @param optimized Run the optimized kernel on a batch of inputs
+ *
+ * @return The report of the kernel
+ */
+template <typename Input, typename Output, typename Generate, typename Reference, typename Optimized>
+static KernelReport runKernel(const std::string& name,
+                              const std::uint32_t maxUlps,
+                              const float absoluteTolerance,
+                              const std::size_t iterations,
+                              const double minTimeMs,
+                              std::mt19937& random,
+                              Generate generate,
+                              Reference reference,
+                              Optimized optimized)
+{
+    KernelReport report;
+    report.name = name;
+    report.maxUlps = maxUlps;
+
+    // Differential check
+    std::vector<Input> inputs(iterations);
+    std::vector<Output> expected(iterations);
+    std::vector<Output> actual(iterations);
+    for (Input& input: inputs)
+    {
+        generate(random, input);
+    }
+    reference(inputs, expected);
+    optimized(inputs, actual);
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        for (std::size_t j = 0; j < expected[i].size(); ++j)
+        {
+            const std::uint32_t ulps = ulpDistance(expected[i][j], actual[i][j]);
+            const bool withinTolerance = ulps <= maxUlps
+                                         || std::fabs(expected[i][j] - actual[i][j]) <= absoluteTolerance;
+            report.worstUlps = std::max(report.worstUlps, ulps);
+            report.checkedValues++;
+            if (!withinTolerance)
+            {
+                if (report.failures == 0)
+                {
+                    Logger::error("%s: input %zu, value %zu: expected %.9g, got %.9g (%u ulps)",
+                                  name.c_str(), i, j, expected[i][j], actual[i][j], ulps);
+                }
+                report.failures++;
+            }
+        }
+    }
+
+    // Timings
+    const auto timeLoop = [minTimeMs](auto& function, const std::vector<Input>& batch, std::vector<Output>& output)
+    {
+        std::size_t repetitions = 0;
+        const auto start = BenchmarkClock::now();
+        double elapsed = 0;
+        do
+        {
+            function(batch, output);
+            benchmarkSink = benchmarkSink + output.back()[0];
+            repetitions++;
+            elapsed = std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start).count();
+        }
+        while (elapsed < minTimeMs);
+        return elapsed * 1e6 / static_cast<double>(repetitions * batch.size());
+    };
+    for (const std::size_t batchSize: BATCH_SIZES)
+    {
+        std::vector<Input> batch(batchSize);
+        std::vector<Output> output(batchSize);
+        for (Input& input: batch)
+        {
+            generate(random, input);
+        }
+        KernelTiming timing;
+        timing.batchSize = batchSize;
+        timing.referenceNs = timeLoop(reference, batch, output);
+        timing.optimizedNs = timeLoop(optimized, batch, output);
+        report.timings.push_back(timing);
+    }
+    return report;
+}
+
+/**
+ * @return A uniform random float between min and max
+ */
+static float randomFloat(std::mt19937& random, const float min, const float max)
+{
+    return std::uniform_real_distribution(min, max)(random);
+}
+
+/**
+ * @return The Matrix4 holding the given data
+ */
+static Matrix4 toMatrix4(const float* data)
+{
+    std::array<float, 16> array{};
+    std::copy_n(data, 16, array.begin());
+    return Matrix4(array);
+}
+
+/**
+ * Copy the data of a Matrix4 into an array.
+ */
+static void fromMatrix4(const Matrix4& matrix, std::array<float, 16>& output)
+{
+    std::copy_n(matrix.getData(), 16, output.begin());
+}
+
+/**
+ * @return The JSON report of the kernels
+ */
+static std::string toJson(const std::vector<KernelReport>& reports, const unsigned int seed)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << "{\n"
+            << "  \"seed\": " << seed << ",\n"
+            << "  \"kernels\": [\n";
+    for (std::size_t i = 0; i < reports.size(); ++i)
+    {
+        const KernelReport& report = reports[i];
+        oss << "    {\n"
+                << "      \"name\": \"" << report.name << "\",\n"
+                << "      \"checked_values\": " << report.checkedValues << ",\n"
+                << "      \"failures\": " << report.failures << ",\n"
+                << "      \"max_ulps\": " << report.maxUlps << ",\n"
+                << "      \"worst_ulps\": " << report.worstUlps << ",\n"
+                << "      \"timings\": [\n";
+        for (std::size_t j = 0; j < report.timings.size(); ++j)
+        {
+            const KernelTiming& timing = report.timings[j];
+            oss << "        {\"batch\": " << timing.batchSize
+                    << ", \"reference_ns\": " << timing.referenceNs
+                    << ", \"optimized_ns\": " << timing.optimizedNs
+                    << ", \"speedup\": " << timing.referenceNs / timing.optimizedNs << "}"
+                    << (j + 1 < report.timings.size() ? "," : "") << "\n";
+        }
+        oss << "      ]\n"
+                << "    }" << (i + 1 < reports.size() ? "," : "") << "\n";
+    }
+    oss << "  ]\n"
+            << "}\n";
+    return oss.str();
+}
+
+int main(const int argc, char** argv)
+{
+    unsigned int seed = DEFAULT_MATHS_BENCH_SEED;
+    std::size_t iterations = DEFAULT_MATHS_BENCH_ITERATIONS;
+    double minTimeMs = DEFAULT_MATHS_BENCH_MIN_TIME_MS;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (argument == "--seed" && hasValue)
+        {
+            seed = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--iterations" && hasValue)
+        {
+            iterations = std::max(std::strtoul(argv[++i], nullptr, 10), 1ul);
+        }
+        else if (argument == "--min-time-ms" && hasValue)
+        {
+            minTimeMs = std::strtod(argv[++i], nullptr);
+        }
+        else
+        {
+            std::cout << "Usage: humangl_maths_bench [--seed N] [--iterations N] [--min-time-ms MS]\n";
+            return argument == "--help" ? 0 : 2;
+        }
+    }
+
+    std::mt19937 random(seed);
+    std::vector<KernelReport> reports;
+
+    using Matrix = std::array<float, 16>;
+    using MatrixPair = std::array<float, 32>;
+    using Point = std::array<float, 3>;
+    using Vector = std::array<float, 4>;
+    using Angles = std::array<float, 3>;
+    using TRS = std::array<float, 9>;
+    using Scalar = std::array<float, 1>;
+    static_assert(sizeof(Point) == 3 * sizeof(float), "Points must be tightly packed");
+
+    const auto generateValues = [](std::mt19937& generator, auto& values)
+    {
+        for (float& value: values)
+        {
+            value = randomFloat(generator, -10.0f, 10.0f);
+        }
+    };
+    const auto generateAngles = [](std::mt19937& generator, Angles& angles)
+    {
+        for (float& angle: angles)
+        {
+            angle = randomFloat(generator, -2 * M_PI, 2 * M_PI);
+        }
+    };
+
+    reports.push_back(runKernel<MatrixPair, Matrix>(
+        "matrix4_multiply", 0, 0.0f, iterations, minTimeMs, random, generateValues,
+        [](const std::vector<MatrixPair>& inputs, std::vector<Matrix>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                Matrix left;
+                Matrix right;
+                std::copy_n(inputs[i].begin(), 16, left.begin());
+                std::copy_n(inputs[i].begin() + 16, 16, right.begin());
+                outputs[i] = ReferenceMaths::multiply(left, right);
+            }
+        },
+        [](const std::vector<MatrixPair>& inputs, std::vector<Matrix>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                fromMatrix4(toMatrix4(inputs[i].data()) * toMatrix4(inputs[i].data() + 16), outputs[i]);
+            }
+        }));
+
+    reports.push_back(runKernel<std::array<float, 20>, Vector>(
+        "matrix4_vector4", 0, 0.0f, iterations, minTimeMs, random, generateValues,
+        [](const std::vector<std::array<float, 20>>& inputs, std::vector<Vector>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                Matrix matrix;
+                std::copy_n(inputs[i].begin(), 16, matrix.begin());
+                outputs[i] = ReferenceMaths::transform(matrix, {inputs[i][16], inputs[i][17], inputs[i][18], inputs[i][19]});
+            }
+        },
+        [](const std::vector<std::array<float, 20>>& inputs, std::vector<Vector>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const Vector4 result = toMatrix4(inputs[i].data())
+                                       * Vector4(inputs[i][16], inputs[i][17], inputs[i][18], inputs[i][19]);
+                outputs[i] = {result.getX(), result.getY(), result.getZ(), result.getW()};
+            }
+        }));
+
+    Matrix transform;
+    generateValues(random, transform);
+    const Matrix4 transformMatrix(transform);
+    // The in-place check draws the same points from a copy of the generator, the inputs of the next kernels unchanged
+    std::mt19937 inPlaceRandom = random;
+    reports.push_back(runKernel<Point, Point>(
+        "matrix4_transform_points", 0, 0.0f, iterations, minTimeMs, random, generateValues,
+        [&transform](const std::vector<Point>& inputs, std::vector<Point>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const Vector result = ReferenceMaths::transform(transform, {inputs[i][0], inputs[i][1], inputs[i][2], 1.0f});
+                outputs[i] = {result[0], result[1], result[2]};
+            }
+        },
+        [&transformMatrix](const std::vector<Point>& inputs, std::vector<Point>& outputs)
+        {
+            transformMatrix.transformPoints(inputs.front().data(), outputs.front().data(), inputs.size());
+        }));
+    reports.push_back(runKernel<Point, Point>(
+        "matrix4_transform_points_in_place", 0, 0.0f, iterations, minTimeMs, inPlaceRandom, generateValues,
+        [&transform](const std::vector<Point>& inputs, std::vector<Point>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const Vector result = ReferenceMaths::transform(transform, {inputs[i][0], inputs[i][1], inputs[i][2], 1.0f});
+                outputs[i] = {result[0], result[1], result[2]};
+            }
+        },
+        [&transformMatrix](const std::vector<Point>& inputs, std::vector<Point>& outputs)
+        {
+            // The vertices of a body part are transformed in their own buffer
+            std::ranges::copy(inputs, outputs.begin());
+            transformMatrix.transformPoints(outputs.front().data(), outputs.front().data(), outputs.size());
+        }));
+
+    reports.push_back(runKernel<Angles, Matrix>(
+        "matrix4_rotation", 0, 0.0f, iterations, minTimeMs, random, generateAngles,
+        [](const std::vector<Angles>& inputs, std::vector<Matrix>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                outputs[i] = ReferenceMaths::createRotationMatrix(inputs[i][0], inputs[i][1], inputs[i][2]);
+            }
+        },
+        [](const std::vector<Angles>& inputs, std::vector<Matrix>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                fromMatrix4(Matrix4::createRotationMatrix(inputs[i][0], inputs[i][1], inputs[i][2]), outputs[i]);
+            }
+        }));
+
+    reports.push_back(runKernel<TRS, Matrix>(
+        "matrix4_trs", 0, 0.0f, iterations, minTimeMs, random,
+        [&generateValues](std::mt19937& generator, TRS& trs)
+        {
+            generateValues(generator, trs);
+            for (int i = 3; i < 6; ++i)
+            {
+                trs[i] = randomFloat(generator, -2 * M_PI, 2 * M_PI);
+            }
+        },
+        [](const std::vector<TRS>& inputs, std::vector<Matrix>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const TRS& trs = inputs[i];
+                outputs[i] = ReferenceMaths::multiply(
+                    ReferenceMaths::multiply(ReferenceMaths::createTranslationMatrix(trs[0], trs[1], trs[2]),
+                                             ReferenceMaths::createRotationMatrix(trs[3], trs[4], trs[5])),
+                    ReferenceMaths::createScalingMatrix(trs[6], trs[7], trs[8]));
+            }
+        },
+        [](const std::vector<TRS>& inputs, std::vector<Matrix>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const TRS& trs = inputs[i];
+                fromMatrix4(Matrix4::createTRSMatrix(trs[0], trs[1], trs[2],
+                                                     trs[3], trs[4], trs[5],
+                                                     trs[6], trs[7], trs[8]),
+                            outputs[i]);
+            }
+        }));
+
+    reports.push_back(runKernel<Vector, Scalar>(
+        "vector4_magnitude", 1, 0.0f, iterations, minTimeMs, random, generateValues,
+        [](const std::vector<Vector>& inputs, std::vector<Scalar>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                outputs[i] = {ReferenceMaths::magnitude(inputs[i])};
+            }
+        },
+        [](const std::vector<Vector>& inputs, std::vector<Scalar>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                outputs[i] = {Vector4(inputs[i][0], inputs[i][1], inputs[i][2], inputs[i][3]).magnitude()};
+            }
+        }));
+
+    // Two random unit quaternions and a factor in [0, 1]
+    reports.push_back(runKernel<std::array<float, 9>, Vector>(
+        "quaternion_nlerp", 4, 1e-6f, iterations, minTimeMs, random,
+        [](std::mt19937& generator, std::array<float, 9>& input)
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                const Quaternion rotation = Quaternion::fromEulerAngles(randomFloat(generator, -M_PI, M_PI),
+                                                                        randomFloat(generator, -M_PI, M_PI),
+                                                                        randomFloat(generator, -M_PI, M_PI));
+                input[i * 4 + 0] = rotation.getW();
+                input[i * 4 + 1] = rotation.getX();
+                input[i * 4 + 2] = rotation.getY();
+                input[i * 4 + 3] = rotation.getZ();
+            }
+            input[8] = randomFloat(generator, 0.0f, 1.0f);
+        },
+        [](const std::vector<std::array<float, 9>>& inputs, std::vector<Vector>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const auto& input = inputs[i];
+                outputs[i] = ReferenceMaths::nlerp({input[0], input[1], input[2], input[3]},
+                                                   {input[4], input[5], input[6], input[7]},
+                                                   input[8]);
+            }
+        },
+        [](const std::vector<std::array<float, 9>>& inputs, std::vector<Vector>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const auto& input = inputs[i];
+                const Quaternion result = Quaternion::nlerp(Quaternion(input[0], input[1], input[2], input[3]),
+                                                            Quaternion(input[4], input[5], input[6], input[7]),
+                                                            input[8]);
+                outputs[i] = {result.getW(), result.getX(), result.getY(), result.getZ()};
+            }
+        }));
+
+    // A chain of random bones and animated rotations, its target anywhere but on its root up to beyond its reach
+    TwoBoneIkBatch batch;
+    reports.push_back(runKernel<ReferenceMaths::TwoBoneChain, ReferenceMaths::TwoBoneRotations>(
+        "two_bone_ik", 64, 1e-4f, iterations, minTimeMs, random,
+        [](std::mt19937& generator, ReferenceMaths::TwoBoneChain& chain)
+        {
+            const auto randomDirection = [&generator](float* direction)
+            {
+                const Vector4 value = Vector4(randomFloat(generator, -1.0f, 1.0f),
+                                              randomFloat(generator, -1.0f, 1.0f),
+                                              randomFloat(generator, -1.0f, 1.0f),
+                                              0.0f).normalize();
+                direction[0] = value.getX();
+                direction[1] = value.getY();
+                direction[2] = value.getZ();
+            };
+            for (int i = 0; i < 3; ++i)
+            {
+                chain[i] = randomFloat(generator, -1.0f, 1.0f);
+            }
+            randomDirection(&chain[3]);
+            randomDirection(&chain[6]);
+            randomDirection(&chain[9]);
+            randomDirection(&chain[12]);
+            const float upperLength = randomFloat(generator, 0.1f, 0.3f);
+            const float lowerLength = randomFloat(generator, 0.1f, 0.3f);
+            const float distance = randomFloat(generator, 0.01f, 1.2f) * (upperLength + lowerLength);
+            for (int i = 0; i < 3; ++i)
+            {
+                chain[3 + i] *= upperLength;
+                chain[6 + i] *= lowerLength;
+                chain[9 + i] = chain[i] + chain[9 + i] * distance;
+            }
+            chain[15] = randomFloat(generator, 0.0f, 1.0f);
+            chain[16] = randomFloat(generator, 0.0f, 1.0f);
+            chain[17] = static_cast<float>(M_PI);
+            for (int i = 0; i < 2; ++i)
+            {
+                const Quaternion rotation = Quaternion::fromEulerAngles(randomFloat(generator, -M_PI, M_PI),
+                                                                        randomFloat(generator, -M_PI, M_PI),
+                                                                        randomFloat(generator, -M_PI, M_PI));
+                chain[18 + i * 4] = rotation.getW();
+                chain[19 + i * 4] = rotation.getX();
+                chain[20 + i * 4] = rotation.getY();
+                chain[21 + i * 4] = rotation.getZ();
+            }
+        },
+        [](const std::vector<ReferenceMaths::TwoBoneChain>& inputs,
+           std::vector<ReferenceMaths::TwoBoneRotations>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                outputs[i] = ReferenceMaths::solveTwoBoneIk(inputs[i]);
+            }
+        },
+        [&batch](const std::vector<ReferenceMaths::TwoBoneChain>& inputs,
+                 std::vector<ReferenceMaths::TwoBoneRotations>& outputs)
+        {
+            batch.clear();
+            for (const ReferenceMaths::TwoBoneChain& input: inputs)
+            {
+                const TwoBoneChain chain = {
+                    0, 1,
+                    Vector4(input[0], input[1], input[2], 0.0f),
+                    Vector4(input[3], input[4], input[5], 0.0f),
+                    Vector4(input[6], input[7], input[8], 0.0f),
+                    Vector4(input[12], input[13], input[14], 0.0f),
+                    input[16], input[17]
+                };
+                batch.add(chain,
+                          chain.root,
+                          Quaternion(input[18], input[19], input[20], input[21]),
+                          Quaternion(input[22], input[23], input[24], input[25]),
+                          {Vector4(input[9], input[10], input[11], 0.0f), chain.pole, input[15]});
+            }
+            batch.solve();
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const Quaternion upper = batch.getUpperRotation(i);
+                const Quaternion lower = batch.getLowerRotation(i);
+                outputs[i] = {
+                    upper.getW(), upper.getX(), upper.getY(), upper.getZ(),
+                    lower.getW(), lower.getX(), lower.getY(), lower.getZ()
+                };
+            }
+        }));
+
+    // The "ease" timing function of CSS, fifteen channels at once so that the batch ends with a scalar tail
+    constexpr float easeX1 = 0.25f;
+    constexpr float easeY1 = 0.1f;
+    constexpr float easeX2 = 0.25f;
+    constexpr float easeY2 = 1.0f;
+    const EasingCurve ease = EasingCurve::fromBezier(easeX1, easeY1, easeX2, easeY2);
+    using EasingChannels = std::array<float, 15>;
+    reports.push_back(runKernel<EasingChannels, EasingChannels>(
+        "easing_curve", 64, 1e-3f, iterations, minTimeMs, random,
+        [](std::mt19937& generator, EasingChannels& progresses)
+        {
+            for (float& progress: progresses)
+            {
+                progress = randomFloat(generator, -0.1f, 1.1f);
+            }
+        },
+        [](const std::vector<EasingChannels>& inputs, std::vector<EasingChannels>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                for (std::size_t channel = 0; channel < inputs[i].size(); ++channel)
+                {
+                    outputs[i][channel] = ReferenceMaths::evaluateBezier(easeX1, easeY1, easeX2, easeY2,
+                                                                         inputs[i][channel]);
+                }
+            }
+        },
+        [&ease](const std::vector<EasingChannels>& inputs, std::vector<EasingChannels>& outputs)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                ease.evaluate(inputs[i], outputs[i]);
+            }
+        }));
+
+    std::cout << toJson(reports, seed);
+
+    bool success = true;
+    for (const KernelReport& report: reports)
+    {
+        if (report.failures > 0)
+        {
+            Logger::error("%s: %zu of %zu values outside of %u ulps.",
+                          report.name.c_str(), report.failures, report.checkedValues, report.maxUlps);
+            success = false;
+        }
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+#ifndef ANIMATION_CLIP_HPP
+#define ANIMATION_CLIP_HPP
+
+#include <algorithm>
+#include <AnimationSource.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <EasingCurve.hpp>
+#include <Pose.hpp>
+#include <Quaternion.hpp>
+#include <utility>
+#include <Vector4.hpp>
+#include <vector>
+
+/**
+ * How a track computes its value between two keys.
+ */
+enum InterpolationMode
+{
+    STEP_INTERPOLATION,     // Hold the value of the previous key
+    LINEAR_INTERPOLATION,   // Lerp vectors, slerp rotations
+    CURVE_INTERPOLATION     // Lerp vectors, slerp rotations, by the eased factor of the curve of the track
+};
+
+/**
+ * A rotation at a given time.
+ */
+struct RotationKey
+{
+    float time;
+    Quaternion value;
+};
+
+/**
+ * A translation or a scale at a given time (w unused).
+ */
+struct VectorKey
+{
+    float time;
+    Vector4 value;
+};
+
+/**
+ * The keys animating one channel of one joint, sorted by time.
+ */
+template<typename Key>
+struct AnimationTrack
+{
+    /**
+    * The index of the animated joint in the pose.
+    */
+    std::size_t joint;
+
+    /**
+    * How the value is computed between two keys.
+    */
+    InterpolationMode interpolation;
+
+    /**
+    * The keys of the track, sorted by time.
+    */
+    std::vector<Key> keys;
+
+    /**
+    * The easing applied between every two keys with CURVE_INTERPOLATION, shared by the tracks using it (nullptr for
+    * none).
+    */
+    const EasingCurve* curve = nullptr;
+
+    /**
+     * Insert a key, keeping the keys sorted by time.<br>
+     * To build long tracks, prefer setKeys() which sorts only once.
+     *
+     * @param key The key to insert
+     *
+     * @return itself
+     */
+    AnimationTrack& addKey(const Key& key)
+    {
+        const auto position = std::ranges::upper_bound(keys, key.time, {}, &Key::time);
+        keys.insert(position, key);
+        return *this;
+    }
+
+    /**
+     * Replace all the keys at once, sorting them a single time.<br>
+     * Keys sharing the same time keep their relative order.
+     *
+     * @param newKeys The keys, in any order
+     *
+     * @return itself
+     */
+    AnimationTrack& setKeys(std::vector<Key> newKeys)
+    {
+        keys = std::move(newKeys);
+        std::ranges::stable_sort(keys, {}, &Key::time);
+        return *this;
+    }
+
+    /**
+     * Ease the track between every two keys, switching it to CURVE_INTERPOLATION.
+     *
+     * @param newCurve The easing curve, which must outlive the track (the curves of EasingCurve::get() do)
+     *
+     * @return itself
+     */
+    AnimationTrack& setCurve(const EasingCurve& newCurve)
+    {
+        curve = &newCurve;
+        interpolation = CURVE_INTERPOLATION;
+        return *this;
+    }
+};
+
+using RotationTrack = AnimationTrack<RotationKey>;
+using VectorTrack = AnimationTrack<VectorKey>;
+
+/**
+ * Data-driven animation: per-joint rotation, translation and scale tracks.<br>
+ * A clip does not reference any human, sampling it fills a Pose that is then applied to a skeleton.
+ */
+class AnimationClip : public AnimationSource
+{
+public:
+    // Constructors
+    explicit AnimationClip(float duration = 0.0f);
+
+    // Getters
+    [[nodiscard]] float getDuration() const override;
+    [[nodiscard]] std::size_t getTrackCount() const;
+    [[nodiscard]] const std::vector<RotationTrack>& getRotationTracks() const;
+    [[nodiscard]] const std::vector<VectorTrack>& getTranslationTracks() const;
+    [[nodiscard]] const std::vector<VectorTrack>& getScaleTracks() const;
+
+    // Setters
+    AnimationClip& setDuration(float duration);
+
+    // Methods
+    RotationTrack& addRotationTrack(std::size_t joint, InterpolationMode interpolation = LINEAR_INTERPOLATION);
+    VectorTrack& addTranslationTrack(std::size_t joint, InterpolationMode interpolation = LINEAR_INTERPOLATION);
+    VectorTrack& addScaleTrack(std::size_t joint, InterpolationMode interpolation = LINEAR_INTERPOLATION);
+    [[nodiscard]] bool hasRotationTrack(std::size_t joint) const;
+    [[nodiscard]] bool hasTranslationTrack(std::size_t joint) const;
+    void sample(float time, Pose& pose, ClipCursor* cursor = nullptr) const override;
+
+private:
+    /**
+    * The duration of the clip in seconds.
+    */
+    float _duration;
+
+    /**
+    * The rotation tracks.
+    */
+    std::vector<RotationTrack> _rotationTracks;
+
+    /**
+    * The translation tracks.
+    */
+    std::vector<VectorTrack> _translationTracks;
+
+    /**
+    * The scale tracks.
+    */
+    std::vector<VectorTrack> _scaleTracks;
+};
+
+#endif //ANIMATION_CLIP_HPP
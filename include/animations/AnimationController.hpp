@@ -0,0 +1,78 @@
+#ifndef ANIMATION_CONTROLLER_HPP
+#define ANIMATION_CONTROLLER_HPP
+
+#include <AnimationPlayer.hpp>
+#include <AnimationStateMachine.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Drives an AnimationPlayer with a shared AnimationStateMachine.<br>
+ * Transitions are only looked for when something can fire them: an event is triggered, a parameter changes or the
+ * current state reaches the earliest exit time among its transitions. Between those, an update only moves the time
+ * of the state forward, so a character costs no more than the pose of its current state.
+ */
+class AnimationController
+{
+public:
+    // Constructors
+    AnimationController(std::shared_ptr<const AnimationStateMachine> stateMachine,
+                        AnimationPlayer* player,
+                        std::size_t initialState = 0);
+
+    // Getters
+    [[nodiscard]] const std::shared_ptr<const AnimationStateMachine>& getStateMachine() const;
+    [[nodiscard]] AnimationPlayer* getPlayer() const;
+    [[nodiscard]] std::size_t getState() const;
+    [[nodiscard]] float getStateTime() const;
+    [[nodiscard]] float getParameter(std::size_t parameter) const;
+
+    // Setters
+    AnimationController& setParameter(std::size_t parameter, float value);
+
+    // Methods
+    bool trigger(std::size_t event);
+    void update(float deltaTime);
+
+private:
+    /**
+    * The graph played by the controller, shared with the other controllers.
+    */
+    std::shared_ptr<const AnimationStateMachine> _stateMachine;
+
+    /**
+    * The player of the character.
+    */
+    AnimationPlayer* _player;
+
+    /**
+    * The current state.
+    */
+    std::size_t _state;
+
+    /**
+    * The time in seconds spent in the current state, the speed of the player included.
+    */
+    float _stateTime;
+
+    /**
+    * The state time from which a transition without event may fire (infinite if none can before a parameter changes).
+    */
+    float _nextExitTime;
+
+    /**
+    * The value of each parameter.
+    */
+    std::vector<float> _parameters;
+
+    // Private methods
+    [[nodiscard]] bool _conditionsHold(const AnimationTransition& transition) const;
+    [[nodiscard]] float _getExitTime(const AnimationTransition& transition) const;
+    [[nodiscard]] bool _canFire(const AnimationTransition& transition, std::size_t event) const;
+    [[nodiscard]] const AnimationTransition* _findTransition(std::size_t event) const;
+    void _enter(std::size_t state, float blendDuration);
+    void _checkTransitions();
+};
+
+#endif //ANIMATION_CONTROLLER_HPP
@@ -0,0 +1,181 @@
+#ifndef ANIMATION_EVENT_DISPATCHER_HPP
+#define ANIMATION_EVENT_DISPATCHER_HPP
+
+#include <AnimationDefines.hpp>
+#include <AnimationPlayer.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <FrameArena.hpp>
+#include <functional>
+#include <span>
+#include <TimerWheel.hpp>
+#include <vector>
+
+/**
+ * An event reached by a player.
+ */
+struct AnimationNotification
+{
+    /**
+    * The simulated time in seconds the player reached the event at, usually a little before the update reporting it.
+    */
+    double time;
+
+    /**
+    * The player.
+    */
+    AnimationPlayer* player;
+
+    /**
+    * The id of the event.
+    */
+    std::uint32_t id;
+};
+
+/**
+ * Reports the events of the base clips of the watched players as they reach them, on the simulation clock.<br>
+ * Only the next event of each player is scheduled, in a TimerWheel: players are not looked at on the updates between
+ * two of their events, and an event costs the same to schedule and to fire whatever the number of players. A player
+ * tells its dispatcher when its timeline changes (a clip played, a seek, a new speed...), and its next event is found
+ * again from the position it changed to. The events reached by an update, looping and ping-pong included, are reported
+ * together in time order, to the listener and by getNotifications().
+ */
+class AnimationEventDispatcher
+{
+public:
+    /**
+    * Receives the events reached by an update.
+    */
+    using Listener = std::function<void(std::span<const AnimationNotification>)>;
+
+    // Constructors
+    explicit AnimationEventDispatcher(float tickDuration = ANIMATION_EVENT_TICK);
+    AnimationEventDispatcher(const AnimationEventDispatcher& other) = delete;
+
+    // Destructor
+    ~AnimationEventDispatcher();
+
+    // Operator overloads
+    AnimationEventDispatcher& operator=(const AnimationEventDispatcher& other) = delete;
+
+    // Getters
+    [[nodiscard]] double getTime() const;
+    [[nodiscard]] float getTickDuration() const;
+    [[nodiscard]] std::size_t getPlayerCount() const;
+    [[nodiscard]] std::size_t getScheduledCount() const;
+    [[nodiscard]] std::span<const AnimationNotification> getNotifications() const;
+
+    // Setters
+    AnimationEventDispatcher& setListener(Listener listener);
+
+    // Methods
+    void reserve(std::size_t playerCount);
+    void watch(AnimationPlayer* player);
+    void unwatch(AnimationPlayer* player);
+    void update(float deltaTime);
+    void clear();
+
+private:
+    /**
+    * A watched player and its next event.
+    */
+    struct WatchedPlayer
+    {
+        /**
+        * The player (nullptr for a free slot).
+        */
+        AnimationPlayer* player;
+
+        /**
+        * The timer of the next event (TimerWheel::NO_TIMER if the player has none).
+        */
+        std::uint32_t timer;
+
+        /**
+        * The next event along the playback cycle of the player, among the events met on the way there and back.
+        */
+        std::size_t step;
+
+        /**
+        * The simulated time in seconds the player reaches the next event at.
+        */
+        double time;
+    };
+
+    /**
+    * An event reached by the current update, with its place in the order they were found.
+    */
+    struct ReachedEvent
+    {
+        /**
+        * The event.
+        */
+        AnimationNotification notification;
+
+        /**
+        * The number of events found before it by the current update, keeping the events of the same time in order.
+        */
+        std::size_t sequence;
+    };
+
+    /**
+    * The simulated time in seconds.
+    */
+    double _time;
+
+    /**
+    * The seconds per tick of the wheel, the precision of the dispatch.
+    */
+    float _tickDuration;
+
+    /**
+    * The receiver of the events reached by each update (empty to only keep them for getNotifications()).
+    */
+    Listener _listener;
+
+    /**
+    * The next event of every watched player.
+    */
+    TimerWheel _wheel;
+
+    /**
+    * The watched players, indexed by their slot.
+    */
+    std::vector<WatchedPlayer> _players;
+
+    /**
+    * The slots freed by unwatch(), given to the next players watched.
+    */
+    std::vector<std::uint32_t> _freeSlots;
+
+    /**
+    * The slots of the players whose timeline changed since the last update, filled up to _outdatedCount by any thread.
+    */
+    std::vector<std::uint32_t> _outdated;
+
+    /**
+    * The number of slots in _outdated.
+    */
+    std::atomic<std::size_t> _outdatedCount;
+
+    /**
+    * The events reached by the last update, in time order.
+    */
+    std::vector<AnimationNotification> _notifications;
+
+    /**
+    * The number of watched players.
+    */
+    std::size_t _playerCount;
+
+    friend class AnimationPlayer;
+
+    // Private methods
+    void _invalidate(std::uint32_t slot);
+    void _schedule(std::uint32_t slot);
+    void _reach(std::uint32_t slot, FrameVector<ReachedEvent>& reached);
+    [[nodiscard]] std::uint64_t _getTick(double time) const;
+};
+
+#endif //ANIMATION_EVENT_DISPATCHER_HPP
@@ -0,0 +1,112 @@
+#ifndef ANIMATION_LAYER_HPP
+#define ANIMATION_LAYER_HPP
+
+#include <AnimationSource.hpp>
+#include <JointMask.hpp>
+#include <memory>
+#include <Pose.hpp>
+
+/**
+ * How a layer combines its pose with the layers below it.
+ */
+enum LayerBlendMode
+{
+    OVERRIDE_BLEND,     // Move toward the pose of the layer
+    ADDITIVE_BLEND      // Add the pose of the layer, read as differences from the rest pose
+};
+
+/**
+ * How the time of a layer moves through its clip.
+ */
+enum PlaybackMode
+{
+    LOOP_PLAYBACK,          // Start again from the beginning after the end
+    ONCE_PLAYBACK,          // Hold the last pose after the end (the first one when playing backward)
+    PING_PONG_PLAYBACK      // Play backward after the end, then forward again after the beginning
+};
+
+/**
+ * One shared clip being played, with its own time, cursor and sampled pose.<br>
+ * An AnimationPlayer stacks layers: a base layer, the layer fading out during a crossfade and any number of override
+ * or additive layers, each optionally restricted to some joints by a JointMask.
+ */
+class AnimationLayer
+{
+public:
+    // Constructors
+    explicit AnimationLayer(std::size_t jointCount);
+
+    // Getters
+    [[nodiscard]] const std::shared_ptr<const AnimationSource>& getClip() const;
+    [[nodiscard]] float getTime() const;
+    [[nodiscard]] float getCycleTime() const;
+    [[nodiscard]] float getCycleTimeAfter(float deltaTime) const;
+    [[nodiscard]] float getWeight() const;
+    [[nodiscard]] LayerBlendMode getBlendMode() const;
+    [[nodiscard]] PlaybackMode getPlaybackMode() const;
+    [[nodiscard]] const std::shared_ptr<const JointMask>& getMask() const;
+    [[nodiscard]] Pose& getPose();
+    [[nodiscard]] const Pose& getPose() const;
+    [[nodiscard]] bool isPlaying() const;
+
+    // Setters
+    AnimationLayer& setTime(double time);
+    AnimationLayer& setWeight(float weight);
+    AnimationLayer& setBlendMode(LayerBlendMode blendMode);
+    AnimationLayer& setPlaybackMode(PlaybackMode playbackMode);
+    AnimationLayer& setMask(std::shared_ptr<const JointMask> mask);
+
+    // Methods
+    void play(std::shared_ptr<const AnimationSource> clip, float startTime = 0.0f);
+    void stop();
+    void advance(float deltaTime);
+    void skip(float deltaTime);
+    void applyTo(Pose& pose) const;
+
+private:
+    /**
+    * The clip being played, shared with the other layers (nullptr if stopped).
+    */
+    std::shared_ptr<const AnimationSource> _clip;
+
+    /**
+    * The position in the playback cycle in seconds: between 0 and the duration of the clip, or twice its duration
+    * when playing in ping-pong.
+    */
+    float _time;
+
+    /**
+    * The weight of the layer, between 0 and 1.
+    */
+    float _weight;
+
+    /**
+    * How the pose of the layer is combined with the layers below it.
+    */
+    LayerBlendMode _blendMode;
+
+    /**
+    * How the time moves through the clip.
+    */
+    PlaybackMode _playbackMode;
+
+    /**
+    * The joints affected by the layer (nullptr for every joint).
+    */
+    std::shared_ptr<const JointMask> _mask;
+
+    /**
+    * The position of the layer in the tracks of the clip.
+    */
+    ClipCursor _cursor;
+
+    /**
+    * The pose sampled by the last advance, reused every frame.
+    */
+    Pose _pose;
+
+    // Private methods
+    [[nodiscard]] float _wrapTime(double time) const;
+};
+
+#endif //ANIMATION_LAYER_HPP
@@ -0,0 +1,119 @@
+#ifndef ANIMATION_LIBRARY_HPP
+#define ANIMATION_LIBRARY_HPP
+
+#include <BakedClip.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * The kind of data stored in an entry of an AnimationLibrary.
+ */
+enum LibraryEntryType : std::uint32_t
+{
+    CLIP_ENTRY = 1,        // A BakedClip pose table
+    SKELETON_ENTRY = 2     // The parent of each joint of a skeleton
+};
+
+/**
+ * A clip to store in an AnimationLibrary.
+ */
+struct LibraryClip
+{
+    std::string name;
+    const BakedClip* clip;
+};
+
+/**
+ * A skeleton to store in an AnimationLibrary: the parent of each joint, -1 for the roots.
+ */
+struct LibrarySkeleton
+{
+    std::string name;
+    std::span<const int> parents;
+};
+
+/**
+ * A read-only library of baked clips and skeletons, mapped in memory and used in place.<br>
+ * Opening a library only maps the file and checks its header and table of contents, whose entries are sorted by name:
+ * nothing is parsed or copied. The clips it returns view the pose tables of the mapping, whose pages are read from
+ * disk the first time they are sampled. The mapping is shared, so processes opening the same library share the page
+ * cache instead of holding a copy each.<br>
+ * Values are stored in the byte order of the machine, libraries are not meant to be exchanged between architectures.
+ */
+class AnimationLibrary : public std::enable_shared_from_this<AnimationLibrary>
+{
+public:
+    /**
+    * The alignment of every entry in the file, a cache line, so pose tables start on a line boundary.
+    */
+    static constexpr std::size_t ENTRY_ALIGNMENT = 64;
+
+    /**
+    * The maximal length of an entry name.
+    */
+    static constexpr std::size_t MAX_NAME_LENGTH = 39;
+
+    // Constructors
+    AnimationLibrary(const AnimationLibrary&) = delete;
+
+    // Destructor
+    ~AnimationLibrary();
+
+    // Getters
+    [[nodiscard]] const std::string& getPath() const;
+    [[nodiscard]] std::size_t getByteSize() const;
+    [[nodiscard]] std::size_t getEntryCount() const;
+    [[nodiscard]] std::string_view getEntryName(std::size_t index) const;
+    [[nodiscard]] LibraryEntryType getEntryType(std::size_t index) const;
+
+    // Methods
+    [[nodiscard]] std::shared_ptr<const BakedClip> getClip(std::string_view name) const;
+    [[nodiscard]] std::span<const std::int32_t> getSkeleton(std::string_view name) const;
+
+    static std::shared_ptr<const AnimationLibrary> open(const std::string& path);
+    static void write(const std::string& path,
+                      const std::vector<LibraryClip>& clips,
+                      const std::vector<LibrarySkeleton>& skeletons);
+
+    // Operator overloads
+    AnimationLibrary& operator=(const AnimationLibrary&) = delete;
+
+private:
+    // Constructors
+    AnimationLibrary(std::string path, const unsigned char* data, std::size_t size);
+
+    /**
+    * The path of the mapped file.
+    */
+    std::string _path;
+
+    /**
+    * The first byte of the mapping.
+    */
+    const unsigned char* _data;
+
+    /**
+    * The size of the mapping in bytes, the size of the file.
+    */
+    std::size_t _size;
+
+    /**
+    * The number of entries of the table of contents.
+    */
+    std::size_t _entryCount;
+
+    /**
+    * The offset of the table of contents in the file.
+    */
+    std::size_t _tocOffset;
+
+    // Private methods
+    [[nodiscard]] std::span<const unsigned char> _findEntry(std::string_view name, LibraryEntryType type) const;
+};
+
+#endif //ANIMATION_LIBRARY_HPP
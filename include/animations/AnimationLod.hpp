@@ -0,0 +1,49 @@
+#ifndef ANIMATION_LOD_HPP
+#define ANIMATION_LOD_HPP
+
+#include <array>
+#include <Matrix4.hpp>
+#include <Vector4.hpp>
+
+/**
+ * How much of its animation a character gets, from the most to the least expensive.
+ */
+enum AnimationLodLevel
+{
+    FULL_LOD,       // Evaluated every update, every joint
+    REDUCED_LOD,    // Evaluated every ANIMATION_LOD_REDUCED_INTERVAL updates, every joint
+    MINIMAL_LOD,    // Evaluated every ANIMATION_LOD_MINIMAL_INTERVAL updates, without the minor joints
+    CULLED_LOD      // Out of view: only the clocks of its layers move forward
+};
+
+/**
+ * The animation level-of-detail policy for one camera.<br>
+ * Built once per frame from the camera, it sorts characters by their distance to the camera and culls the ones whose
+ * bounding sphere is outside of the view frustum, so the cost of a crowd follows what is visible.
+ */
+class AnimationLod
+{
+public:
+    // Constructors
+    AnimationLod(const Vector4& cameraPosition, const Matrix4& viewProjection);
+
+    // Getters
+    [[nodiscard]] static unsigned int getUpdateInterval(AnimationLodLevel level);
+
+    // Methods
+    [[nodiscard]] static AnimationLod fromCamera();
+    [[nodiscard]] AnimationLodLevel classify(const Vector4& position, float radius) const;
+
+private:
+    /**
+    * The position of the eye in the world, where the view translation by the camera position brings the origin.
+    */
+    Vector4 _eye;
+
+    /**
+    * The planes of the view frustum (a, b, c, d), the inside verifying ax + by + cz + d >= 0.
+    */
+    std::array<std::array<float, 4>, 6> _planes;
+};
+
+#endif //ANIMATION_LOD_HPP
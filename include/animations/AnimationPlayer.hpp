@@ -0,0 +1,180 @@
+#ifndef ANIMATION_PLAYER_HPP
+#define ANIMATION_PLAYER_HPP
+
+#include <AnimationSource.hpp>
+#include <AnimationLayer.hpp>
+#include <AnimationLod.hpp>
+#include <array>
+#include <cstdint>
+#include <Human.hpp>
+#include <memory>
+#include <Pose.hpp>
+#include <span>
+#include <TwoBoneIk.hpp>
+#include <vector>
+
+class AnimationEventDispatcher;
+
+/**
+ * Plays shared animations (AnimationSource) on a human.<br>
+ * They are immutable and may be played by any number of players at once: a player only owns the per-character
+ * playback state. Its pose is evaluated from a stack of layers: the base clip, crossfaded when it is replaced, then
+ * every extra layer from the first added to the last, each overriding or adding to the result below it.<br>
+ * Its AnimationLodLevel decides how often the pose is evaluated: the time of the skipped updates is accumulated and
+ * caught up by the next evaluation, so throttled characters stay in sync with the others.<br>
+ * The limbs given an IkTarget are solved on the evaluated pose, four limbs at once, before it is applied to the human.
+ * <br>
+ * A player watched by an AnimationEventDispatcher tells it when its timeline changes, and must stay at the same address
+ * until it is unwatched or destroyed.
+ */
+class AnimationPlayer
+{
+public:
+    // Constructor
+    explicit AnimationPlayer(Human* human);
+
+    // Destructor
+    ~AnimationPlayer();
+
+    // Getters
+    [[nodiscard]] const std::shared_ptr<const AnimationSource>& getClip() const;
+    [[nodiscard]] Human* getHuman() const;
+    [[nodiscard]] float getTime() const;
+    [[nodiscard]] float getCycleTime() const;
+    [[nodiscard]] float getSpeed() const;
+    [[nodiscard]] PlaybackMode getPlaybackMode() const;
+    [[nodiscard]] const Pose& getPose() const;
+    [[nodiscard]] std::span<AnimationLayer> getLayers();
+    [[nodiscard]] bool isPlaying() const;
+    [[nodiscard]] bool isCrossFading() const;
+    [[nodiscard]] AnimationLodLevel getLod() const;
+    [[nodiscard]] bool hasNewPose() const;
+    [[nodiscard]] const IkTarget& getIkTarget(HumanLimb limb) const;
+
+    // Setters
+    AnimationPlayer& setTime(double time);
+    AnimationPlayer& setSpeed(float speed);
+    AnimationPlayer& setPlaybackMode(PlaybackMode playbackMode);
+    AnimationPlayer& setLod(AnimationLodLevel lod);
+    AnimationPlayer& setLodPhase(unsigned int phase);
+    AnimationPlayer& setIkTarget(HumanLimb limb, const IkTarget& target);
+
+    // Methods
+    void play(std::shared_ptr<const AnimationSource> clip, float startTime = 0.0f);
+    void crossFade(std::shared_ptr<const AnimationSource> clip, float duration, float startTime = 0.0f);
+    void stop();
+    void seek(double time);
+    AnimationLayer& addLayer(std::shared_ptr<const AnimationSource> clip,
+                             LayerBlendMode blendMode = OVERRIDE_BLEND,
+                             float weight = 1.0f,
+                             std::shared_ptr<const JointMask> mask = nullptr);
+    void clearLayers();
+    void clearIkTargets();
+    void update(float deltaTime);
+
+private:
+    /**
+    * The animated human.
+    */
+    Human* _human;
+
+    /**
+    * The playback speed factor of every layer, negative to play backward.
+    */
+    float _speed;
+
+    /**
+    * The base layer, playing the current clip.
+    */
+    AnimationLayer _base;
+
+    /**
+    * The previous base layer, fading out during a crossfade.
+    */
+    AnimationLayer _fadingOut;
+
+    /**
+    * The duration of the current crossfade in seconds.
+    */
+    float _fadeDuration;
+
+    /**
+    * The time in seconds elapsed since the start of the current crossfade.
+    */
+    float _fadeElapsed;
+
+    /**
+    * The extra layers, applied over the base layer in order.
+    */
+    std::vector<AnimationLayer> _layers;
+
+    /**
+    * The level of detail of the character, set for each frame by the owner of the player.
+    */
+    AnimationLodLevel _lod;
+
+    /**
+    * The offset of the updates evaluating a throttled player, spreading throttled players over consecutive updates.
+    */
+    unsigned int _lodPhase;
+
+    /**
+    * The number of updates since the player was created.
+    */
+    unsigned int _updateCount;
+
+    /**
+    * The time in seconds accumulated by the updates that did not evaluate the pose.
+    */
+    float _pendingTime;
+
+    /**
+    * Whether the last update applied a pose to the human.
+    */
+    bool _newPose;
+
+    /**
+    * The target of each limb, indexed by HumanLimb (a weight of 0 leaves the limb animated).
+    */
+    std::array<IkTarget, HUMAN_LIMB_COUNT> _ikTargets;
+
+    /**
+    * The limbs solved by the current evaluation.
+    */
+    TwoBoneIkBatch _ikBatch;
+
+    /**
+    * The dispatcher reporting the events of the base clip (nullptr if the player is not watched).
+    */
+    AnimationEventDispatcher* _eventDispatcher;
+
+    /**
+    * The index of the player in its dispatcher.
+    */
+    std::uint32_t _eventSlot;
+
+    /**
+    * Whether the dispatcher was told that the timeline changed since it last scheduled the next event.
+    */
+    bool _eventsOutdated;
+
+    /**
+    * The position in the playback cycle of the base layer at the last change of the timeline.
+    */
+    float _eventsPosition;
+
+    /**
+    * The time in seconds the player was updated by since the last change of the timeline.
+    */
+    float _eventsElapsed;
+
+    friend class AnimationEventDispatcher;
+
+    // Private methods
+    void _evaluate(float step);
+    void _invalidateEvents();
+    void _solveIk(Pose& pose);
+    void _skip(float step);
+};
+
+#endif // ANIMATION_PLAYER_HPP
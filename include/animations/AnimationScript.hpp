@@ -0,0 +1,150 @@
+#ifndef ANIMATION_SCRIPT_HPP
+#define ANIMATION_SCRIPT_HPP
+
+#include <BodyPart.hpp>
+#include <coroutine>
+#include <EasingCurve.hpp>
+#include <exception>
+
+class ScriptScheduler;
+
+/**
+ * A value of a body part a script can tween.
+ */
+enum TweenProperty
+{
+    X_ROTATION_PROPERTY,
+    Y_ROTATION_PROPERTY,
+    Z_ROTATION_PROPERTY,
+    X_TRANSLATION_PROPERTY,
+    Y_TRANSLATION_PROPERTY,
+    Z_TRANSLATION_PROPERTY
+};
+
+/**
+ * A timed sequence written as a C++20 coroutine, run by a ScriptScheduler on the simulation clock:
+ * <pre>
+ * AnimationScript wave(BodyPart& arm)
+ * {
+ *     co_await AnimationScript::tween(arm, Z_ROTATION_PROPERTY, M_PI / 2, 0.5f);
+ *     co_await AnimationScript::seconds(1.0f);
+ *     co_await AnimationScript::tween(arm, Z_ROTATION_PROPERTY, 0.0f, 0.5f);
+ * }
+ * </pre>
+ * A script does not run before it is started by a scheduler, which then owns it until it returns. Times add up from
+ * the time the script reached rather than from the update resuming it, so a sequence keeps its rhythm whatever the
+ * step of the clock. A script may only co_await seconds() and tween().
+ */
+class AnimationScript
+{
+public:
+    /**
+    * The state of a script shared with its scheduler.
+    */
+    struct promise_type
+    {
+        /**
+        * The scheduler running the script, set when it starts it.
+        */
+        ScriptScheduler* scheduler = nullptr;
+
+        /**
+        * The simulated time in seconds the script reached, the end of its last wait.
+        */
+        double time = 0.0;
+
+        /**
+        * The exception the script ended on, rethrown by the scheduler.
+        */
+        std::exception_ptr exception;
+
+        AnimationScript get_return_object();
+        std::suspend_always initial_suspend() noexcept;
+        std::suspend_always final_suspend() noexcept;
+        void return_void();
+        void unhandled_exception();
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /**
+    * Waits a duration, see seconds().
+    */
+    struct Delay
+    {
+        /**
+        * The duration in seconds.
+        */
+        float duration;
+
+        [[nodiscard]] bool await_ready() const noexcept;
+        void await_suspend(Handle handle) const;
+        void await_resume() const noexcept;
+    };
+
+    /**
+    * Moves a value of a body part to a target along an easing curve, see tween().
+    */
+    struct Tween
+    {
+        /**
+        * The animated body part.
+        */
+        BodyPart* part;
+
+        /**
+        * The animated value.
+        */
+        TweenProperty property;
+
+        /**
+        * The value reached at the end of the tween.
+        */
+        float target;
+
+        /**
+        * The duration in seconds.
+        */
+        float duration;
+
+        /**
+        * The easing of the progress of the tween.
+        */
+        const EasingCurve* curve;
+
+        [[nodiscard]] bool await_ready() const noexcept;
+        bool await_suspend(Handle handle) const;
+        void await_resume() const noexcept;
+    };
+
+    // Constructors
+    explicit AnimationScript(Handle handle);
+    AnimationScript(const AnimationScript& other) = delete;
+    AnimationScript(AnimationScript&& other) noexcept;
+
+    // Destructor
+    ~AnimationScript();
+
+    // Operator overloads
+    AnimationScript& operator=(const AnimationScript& other) = delete;
+    AnimationScript& operator=(AnimationScript&& other) noexcept;
+
+    // Methods
+    Handle release();
+    static Delay seconds(float duration);
+    static Tween tween(BodyPart& part,
+                       TweenProperty property,
+                       float target,
+                       float duration,
+                       const EasingCurve& curve = EasingCurve::get(LINEAR_EASING));
+    static float getProperty(const BodyPart& part, TweenProperty property);
+    static void setProperty(BodyPart& part, TweenProperty property, float value);
+
+private:
+    /**
+    * The coroutine, until a scheduler takes it.
+    */
+    Handle _handle;
+};
+
+#endif //ANIMATION_SCRIPT_HPP
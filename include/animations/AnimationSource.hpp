@@ -0,0 +1,68 @@
+#ifndef ANIMATION_SOURCE_HPP
+#define ANIMATION_SOURCE_HPP
+
+#include <cstdint>
+#include <Pose.hpp>
+#include <span>
+#include <vector>
+
+/**
+ * The playback position of one player in the data of an animation.<br>
+ * It remembers the key found by the last sample of each track, so monotonic playback finds the next key in constant
+ * time instead of searching the whole track. Sources that do not need it leave it untouched.
+ */
+struct ClipCursor
+{
+    /**
+    * For each track (rotations, then translations, then scales), the index of the first key after the last sampled
+    * time.
+    */
+    std::vector<std::uint32_t> nextKeys;
+};
+
+/**
+ * A moment of an animation the game wants to hear about, such as a foot touching the ground.
+ */
+struct AnimationEvent
+{
+    /**
+    * The time of the event in seconds, between 0 and the duration of the animation.
+    */
+    float time;
+
+    /**
+    * What happens, the meaning of the values being up to the game (see AnimationEventId for the built-in animations).
+    */
+    std::uint32_t id;
+};
+
+/**
+ * Anything an AnimationPlayer can play: an immutable, looping animation that fills a Pose at a given time.<br>
+ * Sources are shared between players, so sampling must not modify them. Their events are set before they are shared,
+ * and reported by an AnimationEventDispatcher as the players reach them.
+ */
+class AnimationSource
+{
+public:
+    // Destructor
+    virtual ~AnimationSource() = default;
+
+    // Getters
+    [[nodiscard]] virtual float getDuration() const = 0;
+    [[nodiscard]] std::span<const AnimationEvent> getEvents() const;
+
+    // Setters
+    AnimationSource& setEvents(std::vector<AnimationEvent> events);
+
+    // Methods
+    AnimationSource& addEvent(const AnimationEvent& event);
+    virtual void sample(float time, Pose& pose, ClipCursor* cursor) const = 0;
+
+private:
+    /**
+    * The events, sorted by time.
+    */
+    std::vector<AnimationEvent> _events;
+};
+
+#endif //ANIMATION_SOURCE_HPP
@@ -0,0 +1,148 @@
+#ifndef ANIMATION_STATE_MACHINE_HPP
+#define ANIMATION_STATE_MACHINE_HPP
+
+#include <AnimationSource.hpp>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * How a parameter is compared to the value of a TransitionCondition.
+ */
+enum TransitionComparison
+{
+    GREATER_COMPARISON,     // parameter > value
+    LESS_COMPARISON,        // parameter < value
+    EQUAL_COMPARISON,       // parameter == value
+    NOT_EQUAL_COMPARISON    // parameter != value
+};
+
+/**
+ * A condition on a parameter of an AnimationController.
+ */
+struct TransitionCondition
+{
+    std::size_t parameter;
+    TransitionComparison comparison;
+    float value;
+};
+
+/**
+ * A transition from a state to another.<br>
+ * It fires when its event is triggered (if it has one), all its conditions hold and the current state has played up
+ * to its exit time (if it has one).
+ */
+struct AnimationTransition
+{
+    /**
+    * The state entered by the transition.
+    */
+    std::size_t to = 0;
+
+    /**
+    * The event firing the transition (NO_EVENT for a transition firing on its conditions and exit time alone).
+    */
+    std::size_t event = std::numeric_limits<std::size_t>::max();
+
+    /**
+    * The conditions that must all hold for the transition to fire.
+    */
+    std::vector<TransitionCondition> conditions;
+
+    /**
+    * The earliest time the transition may fire, in durations of the clip of the state it leaves (negative for none).
+    */
+    float exitTime = -1.0f;
+
+    /**
+    * The duration of the crossfade to the entered state in seconds.
+    */
+    float blendDuration = 0.0f;
+};
+
+/**
+ * A state: a clip played in a loop until a transition leaves it.
+ */
+struct AnimationState
+{
+    std::string name;
+    std::shared_ptr<const AnimationSource> clip;
+    std::vector<AnimationTransition> transitions;
+};
+
+/**
+ * The states, events, parameters and transitions of an animation graph.<br>
+ * A state machine is immutable once built and shared by every AnimationController playing it, which owns the
+ * per-character state. Transitions from ANY_STATE may leave every state but the one they enter.
+ */
+class AnimationStateMachine
+{
+public:
+    /**
+    * The source of the transitions leaving every state.
+    */
+    static constexpr std::size_t ANY_STATE = std::numeric_limits<std::size_t>::max();
+
+    /**
+    * The event of the transitions that are not fired by an event.
+    */
+    static constexpr std::size_t NO_EVENT = std::numeric_limits<std::size_t>::max();
+
+    /**
+    * The index returned by the lookups of unknown names.
+    */
+    static constexpr std::size_t NOT_FOUND = std::numeric_limits<std::size_t>::max();
+
+    // Constructors
+    AnimationStateMachine() = default;
+
+    // Getters
+    [[nodiscard]] std::size_t getStateCount() const;
+    [[nodiscard]] const AnimationState& getState(std::size_t state) const;
+    [[nodiscard]] std::span<const AnimationTransition> getAnyStateTransitions() const;
+    [[nodiscard]] std::size_t getEventCount() const;
+    [[nodiscard]] const std::string& getEventName(std::size_t event) const;
+    [[nodiscard]] std::size_t getParameterCount() const;
+    [[nodiscard]] float getParameterDefault(std::size_t parameter) const;
+
+    // Methods
+    std::size_t addState(std::string name, std::shared_ptr<const AnimationSource> clip);
+    std::size_t addEvent(std::string name);
+    std::size_t addParameter(std::string name, float defaultValue = 0.0f);
+    AnimationStateMachine& addTransition(std::size_t from, AnimationTransition transition);
+    [[nodiscard]] std::size_t findState(std::string_view name) const;
+    [[nodiscard]] std::size_t findEvent(std::string_view name) const;
+    [[nodiscard]] std::size_t findParameter(std::string_view name) const;
+
+private:
+    /**
+    * The states, each with the transitions leaving it.
+    */
+    std::vector<AnimationState> _states;
+
+    /**
+    * The transitions leaving every state.
+    */
+    std::vector<AnimationTransition> _anyStateTransitions;
+
+    /**
+    * The names of the events, indexed by event.
+    */
+    std::vector<std::string> _events;
+
+    /**
+    * The names of the parameters, indexed by parameter.
+    */
+    std::vector<std::string> _parameterNames;
+
+    /**
+    * The initial value of each parameter.
+    */
+    std::vector<float> _parameterDefaults;
+};
+
+#endif //ANIMATION_STATE_MACHINE_HPP
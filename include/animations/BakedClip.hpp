@@ -0,0 +1,109 @@
+#ifndef BAKED_CLIP_HPP
+#define BAKED_CLIP_HPP
+
+#include <AnimationSource.hpp>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * An animation sampled at a fixed rate into a contiguous pose table.<br>
+ * Each frame stores the rotation (w, x, y, z), translation (x, y, z) and scale (x, y, z) of every joint, so playing it
+ * is an indexed fetch and an interpolation between two frames, whatever the cost of the baked source.<br>
+ * The pose table is either owned by the clip or a view over memory owned by someone else, such as an AnimationLibrary.
+ */
+class BakedClip : public AnimationSource
+{
+public:
+    /**
+    * The number of floats stored per joint and per frame: rotation, translation and scale.
+    */
+    static constexpr std::size_t FLOATS_PER_JOINT = 10;
+
+    // Constructors
+    BakedClip(const BakedClip&) = delete;
+    BakedClip(BakedClip&&) noexcept = default;
+
+    // Destructor
+    ~BakedClip() override = default;
+
+    // Getters
+    [[nodiscard]] float getDuration() const override;
+    [[nodiscard]] float getFrameRate() const;
+    [[nodiscard]] std::size_t getFrameCount() const;
+    [[nodiscard]] std::size_t getJointCount() const;
+    [[nodiscard]] unsigned char getChannels(std::size_t joint) const;
+    [[nodiscard]] std::span<const float> getFrame(std::size_t frame) const;
+    [[nodiscard]] std::size_t getByteSize() const;
+
+    // Methods
+    void sample(float time, Pose& pose, ClipCursor* cursor = nullptr) const override;
+    void save(const std::string& path) const;
+
+    static BakedClip bake(const AnimationSource& source, std::size_t jointCount, float frameRate);
+    static BakedClip load(const std::string& path);
+    static BakedClip view(float duration,
+                          float frameRate,
+                          std::size_t frameCount,
+                          std::span<const unsigned char> channels,
+                          std::span<const float> samples,
+                          std::shared_ptr<const void> owner);
+
+    // Operator overloads
+    BakedClip& operator=(const BakedClip&) = delete;
+    BakedClip& operator=(BakedClip&&) noexcept = default;
+
+private:
+    // Constructors
+    BakedClip() = default;
+
+    /**
+    * The duration of the clip in seconds.
+    */
+    float _duration = 0.0f;
+
+    /**
+    * The number of frames per second, adjusted so the frames span the duration evenly.
+    */
+    float _frameRate = 0.0f;
+
+    /**
+    * The number of frames, the first at time 0 and the last at the duration.
+    */
+    std::size_t _frameCount = 0;
+
+    /**
+    * The number of joints of each frame.
+    */
+    std::size_t _jointCount = 0;
+
+    /**
+    * The PoseChannel flags set by the source on each joint.
+    */
+    std::span<const unsigned char> _channels;
+
+    /**
+    * The transformations, frame by frame then joint by joint.
+    */
+    std::span<const float> _samples;
+
+    /**
+    * The storage of _channels when the clip owns its pose table (empty for a view).<br>
+    * Moving a vector keeps its buffer, so the spans stay valid when the clip is moved.
+    */
+    std::vector<unsigned char> _channelStorage;
+
+    /**
+    * The storage of _samples when the clip owns its pose table (empty for a view).
+    */
+    std::vector<float> _sampleStorage;
+
+    /**
+    * Keeps the memory viewed by _channels and _samples alive (nullptr when the clip owns its pose table).
+    */
+    std::shared_ptr<const void> _owner;
+};
+
+#endif //BAKED_CLIP_HPP
@@ -0,0 +1,113 @@
+#ifndef COMPRESSED_CLIP_HPP
+#define COMPRESSED_CLIP_HPP
+
+#include <AnimationSource.hpp>
+#include <array>
+#include <BakedClip.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Measures how far an approximated pose is from a reference pose, e.g. Human::measurePoseError().
+ */
+using PoseErrorMetric = std::function<float(const Pose& reference, const Pose& approximation)>;
+
+/**
+ * A baked clip compressed for memory.<br>
+ * Rotations are quantized with the smallest three method (48 bits), translations and scales are quantized to 16 bits
+ * per component over the range of their track, and every key that linear interpolation can rebuild is dropped. The
+ * tolerance of the key reduction is tightened until the error measured over the whole skeleton is under a bound.
+ */
+class CompressedClip : public AnimationSource
+{
+public:
+    // Getters
+    [[nodiscard]] float getDuration() const override;
+    [[nodiscard]] std::size_t getTrackCount() const;
+    [[nodiscard]] std::size_t getKeyCount() const;
+    [[nodiscard]] std::size_t getByteSize() const;
+    [[nodiscard]] float getMaxError() const;
+
+    // Methods
+    void sample(float time, Pose& pose, ClipCursor* cursor = nullptr) const override;
+
+    static CompressedClip compress(const BakedClip& source, float maxError, const PoseErrorMetric& metric);
+
+private:
+    /**
+     * The keys animating one channel of one joint.
+     */
+    struct Track
+    {
+        /**
+        * The index of the animated joint in the pose.
+        */
+        std::uint16_t joint;
+
+        /**
+        * The PoseChannel animated by the track.
+        */
+        unsigned char channel;
+
+        /**
+        * The index of the first key of the track in the key arrays.
+        */
+        std::uint32_t firstKey;
+
+        /**
+        * The number of keys of the track, at least 1.
+        */
+        std::uint32_t keyCount;
+
+        /**
+        * The smallest value of each component (translation and scale tracks only).
+        */
+        std::array<float, 3> rangeMin;
+
+        /**
+        * The difference between the largest and the smallest value of each component (translation and scale only).
+        */
+        std::array<float, 3> rangeExtent;
+    };
+
+    // Constructors
+    CompressedClip() = default;
+
+    /**
+    * The duration of the clip in seconds.
+    */
+    float _duration = 0.0f;
+
+    /**
+    * The number of frames per second of the baked source, in which key times are expressed.
+    */
+    float _frameRate = 0.0f;
+
+    /**
+    * The largest error measured by the metric over every frame of the source.
+    */
+    float _maxError = 0.0f;
+
+    /**
+    * The tracks, each owning a range of keys.
+    */
+    std::vector<Track> _tracks;
+
+    /**
+    * The frame of each key in the baked source.
+    */
+    std::vector<std::uint16_t> _keyFrames;
+
+    /**
+    * The quantized value of each key.
+    */
+    std::vector<std::array<std::uint16_t, 3>> _keyValues;
+
+    // Private methods
+    void _addTracks(const BakedClip& source, float tolerance);
+    [[nodiscard]] float _measureError(const BakedClip& source, const PoseErrorMetric& metric) const;
+};
+
+#endif //COMPRESSED_CLIP_HPP
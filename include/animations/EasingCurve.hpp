@@ -0,0 +1,76 @@
+#ifndef EASING_CURVE_HPP
+#define EASING_CURVE_HPP
+
+#include <AnimationDefines.hpp>
+#include <array>
+#include <cstddef>
+#include <span>
+
+/**
+ * The named easing functions, mapping the progress of a transition from 0 to 1 onto the eased progress.
+ */
+enum EasingFunction
+{
+    LINEAR_EASING,
+    SMOOTHSTEP_EASING,
+    QUADRATIC_IN_EASING,
+    QUADRATIC_OUT_EASING,
+    QUADRATIC_IN_OUT_EASING,
+    CUBIC_IN_EASING,
+    CUBIC_OUT_EASING,
+    CUBIC_IN_OUT_EASING,
+    SINE_IN_EASING,
+    SINE_OUT_EASING,
+    SINE_IN_OUT_EASING,
+    BACK_OUT_EASING,
+    ELASTIC_OUT_EASING,
+    BOUNCE_OUT_EASING,
+    EASING_FUNCTION_COUNT
+};
+
+/**
+ * An easing curve compiled to a lookup table of EASING_CURVE_SEGMENTS uniform segments.<br>
+ * Named functions, cubic Bézier curves (as in CSS) and Hermite tangents are all evaluated once when the curve is built,
+ * so evaluating any curve costs a clamp, a lookup and a lerp, without any transcendental function or root solving. The
+ * table fits in a few cache lines, and evaluate() eases a batch of channels four at a time with SSE2.
+ */
+class EasingCurve
+{
+public:
+    /**
+    * The number of samples of the table, both ends included.
+    */
+    static constexpr std::size_t SAMPLE_COUNT = EASING_CURVE_SEGMENTS + 1;
+
+    // Constructors
+    explicit EasingCurve(EasingFunction function = LINEAR_EASING);
+
+    // Getters
+    [[nodiscard]] std::span<const float> getSamples() const;
+    [[nodiscard]] float getMaxError() const;
+
+    // Methods
+    [[nodiscard]] float evaluate(float progress) const;
+    void evaluate(std::span<const float> progresses, std::span<float> results) const;
+    static const EasingCurve& get(EasingFunction function);
+    static EasingCurve fromBezier(float x1, float y1, float x2, float y2);
+    static EasingCurve fromHermite(float startTangent, float endTangent);
+    static float evaluateFunction(EasingFunction function, float progress);
+
+private:
+    /**
+    * The eased progress at each end of the segments.
+    */
+    std::array<float, SAMPLE_COUNT> _samples;
+
+    /**
+    * The largest difference between the table and the exact curve, measured in the middle of each segment.
+    */
+    float _maxError;
+
+    // Private methods
+    template<typename Function>
+    void _compile(const Function& function);
+};
+
+#endif //EASING_CURVE_HPP
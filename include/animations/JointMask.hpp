@@ -0,0 +1,33 @@
+#ifndef JOINT_MASK_HPP
+#define JOINT_MASK_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+/**
+ * Per-joint weights restricting a layer to a part of the skeleton (e.g. only the upper body).<br>
+ * A weight of 0 leaves the joint untouched, 1 applies the layer fully.
+ */
+class JointMask
+{
+public:
+    // Constructors
+    explicit JointMask(std::size_t jointCount, float weight = 1.0f);
+    JointMask(std::size_t jointCount, std::initializer_list<std::size_t> joints);
+
+    // Getters
+    [[nodiscard]] std::size_t getJointCount() const;
+    [[nodiscard]] float getWeight(std::size_t joint) const;
+
+    // Setters
+    JointMask& setWeight(std::size_t joint, float weight);
+
+private:
+    /**
+    * The weights, indexed by joint.
+    */
+    std::vector<float> _weights;
+};
+
+#endif //JOINT_MASK_HPP
@@ -0,0 +1,130 @@
+#ifndef MOTION_DATABASE_HPP
+#define MOTION_DATABASE_HPP
+
+#include <AnimationDefines.hpp>
+#include <AnimationSource.hpp>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/**
+ * A frame of a MotionDatabase: a time in one of its clips.
+ */
+struct MotionFrame
+{
+    std::size_t clip;
+    float time;
+};
+
+/**
+ * The best frame found by a search, with its cost (the squared distance of its normalized features to the query).
+ */
+struct MotionMatch
+{
+    std::size_t frame;
+    float cost;
+};
+
+/**
+ * The frames of a set of clips played by motion matching, each described by a feature vector over the Human skeleton:
+ * <br>
+ * - the position of each hand and foot in the model space of the torso, in HumanLimb order<br>
+ * - the velocity of each hand and foot, per second<br>
+ * - the trajectory: the translation of the torso MOTION_MATCHING_NEAR_TIME and MOTION_MATCHING_FAR_TIME ahead, minus
+ * its current translation<br>
+ * Each group of features is normalized by its standard deviation over the database and by its weight, so a search
+ * cost is a plain squared distance. The normalized features are indexed in blocks of four frames, feature by feature,
+ * so that a search compares a query to four frames at once with SSE and reads the index once, in order.
+ */
+class MotionDatabase
+{
+public:
+    /**
+    * The number of features of a frame.
+    */
+    static constexpr std::size_t FEATURE_COUNT = 30;
+
+    /**
+    * The first feature of the hand and foot positions.
+    */
+    static constexpr std::size_t POSITION_FEATURES = 0;
+
+    /**
+    * The first feature of the hand and foot velocities.
+    */
+    static constexpr std::size_t VELOCITY_FEATURES = 12;
+
+    /**
+    * The first feature of the trajectory, the near point then the far point.
+    */
+    static constexpr std::size_t TRAJECTORY_FEATURES = 24;
+
+    /**
+    * The frame of a search in an empty database.
+    */
+    static constexpr std::size_t NO_FRAME = std::numeric_limits<std::size_t>::max();
+
+    using Features = std::array<float, FEATURE_COUNT>;
+
+    // Constructors
+    explicit MotionDatabase(float sampleRate = MOTION_MATCHING_SAMPLE_RATE);
+
+    // Getters
+    [[nodiscard]] float getSampleRate() const;
+    [[nodiscard]] std::size_t getClipCount() const;
+    [[nodiscard]] const std::shared_ptr<const AnimationSource>& getClip(std::size_t clip) const;
+    [[nodiscard]] std::size_t getFrameCount() const;
+    [[nodiscard]] MotionFrame getFrame(std::size_t frame) const;
+    [[nodiscard]] const Features& getFeatures(std::size_t frame) const;
+
+    // Methods
+    std::size_t addClip(std::shared_ptr<const AnimationSource> clip);
+    void build();
+    [[nodiscard]] std::size_t findFrame(std::size_t clip, float time) const;
+    [[nodiscard]] Features normalize(const Features& features) const;
+    [[nodiscard]] float getCost(std::size_t frame, const Features& query) const;
+    [[nodiscard]] MotionMatch search(const Features& query) const;
+
+private:
+    /**
+    * The number of frames sampled per second of clip.
+    */
+    float _sampleRate;
+
+    /**
+    * The clips of the database, shared with the players.
+    */
+    std::vector<std::shared_ptr<const AnimationSource>> _clips;
+
+    /**
+    * The first frame of each clip, followed by the number of frames.
+    */
+    std::vector<std::size_t> _clipFrames;
+
+    /**
+    * The features of each frame, before normalization.
+    */
+    std::vector<Features> _features;
+
+    /**
+    * The mean of each feature, subtracted by the normalization.
+    */
+    Features _means;
+
+    /**
+    * The factor of each feature applied by the normalization: the weight of its group over its deviation.
+    */
+    Features _scales;
+
+    /**
+    * The normalized features, in blocks of 4 frames holding FEATURE_COUNT groups of 4 lanes.
+    */
+    std::vector<float> _index;
+
+    // Private methods
+    [[nodiscard]] Features _extractFeatures(const AnimationSource& clip, float time) const;
+};
+
+#endif //MOTION_DATABASE_HPP
@@ -0,0 +1,78 @@
+#ifndef MOTION_MATCHER_HPP
+#define MOTION_MATCHER_HPP
+
+#include <AnimationPlayer.hpp>
+#include <cstddef>
+#include <memory>
+#include <MotionDatabase.hpp>
+#include <Vector4.hpp>
+
+/**
+ * Drives an AnimationPlayer by motion matching over a shared MotionDatabase.<br>
+ * Every MOTION_MATCHING_SEARCH_INTERVAL updates, the features of the frame being played are searched with the desired
+ * trajectory in place of the one of the clip, and the player crossfades to the best frame when it is clearly better
+ * than carrying on. The phase of the searches spreads the characters over the updates, so a crowd does not search all
+ * at once.
+ */
+class MotionMatcher
+{
+public:
+    // Constructors
+    MotionMatcher(std::shared_ptr<const MotionDatabase> database, AnimationPlayer* player, std::size_t startFrame = 0);
+
+    // Getters
+    [[nodiscard]] const std::shared_ptr<const MotionDatabase>& getDatabase() const;
+    [[nodiscard]] AnimationPlayer* getPlayer() const;
+    [[nodiscard]] std::size_t getClip() const;
+    [[nodiscard]] const Vector4& getNearTrajectory() const;
+    [[nodiscard]] const Vector4& getFarTrajectory() const;
+    [[nodiscard]] std::size_t getSearchCount() const;
+
+    // Setters
+    MotionMatcher& setTrajectory(const Vector4& near, const Vector4& far);
+    MotionMatcher& setSearchPhase(unsigned int phase);
+
+    // Methods
+    void update();
+
+private:
+    /**
+    * The frames matched by the matcher, shared with the other matchers.
+    */
+    std::shared_ptr<const MotionDatabase> _database;
+
+    /**
+    * The player of the character.
+    */
+    AnimationPlayer* _player;
+
+    /**
+    * The clip of the database being played.
+    */
+    std::size_t _clip;
+
+    /**
+    * The desired translation of the torso MOTION_MATCHING_NEAR_TIME ahead, from its current one.
+    */
+    Vector4 _nearTrajectory;
+
+    /**
+    * The desired translation of the torso MOTION_MATCHING_FAR_TIME ahead, from its current one.
+    */
+    Vector4 _farTrajectory;
+
+    /**
+    * The number of updates since the last search, shifted by the search phase.
+    */
+    unsigned int _updates;
+
+    /**
+    * The number of searches run so far.
+    */
+    std::size_t _searchCount;
+
+    // Private methods
+    void _search();
+};
+
+#endif //MOTION_MATCHER_HPP
@@ -0,0 +1,78 @@
+#ifndef POSE_HPP
+#define POSE_HPP
+
+#include <cstddef>
+#include <JointMask.hpp>
+#include <Quaternion.hpp>
+#include <span>
+#include <Vector4.hpp>
+#include <vector>
+
+/**
+ * The channels of a joint that a pose sets, as bit flags.
+ */
+enum PoseChannel : unsigned char
+{
+    NO_CHANNEL = 0,
+    ROTATION_CHANNEL = 1,
+    TRANSLATION_CHANNEL = 2,
+    SCALE_CHANNEL = 4
+};
+
+/**
+ * The local transformation of one joint.
+ */
+struct JointPose
+{
+    /**
+    * The rotation of the joint.
+    */
+    Quaternion rotation;
+
+    /**
+    * The translation of the joint (w unused).
+    */
+    Vector4 translation = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+
+    /**
+    * The scale of the joint (w unused).
+    */
+    Vector4 scale = Vector4(1.0f, 1.0f, 1.0f, 0.0f);
+
+    /**
+    * The PoseChannel flags of the values set by the pose, the others must be left untouched when applied.
+    */
+    unsigned char channels = NO_CHANNEL;
+};
+
+/**
+ * The local transformations of every joint of a skeleton, filled by sampling clips.
+ */
+class Pose
+{
+public:
+    // Constructors
+    explicit Pose(std::size_t jointCount);
+
+    // Getters
+    [[nodiscard]] std::size_t getJointCount() const;
+    [[nodiscard]] std::span<JointPose> getJoints();
+    [[nodiscard]] std::span<const JointPose> getJoints() const;
+
+    // Operator overloads
+    JointPose& operator[](std::size_t joint);
+    const JointPose& operator[](std::size_t joint) const;
+
+    // Methods
+    void reset();
+    void blend(const Pose& other, float weight, const JointMask* mask = nullptr);
+    void add(const Pose& additive, float weight, const JointMask* mask = nullptr);
+
+private:
+    /**
+    * The transformations, indexed by joint.
+    */
+    std::vector<JointPose> _joints;
+};
+
+#endif //POSE_HPP
@@ -0,0 +1,133 @@
+#ifndef SCRIPT_SCHEDULER_HPP
+#define SCRIPT_SCHEDULER_HPP
+
+#include <AnimationScript.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Runs AnimationScripts on the simulation clock.<br>
+ * A waiting script sits in a timer queue (a binary heap ordered by wake time) and costs nothing until its time comes:
+ * an update only pops the scripts due, so thousands of idle scripts cost a comparison. Tweens in progress are the only
+ * work done on every update, one setter per tween. A script is resumed at most once per update, and the scripts due
+ * on the same update are resumed in the order of their wake times, so a run only depends on the steps of the clock.
+ */
+class ScriptScheduler
+{
+public:
+    // Constructors
+    ScriptScheduler();
+    ScriptScheduler(const ScriptScheduler& other) = delete;
+
+    // Destructor
+    ~ScriptScheduler();
+
+    // Operator overloads
+    ScriptScheduler& operator=(const ScriptScheduler& other) = delete;
+
+    // Getters
+    [[nodiscard]] double getTime() const;
+    [[nodiscard]] std::size_t getScriptCount() const;
+    [[nodiscard]] std::size_t getWaitingCount() const;
+    [[nodiscard]] std::size_t getTweenCount() const;
+
+    // Methods
+    void reserve(std::size_t scriptCount);
+    void start(AnimationScript script);
+    void update(float deltaTime);
+    void clear();
+
+private:
+    /**
+    * A script suspended until a time.
+    */
+    struct ScriptTimer
+    {
+        /**
+        * The simulated time in seconds the script resumes at.
+        */
+        double time;
+
+        /**
+        * The order the script started waiting in, breaking ties between equal times.
+        */
+        std::uint64_t sequence;
+
+        /**
+        * The script.
+        */
+        AnimationScript::Handle handle;
+    };
+
+    /**
+    * A tween in progress, resuming its script once finished.
+    */
+    struct ActiveTween
+    {
+        /**
+        * The body part, property, target, duration and curve of the tween.
+        */
+        AnimationScript::Tween tween;
+
+        /**
+        * The value of the property when the tween started.
+        */
+        float from;
+
+        /**
+        * The simulated time in seconds the tween started at.
+        */
+        double start;
+
+        /**
+        * The order the script started waiting in, breaking ties between equal times.
+        */
+        std::uint64_t sequence;
+
+        /**
+        * The script.
+        */
+        AnimationScript::Handle handle;
+    };
+
+    /**
+    * The simulated time in seconds.
+    */
+    double _time;
+
+    /**
+    * The number of waits started so far.
+    */
+    std::uint64_t _sequence;
+
+    /**
+    * The number of scripts started and not returned yet.
+    */
+    std::size_t _scriptCount;
+
+    /**
+    * The scripts waiting for a time, as a min-heap on the time then the sequence.
+    */
+    std::vector<ScriptTimer> _timers;
+
+    /**
+    * The tweens in progress.
+    */
+    std::vector<ActiveTween> _tweens;
+
+    /**
+    * The scripts resumed by the current update, kept to reuse its capacity.
+    */
+    std::vector<ScriptTimer> _ready;
+
+    // Private methods
+    void _wait(AnimationScript::Handle handle, double time);
+    void _tween(AnimationScript::Handle handle, const AnimationScript::Tween& tween);
+    void _resume(AnimationScript::Handle handle, double time);
+
+    friend struct AnimationScript::Delay;
+    friend struct AnimationScript::Tween;
+};
+
+#endif //SCRIPT_SCHEDULER_HPP
@@ -0,0 +1,136 @@
+#ifndef TWO_BONE_IK_HPP
+#define TWO_BONE_IK_HPP
+
+#include <cstddef>
+#include <Pose.hpp>
+#include <Quaternion.hpp>
+#include <Vector4.hpp>
+#include <vector>
+
+/**
+ * The rest geometry of a chain of two joints (an upper limb and its lower limb) ending on an effector.<br>
+ * Every position is in the space of the parent of the upper joint, every bone in the space of the joint it starts at.
+ */
+struct TwoBoneChain
+{
+    /**
+    * The joint rotating the whole chain.
+    */
+    std::size_t upperJoint;
+
+    /**
+    * The child of the upper joint, bending the chain.
+    */
+    std::size_t lowerJoint;
+
+    /**
+    * The rotation center of the upper joint, before its pose translation.
+    */
+    Vector4 root;
+
+    /**
+    * From the rotation center of the upper joint to the one of the lower joint.
+    */
+    Vector4 upperBone;
+
+    /**
+    * From the rotation center of the lower joint to the effector.
+    */
+    Vector4 lowerBone;
+
+    /**
+    * The direction the lower joint bends toward when the target does not give one.
+    */
+    Vector4 pole;
+
+    /**
+    * The smallest angle between the two bones in radians, π when the chain is straight.
+    */
+    float minAngle;
+
+    /**
+    * The largest angle between the two bones in radians.
+    */
+    float maxAngle;
+};
+
+/**
+ * Where a chain must bring its effector, in the space of the parent of its upper joint.
+ */
+struct IkTarget
+{
+    /**
+    * The position to reach, brought within the reach and the joint limits of the chain.
+    */
+    Vector4 position = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+
+    /**
+    * The direction the lower joint bends toward (a null vector for the pole of the chain).
+    */
+    Vector4 pole = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+
+    /**
+    * How much the solved rotations replace the animated ones, from 0 (disabled) to 1.
+    */
+    float weight = 0.0f;
+};
+
+/**
+ * Solves two-bone chains analytically, stored as a structure of arrays so that four chains are solved at once with
+ * SSE.<br>
+ * A solve replaces the rotations of the upper and lower joints of each chain with the smallest rotations bringing the
+ * effector on its target, the lower joint bending toward the pole: the twist of the animation is kept. Chains are
+ * added from their animated pose, solved together, then written back to the poses before they are applied, so the
+ * batch costs no allocation once its capacity is reached.
+ */
+class TwoBoneIkBatch
+{
+public:
+    // Constructors
+    explicit TwoBoneIkBatch(std::size_t capacity = 0);
+
+    // Getters
+    [[nodiscard]] std::size_t getSize() const;
+    [[nodiscard]] std::size_t getCapacity() const;
+    [[nodiscard]] Quaternion getUpperRotation(std::size_t chain) const;
+    [[nodiscard]] Quaternion getLowerRotation(std::size_t chain) const;
+
+    // Methods
+    void reserve(std::size_t capacity);
+    void clear();
+    std::size_t add(const TwoBoneChain& chain,
+                    const Vector4& root,
+                    const Quaternion& upperRotation,
+                    const Quaternion& lowerRotation,
+                    const IkTarget& target);
+    std::size_t add(const TwoBoneChain& chain, const Pose& pose, const IkTarget& target);
+    void solve();
+    void writeTo(std::size_t chain, const TwoBoneChain& definition, Pose& pose) const;
+
+private:
+    /**
+    * The values of every chain, one array per field.
+    */
+    std::vector<float> _fields;
+
+    /**
+    * The number of chains of the batch.
+    */
+    std::size_t _size;
+
+    /**
+    * The number of chains the fields can hold, a multiple of four.
+    */
+    std::size_t _capacity;
+
+    /**
+    * The distance in floats between the arrays of two fields.
+    */
+    std::size_t _stride;
+
+    // Private methods
+    [[nodiscard]] float* _field(std::size_t field);
+    [[nodiscard]] const float* _field(std::size_t field) const;
+};
+
+#endif //TWO_BONE_IK_HPP
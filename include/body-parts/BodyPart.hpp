@@ -1,21 +1,57 @@
 #ifndef BODY_PART_HPP
 #define BODY_PART_HPP
 
-#include <stack>
+#include <array>
+#include <cstddef>
+#include <Quaternion.hpp>
+#include <span>
 #include <Vector4.hpp>
-#include <vector>
 #include "Matrix4.hpp"
 
+/**
+ * How the cube of a body part is drawn.
+ */
+enum BodyPartRendering
+{
+    VERTEX_RENDERING,       // Its triangles are transformed to the world and written to the BufferManager buffers
+    INSTANCED_RENDERING     // Its world matrix is written to a BodyPartInstance, the cube being shared by every part
+};
+
+/**
+ * The cube of a body part drawn by instancing: the unit cube centered on the origin, transformed to the world.
+ */
+struct BodyPartInstance
+{
+    /**
+    * The first three rows of the matrix from the unit cube to the world, the last one being (0, 0, 0, 1).
+    */
+    float rows[12];
+
+    /**
+    * The red, green and blue of the cube in [0, 1], then 1.
+    */
+    float color[4];
+};
+
 class BodyPart
 {
 public:
     // Constructors
-    BodyPart();
+    explicit BodyPart(BodyPartRendering rendering = VERTEX_RENDERING);
 
     // Getters
-    [[nodiscard]] Matrix4 getMatrixStack() const;
+    [[nodiscard]] static int getVertexCount();
+    [[nodiscard]] const Matrix4& getWorldMatrix() const;
     [[nodiscard]] Matrix4 getTransformationMatrix() const;
     [[nodiscard]] Matrix4 getScaleMatrix() const;
+    [[nodiscard]] std::span<const float> getVertices() const;
+    [[nodiscard]] std::array<int, 3> getDefaultColor() const;
+    [[nodiscard]] float getXRotation() const;
+    [[nodiscard]] float getYRotation() const;
+    [[nodiscard]] float getZRotation() const;
+    [[nodiscard]] float getTranslateX() const;
+    [[nodiscard]] float getTranslateY() const;
+    [[nodiscard]] float getTranslateZ() const;
 
     // Setters
     BodyPart& setColor(float red, float green, float blue);
@@ -26,9 +62,12 @@ public:
     BodyPart& setXRotation(float angle);
     BodyPart& setYRotation(float angle);
     BodyPart& setZRotation(float angle);
+    BodyPart& setRotation(const Quaternion& rotation);
     BodyPart& setTranslateX(float x);
     BodyPart& setTranslateY(float y);
     BodyPart& setTranslateZ(float z);
+    BodyPart& setTranslation(float x, float y, float z);
+    BodyPart& setPoseScale(float x, float y, float z);
     BodyPart& setParentRelativeShift(float x, float y, float z);
     BodyPart& setOwnRelativeShift(float x, float y, float z);
 
@@ -41,6 +80,10 @@ public:
 
     BodyPart& addChild(BodyPart* child);
     void applyTransformation();
+    void applyTransformation(BodyPartInstance& instance);
+    void applyWorldMatrix(const Matrix4& worldMatrix);
+    void applyWorldMatrix(const Matrix4& worldMatrix, BodyPartInstance& instance);
+    static void fillCubeVertices(float* vertices, float halfWidth, float halfHeight, float halfDepth);
 
 private:
     /**
@@ -103,6 +146,11 @@ private:
     */
     float _angleZ = 0;
 
+    /**
+    * Whether the angles must be recomputed from the rotation matrix, set by setRotation().
+    */
+    bool _anglesOutdated = false;
+
     /**
      * The translate x value.
      */
@@ -118,6 +166,21 @@ private:
      */
     float _translateZ = 0;
 
+    /**
+    * The scale applied by the animations on the x-axis, only resizing the cube (children are not affected).
+    */
+    float _poseScaleX = 1;
+
+    /**
+    * The scale applied by the animations on the y-axis, only resizing the cube (children are not affected).
+    */
+    float _poseScaleY = 1;
+
+    /**
+    * The scale applied by the animations on the z-axis, only resizing the cube (children are not affected).
+    */
+    float _poseScaleZ = 1;
+
     /**
     * The red value of the body part's color.
     */
@@ -164,9 +227,15 @@ private:
     Matrix4 _scaleMatrix;
 
     /**
-    * A list of all the children of the body part.
+    * The offset from this body part to its first child.<br>
+    * Children are stored next to each other (see BodyPartPool), so they are described by an index range.
+    */
+    std::ptrdiff_t _firstChildOffset = 0;
+
+    /**
+    * The number of children of the body part.
     */
-    std::vector<BodyPart*> _children;
+    std::size_t _childCount = 0;
 
     /**
     * The parent of the body part.
@@ -179,33 +248,32 @@ private:
     Vector4 _pivotPoint;
 
     /**
-    * The matrix stack of the body part.
-    */
-    std::stack<Matrix4> _matrixStack;
-
-    /**
-    * The buffer's index of triangles vertices of the body part.
+    * The world matrix of the body part, computed by the last call to applyTransformation().
     */
-    unsigned int _trianglesVerticesBufferIndex;
+    Matrix4 _worldMatrix;
 
     /**
-    * The buffer's index of triangles colors of the body part.
+    * The buffer index of a body part drawn by instancing, which has no vertices.
     */
-    unsigned int _trianglesColorsBufferIndex;
+    static constexpr unsigned int NO_BUFFER = -1;
 
     /**
-    * The buffer of triangles vertices of the body part.
+    * The buffer's index of triangles vertices of the body part (NO_BUFFER if it is drawn by instancing).
     */
-    std::vector<float> _trianglesVerticesBuffer;
+    unsigned int _trianglesVerticesBufferIndex;
 
     /**
-    * The buffer of triangles colors of the body part.
+    * The buffer's index of triangles colors of the body part (NO_BUFFER if it is drawn by instancing).
     */
-    std::vector<float> _trianglesColorsBuffer;
+    unsigned int _trianglesColorsBufferIndex;
 
-    // Private getters
-    [[nodiscard]] std::vector<float> _getTrianglesVerticesBuffer() const;
-    [[nodiscard]] std::vector<float> _getTrianglesColorsBuffer() const;
+    // Private methods
+    [[nodiscard]] std::span<BodyPart> _getChildren();
+    void _computeAngles(float& angleX, float& angleY, float& angleZ) const;
+    void _updateAngles();
+    [[nodiscard]] Vector4 _getCubeSize() const;
+    void _fillTrianglesVertices(float* vertices) const;
+    void _fillTrianglesColors(float* colors) const;
 };
 
 #endif //BODY_PART_HPP
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef BODY_PART_POOL_HPP
+#define BODY_PART_POOL_HPP
+
+#include <BodyPart.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Stable identifier of a body part stored in the BodyPartPool.
+ */
+using BodyPartHandle = std::uint32_t;
+
+/**
+ * Contiguous storage for the body parts of every human.<br>
+ * Body parts are allocated by ranges: the parts of a range are adjacent in memory, which lets a node store its
+ * children as an index range and keeps a whole skeleton in a few cache lines.<br>
+ * Memory is taken from the heap by chunks that never move, so handles and pointers stay valid until their range is
+ * released.
+ */
+class BodyPartPool
+{
+public:
+    // Constructors
+    BodyPartPool(const BodyPartPool& other) = delete;
+
+    // Destructor
+    ~BodyPartPool();
+
+    // Getters
+    [[nodiscard]] static BodyPartPool& getInstance();
+    [[nodiscard]] BodyPart& get(BodyPartHandle handle) const;
+    [[nodiscard]] std::size_t getSize() const;
+    [[nodiscard]] std::size_t getCapacity() const;
+
+    // Operator overloads
+    BodyPartPool& operator=(const BodyPartPool& other) = delete;
+
+    // Methods
+    void reserve(std::size_t count);
+    BodyPartHandle allocate(std::size_t count, BodyPartRendering rendering = VERTEX_RENDERING);
+    void release(BodyPartHandle first, std::size_t count);
+    static void deletePool();
+
+private:
+    BodyPartPool() = default;
+
+    /**
+    * A block of body parts allocated at once.
+    */
+    struct Chunk
+    {
+        BodyPartHandle first;
+        std::size_t capacity;
+        std::size_t used;
+        BodyPart* data;
+    };
+
+    /**
+    * A range of released body parts that can be allocated again.
+    */
+    struct FreeRange
+    {
+        BodyPartHandle first;
+        std::size_t count;
+    };
+
+    /**
+    * The unique instance of BodyPartPool.
+    */
+    static BodyPartPool* _instance;
+
+    /**
+    * The chunks, sorted by first handle.
+    */
+    std::vector<Chunk> _chunks;
+
+    /**
+    * The ranges released by release().
+    */
+    std::vector<FreeRange> _freeRanges;
+
+    /**
+    * The number of live body parts.
+    */
+    std::size_t _size = 0;
+
+    // Private methods
+    void _addChunk(std::size_t capacity);
+};
+
+#endif //BODY_PART_POOL_HPP
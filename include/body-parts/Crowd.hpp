@@ -0,0 +1,107 @@
+#ifndef CROWD_HPP
+#define CROWD_HPP
+
+#include <AnimationManager.hpp>
+#include <array>
+#include <BodyPart.hpp>
+#include <CharacterRegistry.hpp>
+#include <CrowdDefines.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <Human.hpp>
+#include <SkeletonDefinition.hpp>
+#include <span>
+#include <vector>
+
+/**
+ * The animation a human of a crowd plays.
+ */
+struct CrowdAnimation
+{
+    /**
+    * The animation.
+    */
+    AnimationType type;
+
+    /**
+    * The time in seconds of the animation the human starts at.
+    */
+    float startTime;
+};
+
+/**
+ * Humans standing on a square grid, each playing one of the built-in animations from its own phase.<br>
+ * The humans are built in turn from the skeleton definitions given, so a crowd mixes characters of different sizes
+ * and colors.<br>
+ * Each human is an entity of a CharacterRegistry, entity i being the human i, whose joints are placed by the
+ * TransformSystem from the matrices of its TransformComponent. With INSTANCED_RENDERING the humans have no vertices:
+ * each frame the TransformSystem writes their body parts to the instances of their RenderComponent,
+ * drawn by the RenderSystem in a single call. A picked pixel then holds the index of its instance, which gives both
+ * the human and the body part.<br>
+ * With VERTEX_RENDERING the humans are drawn from the BufferManager buffers and picked by their colors, which may be
+ * the same for every human: only the selected human can be picked.
+ */
+class Crowd
+{
+public:
+    /**
+    * The most humans of a crowd, every instance being picked by a different 24 bits color.
+    */
+    static constexpr std::size_t MAX_SIZE = ((std::size_t{1} << 24) - 1) / HUMAN_JOINT_COUNT;
+
+    // Constructors
+    explicit Crowd(std::size_t size,
+                   BodyPartRendering rendering = INSTANCED_RENDERING,
+                   std::uint32_t seed = CROWD_SEED,
+                   std::span<const SkeletonDefinition> skeletons = {});
+    Crowd(const Crowd& other) = delete;
+
+    // Destructor
+    ~Crowd();
+
+    // Operator overloads
+    Crowd& operator=(const Crowd& other) = delete;
+
+    // Getters
+    [[nodiscard]] std::size_t getSize() const;
+    [[nodiscard]] CharacterRegistry& getRegistry();
+    [[nodiscard]] BodyPartRendering getRendering() const;
+    [[nodiscard]] Human* getHuman(std::size_t index) const;
+    [[nodiscard]] const CrowdAnimation& getAnimation(std::size_t index) const;
+    [[nodiscard]] std::span<const BodyPartInstance> getInstances() const;
+    [[nodiscard]] Human* getSelected() const;
+    [[nodiscard]] Human* findHuman(const std::array<int, 3>& color) const;
+    [[nodiscard]] BodyPart* findBodyPart(const std::array<int, 3>& color) const;
+
+    // Setters
+    Crowd& setSelected(Human* human);
+
+    // Methods
+    void animate();
+    void applyTransformation(std::size_t begin, std::size_t end);
+    void applyTransformation();
+    void draw() const;
+
+private:
+    /**
+    * How the humans are drawn.
+    */
+    BodyPartRendering _rendering;
+
+    /**
+    * The humans, owned by the crowd, and their components.
+    */
+    CharacterRegistry _registry;
+
+    /**
+    * The animation of each human, indexed by entity.
+    */
+    std::vector<CrowdAnimation> _animations;
+
+    /**
+    * The human controlled by the keyboard.
+    */
+    Human* _selected;
+};
+
+#endif //CROWD_HPP
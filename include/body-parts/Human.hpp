@@ -1,20 +1,72 @@
 #ifndef HUMAN_HPP
 #define HUMAN_HPP
 #include <BodyPart.hpp>
-#include <map>
+#include <BodyPartPool.hpp>
+#include <JointMask.hpp>
+#include <memory>
+#include <Pose.hpp>
+#include <SkeletonDefinition.hpp>
+#include <span>
+#include <TwoBoneIk.hpp>
+#include <Vector4.hpp>
+
+/**
+ * The body parts of a human, in the order they are stored in its BodyPartPool range.<br>
+ * The order is breadth first, so the children of every body part are adjacent.
+ */
+enum HumanJoint
+{
+    TORSO,
+    HEAD,
+    RIGHT_ARM,
+    LEFT_ARM,
+    RIGHT_LEG,
+    LEFT_LEG,
+    HAT_BRIM,
+    RIGHT_LOWER_ARM,
+    LEFT_LOWER_ARM,
+    RIGHT_LOWER_LEG,
+    LEFT_LOWER_LEG,
+    HAT_BRIM_GREEN_BAND,
+    RIGHT_SHOE,
+    LEFT_SHOE,
+    HAT_BRIM_RED_BAND,
+    HAT_BRIM_YELLOW_BAND,
+    HAT_CROWN,
+    HUMAN_JOINT_COUNT
+};
+
+/**
+ * The two-bone chains of a human solved by inverse kinematics, each ending on the far end of its lower limb.
+ */
+enum HumanLimb
+{
+    RIGHT_ARM_LIMB,     // RIGHT_ARM, RIGHT_LOWER_ARM
+    LEFT_ARM_LIMB,      // LEFT_ARM, LEFT_LOWER_ARM
+    RIGHT_LEG_LIMB,     // RIGHT_LEG, RIGHT_LOWER_LEG
+    LEFT_LEG_LIMB,      // LEFT_LEG, LEFT_LOWER_LEG
+    HUMAN_LIMB_COUNT
+};
 
 class Human
 {
 public:
     // Constructors
-    Human();
+    explicit Human(BodyPartRendering rendering = VERTEX_RENDERING);
+    explicit Human(const SkeletonDefinition& skeleton, BodyPartRendering rendering = VERTEX_RENDERING);
 
     // Destructor
     ~Human();
 
     // Getters
-    [[nodiscard]] static std::map<std::array<int, 3>, BodyPart*> getColorToBodyPartMap() ;
+    [[nodiscard]] static const SkeletonDefinition& getDefaultSkeleton();
+    [[nodiscard]] static std::span<const int> getJointParents();
+    [[nodiscard]] static std::span<const TwoBoneChain> getLimbChains();
+    [[nodiscard]] static const std::shared_ptr<const JointMask>& getUpperBodyMask();
+    [[nodiscard]] static const std::shared_ptr<const JointMask>& getMajorJointMask();
     [[nodiscard]] BodyPart* getRoot() const;
+    [[nodiscard]] Vector4 getPosition() const;
+    [[nodiscard]] BodyPart* getBodyPart(HumanJoint joint) const;
     [[nodiscard]] BodyPart* getTarget() const;
     [[nodiscard]] BodyPart* getHead() const;
     [[nodiscard]] BodyPart* getTorso() const;
@@ -32,68 +84,37 @@ public:
 
     // Setter
     void setTarget(BodyPart* target);
+    void setPosition(const Vector4& position) const;
 
     // Methods
-    static void addToColorToBodyPartMap(std::array<int, 3> colors, BodyPart* bodyPart);
+    [[nodiscard]] static bool isHumanSkeleton(const SkeletonDefinition& skeleton);
+    [[nodiscard]] BodyPart* findBodyPart(const std::array<int, 3>& color) const;
+    void applyTransformation(std::span<BodyPartInstance> instances) const;
+    void applyPose(const Pose& pose, const JointMask* mask = nullptr) const;
+    [[nodiscard]] float measurePoseError(const Pose& reference, const Pose& approximation) const;
     void resetMembersRotations() const;
     void resetMembersTranslations() const;
     void resetMembersScaling() const;
     static void resetRotation(BodyPart* bodyPart);
 
 private:
-    // Body parts of the human
-    BodyPart* _root = nullptr;
-    BodyPart* _target = nullptr;
-    BodyPart* _head = nullptr;
-    BodyPart* _torso = nullptr;
-    BodyPart* _rightArm = nullptr;
-    BodyPart* _rightLowerArm = nullptr;
-    BodyPart* _leftArm = nullptr;
-    BodyPart* _leftLowerArm = nullptr;
-    BodyPart* _rightLeg = nullptr;
-    BodyPart* _rightLowerLeg = nullptr;
-    BodyPart* _leftLeg = nullptr;
-    BodyPart* _leftLowerLeg = nullptr;
-
-    BodyPart* _rightShoe = nullptr;
-    BodyPart* _leftShoe = nullptr;
+    /**
+    * The handle of the first body part of the human in the BodyPartPool, the others follow it.
+    */
+    BodyPartHandle _firstBodyPart = 0;
 
-    BodyPart* _hatBrim = nullptr;
-    BodyPart* _hatBrimGreenBand = nullptr;
-    BodyPart* _hatBrimRedBand = nullptr;
-    BodyPart* _hatBrimYellowBand = nullptr;
+    /**
+    * The body parts of the human, indexed by HumanJoint.
+    */
+    BodyPart* _bodyParts = nullptr;
 
-    BodyPart* _hatCrown = nullptr;
+    BodyPart* _root = nullptr;
+    BodyPart* _target = nullptr;
 
     // Methods
-    void _initBodyParts();
-    void _initHead() const;
-    void _initTorso() const;
-    void _initRightArm() const;
-    void _initRightLowerArm() const;
-    void _initLeftArm() const;
-    void _initLeftLowerArm() const;
-    void _initRightLeg() const;
-    void _initRightLowerLeg() const;
-    void _initLeftLeg() const;
-    void _initLeftLowerLeg() const;
-
-    void _initRightShoe() const;
-    void _initLeftShoe() const;
-
-    void _initHatBrim() const;
-    void _initHatBrimGreenBand() const;
-    void _initHatBrimRedBand() const;
-    void _initHatBrimYellowBand() const;
-
-    void _initHatCrown() const;
-
+    void _initBodyParts(const SkeletonDefinition& skeleton);
     void _initRoot();
     void _initTarget();
-
-    void _linkChildren() const;
-
-    static std::map<std::array<int, 3>, BodyPart*> _colorToBodyPartMap;
 };
 
 #endif //HUMAN_HPP
@@ -0,0 +1,87 @@
+#ifndef SKELETON_DEFINITION_HPP
+#define SKELETON_DEFINITION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * A joint of a SkeletonDefinition: the cube of a body part and where it hangs from its parent.<br>
+ * The points are given in fractions of a size, so resizing a body part keeps its children attached to it.
+ */
+struct JointDefinition
+{
+    /**
+    * The index of the parent joint (-1 for a root).
+    */
+    std::int32_t parent;
+
+    /**
+    * The size of the cube in world units, a negative size mirroring the cube and its children on that axis.
+    */
+    float size[3];
+
+    /**
+    * The point of the parent the joint hangs from, from the center of the parent, in fractions of its size.
+    */
+    float anchor[3];
+
+    /**
+    * The center of the cube from the anchor, in fractions of its own size.
+    */
+    float offset[3];
+
+    /**
+    * The point the cube rotates around, from its center, in fractions of its own size.
+    */
+    float pivot[3];
+
+    /**
+    * The default red, green and blue of the cube.
+    */
+    std::uint8_t color[3];
+
+    /**
+    * Padding of the compiled file format, where joints are written as they are stored in memory, always 0.
+    */
+    std::uint8_t reserved = 0;
+};
+
+/**
+ * The joints of a character, their hierarchy, sizes, pivots and colors, so that characters are data instead of code.
+ * <br>
+ * Joints are stored in the order of the BodyPartPool range they are built into: parents come before their children
+ * and the children of a joint follow each other, so a character is built in a single pass over its joints.
+ * Definitions are authored as text, see parse(), and compiled by save() to a binary file read without any parsing.
+ * Colors are all different, so the joint under the cursor is known from the color of the pixel.
+ */
+class SkeletonDefinition
+{
+public:
+    // Constructors
+    explicit SkeletonDefinition(std::vector<JointDefinition> joints, const std::string& source = "skeleton");
+
+    // Getters
+    [[nodiscard]] std::size_t getJointCount() const;
+    [[nodiscard]] std::span<const JointDefinition> getJoints() const;
+
+    // Methods
+    void save(const std::string& path) const;
+
+    [[nodiscard]] static SkeletonDefinition parse(std::string_view text, const std::string& source = "skeleton");
+    [[nodiscard]] static SkeletonDefinition load(const std::string& path);
+
+    // Operator overloads
+    const JointDefinition& operator[](std::size_t joint) const;
+
+private:
+    /**
+    * The joints, parents first.
+    */
+    std::vector<JointDefinition> _joints;
+};
+
+#endif //SKELETON_DEFINITION_HPP
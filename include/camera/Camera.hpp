@@ -31,7 +31,7 @@ public:
     [[nodiscard]] const Matrix4& getProjectionMatrix() const;
 
     // Methods
-    void updateCameraPos(CameraDirection dir);
+    void updateCameraPos(CameraDirection dir, float deltaTime);
     [[nodiscard]] static Matrix4 getFinalMatrix();
     static void resetCamera();
     static void deleteCamera();
@@ -81,7 +81,7 @@ private:
     float _pitch;
 
     /**
-    * The speed at which the different rotations will be done.
+    * The speed at which the camera moves, in units per second.
     */
     float _speed;
 
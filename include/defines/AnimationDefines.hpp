@@ -0,0 +1,27 @@
+#ifndef ANIMATION_DEFINES_HPP
+#define ANIMATION_DEFINES_HPP
+
+#define ANIMATION_CROSSFADE_DURATION 0.25f      // Seconds taken by the AnimationManager to switch animations
+#define CLIP_CURSOR_RESERVED_TRACKS 64          // Tracks a layer can play without its cursor allocating
+#define EASING_CURVE_SEGMENTS 64                // Uniform segments of the lookup table of an easing curve
+#define ANIMATION_EVENT_TICK (1.0f / 120.0f)    // Seconds per tick of the timer wheel dispatching animation events
+#define ANIMATION_BAKE_RATE 60.0f               // Minimal frames per second of the clips baked by the AnimationManager
+#define ANIMATION_COMPRESSION_MAX_ERROR 0.001f  // Largest vertex error in world units of compressed clips
+#define ANIMATION_LOD_REDUCED_DISTANCE 8.0f     // Distance to the camera from which humans are updated less often
+#define ANIMATION_LOD_MINIMAL_DISTANCE 24.0f    // Distance to the camera from which humans lose their minor joints
+#define ANIMATION_LOD_REDUCED_INTERVAL 2        // Updates between two evaluations of a reduced human
+#define ANIMATION_LOD_MINIMAL_INTERVAL 4        // Updates between two evaluations of a minimal human
+#define HUMAN_BOUNDING_RADIUS 1.0f              // Radius around the torso containing a human in any pose
+#define IK_ELBOW_MIN_ANGLE 0.5f                 // Smallest angle in radians the IK leaves between arm and lower arm
+#define IK_KNEE_MIN_ANGLE 0.35f                 // Smallest angle in radians the IK leaves between leg and lower leg
+#define MOTION_MATCHING_SAMPLE_RATE 30.0f       // Frames per second sampled from the clips of a motion database
+#define MOTION_MATCHING_NEAR_TIME 0.25f         // Seconds ahead of the first point of the trajectory features
+#define MOTION_MATCHING_FAR_TIME 0.5f           // Seconds ahead of the second point of the trajectory features
+#define MOTION_MATCHING_POSE_WEIGHT 1.0f        // Weight of the hand and foot positions in the search cost
+#define MOTION_MATCHING_VELOCITY_WEIGHT 0.5f    // Weight of the hand and foot velocities in the search cost
+#define MOTION_MATCHING_TRAJECTORY_WEIGHT 2.0f  // Weight of the trajectory in the search cost
+#define MOTION_MATCHING_SEARCH_INTERVAL 6       // Updates between two searches of a character
+#define MOTION_MATCHING_MIN_IMPROVEMENT 0.05f   // Cost a match must save over the current frame to be jumped to
+#define MOTION_MATCHING_BLEND_DURATION 0.2f     // Seconds of the crossfade to a matched frame
+
+#endif // ANIMATION_DEFINES_HPP
@@ -26,6 +26,9 @@
 
 #define LENGTH_BASE_UNIT 1.0f
 
-#define ROTATION_SPEED 0.1f    // Rotation speed of the body parts
+#define ROTATION_SPEED 6.0f    // Rotation speed of the body parts (in radians per second)
+#define SCALING_RATE 1.82f     // Factor applied to the scale of the body parts each second
+
+#define BODY_PART_POOL_CHUNK_SIZE 4096    // Minimum number of body parts allocated at once by the pool
 
 #endif // BODYPART_DEFINES_HPP
\ No newline at end of file
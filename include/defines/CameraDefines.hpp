@@ -6,5 +6,6 @@
 #define FAR_PLANE_Z 100.0f                          // Far clipping plane
 #define Z_RANGE (NEAR_PLANE_Z - FAR_PLANE_Z)        // Range of the z-axis
 #define ASPECT_RATIO (WINDOW_WIDTH / WINDOW_HEIGHT) // Aspect ratio of the window
+#define CAMERA_SPEED 9.0f                           // Speed of the camera (in units per second)
 
 #endif //CAMERADEFINES_HPP
\ No newline at end of file
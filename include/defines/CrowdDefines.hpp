@@ -0,0 +1,7 @@
+#ifndef CROWDDEFINES_HPP
+#define CROWDDEFINES_HPP
+
+#define CROWD_GRID_SPACING 1.5f                             // Distance between two neighbours of the crowd grid
+#define CROWD_SEED 42                                       // Seed of the animations and phases drawn for the crowd
+
+#endif // CROWDDEFINES_HPP
@@ -0,0 +1,7 @@
+#ifndef JOBDEFINES_HPP
+#define JOBDEFINES_HPP
+
+#define JOB_QUEUE_CAPACITY 1024                             // Jobs queued per thread, a full queue runs jobs inline
+#define ANIMATION_JOB_CHUNK_SIZE 32                         // Humans animated or transformed by one job
+
+#endif // JOBDEFINES_HPP
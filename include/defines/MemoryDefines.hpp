@@ -0,0 +1,7 @@
+#ifndef MEMORYDEFINES_HPP
+#define MEMORYDEFINES_HPP
+
+#define FRAME_ARENA_CAPACITY (256 * 1024)                   // Initial size in bytes of each thread's frame arena
+#define FRAME_ARENA_BLOCK_ALIGNMENT 64                      // Alignment in bytes of the frame arena blocks
+
+#endif // MEMORYDEFINES_HPP
@@ -0,0 +1,9 @@
+#ifndef SIMULATIONDEFINES_HPP
+#define SIMULATIONDEFINES_HPP
+
+#define SIMULATION_TIMESTEP (1.0f / 120.0f)                 // Seconds simulated by each fixed step
+#define SIMULATION_MAX_STEPS 8                              // Most steps run for one frame, the backlog is dropped
+#define SIMULATION_MIN_TIME_SCALE 0.125f                    // Slowest time scale reachable from the keyboard
+#define SIMULATION_MAX_TIME_SCALE 8.0f                      // Fastest time scale reachable from the keyboard
+
+#endif // SIMULATIONDEFINES_HPP
@@ -0,0 +1,70 @@
+#ifndef CHARACTER_COMPONENTS_HPP
+#define CHARACTER_COMPONENTS_HPP
+
+#include <AnimationPlayer.hpp>
+#include <cstdint>
+#include <Human.hpp>
+
+/**
+ * The skeleton of a character: its body parts, posed by its player and placed by the TransformSystem.
+ */
+struct SkeletonComponent
+{
+    /**
+    * The human whose body parts make the skeleton, not owned by the registry.
+    */
+    Human* human;
+};
+
+/**
+ * The transforms of the joints of a character, a range of the joint arrays of its CharacterRegistry (parents, local
+ * and world matrices).<br>
+ * The joints follow the order of the skeleton, parents first, so the world matrices are computed in a single pass.
+ */
+struct TransformComponent
+{
+    /**
+    * The index of the first joint in the joint arrays, the others following it.
+    */
+    std::uint32_t firstJoint;
+
+    /**
+    * The number of joints, one per body part.
+    */
+    std::uint32_t jointCount;
+};
+
+/**
+ * The player animating the skeleton of a character.
+ */
+struct AnimationComponent
+{
+    /**
+    * The player, not owned by the registry.
+    */
+    AnimationPlayer* player;
+};
+
+/**
+ * The instances drawing the body parts of a character, a range of the instances of its CharacterRegistry.<br>
+ * The index of an instance is also its picking id, see RenderSystem::pick().
+ */
+struct RenderComponent
+{
+    /**
+    * The index of the instance of the first body part, the others following it in the order of the skeleton.
+    */
+    std::uint32_t firstInstance;
+
+    /**
+    * The number of instances, one per body part.
+    */
+    std::uint32_t instanceCount;
+
+    /**
+    * Whether the instances were never written, so that they are written even if the character is culled.
+    */
+    bool outdated;
+};
+
+#endif //CHARACTER_COMPONENTS_HPP
@@ -0,0 +1,132 @@
+#ifndef CHARACTER_REGISTRY_HPP
+#define CHARACTER_REGISTRY_HPP
+
+#include <BodyPart.hpp>
+#include <CharacterComponents.hpp>
+#include <ComponentStore.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <Matrix4.hpp>
+#include <span>
+#include <vector>
+
+/**
+ * The entities of a scene of characters and their components, one ComponentStore per type of component.<br>
+ * An entity is an index with nothing attached: what a character is depends on its components, and each system only
+ * goes through the stores of the components it needs. The joints of the TransformComponents are stored as parallel
+ * arrays (parents, local matrices, world matrices), and the instances of the RenderComponents are packed in a single
+ * array: each in the order their ranges were added, so that the transforms are walked linearly and the instances are
+ * drawn in one call.<br>
+ * The registry does not own what its components point to.
+ */
+class CharacterRegistry
+{
+public:
+    /**
+    * The entity of no character.
+    */
+    static constexpr Entity NO_ENTITY = UINT32_MAX;
+
+    // Constructors
+    CharacterRegistry() = default;
+    CharacterRegistry(const CharacterRegistry& other) = delete;
+
+    // Destructor
+    ~CharacterRegistry() = default;
+
+    // Operator overloads
+    CharacterRegistry& operator=(const CharacterRegistry& other) = delete;
+
+    // Getters
+    [[nodiscard]] std::size_t getEntityCount() const;
+    [[nodiscard]] bool isAlive(Entity entity) const;
+    [[nodiscard]] ComponentStore<SkeletonComponent>& getSkeletons();
+    [[nodiscard]] const ComponentStore<SkeletonComponent>& getSkeletons() const;
+    [[nodiscard]] ComponentStore<TransformComponent>& getTransforms();
+    [[nodiscard]] const ComponentStore<TransformComponent>& getTransforms() const;
+    [[nodiscard]] std::span<const std::int32_t> getJointParents() const;
+    [[nodiscard]] std::span<Matrix4> getLocalMatrices();
+    [[nodiscard]] std::span<Matrix4> getWorldMatrices();
+    [[nodiscard]] std::span<const Matrix4> getWorldMatrices() const;
+    [[nodiscard]] ComponentStore<AnimationComponent>& getAnimations();
+    [[nodiscard]] const ComponentStore<AnimationComponent>& getAnimations() const;
+    [[nodiscard]] ComponentStore<RenderComponent>& getRenders();
+    [[nodiscard]] const ComponentStore<RenderComponent>& getRenders() const;
+    [[nodiscard]] std::span<BodyPartInstance> getInstances();
+    [[nodiscard]] std::span<const BodyPartInstance> getInstances() const;
+    [[nodiscard]] std::span<BodyPartInstance> getInstances(const RenderComponent& render);
+    [[nodiscard]] Entity findInstanceOwner(std::size_t instance) const;
+
+    // Methods
+    void reserve(std::size_t entityCount, std::size_t jointCount, std::size_t instanceCount);
+    Entity create();
+    void destroy(Entity entity);
+    TransformComponent& addTransform(Entity entity, std::span<const int> parents);
+    void removeTransform(Entity entity);
+    RenderComponent& addRender(Entity entity, std::size_t instanceCount);
+    void removeRender(Entity entity);
+    void clear();
+
+private:
+    /**
+    * Whether each entity is alive.
+    */
+    std::vector<bool> _alive;
+
+    /**
+    * The destroyed entities, given to the next created ones.
+    */
+    std::vector<Entity> _freeEntities;
+
+    /**
+    * The number of alive entities.
+    */
+    std::size_t _entityCount = 0;
+
+    /**
+    * The skeletons of the characters.
+    */
+    ComponentStore<SkeletonComponent> _skeletons;
+
+    /**
+    * The joint ranges of the transformed characters.
+    */
+    ComponentStore<TransformComponent> _transforms;
+
+    /**
+    * The index in the joint arrays of the parent of each joint (-1 for a root).
+    */
+    std::vector<std::int32_t> _jointParents;
+
+    /**
+    * The matrix of each joint in the space of its parent.
+    */
+    std::vector<Matrix4> _localMatrices;
+
+    /**
+    * The matrix of each joint in the world.
+    */
+    std::vector<Matrix4> _worldMatrices;
+
+    /**
+    * The players of the animated characters.
+    */
+    ComponentStore<AnimationComponent> _animations;
+
+    /**
+    * The instance ranges of the drawn characters.
+    */
+    ComponentStore<RenderComponent> _renders;
+
+    /**
+    * The instances of every RenderComponent.
+    */
+    std::vector<BodyPartInstance> _instances;
+
+    /**
+    * The entity owning each instance.
+    */
+    std::vector<Entity> _instanceOwners;
+};
+
+#endif //CHARACTER_REGISTRY_HPP
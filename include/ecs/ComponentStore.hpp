@@ -0,0 +1,184 @@
+#ifndef COMPONENT_STORE_HPP
+#define COMPONENT_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * Identifier of an entity of a CharacterRegistry, reused once the entity is destroyed.
+ */
+using Entity = std::uint32_t;
+
+/**
+ * Sparse set of the components of one type, indexed by entity.<br>
+ * The components are packed in a dense array, in the order they were inserted, next to the array of their entities:
+ * a system going through them reads contiguous memory holding nothing but the data it needs. A sparse array indexed
+ * by entity gives the place of the component of an entity in constant time.<br>
+ * Erasing a component moves the last one to its place, so pointers and spans to the components are invalidated by
+ * insert() and erase().
+ *
+ * @tparam Component The type of the components
+ */
+template<typename Component>
+class ComponentStore
+{
+public:
+    /**
+    * The index in the dense arrays of an entity without component.
+    */
+    static constexpr std::uint32_t NO_INDEX = UINT32_MAX;
+
+    /**
+    * @return The number of components
+    */
+    [[nodiscard]] std::size_t getSize() const
+    {
+        return _components.size();
+    }
+
+    /**
+    * @return The components, in the same order as getEntities()
+    */
+    [[nodiscard]] std::span<Component> getComponents()
+    {
+        return _components;
+    }
+
+    /**
+    * @return The components, in the same order as getEntities()
+    */
+    [[nodiscard]] std::span<const Component> getComponents() const
+    {
+        return _components;
+    }
+
+    /**
+    * @return The entities of the components
+    */
+    [[nodiscard]] std::span<const Entity> getEntities() const
+    {
+        return _entities;
+    }
+
+    /**
+    * @param entity The entity
+    *
+    * @return Whether the entity has a component
+    */
+    [[nodiscard]] bool contains(const Entity entity) const
+    {
+        return entity < _sparse.size() && _sparse[entity] != NO_INDEX;
+    }
+
+    /**
+    * @param entity The entity
+    *
+    * @return The component of the entity (nullptr if it has none)
+    */
+    [[nodiscard]] Component* find(const Entity entity)
+    {
+        return contains(entity) ? &_components[_sparse[entity]] : nullptr;
+    }
+
+    /**
+    * @param entity The entity
+    *
+    * @return The component of the entity (nullptr if it has none)
+    */
+    [[nodiscard]] const Component* find(const Entity entity) const
+    {
+        return contains(entity) ? &_components[_sparse[entity]] : nullptr;
+    }
+
+    /**
+    * Reserve room for a number of components and of entities, so that inserting them does not allocate.
+    *
+    * @param count The number of components, the entities being below it
+    */
+    void reserve(const std::size_t count)
+    {
+        if (_sparse.size() < count)
+        {
+            _sparse.resize(count, NO_INDEX);
+        }
+        _entities.reserve(count);
+        _components.reserve(count);
+    }
+
+    /**
+    * Give a component to an entity, replacing the one it had.
+    *
+    * @param entity The entity
+    * @param component The component
+    *
+    * @return The component stored
+    */
+    Component& insert(const Entity entity, const Component& component)
+    {
+        if (Component* existing = find(entity))
+        {
+            return *existing = component;
+        }
+        if (entity >= _sparse.size())
+        {
+            _sparse.resize(entity + 1, NO_INDEX);
+        }
+        _sparse[entity] = static_cast<std::uint32_t>(_components.size());
+        _entities.push_back(entity);
+        return _components.emplace_back(component);
+    }
+
+    /**
+    * Remove the component of an entity, the last component taking its place.
+    *
+    * @param entity The entity (nothing happens if it has no component)
+    */
+    void erase(const Entity entity)
+    {
+        if (!contains(entity))
+        {
+            return;
+        }
+        const std::uint32_t index = _sparse[entity];
+        _sparse[_entities.back()] = index;
+        _entities[index] = _entities.back();
+        _components[index] = std::move(_components.back());
+        _entities.pop_back();
+        _components.pop_back();
+        _sparse[entity] = NO_INDEX;
+    }
+
+    /**
+    * Remove every component.
+    */
+    void clear()
+    {
+        for (const Entity entity: _entities)
+        {
+            _sparse[entity] = NO_INDEX;
+        }
+        _entities.clear();
+        _components.clear();
+    }
+
+private:
+    /**
+    * The index in the dense arrays of the component of each entity (NO_INDEX if it has none).
+    */
+    std::vector<std::uint32_t> _sparse;
+
+    /**
+    * The entity of each component.
+    */
+    std::vector<Entity> _entities;
+
+    /**
+    * The components, packed.
+    */
+    std::vector<Component> _components;
+};
+
+#endif //COMPONENT_STORE_HPP
@@ -0,0 +1,41 @@
+#ifndef RENDER_SYSTEM_HPP
+#define RENDER_SYSTEM_HPP
+
+#include <array>
+#include <CharacterRegistry.hpp>
+#include <cstddef>
+
+/**
+ * A body part found by picking.
+ */
+struct PickedBodyPart
+{
+    /**
+    * The character (CharacterRegistry::NO_ENTITY for the background).
+    */
+    Entity entity;
+
+    /**
+    * The index of the body part in the skeleton of the character.
+    */
+    std::size_t joint;
+};
+
+/**
+ * Draws the instances of a CharacterRegistry, and finds the character and the body part of a picked pixel.
+ */
+class RenderSystem
+{
+public:
+    // Constructors
+    RenderSystem() = delete;
+
+    // Destructor
+    ~RenderSystem() = delete;
+
+    // Methods
+    static void draw(const CharacterRegistry& registry);
+    [[nodiscard]] static PickedBodyPart pick(const CharacterRegistry& registry, const std::array<int, 3>& color);
+};
+
+#endif //RENDER_SYSTEM_HPP
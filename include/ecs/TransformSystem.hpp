@@ -0,0 +1,30 @@
+#ifndef TRANSFORM_SYSTEM_HPP
+#define TRANSFORM_SYSTEM_HPP
+
+#include <CharacterRegistry.hpp>
+#include <cstddef>
+
+/**
+ * Brings the skeletons of a CharacterRegistry to the world.<br>
+ * The local matrix of each joint of a TransformComponent is read from its body part, then the world matrices are
+ * computed in one linear pass over the joint arrays, each parent coming before its children. A character with a
+ * RenderComponent gets its instances written, and is skipped while its AnimationComponent player is culled: its pose
+ * does not move and it is out of view. A character without one gets the vertices of its body parts written to the
+ * BufferManager buffers.<br>
+ * A character without TransformComponent is transformed down the hierarchy of its body parts.
+ */
+class TransformSystem
+{
+public:
+    // Constructors
+    TransformSystem() = delete;
+
+    // Destructor
+    ~TransformSystem() = delete;
+
+    // Methods
+    static void update(CharacterRegistry& registry, std::size_t begin, std::size_t end);
+    static void update(CharacterRegistry& registry);
+};
+
+#endif //TRANSFORM_SYSTEM_HPP
@@ -0,0 +1,24 @@
+#ifndef ALLOCATION_EXCEPTION_HPP
+#define ALLOCATION_EXCEPTION_HPP
+
+#include <exception>
+#include <string>
+#include <utility>
+
+class AllocationException : public std::exception
+{
+public:
+    explicit AllocationException(std::string message) : _message(std::move(message))
+    {
+    }
+
+    [[nodiscard]] const char* what() const noexcept override
+    {
+        return _message.c_str();
+    }
+
+private:
+    std::string _message;
+};
+
+#endif //ALLOCATION_EXCEPTION_HPP
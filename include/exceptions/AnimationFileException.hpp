@@ -0,0 +1,24 @@
+#ifndef ANIMATION_FILE_EXCEPTION_HPP
+#define ANIMATION_FILE_EXCEPTION_HPP
+
+#include <exception>
+#include <string>
+#include <utility>
+
+class AnimationFileException : public std::exception
+{
+public:
+    explicit AnimationFileException(std::string message) : _message(std::move(message))
+    {
+    }
+
+    [[nodiscard]] const char* what() const noexcept override
+    {
+        return _message.c_str();
+    }
+
+private:
+    std::string _message;
+};
+
+#endif //ANIMATION_FILE_EXCEPTION_HPP
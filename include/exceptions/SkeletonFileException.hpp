@@ -0,0 +1,24 @@
+#ifndef SKELETON_FILE_EXCEPTION_HPP
+#define SKELETON_FILE_EXCEPTION_HPP
+
+#include <exception>
+#include <string>
+#include <utility>
+
+class SkeletonFileException : public std::exception
+{
+public:
+    explicit SkeletonFileException(std::string message) : _message(std::move(message))
+    {
+    }
+
+    [[nodiscard]] const char* what() const noexcept override
+    {
+        return _message.c_str();
+    }
+
+private:
+    std::string _message;
+};
+
+#endif //SKELETON_FILE_EXCEPTION_HPP
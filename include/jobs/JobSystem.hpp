@@ -0,0 +1,150 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * The function of a job, called on a range of indices.
+ */
+using JobFunction = void (*)(void* context, std::size_t begin, std::size_t end);
+
+/**
+ * The number of unfinished jobs of a fork, waited for by JobSystem::wait().
+ */
+using JobCounter = std::atomic<std::size_t>;
+
+/**
+ * A unit of work: a function, the data it works on and the range of indices it covers.<br>
+ * Jobs are plain values, so queuing them never allocates.
+ */
+struct Job
+{
+    JobFunction function;
+    void* context;
+    std::size_t begin;
+    std::size_t end;
+    JobCounter* counter;
+};
+
+/**
+ * A work-stealing thread pool.<br>
+ * Each thread (the workers, plus one queue shared by the threads outside of the pool) owns a queue of jobs. A thread
+ * runs its own jobs newest first, and when it has none, steals the oldest jobs of the others. A thread waiting for a
+ * fork runs jobs instead of blocking, so forks may be nested and a pool without worker runs everything on the caller.
+ * <br>
+ * Jobs must not throw and must not depend on the order in which they run: as long as each job writes its own data,
+ * the result is the same whatever the number of threads.
+ */
+class JobSystem
+{
+public:
+    // Constructors
+    explicit JobSystem(unsigned int workerCount);
+    JobSystem(const JobSystem&) = delete;
+
+    // Destructor
+    ~JobSystem();
+
+    // Getters
+    [[nodiscard]] static JobSystem& getInstance();
+    [[nodiscard]] unsigned int getWorkerCount() const;
+    [[nodiscard]] unsigned int getThreadCount() const;
+
+    // Operator overloads
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Methods
+    static void deleteInstance();
+    void run(const Job& job);
+    void wait(JobCounter& counter);
+
+    /**
+     * Call a function on every chunk of a range of indices, in parallel, and wait for all of them.<br>
+     * The function is called with the bounds of each chunk, in no particular order nor thread.
+     *
+     * @param count The number of indices
+     * @param chunkSize The number of indices per job
+     * @param function The function, called as function(begin, end)
+     */
+    template<typename Function>
+    void parallelFor(const std::size_t count, const std::size_t chunkSize, Function&& function)
+    {
+        using FunctionType = std::remove_reference_t<Function>;
+        const JobFunction trampoline = [](void* context, const std::size_t begin, const std::size_t end)
+        {
+            (*static_cast<FunctionType*>(context))(begin, end);
+        };
+        void* context = const_cast<std::remove_const_t<FunctionType>*>(std::addressof(function));
+        const std::size_t step = std::max<std::size_t>(chunkSize, 1);
+
+        JobCounter counter{0};
+        for (std::size_t begin = 0; begin < count; begin += step)
+        {
+            run({trampoline, context, begin, std::min(begin + step, count), &counter});
+        }
+        wait(counter);
+    }
+
+private:
+    /**
+    * A fixed-capacity ring of jobs, pushed and popped at the back by its owner and stolen from the front.
+    */
+    struct JobQueue
+    {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        std::size_t front = 0;
+        std::size_t size = 0;
+    };
+
+    /**
+    * The queues, the first one shared by the threads outside of the pool and the next ones owned by the workers.
+    */
+    std::vector<std::unique_ptr<JobQueue>> _queues;
+
+    /**
+    * The worker threads.
+    */
+    std::vector<std::thread> _workers;
+
+    /**
+    * The number of jobs queued and not yet taken, to let the workers sleep when there is none.
+    */
+    std::atomic<std::size_t> _queuedJobs;
+
+    /**
+    * Whether the workers must exit once the queues are empty.
+    */
+    bool _stopping;
+
+    /**
+    * Protects _stopping and the sleep of the workers.
+    */
+    std::mutex _sleepMutex;
+
+    /**
+    * Wakes the workers up when a job is queued.
+    */
+    std::condition_variable _wakeUp;
+
+    /**
+    * The pool shared by the engine.
+    */
+    static JobSystem* _instance;
+
+    // Private methods
+    [[nodiscard]] std::size_t _currentQueue() const;
+    bool _tryRunJob(std::size_t queueIndex);
+    void _workerLoop(std::size_t queueIndex);
+    static void _execute(const Job& job);
+};
+
+#endif //JOB_SYSTEM_HPP
@@ -3,6 +3,8 @@
 #include <Human.hpp>
 #include <GLFW/glfw3.h>
 
-void handleKeys(GLFWwindow* window, const Human* selectedHuman);
+void handleAnimationKey(int key);
+void handleKeys(GLFWwindow* window, const Human* selectedHuman, float deltaTime);
+void handleCameraKeys(GLFWwindow* window, float deltaTime);
 
 #endif // KEYBINDINGS_HPP
\ No newline at end of file
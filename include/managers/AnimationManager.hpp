@@ -1,8 +1,18 @@
 #ifndef ANIMATION_MANAGER_HPP
 #define ANIMATION_MANAGER_HPP
 
-#include <Animation.hpp>
+#include <AnimationClip.hpp>
+#include <AnimationController.hpp>
+#include <AnimationEventDispatcher.hpp>
+#include <AnimationPlayer.hpp>
+#include <AnimationStateMachine.hpp>
+#include <CompressedClip.hpp>
 #include <Human.hpp>
+#include <memory>
+#include <ScriptScheduler.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
 
 enum AnimationType
 {
@@ -10,7 +20,19 @@ enum AnimationType
     STAYING_PUT = 0,
     WALKING = 1,
     JUMPING = 2,
-    SNOW_ANGEL = 3
+    SNOW_ANGEL = 3,
+    ANIMATION_TYPE_COUNT = 4
+};
+
+/**
+ * The ids of the events of the built-in animations.
+ */
+enum AnimationEventId
+{
+    LEFT_FOOTSTEP_EVENT,    // The left foot touches the ground while walking
+    RIGHT_FOOTSTEP_EVENT,   // The right foot touches the ground while walking
+    JUMP_TAKEOFF_EVENT,     // Both feet leave the ground
+    JUMP_LANDING_EVENT      // Both feet touch the ground again
 };
 
 class AnimationManager
@@ -22,28 +44,62 @@ public:
     // Destructor
     ~AnimationManager() = delete;
 
+    // Getters
+    static std::shared_ptr<const AnimationSource> getClip(AnimationType type);
+    static std::string_view getName(AnimationType type);
+    static const std::shared_ptr<const AnimationStateMachine>& getStateMachine();
+    static ScriptScheduler& getScriptScheduler();
+    static AnimationEventDispatcher& getEventDispatcher();
+
     // Methods
     static void init(Human* human);
-    static void update();
+    static AnimationPlayer* addPlayer(Human* human, AnimationType type = NO_ANIMATION, float startTime = 0.0f);
+    static AnimationClip createClip(AnimationType type);
+    static std::shared_ptr<const CompressedClip> compressClip(AnimationType type, const Human& skeleton);
+    static void saveLibrary(const std::string& path);
+    static void loadLibrary(const std::string& path);
+    static void update(float deltaTime);
     static void select(int index);
     static void clean();
 
 private:
     /**
-     * The different animations that are managed by the AnimationManager.
+     * The clips of the built-in animations, indexed by AnimationType.<br>
+     * Each clip is built once and shared by every player.
+     */
+    static std::vector<std::shared_ptr<const AnimationSource>> _clips;
+
+    /**
+     * The players driven by the AnimationManager, one per animated human.
+     */
+    static std::vector<AnimationPlayer*> _players;
+
+    /**
+     * The controllers of the players, indexed like them, playing the state machine of the built-in animations.
+     */
+    static std::vector<AnimationController> _controllers;
+
+    /**
+     * The state machine of the built-in animations, built on first use.
+     */
+    static std::shared_ptr<const AnimationStateMachine> _stateMachine;
+
+    /**
+     * The dispatcher of the events of the players, updated after them.
      */
-    static std::vector<Animation*> _animations;
+    static AnimationEventDispatcher _eventDispatcher;
 
     /**
-     * The currently selected animation.
+     * The scheduler of the animation scripts, updated after the players so that scripts have the last word.
      */
-    static Animation* _selectedAnimation;
+    static ScriptScheduler _scriptScheduler;
 
     // Methods
-    static void _generateAndAddStayingPutKeyframes(Human* human);
-    static void _generateAndAddWalkingKeyframes(Human* human);
-    static void _generateAndAddJumpingKeyframes(Human* human);
-    static void _generateAndAddSnowAngelKeyframes(Human* human);
+    static std::size_t _getState(AnimationType type);
+    static AnimationClip _generateStayingPutClip();
+    static AnimationClip _generateWalkingClip();
+    static AnimationClip _generateJumpingClip();
+    static AnimationClip _generateSnowAngelClip();
 };
 
 #endif //ANIMATION_MANAGER_HPP
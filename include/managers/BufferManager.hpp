@@ -1,6 +1,8 @@
 #ifndef BUFFER_MANAGER_HPP
 #define BUFFER_MANAGER_HPP
 
+#include <BodyPart.hpp>
+#include <span>
 #include <vector>
 #include <GL/glew.h>
 
@@ -19,16 +21,22 @@ public:
  // Destructor
  ~BufferManager() = delete;
 
+ // Getters
+ [[nodiscard]] static float* getData(ManipulableBuffer bufferToGet, unsigned int startIndex);
+
  // Methods
  static void init();
  static void clean();
+ static void reset();
  static void drawAll();
  static void drawTriangles();
+ static void drawInstances(std::span<const BodyPartInstance> instances);
 
- static unsigned int add(ManipulableBuffer bufferToManipulate, const std::vector<float>& data);
+ static unsigned int allocate(ManipulableBuffer bufferToManipulate, std::size_t count);
+ static unsigned int add(ManipulableBuffer bufferToManipulate, std::span<const float> data);
  static unsigned int modify(ManipulableBuffer bufferToManipulate,
                             unsigned int startIndex,
-                            const std::vector<float>& data);
+                            std::span<const float> data);
 
 private:
  /**
@@ -36,6 +44,11 @@ private:
  */
  static GLuint _vertexArrayID;
 
+ /**
+ * The vertex array ID of the instanced cubes.
+ */
+ static GLuint _instancedVertexArrayID;
+
  /**
   * Whether the buffer manager has been initialized.
   */
@@ -61,6 +74,16 @@ private:
   */
  static GLuint _glTrianglesColorsBuffer;
 
+ /**
+  * The OpenGL buffer of the cube shared by the instances.
+  */
+ static GLuint _glCubeBuffer;
+
+ /**
+  * The OpenGL buffer of the instances.
+  */
+ static GLuint _glInstancesBuffer;
+
  // Methods
  static std::vector<float>* _getBuffer(ManipulableBuffer bufferToGet);
 };
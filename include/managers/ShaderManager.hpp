@@ -5,6 +5,7 @@
 #include <GL/glew.h>
 
 #define VERTEX_SHADER_SOURCE_PATH "../src/shaders/vertexShader.glsl"
+#define INSTANCED_VERTEX_SHADER_SOURCE_PATH "../src/shaders/instancedVertexShader.glsl"
 #define FRAGMENT_SHADER_SOURCE_PATH "../src/shaders/fragmentShader.glsl"
 
 class ShaderManager
@@ -19,6 +20,7 @@ public:
 
     // Getters
     static GLuint getProgramId();
+    static GLuint getInstancedProgramId();
 
     // Operator overloads
     ShaderManager& operator=(const ShaderManager&) = delete;
@@ -32,7 +34,13 @@ private:
     */
     static GLuint _programId;
 
+    /**
+    * The program drawing the cubes of the instanced body parts.
+    */
+    static GLuint _instancedProgramId;
+
     // Private methods
+    static GLuint _createProgram(const std::string& vertexShaderFileName, const std::string& fragmentShaderFileName);
     static GLuint _compileShader(const std::string& fileName, GLenum shaderId);
     static const char* _loadShader(const std::string& fileName);
 };
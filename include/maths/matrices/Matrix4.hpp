@@ -2,6 +2,7 @@
 #define MATRIX4_HPP
 
 #include <array>
+#include <cstddef>
 #include <Vector4.hpp>
 
 class Matrix4
@@ -27,12 +28,16 @@ public:
     Vector4 operator*(const Vector4& other) const;
 
     // Methods
+    void transformPoints(const float* points, float* result, std::size_t count) const;
     static Matrix4 createRotationMatrix(double angleX, double angleY, double angleZ);
     static Matrix4 createRotationXMatrix(double angle);
     static Matrix4 createRotationYMatrix(double angle);
     static Matrix4 createRotationZMatrix(double angle);
     static Matrix4 createScalingMatrix(float sx, float sy, float sz);
     static Matrix4 createTranslationMatrix(float tx, float ty, float tz);
+    static Matrix4 createTRSMatrix(float tx, float ty, float tz,
+                                   double angleX, double angleY, double angleZ,
+                                   float sx, float sy, float sz);
     static Matrix4 identity();
     [[nodiscard]] std::string toString() const;
 
@@ -0,0 +1,69 @@
+#ifndef QUATERNION_HPP
+#define QUATERNION_HPP
+
+#include <Matrix4.hpp>
+#include <ostream>
+#include <string>
+
+/**
+ * Unit quaternion representing a rotation.<br>
+ * Products follow the matrix convention of the engine: (a * b) rotates by b, then by a.
+ */
+class Quaternion
+{
+public:
+    // Constructors
+    Quaternion();
+    Quaternion(float w, float x, float y, float z);
+
+    // Getters
+    [[nodiscard]] float getW() const;
+    [[nodiscard]] float getX() const;
+    [[nodiscard]] float getY() const;
+    [[nodiscard]] float getZ() const;
+
+    // Operator overloads
+    Quaternion operator*(const Quaternion& other) const;
+    bool operator==(const Quaternion& other) const;
+    bool operator!=(const Quaternion& other) const;
+
+    // Methods
+    [[nodiscard]] Quaternion conjugate() const;
+    [[nodiscard]] float dot(const Quaternion& other) const;
+    [[nodiscard]] Quaternion normalize() const;
+    [[nodiscard]] Vector4 rotate(const Vector4& vector) const;
+    [[nodiscard]] Matrix4 toMatrix() const;
+    void toEulerAngles(float& angleX, float& angleY, float& angleZ) const;
+    [[nodiscard]] std::string toString() const;
+
+    static Quaternion identity();
+    static Quaternion fromAxisAngle(float axisX, float axisY, float axisZ, float angle);
+    static Quaternion fromEulerAngles(float angleX, float angleY, float angleZ);
+    static Quaternion nlerp(const Quaternion& from, const Quaternion& to, float factor);
+    static Quaternion slerp(const Quaternion& from, const Quaternion& to, float factor);
+
+private:
+    /**
+    * The scalar part of the quaternion.
+    */
+    float _w;
+
+    /**
+    * The x component of the vector part of the quaternion.
+    */
+    float _x;
+
+    /**
+    * The y component of the vector part of the quaternion.
+    */
+    float _y;
+
+    /**
+    * The z component of the vector part of the quaternion.
+    */
+    float _z;
+};
+
+std::ostream& operator<<(std::ostream& os, const Quaternion& quaternion);
+
+#endif //QUATERNION_HPP
@@ -0,0 +1,93 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Heap allocation counters.
+ */
+struct AllocationStats
+{
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t allocatedBytes = 0;
+};
+
+/**
+ * Counts every call to the global operator new and operator delete, globally and per thread.<br>
+ * A frame is delimited by beginFrame() and endFrame(). In strict mode, any allocation done by a frame once the warm-up
+ * frames are over throws an AllocationException.
+ */
+class AllocationTracker
+{
+public:
+    // Constructors
+    AllocationTracker() = delete;
+
+    // Destructor
+    ~AllocationTracker() = delete;
+
+    // Getters
+    [[nodiscard]] static AllocationStats getGlobalStats();
+    [[nodiscard]] static AllocationStats getThreadStats();
+    [[nodiscard]] static const AllocationStats& getLastFrameStats();
+    [[nodiscard]] static bool isStrict();
+
+    // Setters
+    static void setStrict(bool strict, unsigned int warmupFrames = 60);
+
+    // Methods
+    static void beginFrame();
+    static const AllocationStats& endFrame();
+    static void recordAllocation(std::size_t size);
+    static void recordDeallocation();
+
+private:
+    /**
+    * The number of allocations done by all threads.
+    */
+    static std::atomic<std::size_t> _allocations;
+
+    /**
+    * The number of deallocations done by all threads.
+    */
+    static std::atomic<std::size_t> _deallocations;
+
+    /**
+    * The number of bytes allocated by all threads.
+    */
+    static std::atomic<std::size_t> _allocatedBytes;
+
+    /**
+    * The counters of the calling thread.
+    */
+    static thread_local AllocationStats _threadStats;
+
+    /**
+    * The global counters at the beginning of the current frame.
+    */
+    static AllocationStats _frameStartStats;
+
+    /**
+    * The allocations done during the last completed frame.
+    */
+    static AllocationStats _lastFrameStats;
+
+    /**
+    * The number of completed frames.
+    */
+    static unsigned int _frameCount;
+
+    /**
+    * Whether a steady-state frame is allowed to allocate.
+    */
+    static bool _strict;
+
+    /**
+    * The number of frames allowed to allocate before the strict mode applies.
+    */
+    static unsigned int _warmupFrames;
+};
+
+#endif //ALLOCATION_TRACKER_HPP
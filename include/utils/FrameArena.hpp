@@ -0,0 +1,132 @@
+#ifndef FRAME_ARENA_HPP
+#define FRAME_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A vector whose storage comes from a memory resource, usually a FrameArena.
+ */
+template<typename T>
+using FrameVector = std::pmr::vector<T>;
+
+/**
+ * Linear (bump) allocator for data that only lives during one frame.<br>
+ * An allocation moves a pointer forward, a deallocation does nothing and reset() releases everything at once.<br>
+ * When a frame needs more than the capacity, the overflow is served by extra blocks taken from the heap. The next
+ * reset() merges them into a single block, so the arena stops allocating once it has seen its largest frame.<br>
+ * Each thread owns its own arena (see getThreadArena()), so no lock is ever taken. beginFrame() starts a new frame for
+ * every thread: the arena of a thread is reset the first time the thread gets it during the frame, so worker threads
+ * need no reset of their own.
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    // Constructors
+    explicit FrameArena(std::size_t capacity);
+    FrameArena(const FrameArena& other) = delete;
+
+    // Destructor
+    ~FrameArena() override;
+
+    // Getters
+    [[nodiscard]] static FrameArena& getThreadArena();
+    [[nodiscard]] std::size_t getCapacity() const;
+    [[nodiscard]] std::size_t getUsedBytes() const;
+    [[nodiscard]] std::size_t getPeakBytes() const;
+    [[nodiscard]] std::pmr::polymorphic_allocator<std::byte> getAllocator();
+
+    // Operator overloads
+    FrameArena& operator=(const FrameArena& other) = delete;
+
+    // Methods
+    static void beginFrame();
+    void reset();
+
+    /**
+     * Build an object in the arena.<br>
+     * Its destructor is never called, so only trivially destructible types are accepted.
+     *
+     * @param args The arguments forwarded to the constructor
+     *
+     * @return The object, valid until the next reset()
+     */
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never calls destructors.");
+        return new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @return An empty vector allocating from the arena, valid until the next reset()
+     */
+    template<typename T>
+    FrameVector<T> makeVector()
+    {
+        return FrameVector<T>(this);
+    }
+
+protected:
+    // Memory resource interface
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    /**
+    * A heap block owned by the arena.
+    */
+    struct Block
+    {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    /**
+    * The main block, where allocations are bumped.
+    */
+    Block _block;
+
+    /**
+    * The offset of the next free byte in the main block.
+    */
+    std::size_t _offset = 0;
+
+    /**
+    * The blocks allocated when the main block was full, freed by the next reset().
+    */
+    std::vector<Block> _overflowBlocks;
+
+    /**
+    * The number of bytes handed out since the last reset().
+    */
+    std::size_t _usedBytes = 0;
+
+    /**
+    * The highest number of bytes handed out during a single frame.
+    */
+    std::size_t _peakBytes = 0;
+
+    /**
+    * The frame the arena was last reset for by getThreadArena().
+    */
+    std::uint64_t _frame = 0;
+
+    /**
+    * The current frame, moved forward by beginFrame().
+    */
+    static std::atomic<std::uint64_t> _currentFrame;
+
+    // Private methods
+    static Block _allocateBlock(std::size_t size);
+    static void _freeBlock(const Block& block);
+};
+
+#endif //FRAME_ARENA_HPP
@@ -0,0 +1,68 @@
+#ifndef SIMULATION_CLOCK_HPP
+#define SIMULATION_CLOCK_HPP
+
+#include <cstdint>
+#include <SimulationDefines.hpp>
+
+/**
+ * The clock of the simulation, advanced in fixed steps.<br>
+ * Real time is scaled and accumulated, then consumed SIMULATION_TIMESTEP at a time: every update sees the same step
+ * whatever the frame rate, so a run only depends on its inputs. The clock can be paused, stepped one step at a time
+ * while paused, and driven by a simulated time to run faster than real time.
+ */
+class SimulationClock
+{
+public:
+    // Constructors
+    explicit SimulationClock(float timestep = SIMULATION_TIMESTEP);
+
+    // Getters
+    [[nodiscard]] float getTimestep() const;
+    [[nodiscard]] float getTimeScale() const;
+    [[nodiscard]] double getTime() const;
+    [[nodiscard]] std::uint64_t getStepCount() const;
+    [[nodiscard]] float getInterpolation() const;
+    [[nodiscard]] bool isPaused() const;
+
+    // Setters
+    SimulationClock& setTimeScale(float timeScale);
+    SimulationClock& setPaused(bool paused);
+
+    // Methods
+    unsigned int advance(double realDeltaTime);
+    void requestStep();
+    void reset();
+
+private:
+    /**
+    * The seconds simulated by each step.
+    */
+    float _timestep;
+
+    /**
+    * The factor applied to real time, 1 for real time, 0 to stop time without pausing.
+    */
+    float _timeScale;
+
+    /**
+    * Whether the clock only advances by the steps requested with requestStep().
+    */
+    bool _paused;
+
+    /**
+    * The number of steps requested with requestStep() and not yet run.
+    */
+    unsigned int _requestedSteps;
+
+    /**
+    * The scaled time in seconds not yet consumed by a step, always less than a step.
+    */
+    double _accumulator;
+
+    /**
+    * The number of steps run since the creation or the last reset of the clock.
+    */
+    std::uint64_t _stepCount;
+};
+
+#endif //SIMULATION_CLOCK_HPP
@@ -0,0 +1,123 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <FrameArena.hpp>
+#include <vector>
+
+/**
+ * Hierarchical timer wheel: timers are due at a tick and fire when the wheel is advanced past it.<br>
+ * Each level is a ring of SLOT_COUNT slots, a slot of a level spanning a whole ring of the level below. A timer is put
+ * in the slot of the highest digit its tick does not share with the current tick, and moved down one level when the
+ * wheel reaches that slot, so scheduling, cancelling and firing a timer each cost constant time whatever the number of
+ * timers. Timers further than the top level are kept aside and looked at again each time the top level wraps.<br>
+ * The timers live in a pool linked by index: once reserved, the wheel does not allocate.
+ */
+class TimerWheel
+{
+public:
+    /**
+    * The handle of no timer.
+    */
+    static constexpr std::uint32_t NO_TIMER = UINT32_MAX;
+
+    /**
+    * The bits of the tick indexing the slots of each level.
+    */
+    static constexpr unsigned int SLOT_BITS = 6;
+
+    /**
+    * The number of slots of each level.
+    */
+    static constexpr std::size_t SLOT_COUNT = std::size_t{1} << SLOT_BITS;
+
+    /**
+    * The number of levels, covering 2^24 ticks ahead of the current tick.
+    */
+    static constexpr std::size_t LEVEL_COUNT = 4;
+
+    // Constructors
+    TimerWheel();
+
+    // Getters
+    [[nodiscard]] std::uint64_t getTick() const;
+    [[nodiscard]] std::size_t getSize() const;
+
+    // Methods
+    void reserve(std::size_t timerCount);
+    std::uint32_t schedule(std::uint64_t tick, std::uint32_t payload);
+    void cancel(std::uint32_t timer);
+    void advance(std::uint64_t tick, FrameVector<std::uint32_t>& payloads);
+    void clear();
+
+private:
+    /**
+    * A scheduled timer, or a free one in the pool.
+    */
+    struct Timer
+    {
+        /**
+        * The tick the timer fires at.
+        */
+        std::uint64_t tick;
+
+        /**
+        * The value given back when the timer fires.
+        */
+        std::uint32_t payload;
+
+        /**
+        * The list holding the timer (NO_TIMER if the timer is free).
+        */
+        std::uint32_t list;
+
+        /**
+        * The previous timer of the list (NO_TIMER for the first one).
+        */
+        std::uint32_t previous;
+
+        /**
+        * The next timer of the list, or of the free timers.
+        */
+        std::uint32_t next;
+    };
+
+    /**
+    * The index of the list of the timers beyond the top level.
+    */
+    static constexpr std::uint32_t OVERFLOW_LIST = LEVEL_COUNT * SLOT_COUNT;
+
+    /**
+    * The last tick reached.
+    */
+    std::uint64_t _tick;
+
+    /**
+    * The number of scheduled timers.
+    */
+    std::size_t _size;
+
+    /**
+    * The pool of timers, scheduled or free.
+    */
+    std::vector<Timer> _timers;
+
+    /**
+    * The first free timer of the pool (NO_TIMER if every timer is scheduled).
+    */
+    std::uint32_t _firstFree;
+
+    /**
+    * The first timer of each slot, level after level, then of the overflow list.
+    */
+    std::array<std::uint32_t, OVERFLOW_LIST + 1> _lists;
+
+    // Private methods
+    void _insert(std::uint32_t timer);
+    void _unlink(std::uint32_t timer);
+    void _cascade(std::uint32_t list);
+};
+
+#endif //TIMER_WHEEL_HPP
@@ -0,0 +1,294 @@
+#include "AnimationClip.hpp"
+
+/**
+ * @return The rotation between from and to, along the shortest arc
+ */
+static Quaternion interpolate(const Quaternion& from, const Quaternion& to, const float factor)
+{
+    return Quaternion::slerp(from, to, factor);
+}
+
+/**
+ * @return The vector between from and to
+ */
+static Vector4 interpolate(const Vector4& from, const Vector4& to, const float factor)
+{
+    return from + (to - from) * factor;
+}
+
+/**
+ * Find the first key strictly after a given time.<br>
+ * The hint (the result of the previous search) is checked first, then its successor, and only then are the keys
+ * binary searched: monotonic playback is amortized O(1), seeking is O(log n).
+ *
+ * @param keys The keys, sorted by time
+ * @param time The time in seconds
+ * @param hint The result of the previous search, updated with the new result (nullptr if none)
+ *
+ * @return The index of the first key after time (the number of keys if there is none)
+ */
+template<typename Key>
+static std::size_t findNextKey(const std::vector<Key>& keys, const float time, std::uint32_t* hint)
+{
+    const auto isNextKey = [&keys, time](const std::size_t index)
+    {
+        return index <= keys.size()
+               && (index == 0 || keys[index - 1].time <= time)
+               && (index == keys.size() || keys[index].time > time);
+    };
+
+    std::size_t next;
+    if (hint && isNextKey(*hint))
+    {
+        next = *hint;
+    }
+    else if (hint && isNextKey(*hint + 1))
+    {
+        next = *hint + 1;
+    }
+    else
+    {
+        next = std::ranges::upper_bound(keys, time, {}, &Key::time) - keys.begin();
+    }
+    if (hint)
+    {
+        *hint = static_cast<std::uint32_t>(next);
+    }
+    return next;
+}
+
+/**
+ * Compute the value of a non-empty track.<br>
+ * Before the first key and after the last one, the value of the nearest key is held.
+ *
+ * @param track The track to sample
+ * @param time The time in seconds
+ * @param hint The cursor of the track (nullptr if none)
+ *
+ * @return The value of the track at the given time
+ */
+template<typename Key>
+static auto sampleTrack(const AnimationTrack<Key>& track, const float time, std::uint32_t* hint)
+{
+    const std::vector<Key>& keys = track.keys;
+    const std::size_t next = findNextKey(keys, time, hint);
+
+    if (next == 0)
+    {
+        return keys.front().value;
+    }
+    if (next == keys.size())
+    {
+        return keys.back().value;
+    }
+
+    const Key& previousKey = keys[next - 1];
+    if (track.interpolation == STEP_INTERPOLATION)
+    {
+        return previousKey.value;
+    }
+    const Key& nextKey = keys[next];
+    const float factor = std::clamp((time - previousKey.time) / (nextKey.time - previousKey.time), 0.0f, 1.0f);
+    if (track.interpolation == CURVE_INTERPOLATION && track.curve != nullptr)
+    {
+        return interpolate(previousKey.value, nextKey.value, track.curve->evaluate(factor));
+    }
+    return interpolate(previousKey.value, nextKey.value, factor);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create an empty clip.
+ *
+ * @param duration The duration of the clip in seconds
+ */
+AnimationClip::AnimationClip(const float duration) : _duration(duration)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The duration of the clip in seconds
+ */
+float AnimationClip::getDuration() const
+{
+    return _duration;
+}
+
+/**
+ * @return The number of tracks of the clip, all channels included
+ */
+std::size_t AnimationClip::getTrackCount() const
+{
+    return _rotationTracks.size() + _translationTracks.size() + _scaleTracks.size();
+}
+
+/**
+ * @return The rotation tracks of the clip
+ */
+const std::vector<RotationTrack>& AnimationClip::getRotationTracks() const
+{
+    return _rotationTracks;
+}
+
+/**
+ * @return The translation tracks of the clip
+ */
+const std::vector<VectorTrack>& AnimationClip::getTranslationTracks() const
+{
+    return _translationTracks;
+}
+
+/**
+ * @return The scale tracks of the clip
+ */
+const std::vector<VectorTrack>& AnimationClip::getScaleTracks() const
+{
+    return _scaleTracks;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Set the duration of the clip.
+ *
+ * @param duration The new duration in seconds
+ *
+ * @return itself
+ */
+AnimationClip& AnimationClip::setDuration(const float duration)
+{
+    _duration = duration;
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Add an empty rotation track.<br>
+ * The returned reference is valid until the next rotation track is added.
+ *
+ * @param joint The index of the animated joint
+ * @param interpolation How the rotation is computed between two keys
+ *
+ * @return The new track
+ */
+RotationTrack& AnimationClip::addRotationTrack(const std::size_t joint, const InterpolationMode interpolation)
+{
+    return _rotationTracks.emplace_back(RotationTrack{joint, interpolation, {}});
+}
+
+/**
+ * Add an empty translation track.<br>
+ * The returned reference is valid until the next translation track is added.
+ *
+ * @param joint The index of the animated joint
+ * @param interpolation How the translation is computed between two keys
+ *
+ * @return The new track
+ */
+VectorTrack& AnimationClip::addTranslationTrack(const std::size_t joint, const InterpolationMode interpolation)
+{
+    return _translationTracks.emplace_back(VectorTrack{joint, interpolation, {}});
+}
+
+/**
+ * Add an empty scale track.<br>
+ * The returned reference is valid until the next scale track is added.
+ *
+ * @param joint The index of the animated joint
+ * @param interpolation How the scale is computed between two keys
+ *
+ * @return The new track
+ */
+VectorTrack& AnimationClip::addScaleTrack(const std::size_t joint, const InterpolationMode interpolation)
+{
+    return _scaleTracks.emplace_back(VectorTrack{joint, interpolation, {}});
+}
+
+/**
+ * @return Whether a rotation track animates the joint
+ */
+bool AnimationClip::hasRotationTrack(const std::size_t joint) const
+{
+    return std::ranges::any_of(_rotationTracks, [joint](const RotationTrack& track)
+    {
+        return track.joint == joint;
+    });
+}
+
+/**
+ * @return Whether a translation track animates the joint
+ */
+bool AnimationClip::hasTranslationTrack(const std::size_t joint) const
+{
+    return std::ranges::any_of(_translationTracks, [joint](const VectorTrack& track)
+    {
+        return track.joint == joint;
+    });
+}
+
+/**
+ * Evaluate every track at a given time.<br>
+ * The pose is reset first, so only the channels animated by the clip are set.
+ *
+ * @param time The time in seconds, between 0 and the duration of the clip
+ * @param pose The pose to fill, with at least as many joints as the clip animates
+ * @param cursor The playback position of the caller, sized on first use (nullptr to always binary search)
+ */
+void AnimationClip::sample(const float time, Pose& pose, ClipCursor* cursor) const
+{
+    std::uint32_t* hints = nullptr;
+    if (cursor)
+    {
+        if (cursor->nextKeys.size() != getTrackCount())
+        {
+            cursor->nextKeys.assign(getTrackCount(), 0);
+        }
+        hints = cursor->nextKeys.data();
+    }
+    // Each track owns one hint, in the order rotations, translations, scales
+    const auto nextHint = [&hints]
+    {
+        return hints ? hints++ : nullptr;
+    };
+
+    pose.reset();
+    for (const RotationTrack& track: _rotationTracks)
+    {
+        std::uint32_t* hint = nextHint();
+        if (!track.keys.empty())
+        {
+            pose[track.joint].rotation = sampleTrack(track, time, hint);
+            pose[track.joint].channels |= ROTATION_CHANNEL;
+        }
+    }
+    for (const VectorTrack& track: _translationTracks)
+    {
+        std::uint32_t* hint = nextHint();
+        if (!track.keys.empty())
+        {
+            pose[track.joint].translation = sampleTrack(track, time, hint);
+            pose[track.joint].channels |= TRANSLATION_CHANNEL;
+        }
+    }
+    for (const VectorTrack& track: _scaleTracks)
+    {
+        std::uint32_t* hint = nextHint();
+        if (!track.keys.empty())
+        {
+            pose[track.joint].scale = sampleTrack(track, time, hint);
+            pose[track.joint].channels |= SCALE_CHANNEL;
+        }
+    }
+}
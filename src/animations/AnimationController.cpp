@@ -0,0 +1,273 @@
+#include "AnimationController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a controller and play the initial state at once.
+ *
+ * @param stateMachine The shared graph to play
+ * @param player The player of the character, which must outlive the controller
+ * @param initialState The state to start in
+ *
+ * @throw std::out_of_range If the initial state does not exist
+ */
+AnimationController::AnimationController(std::shared_ptr<const AnimationStateMachine> stateMachine,
+                                         AnimationPlayer* player,
+                                         const std::size_t initialState)
+    : _stateMachine(std::move(stateMachine)),
+      _player(player),
+      _state(initialState),
+      _stateTime(0.0f),
+      _nextExitTime(0.0f)
+{
+    _parameters.reserve(_stateMachine->getParameterCount());
+    for (std::size_t parameter = 0; parameter < _stateMachine->getParameterCount(); ++parameter)
+    {
+        _parameters.push_back(_stateMachine->getParameterDefault(parameter));
+    }
+    _enter(initialState, 0.0f);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The graph played by the controller
+ */
+const std::shared_ptr<const AnimationStateMachine>& AnimationController::getStateMachine() const
+{
+    return _stateMachine;
+}
+
+/**
+ * @return The player of the character
+ */
+AnimationPlayer* AnimationController::getPlayer() const
+{
+    return _player;
+}
+
+/**
+ * @return The index of the current state
+ */
+std::size_t AnimationController::getState() const
+{
+    return _state;
+}
+
+/**
+ * @return The time in seconds spent in the current state
+ */
+float AnimationController::getStateTime() const
+{
+    return _stateTime;
+}
+
+/**
+ * @param parameter The index of the parameter
+ *
+ * @return The value of the parameter
+ *
+ * @throw std::out_of_range If the parameter does not exist
+ */
+float AnimationController::getParameter(const std::size_t parameter) const
+{
+    return _parameters.at(parameter);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Change a parameter, firing the first transition without event its new value allows.
+ *
+ * @param parameter The index of the parameter, ignored if it does not exist
+ * @param value The new value
+ *
+ * @return itself
+ */
+AnimationController& AnimationController::setParameter(const std::size_t parameter, const float value)
+{
+    if (parameter < _parameters.size() && _parameters[parameter] != value)
+    {
+        _parameters[parameter] = value;
+        _checkTransitions();
+    }
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Send an event, firing the first transition waiting for it that is able to fire.<br>
+ * An event firing no transition is dropped: triggering the event of the current state again does not restart it.
+ *
+ * @param event The index of the event
+ *
+ * @return Whether a transition fired
+ */
+bool AnimationController::trigger(const std::size_t event)
+{
+    if (event >= _stateMachine->getEventCount())
+    {
+        return false;
+    }
+    const AnimationTransition* transition = _findTransition(event);
+    if (transition == nullptr)
+    {
+        return false;
+    }
+    _enter(transition->to, transition->blendDuration);
+    return true;
+}
+
+/**
+ * Move the current state forward, firing the transitions without event once their exit time is reached.<br>
+ * The pose itself is evaluated by the player, which must be updated with the same time.
+ *
+ * @param deltaTime The time in seconds elapsed since the previous update
+ */
+void AnimationController::update(const float deltaTime)
+{
+    _stateTime += std::fabs(deltaTime * _player->getSpeed());
+    if (_stateTime >= _nextExitTime)
+    {
+        _checkTransitions();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return Whether every condition of a transition holds
+ */
+bool AnimationController::_conditionsHold(const AnimationTransition& transition) const
+{
+    return std::ranges::all_of(transition.conditions, [this](const TransitionCondition& condition)
+    {
+        const float parameter = _parameters[condition.parameter];
+        switch (condition.comparison)
+        {
+            case GREATER_COMPARISON:
+                return parameter > condition.value;
+            case LESS_COMPARISON:
+                return parameter < condition.value;
+            case EQUAL_COMPARISON:
+                return parameter == condition.value;
+            case NOT_EQUAL_COMPARISON:
+                return parameter != condition.value;
+        }
+        return false;
+    });
+}
+
+/**
+ * @return The state time in seconds from which a transition may leave the current state (0 if it has no exit time)
+ */
+float AnimationController::_getExitTime(const AnimationTransition& transition) const
+{
+    if (transition.exitTime < 0.0f)
+    {
+        return 0.0f;
+    }
+    const std::shared_ptr<const AnimationSource>& clip = _stateMachine->getState(_state).clip;
+    return clip == nullptr ? 0.0f : transition.exitTime * clip->getDuration();
+}
+
+/**
+ * @return Whether a transition of the current state can fire now on an event (NO_EVENT for a check without event)
+ */
+bool AnimationController::_canFire(const AnimationTransition& transition, const std::size_t event) const
+{
+    return transition.event == event && _stateTime >= _getExitTime(transition) && _conditionsHold(transition);
+}
+
+/**
+ * Find the transition leaving the current state on an event: the transitions of the state come first, in the order
+ * they were added, then the transitions from any state.
+ *
+ * @param event The event (NO_EVENT for a check without event)
+ *
+ * @return The first transition able to fire (nullptr if none)
+ */
+const AnimationTransition* AnimationController::_findTransition(const std::size_t event) const
+{
+    for (const AnimationTransition& transition: _stateMachine->getState(_state).transitions)
+    {
+        if (_canFire(transition, event))
+        {
+            return &transition;
+        }
+    }
+    for (const AnimationTransition& transition: _stateMachine->getAnyStateTransitions())
+    {
+        if (transition.to != _state && _canFire(transition, event))
+        {
+            return &transition;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Enter a state, crossfading the player to its clip.<br>
+ * The transitions of the new state are checked by the next update, so entering a state fires at most one transition.
+ *
+ * @param state The state to enter
+ * @param blendDuration The duration of the crossfade in seconds
+ *
+ * @throw std::out_of_range If the state does not exist
+ */
+void AnimationController::_enter(const std::size_t state, const float blendDuration)
+{
+    const AnimationState& entered = _stateMachine->getState(state);
+    _state = state;
+    _stateTime = 0.0f;
+    _nextExitTime = 0.0f;
+    _player->crossFade(entered.clip, blendDuration);
+}
+
+/**
+ * Fire the first transition without event able to fire, or else find when the next one may.
+ */
+void AnimationController::_checkTransitions()
+{
+    if (const AnimationTransition* transition = _findTransition(AnimationStateMachine::NO_EVENT))
+    {
+        _enter(transition->to, transition->blendDuration);
+        return;
+    }
+
+    // Only the exit times can change without an event or a parameter change, so nothing is checked until the next one
+    _nextExitTime = std::numeric_limits<float>::infinity();
+    const auto schedule = [this](const AnimationTransition& transition)
+    {
+        if (transition.event == AnimationStateMachine::NO_EVENT && _conditionsHold(transition))
+        {
+            _nextExitTime = std::min(_nextExitTime, _getExitTime(transition));
+        }
+    };
+    for (const AnimationTransition& transition: _stateMachine->getState(_state).transitions)
+    {
+        schedule(transition);
+    }
+    for (const AnimationTransition& transition: _stateMachine->getAnyStateTransitions())
+    {
+        if (transition.to != _state)
+        {
+            schedule(transition);
+        }
+    }
+}
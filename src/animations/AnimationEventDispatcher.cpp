@@ -0,0 +1,518 @@
+#include "AnimationEventDispatcher.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+/**
+ * The fraction of a tick a time may be off and still be counted in it, so that rounding errors do not delay events
+ * falling exactly on a tick.
+ */
+static constexpr double TICK_TOLERANCE = 1e-6;
+
+/**
+ * The events of a clip in the order a player meets them along its playback cycle.<br>
+ * A step is an event at a position of the cycle: a looping clip has a step per event, a ping-pong has a step per event
+ * on the way there, then a step per event on the way back. The positions of the steps grow with their index.
+ */
+struct EventCycle
+{
+    /**
+    * The events of the clip, sorted by time.
+    */
+    std::span<const AnimationEvent> events;
+
+    /**
+    * The duration of the clip in seconds.
+    */
+    double duration;
+
+    /**
+    * The duration of the playback cycle in seconds, twice the one of the clip in ping-pong.
+    */
+    double length;
+
+    /**
+    * The number of steps.
+    */
+    std::size_t stepCount;
+
+    /**
+    * The number of seconds of the cycle the player moves through per simulated second.
+    */
+    double speed;
+
+    /**
+    * Whether the player moves backward through the cycle.
+    */
+    bool backward;
+
+    /**
+    * Whether the player starts the cycle again after its end.
+    */
+    bool wraps;
+
+    /**
+    * Whether the player plays in ping-pong.
+    */
+    bool pingPong;
+};
+
+/**
+ * Describe the cycle of the base clip of a player.
+ *
+ * @param player The player
+ * @param cycle The cycle
+ *
+ * @return Whether the player moves through a clip with events
+ */
+static bool getCycle(const AnimationPlayer& player, EventCycle& cycle)
+{
+    const std::shared_ptr<const AnimationSource>& clip = player.getClip();
+    if (clip == nullptr || clip->getEvents().empty() || clip->getDuration() <= 0.0f || player.getSpeed() == 0.0f)
+    {
+        return false;
+    }
+    cycle.events = clip->getEvents();
+    cycle.duration = clip->getDuration();
+    cycle.pingPong = player.getPlaybackMode() == PING_PONG_PLAYBACK;
+    cycle.wraps = player.getPlaybackMode() != ONCE_PLAYBACK;
+    cycle.length = cycle.pingPong ? 2.0 * cycle.duration : cycle.duration;
+    cycle.stepCount = cycle.pingPong ? 2 * cycle.events.size() : cycle.events.size();
+    cycle.speed = std::fabs(player.getSpeed());
+    cycle.backward = player.getSpeed() < 0.0f;
+    return true;
+}
+
+/**
+ * @return The index in the clip of the event of a step
+ */
+static std::size_t getStepEvent(const EventCycle& cycle, const std::size_t step)
+{
+    return step < cycle.events.size() ? step : cycle.stepCount - 1 - step;
+}
+
+/**
+ * @return The position in the cycle in seconds of a step
+ */
+static double getStepPosition(const EventCycle& cycle, const std::size_t step)
+{
+    const double time = std::clamp(static_cast<double>(cycle.events[getStepEvent(cycle, step)].time),
+                                   0.0,
+                                   cycle.duration);
+    return step < cycle.events.size() ? time : cycle.length - time;
+}
+
+/**
+ * Find the first step a player meets from a position of its cycle, a step at the position included.
+ *
+ * @param cycle The cycle
+ * @param position The position in seconds
+ * @param step The step found
+ * @param distance The seconds of the cycle between the position and the step
+ *
+ * @return Whether the player meets a step (not at the end of a clip played once)
+ */
+static bool findStep(const EventCycle& cycle, const double position, std::size_t& step, double& distance)
+{
+    // Binary search of the first step after the position, or at the position when moving forward
+    std::size_t low = 0;
+    std::size_t high = cycle.stepCount;
+    while (low < high)
+    {
+        const std::size_t middle = (low + high) / 2;
+        const double middlePosition = getStepPosition(cycle, middle);
+        if (cycle.backward ? middlePosition <= position : middlePosition < position)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    if (!cycle.backward)
+    {
+        if (low == cycle.stepCount && !cycle.wraps)
+        {
+            return false;
+        }
+        step = low == cycle.stepCount ? 0 : low;
+        distance = getStepPosition(cycle, step) - position + (low == cycle.stepCount ? cycle.length : 0.0);
+        return true;
+    }
+    if (low == 0 && !cycle.wraps)
+    {
+        return false;
+    }
+    step = low == 0 ? cycle.stepCount - 1 : low - 1;
+    distance = position - getStepPosition(cycle, step) + (low == 0 ? cycle.length : 0.0);
+    return true;
+}
+
+/**
+ * Move to the step a player meets after another one.
+ *
+ * @param cycle The cycle
+ * @param step The step reached, replaced by the next one
+ * @param distance The seconds of the cycle between the two steps
+ *
+ * @return Whether the player meets another step (not at the end of a clip played once)
+ */
+static bool nextStep(const EventCycle& cycle, std::size_t& step, double& distance)
+{
+    distance = 0.0;
+    bool turningAround;
+    do
+    {
+        const std::size_t previous = step;
+        const bool last = cycle.backward ? step == 0 : step + 1 == cycle.stepCount;
+        if (last && !cycle.wraps)
+        {
+            return false;
+        }
+        double gap;
+        if (cycle.backward)
+        {
+            step = last ? cycle.stepCount - 1 : step - 1;
+            gap = getStepPosition(cycle, previous) - getStepPosition(cycle, step);
+        }
+        else
+        {
+            step = last ? 0 : step + 1;
+            gap = getStepPosition(cycle, step) - getStepPosition(cycle, previous);
+        }
+        distance += last ? gap + cycle.length : gap;
+        // A ping-pong turning around on an event meets it once, not on both ways
+        turningAround = cycle.pingPong
+                        && step != previous
+                        && getStepEvent(cycle, step) == getStepEvent(cycle, previous)
+                        && (last ? gap + cycle.length : gap) == 0.0;
+    }
+    while (turningAround);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a dispatcher at time 0, watching no player.
+ *
+ * @param tickDuration The seconds per tick of the timer wheel: an event is reported by the first update reaching the
+ * tick it falls in, so it should not be longer than the step of the simulation
+ */
+AnimationEventDispatcher::AnimationEventDispatcher(const float tickDuration) : _time(0.0),
+                                                                             _tickDuration(tickDuration),
+                                                                             _outdatedCount(0),
+                                                                             _playerCount(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Stop watching the players.
+ */
+AnimationEventDispatcher::~AnimationEventDispatcher()
+{
+    clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The simulated time in seconds
+ */
+double AnimationEventDispatcher::getTime() const
+{
+    return _time;
+}
+
+/**
+ * @return The seconds per tick of the timer wheel
+ */
+float AnimationEventDispatcher::getTickDuration() const
+{
+    return _tickDuration;
+}
+
+/**
+ * @return The number of watched players
+ */
+std::size_t AnimationEventDispatcher::getPlayerCount() const
+{
+    return _playerCount;
+}
+
+/**
+ * @return The number of players waiting for their next event
+ */
+std::size_t AnimationEventDispatcher::getScheduledCount() const
+{
+    return _wheel.getSize();
+}
+
+/**
+ * @return The events reached by the last update, in time order
+ */
+std::span<const AnimationNotification> AnimationEventDispatcher::getNotifications() const
+{
+    return _notifications;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Set the receiver of the events, called once by each update reaching any event.
+ *
+ * @param listener The new listener (empty for none)
+ *
+ * @return itself
+ */
+AnimationEventDispatcher& AnimationEventDispatcher::setListener(Listener listener)
+{
+    _listener = std::move(listener);
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reserve room for a number of players, so that watching them and dispatching an event per player and per update do
+ * not allocate (the events of an update are gathered in the frame arena of the calling thread).
+ *
+ * @param playerCount The number of players
+ */
+void AnimationEventDispatcher::reserve(const std::size_t playerCount)
+{
+    _players.reserve(playerCount);
+    _freeSlots.reserve(playerCount);
+    _outdated.reserve(playerCount);
+    _notifications.reserve(playerCount);
+    _wheel.reserve(playerCount);
+}
+
+/**
+ * Report the events of a player from the next update on, the player leaving the dispatcher watching it if any.
+ *
+ * @param player The player, which must not move until it is unwatched (nothing happens for nullptr)
+ */
+void AnimationEventDispatcher::watch(AnimationPlayer* player)
+{
+    if (player == nullptr || player->_eventDispatcher == this)
+    {
+        return;
+    }
+    if (player->_eventDispatcher != nullptr)
+    {
+        player->_eventDispatcher->unwatch(player);
+    }
+
+    std::uint32_t slot;
+    if (_freeSlots.empty())
+    {
+        slot = static_cast<std::uint32_t>(_players.size());
+        _players.emplace_back();
+    }
+    else
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    _players[slot] = {player, TimerWheel::NO_TIMER, 0, 0.0};
+    ++_playerCount;
+    player->_eventDispatcher = this;
+    player->_eventSlot = slot;
+    player->_eventsOutdated = false;
+
+    // Every player may be outdated once before the next update, from any thread: the queue never grows there
+    _outdated.resize(std::max(_outdated.size(), _outdatedCount.load(std::memory_order_relaxed) + _playerCount));
+    player->_invalidateEvents();
+}
+
+/**
+ * Stop reporting the events of a player.
+ *
+ * @param player The player (nothing happens if it is not watched by this dispatcher)
+ */
+void AnimationEventDispatcher::unwatch(AnimationPlayer* player)
+{
+    if (player == nullptr || player->_eventDispatcher != this)
+    {
+        return;
+    }
+    const std::uint32_t slot = player->_eventSlot;
+    _wheel.cancel(_players[slot].timer);
+    _players[slot] = {nullptr, TimerWheel::NO_TIMER, 0, 0.0};
+    _freeSlots.push_back(slot);
+    --_playerCount;
+    player->_eventDispatcher = nullptr;
+    player->_eventsOutdated = false;
+}
+
+/**
+ * Move the time forward and report the events reached, once the players were updated by the same time.<br>
+ * Must not be called while players are updated.
+ *
+ * @param deltaTime The time in seconds elapsed since the previous update
+ */
+void AnimationEventDispatcher::update(const float deltaTime)
+{
+    _time += deltaTime;
+    _notifications.clear();
+
+    // Sorting makes the schedule, so the order of the events, independent of the threads that changed the players
+    const std::size_t outdatedCount = _outdatedCount.exchange(0, std::memory_order_relaxed);
+    std::sort(_outdated.begin(), _outdated.begin() + static_cast<std::ptrdiff_t>(outdatedCount));
+    for (std::size_t index = 0; index < outdatedCount; ++index)
+    {
+        const std::uint32_t slot = _outdated[index];
+        if (_players[slot].player != nullptr)
+        {
+            _players[slot].player->_eventsOutdated = false;
+            _schedule(slot);
+        }
+    }
+
+    // The fired slots and the events reached only live during the update, they are taken from the frame arena
+    FrameArena& arena = FrameArena::getThreadArena();
+    FrameVector<std::uint32_t> fired = arena.makeVector<std::uint32_t>();
+    fired.reserve(_playerCount);
+    _wheel.advance(static_cast<std::uint64_t>(std::max(0.0, std::floor(_time / _tickDuration + TICK_TOLERANCE))),
+                   fired);
+    FrameVector<ReachedEvent> reached = arena.makeVector<ReachedEvent>();
+    reached.reserve(fired.size());
+    for (const std::uint32_t slot: fired)
+    {
+        _reach(slot, reached);
+    }
+
+    if (reached.empty())
+    {
+        return;
+    }
+    // A stable sort would allocate its buffer on every update
+    std::ranges::sort(reached, [](const ReachedEvent& left, const ReachedEvent& right)
+    {
+        return left.notification.time != right.notification.time
+                   ? left.notification.time < right.notification.time
+                   : left.sequence < right.sequence;
+    });
+    for (const ReachedEvent& event: reached)
+    {
+        _notifications.push_back(event.notification);
+    }
+    if (_listener)
+    {
+        _listener(_notifications);
+    }
+}
+
+/**
+ * Stop watching every player, dropping their scheduled events. The time and the listener are kept.
+ */
+void AnimationEventDispatcher::clear()
+{
+    for (const WatchedPlayer& watched: _players)
+    {
+        if (watched.player != nullptr)
+        {
+            watched.player->_eventDispatcher = nullptr;
+            watched.player->_eventsOutdated = false;
+        }
+    }
+    _players.clear();
+    _freeSlots.clear();
+    _outdatedCount.store(0, std::memory_order_relaxed);
+    _wheel.clear();
+    _notifications.clear();
+    _playerCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Queue a player whose timeline changed, called by the player from any thread at most once per update.
+ *
+ * @param slot The slot of the player
+ */
+void AnimationEventDispatcher::_invalidate(const std::uint32_t slot)
+{
+    _outdated[_outdatedCount.fetch_add(1, std::memory_order_relaxed)] = slot;
+}
+
+/**
+ * Schedule the next event of a player from the last change of its timeline, an event at the position it changed to
+ * included. The events reached since then fire with this update.
+ *
+ * @param slot The slot of the player
+ */
+void AnimationEventDispatcher::_schedule(const std::uint32_t slot)
+{
+    WatchedPlayer& watched = _players[slot];
+    const AnimationPlayer& player = *watched.player;
+    _wheel.cancel(watched.timer);
+    watched.timer = TimerWheel::NO_TIMER;
+    EventCycle cycle{};
+    double distance;
+    if (!getCycle(player, cycle) || !findStep(cycle, player._eventsPosition, watched.step, distance))
+    {
+        return;
+    }
+    watched.time = _time - player._eventsElapsed + distance / cycle.speed;
+    watched.timer = _wheel.schedule(_getTick(watched.time), slot);
+}
+
+/**
+ * Report the event a player reached, with the next ones falling in the ticks already reached, and schedule the
+ * following one.
+ *
+ * @param slot The slot of the player
+ * @param reached The events reached by the update, the ones of the player appended
+ */
+void AnimationEventDispatcher::_reach(const std::uint32_t slot, FrameVector<ReachedEvent>& reached)
+{
+    WatchedPlayer& watched = _players[slot];
+    watched.timer = TimerWheel::NO_TIMER;
+    EventCycle cycle{};
+    if (!getCycle(*watched.player, cycle))
+    {
+        return;
+    }
+    double distance;
+    do
+    {
+        const AnimationNotification notification = {
+            watched.time,
+            watched.player,
+            cycle.events[getStepEvent(cycle, watched.step)].id
+        };
+        reached.push_back({notification, reached.size()});
+        if (!nextStep(cycle, watched.step, distance))
+        {
+            return;
+        }
+        watched.time += distance / cycle.speed;
+    }
+    while (_getTick(watched.time) <= _wheel.getTick());
+    watched.timer = _wheel.schedule(_getTick(watched.time), slot);
+}
+
+/**
+ * @return The first tick at or after a simulated time, the one whose update reports an event at that time
+ */
+std::uint64_t AnimationEventDispatcher::_getTick(const double time) const
+{
+    return static_cast<std::uint64_t>(std::max(0.0, std::ceil(time / _tickDuration - TICK_TOLERANCE)));
+}
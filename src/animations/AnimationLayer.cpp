@@ -0,0 +1,300 @@
+#include "AnimationLayer.hpp"
+#include <AnimationDefines.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a stopped layer of full weight, overriding every joint.
+ *
+ * @param jointCount The number of joints of the animated skeleton
+ */
+AnimationLayer::AnimationLayer(const std::size_t jointCount) : _time(0.0f),
+                                                               _weight(1.0f),
+                                                               _blendMode(OVERRIDE_BLEND),
+                                                               _playbackMode(LOOP_PLAYBACK),
+                                                               _pose(jointCount)
+{
+    // Switching clips while playing must not allocate
+    _cursor.nextKeys.reserve(CLIP_CURSOR_RESERVED_TRACKS);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The clip being played (nullptr if stopped)
+ */
+const std::shared_ptr<const AnimationSource>& AnimationLayer::getClip() const
+{
+    return _clip;
+}
+
+/**
+ * @return The position in the clip in seconds
+ */
+float AnimationLayer::getTime() const
+{
+    if (_playbackMode == PING_PONG_PLAYBACK && _clip != nullptr && _time > _clip->getDuration())
+    {
+        return 2.0f * _clip->getDuration() - _time;
+    }
+    return _time;
+}
+
+/**
+ * @return The position in the playback cycle in seconds, which only differs from getTime() on the way back of a
+ * ping-pong
+ */
+float AnimationLayer::getCycleTime() const
+{
+    return _time;
+}
+
+/**
+ * @param deltaTime The time in seconds to move forward (negative to move backward)
+ *
+ * @return The position in the playback cycle in seconds the layer would reach by moving, without moving it
+ */
+float AnimationLayer::getCycleTimeAfter(const float deltaTime) const
+{
+    return _wrapTime(static_cast<double>(_time) + deltaTime);
+}
+
+/**
+ * @return The weight of the layer
+ */
+float AnimationLayer::getWeight() const
+{
+    return _weight;
+}
+
+/**
+ * @return How the layer is combined with the layers below it
+ */
+LayerBlendMode AnimationLayer::getBlendMode() const
+{
+    return _blendMode;
+}
+
+/**
+ * @return How the time moves through the clip
+ */
+PlaybackMode AnimationLayer::getPlaybackMode() const
+{
+    return _playbackMode;
+}
+
+/**
+ * @return The joints affected by the layer (nullptr for every joint)
+ */
+const std::shared_ptr<const JointMask>& AnimationLayer::getMask() const
+{
+    return _mask;
+}
+
+/**
+ * @return The pose sampled by the last advance
+ */
+Pose& AnimationLayer::getPose()
+{
+    return _pose;
+}
+
+/**
+ * @return The pose sampled by the last advance
+ */
+const Pose& AnimationLayer::getPose() const
+{
+    return _pose;
+}
+
+/**
+ * @return Whether a clip is being played
+ */
+bool AnimationLayer::isPlaying() const
+{
+    return _clip != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Move the layer to a time of its timeline, brought into the playback cycle: the pose at any time is known without
+ * playing the time before it.
+ *
+ * @param time The new time in seconds since the start of the clip, in double precision for long timelines
+ *
+ * @return itself
+ */
+AnimationLayer& AnimationLayer::setTime(const double time)
+{
+    _time = _wrapTime(time);
+    return *this;
+}
+
+/**
+ * Set how the time moves through the clip.<br>
+ * The current position in the clip is kept.
+ *
+ * @param playbackMode The new playback mode
+ *
+ * @return itself
+ */
+AnimationLayer& AnimationLayer::setPlaybackMode(const PlaybackMode playbackMode)
+{
+    const float time = getTime();
+    _playbackMode = playbackMode;
+    _time = _wrapTime(time);
+    return *this;
+}
+
+/**
+ * Set the weight of the layer.
+ *
+ * @param weight The new weight, 0 disabling the layer and 1 applying it fully
+ *
+ * @return itself
+ */
+AnimationLayer& AnimationLayer::setWeight(const float weight)
+{
+    _weight = weight;
+    return *this;
+}
+
+/**
+ * Set how the layer is combined with the layers below it.
+ *
+ * @param blendMode The new blend mode
+ *
+ * @return itself
+ */
+AnimationLayer& AnimationLayer::setBlendMode(const LayerBlendMode blendMode)
+{
+    _blendMode = blendMode;
+    return *this;
+}
+
+/**
+ * Restrict the layer to some joints.
+ *
+ * @param mask The shared per-joint weights (nullptr for every joint)
+ *
+ * @return itself
+ */
+AnimationLayer& AnimationLayer::setMask(std::shared_ptr<const JointMask> mask)
+{
+    _mask = std::move(mask);
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Start playing a clip, shared and not copied.
+ *
+ * @param clip The clip to play (nullptr to stop)
+ * @param startTime The position to start from in seconds
+ */
+void AnimationLayer::play(std::shared_ptr<const AnimationSource> clip, const float startTime)
+{
+    _clip = std::move(clip);
+    // Keep the capacity: the cursor is resized by the next sample without allocating
+    _cursor.nextKeys.clear();
+    setTime(startTime);
+}
+
+/**
+ * Stop playing, the pose is left as sampled by the last advance.
+ */
+void AnimationLayer::stop()
+{
+    _clip = nullptr;
+    _time = 0.0f;
+}
+
+/**
+ * Advance the layer and sample its clip.<br>
+ * A stopped layer resets its pose, setting no channel.
+ *
+ * @param deltaTime The time in seconds to move forward (negative to move backward)
+ */
+void AnimationLayer::advance(const float deltaTime)
+{
+    if (_clip == nullptr)
+    {
+        _pose.reset();
+        return;
+    }
+    _time = _wrapTime(_time + deltaTime);
+    _clip->sample(getTime(), _pose, &_cursor);
+}
+
+/**
+ * Move the layer forward without sampling its clip, the pose is left as sampled by the last advance.<br>
+ * Used for the characters nobody sees, whose animation must go on without being evaluated.
+ *
+ * @param deltaTime The time in seconds to move forward (negative to move backward)
+ */
+void AnimationLayer::skip(const float deltaTime)
+{
+    _time = _wrapTime(_time + deltaTime);
+}
+
+/**
+ * Combine the pose of the layer into a pose, according to its blend mode, weight and mask.
+ *
+ * @param pose The pose of the layers below this one
+ */
+void AnimationLayer::applyTo(Pose& pose) const
+{
+    if (_clip == nullptr || _weight <= 0.0f)
+    {
+        return;
+    }
+    if (_blendMode == ADDITIVE_BLEND)
+    {
+        pose.add(_pose, _weight, _mask.get());
+    }
+    else
+    {
+        pose.blend(_pose, _weight, _mask.get());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Bring a time into the playback cycle of the clip.
+ *
+ * @param time The time in seconds, possibly negative or beyond the end of the clip
+ *
+ * @return The time between 0 and the duration of the clip (twice the duration in ping-pong), unchanged if the clip has
+ * no duration
+ */
+float AnimationLayer::_wrapTime(const double time) const
+{
+    if (_clip == nullptr || _clip->getDuration() <= 0.0f)
+    {
+        return static_cast<float>(time);
+    }
+    const double duration = _clip->getDuration();
+    if (_playbackMode == ONCE_PLAYBACK)
+    {
+        return static_cast<float>(std::clamp(time, 0.0, duration));
+    }
+    const double cycle = _playbackMode == PING_PONG_PLAYBACK ? 2.0 * duration : duration;
+    const double wrapped = std::fmod(time, cycle);
+    return static_cast<float>(wrapped < 0.0 ? wrapped + cycle : wrapped);
+}
@@ -0,0 +1,554 @@
+#include "AnimationLibrary.hpp"
+#include <AnimationFileException.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * The first bytes of a library file.
+ */
+static constexpr char LIBRARY_MAGIC[4] = {'H', 'G', 'L', 'L'};
+
+/**
+ * The version of the library file format, increased on every incompatible change.
+ */
+static constexpr std::uint32_t LIBRARY_VERSION = 2;
+
+/**
+ * A value written in the byte order of the machine, read back differently by a machine of another byte order.
+ */
+static constexpr std::uint32_t LIBRARY_BYTE_ORDER = 0x01020304;
+
+/**
+ * The header at the start of a library file.
+ */
+struct LibraryHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t entryCount;
+    std::uint64_t tocOffset;        // The offset of the first LibraryEntry
+    std::uint64_t fileSize;         // The size of the whole file, to detect truncated files
+    unsigned char reserved[32];
+};
+
+/**
+ * An entry of the table of contents, the entries being sorted by name.
+ */
+struct LibraryEntry
+{
+    char name[AnimationLibrary::MAX_NAME_LENGTH + 1];    // Padded with zeros
+    std::uint32_t type;                                   // A LibraryEntryType
+    std::uint32_t reserved;
+    std::uint64_t offset;                                 // The offset of the data, a multiple of ENTRY_ALIGNMENT
+    std::uint64_t size;                                   // The size of the data in bytes
+};
+
+/**
+ * The header of the data of a CLIP_ENTRY, the offsets being relative to the start of the data.
+ */
+struct ClipEntryHeader
+{
+    std::uint32_t jointCount;
+    std::uint32_t frameCount;
+    float duration;
+    float frameRate;
+    std::uint64_t channelsOffset;    // jointCount PoseChannel flags
+    std::uint64_t samplesOffset;     // The pose table, aligned on ENTRY_ALIGNMENT
+    std::uint32_t eventCount;
+    std::uint32_t reserved;
+    std::uint64_t eventsOffset;      // eventCount AnimationEvent, sorted by time
+};
+
+/**
+ * The header of the data of a SKELETON_ENTRY, the offset being relative to the start of the data.
+ */
+struct SkeletonEntryHeader
+{
+    std::uint32_t jointCount;
+    std::uint32_t reserved;
+    std::uint64_t parentsOffset;     // jointCount int32 parent indices
+};
+
+static_assert(sizeof(LibraryHeader) == AnimationLibrary::ENTRY_ALIGNMENT);
+static_assert(sizeof(AnimationEvent) == 8, "AnimationEvent is written as is to libraries");
+static_assert(sizeof(LibraryEntry) == AnimationLibrary::ENTRY_ALIGNMENT);
+
+/**
+ * @return The smallest multiple of ENTRY_ALIGNMENT greater than or equal to offset
+ */
+static std::uint64_t alignOffset(const std::uint64_t offset)
+{
+    return (offset + AnimationLibrary::ENTRY_ALIGNMENT - 1) / AnimationLibrary::ENTRY_ALIGNMENT
+           * AnimationLibrary::ENTRY_ALIGNMENT;
+}
+
+/**
+ * Copy a structure out of the mapping, whatever the alignment of its offset.
+ */
+template<typename T>
+static T readStruct(const unsigned char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+/**
+ * Write the bytes of a structure (in the byte order of the machine).
+ */
+template<typename T>
+static void writeStruct(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * Write zeros up to an offset.
+ */
+static void writePadding(std::ofstream& file, const std::uint64_t offset)
+{
+    static constexpr char zeros[AnimationLibrary::ENTRY_ALIGNMENT] = {};
+    const auto position = static_cast<std::uint64_t>(file.tellp());
+    file.write(zeros, static_cast<std::streamsize>(offset - position));
+}
+
+/**
+ * @return The offset of the events in the data of a clip entry, after its header and its channels
+ */
+static std::uint64_t eventsOffset(const std::size_t jointCount)
+{
+    return (sizeof(ClipEntryHeader) + jointCount + alignof(AnimationEvent) - 1) / alignof(AnimationEvent)
+           * alignof(AnimationEvent);
+}
+
+/**
+ * @return The offset of the pose table in the data of a clip entry, after its events
+ */
+static std::uint64_t samplesOffset(const BakedClip& clip)
+{
+    return alignOffset(eventsOffset(clip.getJointCount()) + clip.getEvents().size() * sizeof(AnimationEvent));
+}
+
+/**
+ * @return The name of an entry, without its padding
+ */
+static std::string_view entryName(const LibraryEntry& entry)
+{
+    return {entry.name, strnlen(entry.name, sizeof(entry.name))};
+}
+
+/**
+ * An entry being written, with the data it references.
+ */
+struct PendingEntry
+{
+    LibraryEntry entry;
+    const BakedClip* clip;
+    std::span<const int> parents;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Take ownership of a mapping whose header has been checked.
+ *
+ * @param path The path of the mapped file
+ * @param data The first byte of the mapping
+ * @param size The size of the mapping in bytes
+ */
+AnimationLibrary::AnimationLibrary(std::string path, const unsigned char* data, const std::size_t size)
+    : _path(std::move(path)),
+      _data(data),
+      _size(size)
+{
+    const auto header = readStruct<LibraryHeader>(_data);
+    _entryCount = header.entryCount;
+    _tocOffset = header.tocOffset;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Unmap the file.<br>
+ * The clips returned by getClip() keep the library alive, so no view outlives the mapping.
+ */
+AnimationLibrary::~AnimationLibrary()
+{
+    munmap(const_cast<unsigned char*>(_data), _size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The path of the mapped file
+ */
+const std::string& AnimationLibrary::getPath() const
+{
+    return _path;
+}
+
+/**
+ * @return The size of the mapped file in bytes
+ */
+std::size_t AnimationLibrary::getByteSize() const
+{
+    return _size;
+}
+
+/**
+ * @return The number of clips and skeletons of the library
+ */
+std::size_t AnimationLibrary::getEntryCount() const
+{
+    return _entryCount;
+}
+
+/**
+ * @return The name of an entry, entries being sorted by name (empty if the index is out of range)
+ */
+std::string_view AnimationLibrary::getEntryName(const std::size_t index) const
+{
+    if (index >= _entryCount)
+    {
+        return {};
+    }
+    return entryName(*reinterpret_cast<const LibraryEntry*>(_data + _tocOffset + index * sizeof(LibraryEntry)));
+}
+
+/**
+ * @return The type of an entry (0 if the index is out of range)
+ */
+LibraryEntryType AnimationLibrary::getEntryType(const std::size_t index) const
+{
+    if (index >= _entryCount)
+    {
+        return static_cast<LibraryEntryType>(0);
+    }
+    return static_cast<LibraryEntryType>(
+        reinterpret_cast<const LibraryEntry*>(_data + _tocOffset + index * sizeof(LibraryEntry))->type);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Find a clip by name.<br>
+ * The returned clip views the pose table of the mapping: only its events are copied, and the pages of the pose table
+ * are only read from disk when the clip is sampled.
+ *
+ * @param name The name of the clip
+ *
+ * @return The clip, keeping the library alive (or nullptr if the library has no clip of this name)
+ *
+ * @throw AnimationFileException If the entry of the clip is corrupt
+ */
+std::shared_ptr<const BakedClip> AnimationLibrary::getClip(const std::string_view name) const
+{
+    const std::span<const unsigned char> data = _findEntry(name, CLIP_ENTRY);
+    if (data.empty())
+    {
+        return nullptr;
+    }
+    if (data.size() < sizeof(ClipEntryHeader))
+    {
+        throw AnimationFileException(_path + ": truncated clip " + std::string(name));
+    }
+
+    const auto header = readStruct<ClipEntryHeader>(data.data());
+    const std::uint64_t frameBytes = static_cast<std::uint64_t>(header.jointCount) * BakedClip::FLOATS_PER_JOINT
+                                     * sizeof(float);
+    if (header.channelsOffset > data.size() || header.jointCount > data.size() - header.channelsOffset
+        || header.samplesOffset % ENTRY_ALIGNMENT != 0 || header.samplesOffset > data.size()
+        || (frameBytes > 0 && header.frameCount > (data.size() - header.samplesOffset) / frameBytes))
+    {
+        throw AnimationFileException(_path + ": the pose table of " + std::string(name) + " is out of its entry");
+    }
+    if (header.eventsOffset % alignof(AnimationEvent) != 0 || header.eventsOffset > data.size()
+        || header.eventCount > (data.size() - header.eventsOffset) / sizeof(AnimationEvent))
+    {
+        throw AnimationFileException(_path + ": the events of " + std::string(name) + " are out of their entry");
+    }
+
+    const std::span channels(data.data() + header.channelsOffset, header.jointCount);
+    const std::span samples(reinterpret_cast<const float*>(data.data() + header.samplesOffset),
+                            static_cast<std::size_t>(header.frameCount) * header.jointCount
+                            * BakedClip::FLOATS_PER_JOINT);
+    const auto* events = reinterpret_cast<const AnimationEvent*>(data.data() + header.eventsOffset);
+    BakedClip clip = BakedClip::view(header.duration, header.frameRate, header.frameCount, channels, samples,
+                                     shared_from_this());
+    clip.setEvents({events, events + header.eventCount});
+    return std::make_shared<const BakedClip>(std::move(clip));
+}
+
+/**
+ * Find a skeleton by name.
+ *
+ * @param name The name of the skeleton
+ *
+ * @return The parent of each joint (-1 for the roots), valid as long as the library (or empty if there is none)
+ *
+ * @throw AnimationFileException If the entry of the skeleton is corrupt
+ */
+std::span<const std::int32_t> AnimationLibrary::getSkeleton(const std::string_view name) const
+{
+    const std::span<const unsigned char> data = _findEntry(name, SKELETON_ENTRY);
+    if (data.empty())
+    {
+        return {};
+    }
+    if (data.size() < sizeof(SkeletonEntryHeader))
+    {
+        throw AnimationFileException(_path + ": truncated skeleton " + std::string(name));
+    }
+
+    const auto header = readStruct<SkeletonEntryHeader>(data.data());
+    if (header.parentsOffset % alignof(std::int32_t) != 0 || header.parentsOffset > data.size()
+        || header.jointCount > (data.size() - header.parentsOffset) / sizeof(std::int32_t))
+    {
+        throw AnimationFileException(_path + ": the joints of " + std::string(name) + " are out of their entry");
+    }
+    return {reinterpret_cast<const std::int32_t*>(data.data() + header.parentsOffset), header.jointCount};
+}
+
+/**
+ * Map a library in memory.<br>
+ * Only the header is read: the cost does not depend on the number or the size of the entries.
+ *
+ * @param path The path of the library
+ *
+ * @return The mapped library
+ *
+ * @throw AnimationFileException If the file cannot be mapped or is not a library of the current version
+ */
+std::shared_ptr<const AnimationLibrary> AnimationLibrary::open(const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        throw AnimationFileException("Could not open file " + path);
+    }
+    struct stat status{};
+    if (fstat(fd, &status) == -1 || static_cast<std::size_t>(status.st_size) < sizeof(LibraryHeader))
+    {
+        close(fd);
+        throw AnimationFileException(path + " is not an animation library");
+    }
+
+    // The descriptor is not needed once the file is mapped
+    const auto size = static_cast<std::size_t>(status.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw AnimationFileException("Could not map file " + path);
+    }
+
+    const auto* data = static_cast<const unsigned char*>(mapping);
+    const auto header = readStruct<LibraryHeader>(data);
+    const char* error = nullptr;
+    if (!std::equal(header.magic, header.magic + sizeof(header.magic), LIBRARY_MAGIC))
+    {
+        error = " is not an animation library";
+    }
+    else if (header.version != LIBRARY_VERSION)
+    {
+        error = ": unsupported animation library version";
+    }
+    else if (header.byteOrder != LIBRARY_BYTE_ORDER)
+    {
+        error = ": animation library written with another byte order";
+    }
+    else if (header.fileSize != size || header.tocOffset % ENTRY_ALIGNMENT != 0 || header.tocOffset > size
+             || header.entryCount > (size - header.tocOffset) / sizeof(LibraryEntry))
+    {
+        error = ": truncated animation library";
+    }
+    if (error)
+    {
+        munmap(mapping, size);
+        throw AnimationFileException(path + error);
+    }
+    return std::shared_ptr<const AnimationLibrary>(new AnimationLibrary(path, data, size));
+}
+
+/**
+ * Write a library.<br>
+ * The entries are sorted by name and each one is aligned on ENTRY_ALIGNMENT, so the pose tables can be used in place
+ * once the file is mapped.
+ *
+ * @param path The path of the file, overwritten if it exists
+ * @param clips The clips to store
+ * @param skeletons The skeletons to store
+ *
+ * @throw AnimationFileException If a name is invalid or used twice, a clip is null, or the file cannot be written
+ */
+void AnimationLibrary::write(const std::string& path,
+                             const std::vector<LibraryClip>& clips,
+                             const std::vector<LibrarySkeleton>& skeletons)
+{
+    std::vector<PendingEntry> entries;
+    entries.reserve(clips.size() + skeletons.size());
+    const auto addEntry = [&entries](const std::string& name, const LibraryEntryType type)-> PendingEntry&
+    {
+        if (name.empty() || name.size() > MAX_NAME_LENGTH)
+        {
+            throw AnimationFileException("Invalid animation library entry name \"" + name + "\"");
+        }
+        PendingEntry& pending = entries.emplace_back();
+        std::ranges::copy(name, pending.entry.name);
+        pending.entry.type = type;
+        return pending;
+    };
+    for (const auto& [name, clip]: clips)
+    {
+        if (clip == nullptr)
+        {
+            throw AnimationFileException("The animation library entry \"" + name + "\" has no clip");
+        }
+        addEntry(name, CLIP_ENTRY).clip = clip;
+    }
+    for (const auto& [name, parents]: skeletons)
+    {
+        addEntry(name, SKELETON_ENTRY).parents = parents;
+    }
+    std::ranges::sort(entries, {}, [](const PendingEntry& pending)
+    {
+        return entryName(pending.entry);
+    });
+    if (std::ranges::adjacent_find(entries, {}, [](const PendingEntry& pending)
+    {
+        return entryName(pending.entry);
+    }) != entries.end())
+    {
+        throw AnimationFileException("An animation library entry name is used twice");
+    }
+
+    // Lay the entries out after the table of contents
+    LibraryHeader header{};
+    std::ranges::copy(LIBRARY_MAGIC, header.magic);
+    header.version = LIBRARY_VERSION;
+    header.byteOrder = LIBRARY_BYTE_ORDER;
+    header.entryCount = static_cast<std::uint32_t>(entries.size());
+    header.tocOffset = sizeof(LibraryHeader);
+    std::uint64_t offset = header.tocOffset + entries.size() * sizeof(LibraryEntry);
+    for (PendingEntry& pending: entries)
+    {
+        if (pending.clip)
+        {
+            pending.entry.size = samplesOffset(*pending.clip) + pending.clip->getFrameCount()
+                                                                * pending.clip->getJointCount()
+                                                                * BakedClip::FLOATS_PER_JOINT * sizeof(float);
+        }
+        else
+        {
+            pending.entry.size = sizeof(SkeletonEntryHeader) + pending.parents.size() * sizeof(std::int32_t);
+        }
+        pending.entry.offset = alignOffset(offset);
+        offset = pending.entry.offset + pending.entry.size;
+    }
+    header.fileSize = offset;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw AnimationFileException("Could not open file " + path);
+    }
+    writeStruct(file, header);
+    for (const PendingEntry& pending: entries)
+    {
+        writeStruct(file, pending.entry);
+    }
+    for (const PendingEntry& pending: entries)
+    {
+        writePadding(file, pending.entry.offset);
+        if (const BakedClip* clip = pending.clip)
+        {
+            const ClipEntryHeader clipHeader{
+                static_cast<std::uint32_t>(clip->getJointCount()),
+                static_cast<std::uint32_t>(clip->getFrameCount()),
+                clip->getDuration(),
+                clip->getFrameRate(),
+                sizeof(ClipEntryHeader),
+                samplesOffset(*clip),
+                static_cast<std::uint32_t>(clip->getEvents().size()),
+                0,
+                eventsOffset(clip->getJointCount())
+            };
+            writeStruct(file, clipHeader);
+            for (std::size_t joint = 0; joint < clip->getJointCount(); ++joint)
+            {
+                writeStruct(file, clip->getChannels(joint));
+            }
+            writePadding(file, pending.entry.offset + clipHeader.eventsOffset);
+            for (const AnimationEvent& event: clip->getEvents())
+            {
+                writeStruct(file, event);
+            }
+            writePadding(file, pending.entry.offset + clipHeader.samplesOffset);
+            for (std::size_t frame = 0; frame < clip->getFrameCount(); ++frame)
+            {
+                const std::span<const float> values = clip->getFrame(frame);
+                file.write(reinterpret_cast<const char*>(values.data()),
+                           static_cast<std::streamsize>(values.size_bytes()));
+            }
+        }
+        else
+        {
+            writeStruct(file, SkeletonEntryHeader{
+                            static_cast<std::uint32_t>(pending.parents.size()), 0, sizeof(SkeletonEntryHeader)
+                        });
+            for (const int parent: pending.parents)
+            {
+                writeStruct(file, static_cast<std::int32_t>(parent));
+            }
+        }
+    }
+    if (!file)
+    {
+        throw AnimationFileException("Could not write file " + path);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Binary search the table of contents.
+ *
+ * @param name The name of the entry
+ * @param type The expected type of the entry
+ *
+ * @return The data of the entry (empty if there is no entry of this name and type)
+ *
+ * @throw AnimationFileException If the entry points outside of the file
+ */
+std::span<const unsigned char> AnimationLibrary::_findEntry(const std::string_view name,
+                                                            const LibraryEntryType type) const
+{
+    const std::span toc(reinterpret_cast<const LibraryEntry*>(_data + _tocOffset), _entryCount);
+    const auto found = std::ranges::lower_bound(toc, name, {}, entryName);
+    if (found == toc.end() || entryName(*found) != name || found->type != type)
+    {
+        return {};
+    }
+    if (found->offset % ENTRY_ALIGNMENT != 0 || found->offset > _size || found->size > _size - found->offset)
+    {
+        throw AnimationFileException(_path + ": the entry " + std::string(name) + " is out of the file");
+    }
+    return {_data + found->offset, static_cast<std::size_t>(found->size)};
+}
@@ -0,0 +1,112 @@
+#include "AnimationLod.hpp"
+#include <AnimationDefines.hpp>
+#include <Camera.hpp>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create the policy of a camera.<br>
+ * The frustum planes are extracted from the rows of the view-projection matrix: a point is visible when each clip
+ * coordinate is between -w and w, so every plane is the last row plus or minus one of the others.
+ *
+ * @param cameraPosition The position of the camera, the translation applied to the world as in Camera::getFinalMatrix()
+ * @param viewProjection The matrix bringing world coordinates to clip coordinates
+ */
+AnimationLod::AnimationLod(const Vector4& cameraPosition, const Matrix4& viewProjection)
+    : _eye(-cameraPosition.getX(), -cameraPosition.getY(), -cameraPosition.getZ()),
+      _planes()
+{
+    const float* data = viewProjection.getData();
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        for (std::size_t side = 0; side < 2; ++side)
+        {
+            const float sign = side == 0 ? 1.0f : -1.0f;
+            std::array<float, 4>& plane = _planes[axis * 2 + side];
+            for (std::size_t column = 0; column < 4; ++column)
+            {
+                plane[column] = data[12 + column] + sign * data[axis * 4 + column];
+            }
+            const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (length > 0.0f)
+            {
+                for (float& coefficient: plane)
+                {
+                    coefficient /= length;
+                }
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of updates between two evaluations of the pose of a character at a level (0 if never evaluated)
+ */
+unsigned int AnimationLod::getUpdateInterval(const AnimationLodLevel level)
+{
+    switch (level)
+    {
+        case FULL_LOD:
+            return 1;
+        case REDUCED_LOD:
+            return ANIMATION_LOD_REDUCED_INTERVAL;
+        case MINIMAL_LOD:
+            return ANIMATION_LOD_MINIMAL_INTERVAL;
+        default:
+            return 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The policy of the camera of the engine, for its current position
+ */
+AnimationLod AnimationLod::fromCamera()
+{
+    return AnimationLod(Camera::getInstance().getPosition(), Camera::getFinalMatrix());
+}
+
+/**
+ * Choose the level of a character.
+ *
+ * @param position The position of the character in the world
+ * @param radius The radius of a sphere around the position containing the character
+ *
+ * @return CULLED_LOD if the sphere is out of the view frustum, else the level of its distance to the camera
+ */
+AnimationLodLevel AnimationLod::classify(const Vector4& position, const float radius) const
+{
+    for (const std::array<float, 4>& plane: _planes)
+    {
+        const float distance = plane[0] * position.getX() + plane[1] * position.getY() + plane[2] * position.getZ()
+                               + plane[3];
+        if (distance < -radius)
+        {
+            return CULLED_LOD;
+        }
+    }
+
+    const float dx = position.getX() - _eye.getX();
+    const float dy = position.getY() - _eye.getY();
+    const float dz = position.getZ() - _eye.getZ();
+    const float squaredDistance = dx * dx + dy * dy + dz * dz;
+    if (squaredDistance >= ANIMATION_LOD_MINIMAL_DISTANCE * ANIMATION_LOD_MINIMAL_DISTANCE)
+    {
+        return MINIMAL_LOD;
+    }
+    if (squaredDistance >= ANIMATION_LOD_REDUCED_DISTANCE * ANIMATION_LOD_REDUCED_DISTANCE)
+    {
+        return REDUCED_LOD;
+    }
+    return FULL_LOD;
+}
@@ -0,0 +1,528 @@
+#include "AnimationPlayer.hpp"
+
+#include <AnimationEventDispatcher.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Initializes a stopped player.
+ *
+ * @param human - The human to animate.
+ */
+AnimationPlayer::AnimationPlayer(Human* human) : _human(human),
+                                                 _speed(1.0f),
+                                                 _base(HUMAN_JOINT_COUNT),
+                                                 _fadingOut(HUMAN_JOINT_COUNT),
+                                                 _fadeDuration(0.0f),
+                                                 _fadeElapsed(0.0f),
+                                                 _lod(FULL_LOD),
+                                                 _lodPhase(0),
+                                                 _updateCount(0),
+                                                 _pendingTime(0.0f),
+                                                 _newPose(false),
+                                                 _ikTargets(),
+                                                 _ikBatch(HUMAN_LIMB_COUNT),
+                                                 _eventDispatcher(nullptr),
+                                                 _eventSlot(0),
+                                                 _eventsOutdated(false),
+                                                 _eventsPosition(0.0f),
+                                                 _eventsElapsed(0.0f)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Stop being watched by the event dispatcher, if any.
+ */
+AnimationPlayer::~AnimationPlayer()
+{
+    if (_eventDispatcher != nullptr)
+    {
+        _eventDispatcher->unwatch(this);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The clip of the base layer (nullptr if stopped).
+ */
+const std::shared_ptr<const AnimationSource>& AnimationPlayer::getClip() const
+{
+    return _base.getClip();
+}
+
+/**
+ * @return The animated human.
+ */
+Human* AnimationPlayer::getHuman() const
+{
+    return _human;
+}
+
+/**
+ * @return The position in the clip of the base layer in seconds.
+ */
+float AnimationPlayer::getTime() const
+{
+    return _base.getTime();
+}
+
+/**
+ * @return The position in the playback cycle of the base layer in seconds, moved by the time the throttled updates
+ * accumulated without evaluating the pose yet.
+ */
+float AnimationPlayer::getCycleTime() const
+{
+    return _base.getCycleTimeAfter(_pendingTime * _speed);
+}
+
+/**
+ * @return The playback speed factor.
+ */
+float AnimationPlayer::getSpeed() const
+{
+    return _speed;
+}
+
+/**
+ * @return How the time of the base clip moves through it.
+ */
+PlaybackMode AnimationPlayer::getPlaybackMode() const
+{
+    return _base.getPlaybackMode();
+}
+
+/**
+ * @return The pose evaluated by the last update, every layer included.
+ */
+const Pose& AnimationPlayer::getPose() const
+{
+    return _base.getPose();
+}
+
+/**
+ * @return The extra layers, in the order they are applied.
+ */
+std::span<AnimationLayer> AnimationPlayer::getLayers()
+{
+    return _layers;
+}
+
+/**
+ * @return Whether the base layer is playing a clip.
+ */
+bool AnimationPlayer::isPlaying() const
+{
+    return _base.isPlaying();
+}
+
+/**
+ * @return Whether the previous clip is still fading out.
+ */
+bool AnimationPlayer::isCrossFading() const
+{
+    return _fadingOut.isPlaying();
+}
+
+/**
+ * @return The level of detail of the character.
+ */
+AnimationLodLevel AnimationPlayer::getLod() const
+{
+    return _lod;
+}
+
+/**
+ * @return Whether the last update applied a new pose to the human, which must then be transformed again.
+ */
+bool AnimationPlayer::hasNewPose() const
+{
+    return _newPose;
+}
+
+/**
+ * @param limb - The limb.
+ *
+ * @return The target of the limb, in the model space of the torso.
+ *
+ * @throw std::out_of_range If the limb does not exist.
+ */
+const IkTarget& AnimationPlayer::getIkTarget(const HumanLimb limb) const
+{
+    return _ikTargets.at(limb);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Move the base layer to a position in its clip, the pose being evaluated by the next update.<br>
+ * The time is brought into the playback cycle, so players of the same clip can be given any phase offset.
+ *
+ * @param time - The new position in seconds.
+ *
+ * @return itself
+ */
+AnimationPlayer& AnimationPlayer::setTime(const double time)
+{
+    _base.setTime(time);
+    _invalidateEvents();
+    return *this;
+}
+
+/**
+ * Set the playback speed factor.
+ *
+ * @param speed - The new speed, 1 for the authored speed, negative to play backward.
+ *
+ * @return itself
+ */
+AnimationPlayer& AnimationPlayer::setSpeed(const float speed)
+{
+    if (speed != _speed)
+    {
+        _speed = speed;
+        _invalidateEvents();
+    }
+    return *this;
+}
+
+/**
+ * Set how the time of the base clip moves through it, kept by the next clips played.<br>
+ * A negative speed plays the clip in reverse whatever the mode.
+ *
+ * @param playbackMode - The new playback mode.
+ *
+ * @return itself
+ */
+AnimationPlayer& AnimationPlayer::setPlaybackMode(const PlaybackMode playbackMode)
+{
+    // The base layer and the fading out layer are swapped by every crossfade
+    _base.setPlaybackMode(playbackMode);
+    _fadingOut.setPlaybackMode(playbackMode);
+    _invalidateEvents();
+    return *this;
+}
+
+/**
+ * Set the level of detail of the character, used from the next update on.
+ *
+ * @param lod - The new level, usually chosen by an AnimationLod.
+ *
+ * @return itself
+ */
+AnimationPlayer& AnimationPlayer::setLod(const AnimationLodLevel lod)
+{
+    _lod = lod;
+    return *this;
+}
+
+/**
+ * Set which updates evaluate the pose when the player is throttled.<br>
+ * Giving consecutive phases to the players of a crowd time-slices their evaluations over consecutive updates.
+ *
+ * @param phase - The offset of the evaluating updates.
+ *
+ * @return itself
+ */
+AnimationPlayer& AnimationPlayer::setLodPhase(const unsigned int phase)
+{
+    _lodPhase = phase;
+    return *this;
+}
+
+/**
+ * Make a limb reach a target, from the next evaluation on.
+ *
+ * @param limb - The limb.
+ * @param target - The target, in the model space of the torso (a weight of 0 gives the limb back to the animation).
+ *
+ * @return itself
+ *
+ * @throw std::out_of_range If the limb does not exist.
+ */
+AnimationPlayer& AnimationPlayer::setIkTarget(const HumanLimb limb, const IkTarget& target)
+{
+    _ikTargets.at(limb) = target;
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Public methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Switch the base layer to a clip at once.<br>
+ * The clip is shared, not copied: the player only keeps a reference to it.
+ *
+ * @param clip - The clip to play (nullptr to stop).
+ * @param startTime - The position to start from in seconds.
+ */
+void AnimationPlayer::play(std::shared_ptr<const AnimationSource> clip, const float startTime)
+{
+    _fadingOut.stop();
+    _base.play(std::move(clip), startTime);
+    _invalidateEvents();
+}
+
+/**
+ * Switch the base layer to a clip, blending from the current clip over a duration.<br>
+ * Starting a crossfade during another one drops the clip that was fading out.
+ *
+ * @param clip - The clip to play (nullptr to stop at once).
+ * @param duration - The duration of the transition in seconds (0 to switch at once).
+ * @param startTime - The position to start from in seconds.
+ */
+void AnimationPlayer::crossFade(std::shared_ptr<const AnimationSource> clip, const float duration, const float startTime)
+{
+    if (clip == nullptr || duration <= 0.0f || !_base.isPlaying())
+    {
+        play(std::move(clip), startTime);
+        return;
+    }
+    // Swapping keeps the pose and cursor buffers of both layers, nothing is allocated
+    std::swap(_base, _fadingOut);
+    _base.play(std::move(clip), startTime);
+    _fadeDuration = duration;
+    _fadeElapsed = 0.0f;
+    _invalidateEvents();
+}
+
+/**
+ * Stop playing the base layer, the human keeps its current pose.
+ */
+void AnimationPlayer::stop()
+{
+    _fadingOut.stop();
+    _base.stop();
+    _invalidateEvents();
+}
+
+/**
+ * Jump to a time of the timeline and evaluate the pose there at once, whatever the level of detail.<br>
+ * Every clip samples any time directly, so seeking costs the same as an update wherever it lands and the pose does
+ * not depend on the previous ones: scrubbing and rendering frames out of order give the poses of a continuous
+ * playback. The extra layers are moved to the same time and a crossfade in progress is dropped.
+ *
+ * @param time - The time in seconds since the start of the clips, in double precision for long timelines.
+ */
+void AnimationPlayer::seek(const double time)
+{
+    _fadingOut.stop();
+    _base.setTime(time);
+    for (AnimationLayer& layer: _layers)
+    {
+        layer.setTime(time);
+    }
+    _pendingTime = 0.0f;
+    _newPose = false;
+    _invalidateEvents();
+    if (_human != nullptr)
+    {
+        _evaluate(0.0f);
+    }
+}
+
+/**
+ * Add a layer over the base layer and the previously added layers.<br>
+ * The returned reference is valid until the next layer is added.
+ *
+ * @param clip - The clip played by the layer.
+ * @param blendMode - How the layer is combined with the layers below it.
+ * @param weight - The weight of the layer.
+ * @param mask - The joints affected by the layer (nullptr for every joint).
+ *
+ * @return The new layer
+ */
+AnimationLayer& AnimationPlayer::addLayer(std::shared_ptr<const AnimationSource> clip,
+                                          const LayerBlendMode blendMode,
+                                          const float weight,
+                                          std::shared_ptr<const JointMask> mask)
+{
+    AnimationLayer& layer = _layers.emplace_back(HUMAN_JOINT_COUNT);
+    layer.setBlendMode(blendMode).setWeight(weight).setMask(std::move(mask));
+    layer.play(std::move(clip));
+    return layer;
+}
+
+/**
+ * Remove every extra layer.
+ */
+void AnimationPlayer::clearLayers()
+{
+    _layers.clear();
+}
+
+/**
+ * Give every limb back to the animation.
+ */
+void AnimationPlayer::clearIkTargets()
+{
+    _ikTargets.fill(IkTarget());
+}
+
+/**
+ * Advance every layer, evaluate the layer stack and apply the resulting pose to the human.<br>
+ * This method should be called every frame. Depending on the level of detail, the evaluation may be skipped (the time
+ * being caught up by the next one), the minor joints left untouched, or only the clocks of the layers moved.
+ *
+ * @param deltaTime - The time in seconds elapsed since the previous update.
+ */
+void AnimationPlayer::update(const float deltaTime)
+{
+    if (_eventsOutdated)
+    {
+        _eventsElapsed += deltaTime;
+    }
+    const bool hasActiveLayer = std::ranges::any_of(_layers, [](const AnimationLayer& layer)
+    {
+        return layer.isPlaying() && layer.getWeight() > 0.0f;
+    });
+    _newPose = false;
+    if (_human == nullptr || (!_base.isPlaying() && !hasActiveLayer)) return;
+
+    _pendingTime += deltaTime;
+    ++_updateCount;
+    if (_lod == CULLED_LOD)
+    {
+        _skip(_pendingTime * _speed);
+        _pendingTime = 0.0f;
+        return;
+    }
+    if ((_updateCount + _lodPhase) % AnimationLod::getUpdateInterval(_lod) != 0)
+    {
+        return;
+    }
+    _evaluate(_pendingTime * _speed);
+    _pendingTime = 0.0f;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Advance every layer, evaluate the layer stack and apply the resulting pose to the human.
+ *
+ * @param step - The time in seconds to move the layers forward, the speed included.
+ */
+void AnimationPlayer::_evaluate(const float step)
+{
+    _base.advance(step);
+    Pose& pose = _base.getPose();
+
+    if (_fadingOut.isPlaying())
+    {
+        _fadeElapsed += std::fabs(step);
+        if (_fadeElapsed < _fadeDuration)
+        {
+            _fadingOut.advance(step);
+            pose.blend(_fadingOut.getPose(), 1.0f - _fadeElapsed / _fadeDuration);
+        }
+        else
+        {
+            _fadingOut.stop();
+        }
+    }
+
+    for (AnimationLayer& layer: _layers)
+    {
+        if (layer.isPlaying() && layer.getWeight() > 0.0f)
+        {
+            layer.advance(step);
+            layer.applyTo(pose);
+        }
+    }
+    _solveIk(pose);
+    _human->applyPose(pose, _lod == MINIMAL_LOD ? Human::getMajorJointMask().get() : nullptr);
+    _newPose = true;
+}
+
+/**
+ * Tell the event dispatcher that the next event of the base clip must be found again, once per update whatever the
+ * number of changes, and remember where the timeline changed.
+ */
+void AnimationPlayer::_invalidateEvents()
+{
+    if (_eventDispatcher == nullptr)
+    {
+        return;
+    }
+    // The dispatcher finds the next event from here, the events reached by the rest of the update included
+    _eventsPosition = getCycleTime();
+    _eventsElapsed = 0.0f;
+    if (!_eventsOutdated)
+    {
+        _eventsOutdated = true;
+        _eventDispatcher->_invalidate(_eventSlot);
+    }
+}
+
+/**
+ * Solve the limbs with a target on the evaluated pose, as one batch.
+ *
+ * @param pose - The evaluated pose, whose limb rotations are replaced.
+ */
+void AnimationPlayer::_solveIk(Pose& pose)
+{
+    const std::span<const TwoBoneChain> chains = Human::getLimbChains();
+    _ikBatch.clear();
+    for (std::size_t limb = 0; limb < HUMAN_LIMB_COUNT; ++limb)
+    {
+        if (_ikTargets[limb].weight > 0.0f)
+        {
+            _ikBatch.add(chains[limb], pose, _ikTargets[limb]);
+        }
+    }
+    if (_ikBatch.getSize() == 0)
+    {
+        return;
+    }
+    _ikBatch.solve();
+    std::size_t chain = 0;
+    for (std::size_t limb = 0; limb < HUMAN_LIMB_COUNT; ++limb)
+    {
+        if (_ikTargets[limb].weight > 0.0f)
+        {
+            _ikBatch.writeTo(chain++, chains[limb], pose);
+        }
+    }
+}
+
+/**
+ * Move every layer and the crossfade forward without evaluating the pose.
+ *
+ * @param step - The time in seconds to move the layers forward, the speed included.
+ */
+void AnimationPlayer::_skip(const float step)
+{
+    _base.skip(step);
+    if (_fadingOut.isPlaying())
+    {
+        _fadeElapsed += std::fabs(step);
+        if (_fadeElapsed < _fadeDuration)
+        {
+            _fadingOut.skip(step);
+        }
+        else
+        {
+            _fadingOut.stop();
+        }
+    }
+    for (AnimationLayer& layer: _layers)
+    {
+        layer.skip(step);
+    }
+}
@@ -0,0 +1,250 @@
+#include "AnimationScript.hpp"
+#include <ScriptScheduler.hpp>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Promise
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The script owning the coroutine
+ */
+AnimationScript AnimationScript::promise_type::get_return_object()
+{
+    return AnimationScript(Handle::from_promise(*this));
+}
+
+/**
+ * A script waits for its scheduler before running.
+ */
+std::suspend_always AnimationScript::promise_type::initial_suspend() noexcept
+{
+    return {};
+}
+
+/**
+ * A returned script stays suspended, so that its scheduler sees it done and destroys it.
+ */
+std::suspend_always AnimationScript::promise_type::final_suspend() noexcept
+{
+    return {};
+}
+
+void AnimationScript::promise_type::return_void()
+{
+}
+
+/**
+ * Keep the exception a script ended on, for its scheduler to rethrow.
+ */
+void AnimationScript::promise_type::unhandled_exception()
+{
+    exception = std::current_exception();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Awaiters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return Whether the script carries on at once, without waiting
+ */
+bool AnimationScript::Delay::await_ready() const noexcept
+{
+    return duration <= 0.0f;
+}
+
+/**
+ * Put the script in the timer queue of its scheduler, until its time plus the duration.
+ *
+ * @param handle The waiting script
+ */
+void AnimationScript::Delay::await_suspend(const Handle handle) const
+{
+    promise_type& promise = handle.promise();
+    promise.scheduler->_wait(handle, promise.time + duration);
+}
+
+void AnimationScript::Delay::await_resume() const noexcept
+{
+}
+
+/**
+ * @return Whether the script carries on at once (the tween must still set its target)
+ */
+bool AnimationScript::Tween::await_ready() const noexcept
+{
+    return false;
+}
+
+/**
+ * Start the tween, or set the target at once if it has no duration.
+ *
+ * @param handle The waiting script
+ *
+ * @return Whether the script waits for the end of the tween
+ */
+bool AnimationScript::Tween::await_suspend(const Handle handle) const
+{
+    if (duration <= 0.0f)
+    {
+        setProperty(*part, property, target);
+        return false;
+    }
+    handle.promise().scheduler->_tween(handle, *this);
+    return true;
+}
+
+void AnimationScript::Tween::await_resume() const noexcept
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Take a coroutine, called by the promise of the script.
+ *
+ * @param handle The coroutine
+ */
+AnimationScript::AnimationScript(const Handle handle) : _handle(handle)
+{
+}
+
+AnimationScript::AnimationScript(AnimationScript&& other) noexcept : _handle(std::exchange(other._handle, nullptr))
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Destroy the coroutine if no scheduler took it.
+ */
+AnimationScript::~AnimationScript()
+{
+    if (_handle)
+    {
+        _handle.destroy();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Operator overloads
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AnimationScript& AnimationScript::operator=(AnimationScript&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (_handle)
+        {
+            _handle.destroy();
+        }
+        _handle = std::exchange(other._handle, nullptr);
+    }
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Give up the coroutine, called by the scheduler starting the script.
+ *
+ * @return The coroutine (a null handle if already released)
+ */
+AnimationScript::Handle AnimationScript::release()
+{
+    return std::exchange(_handle, nullptr);
+}
+
+/**
+ * Wait a duration of simulated time.
+ *
+ * @param duration The duration in seconds (0 or less to carry on at once)
+ *
+ * @return The awaiter
+ */
+AnimationScript::Delay AnimationScript::seconds(const float duration)
+{
+    return {duration};
+}
+
+/**
+ * Move a value of a body part to a target, from its value when the tween starts, and wait for the end.
+ *
+ * @param part The body part, which must outlive the tween
+ * @param property The value to move
+ * @param target The value at the end of the tween
+ * @param duration The duration in seconds (0 or less to set the target at once)
+ * @param curve The easing of the progress, which must outlive the tween (the curves of EasingCurve::get() do)
+ *
+ * @return The awaiter
+ */
+AnimationScript::Tween AnimationScript::tween(BodyPart& part,
+                                              const TweenProperty property,
+                                              const float target,
+                                              const float duration,
+                                              const EasingCurve& curve)
+{
+    return {&part, property, target, duration, &curve};
+}
+
+/**
+ * @return The current value of a property of a body part
+ */
+float AnimationScript::getProperty(const BodyPart& part, const TweenProperty property)
+{
+    switch (property)
+    {
+        case X_ROTATION_PROPERTY:
+            return part.getXRotation();
+        case Y_ROTATION_PROPERTY:
+            return part.getYRotation();
+        case Z_ROTATION_PROPERTY:
+            return part.getZRotation();
+        case X_TRANSLATION_PROPERTY:
+            return part.getTranslateX();
+        case Y_TRANSLATION_PROPERTY:
+            return part.getTranslateY();
+        case Z_TRANSLATION_PROPERTY:
+            return part.getTranslateZ();
+    }
+    return 0.0f;
+}
+
+/**
+ * Set a property of a body part.
+ *
+ * @param part The body part
+ * @param property The property
+ * @param value The new value
+ */
+void AnimationScript::setProperty(BodyPart& part, const TweenProperty property, const float value)
+{
+    switch (property)
+    {
+        case X_ROTATION_PROPERTY:
+            part.setXRotation(value);
+            break;
+        case Y_ROTATION_PROPERTY:
+            part.setYRotation(value);
+            break;
+        case Z_ROTATION_PROPERTY:
+            part.setZRotation(value);
+            break;
+        case X_TRANSLATION_PROPERTY:
+            part.setTranslateX(value);
+            break;
+        case Y_TRANSLATION_PROPERTY:
+            part.setTranslateY(value);
+            break;
+        case Z_TRANSLATION_PROPERTY:
+            part.setTranslateZ(value);
+            break;
+    }
+}
@@ -0,0 +1,52 @@
+#include "AnimationSource.hpp"
+#include <algorithm>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The events, sorted by time
+ */
+std::span<const AnimationEvent> AnimationSource::getEvents() const
+{
+    return _events;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Replace all the events at once, sorting them a single time.<br>
+ * Events sharing the same time keep their relative order, and are reported in that order.
+ *
+ * @param events The events, in any order
+ *
+ * @return itself
+ */
+AnimationSource& AnimationSource::setEvents(std::vector<AnimationEvent> events)
+{
+    _events = std::move(events);
+    std::ranges::stable_sort(_events, {}, &AnimationEvent::time);
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Insert an event, keeping the events sorted by time.
+ *
+ * @param event The event, after the events of the same time
+ *
+ * @return itself
+ */
+AnimationSource& AnimationSource::addEvent(const AnimationEvent& event)
+{
+    const auto position = std::ranges::upper_bound(_events, event.time, {}, &AnimationEvent::time);
+    _events.insert(position, event);
+    return *this;
+}
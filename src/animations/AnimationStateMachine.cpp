@@ -0,0 +1,197 @@
+#include "AnimationStateMachine.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * Find a name in a list of names.
+ *
+ * @return The index of the name (AnimationStateMachine::NOT_FOUND if absent)
+ */
+static std::size_t findName(const std::span<const std::string> names, const std::string_view name)
+{
+    const auto found = std::ranges::find(names, name);
+    return found == names.end() ? AnimationStateMachine::NOT_FOUND : static_cast<std::size_t>(found - names.begin());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of states
+ */
+std::size_t AnimationStateMachine::getStateCount() const
+{
+    return _states.size();
+}
+
+/**
+ * @param state The index of the state
+ *
+ * @return The state
+ *
+ * @throw std::out_of_range If the state does not exist
+ */
+const AnimationState& AnimationStateMachine::getState(const std::size_t state) const
+{
+    return _states.at(state);
+}
+
+/**
+ * @return The transitions leaving every state, checked after the transitions of the current state
+ */
+std::span<const AnimationTransition> AnimationStateMachine::getAnyStateTransitions() const
+{
+    return _anyStateTransitions;
+}
+
+/**
+ * @return The number of events
+ */
+std::size_t AnimationStateMachine::getEventCount() const
+{
+    return _events.size();
+}
+
+/**
+ * @param event The index of the event
+ *
+ * @return The name of the event
+ *
+ * @throw std::out_of_range If the event does not exist
+ */
+const std::string& AnimationStateMachine::getEventName(const std::size_t event) const
+{
+    return _events.at(event);
+}
+
+/**
+ * @return The number of parameters
+ */
+std::size_t AnimationStateMachine::getParameterCount() const
+{
+    return _parameterNames.size();
+}
+
+/**
+ * @param parameter The index of the parameter
+ *
+ * @return The value of the parameter when a controller is created
+ *
+ * @throw std::out_of_range If the parameter does not exist
+ */
+float AnimationStateMachine::getParameterDefault(const std::size_t parameter) const
+{
+    return _parameterDefaults.at(parameter);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Add a state, without any transition leaving it.
+ *
+ * @param name The name of the state
+ * @param clip The clip looped by the state, shared with the other states and players (nullptr to stop playing)
+ *
+ * @return The index of the state
+ */
+std::size_t AnimationStateMachine::addState(std::string name, std::shared_ptr<const AnimationSource> clip)
+{
+    _states.push_back({std::move(name), std::move(clip), {}});
+    return _states.size() - 1;
+}
+
+/**
+ * Add an event, which AnimationController::trigger() sends to fire the transitions waiting for it.
+ *
+ * @param name The name of the event
+ *
+ * @return The index of the event
+ */
+std::size_t AnimationStateMachine::addEvent(std::string name)
+{
+    _events.push_back(std::move(name));
+    return _events.size() - 1;
+}
+
+/**
+ * Add a parameter, which AnimationController::setParameter() changes to fire the transitions depending on it.
+ *
+ * @param name The name of the parameter
+ * @param defaultValue The value of the parameter when a controller is created
+ *
+ * @return The index of the parameter
+ */
+std::size_t AnimationStateMachine::addParameter(std::string name, const float defaultValue)
+{
+    _parameterNames.push_back(std::move(name));
+    _parameterDefaults.push_back(defaultValue);
+    return _parameterNames.size() - 1;
+}
+
+/**
+ * Add a transition leaving a state.<br>
+ * The transitions of a state are checked in the order they are added, the first one able to fire wins.
+ *
+ * @param from The state left by the transition (ANY_STATE for every state but the one it enters)
+ * @param transition The transition
+ *
+ * @return itself
+ *
+ * @throw std::out_of_range If a state, the event or a parameter of the transition does not exist
+ */
+AnimationStateMachine& AnimationStateMachine::addTransition(const std::size_t from, AnimationTransition transition)
+{
+    if ((from != ANY_STATE && from >= _states.size()) || transition.to >= _states.size())
+    {
+        throw std::out_of_range("The states of the transition must exist");
+    }
+    if (transition.event != NO_EVENT && transition.event >= _events.size())
+    {
+        throw std::out_of_range("The event of the transition must exist");
+    }
+    for (const TransitionCondition& condition: transition.conditions)
+    {
+        if (condition.parameter >= _parameterNames.size())
+        {
+            throw std::out_of_range("The parameters of the transition must exist");
+        }
+    }
+    if (from == ANY_STATE)
+    {
+        _anyStateTransitions.push_back(std::move(transition));
+    }
+    else
+    {
+        _states[from].transitions.push_back(std::move(transition));
+    }
+    return *this;
+}
+
+/**
+ * @return The index of the state of this name (NOT_FOUND if none)
+ */
+std::size_t AnimationStateMachine::findState(const std::string_view name) const
+{
+    const auto found = std::ranges::find(_states, name, &AnimationState::name);
+    return found == _states.end() ? NOT_FOUND : static_cast<std::size_t>(found - _states.begin());
+}
+
+/**
+ * @return The index of the event of this name (NOT_FOUND if none)
+ */
+std::size_t AnimationStateMachine::findEvent(const std::string_view name) const
+{
+    return findName(_events, name);
+}
+
+/**
+ * @return The index of the parameter of this name (NOT_FOUND if none)
+ */
+std::size_t AnimationStateMachine::findParameter(const std::string_view name) const
+{
+    return findName(_parameterNames, name);
+}
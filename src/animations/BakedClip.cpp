@@ -0,0 +1,363 @@
+#include "BakedClip.hpp"
+#include <AnimationFileException.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <utility>
+
+/**
+ * The first bytes of a baked clip file.
+ */
+static constexpr char BAKED_CLIP_MAGIC[4] = {'H', 'G', 'L', 'B'};
+
+/**
+ * The version of the baked clip file format, increased on every incompatible change.
+ */
+static constexpr std::uint32_t BAKED_CLIP_VERSION = 1;
+
+/**
+ * Write the bytes of a value (in the byte order of the machine).
+ */
+template<typename T>
+static void writeValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * Read the bytes of a value written by writeValue().
+ */
+template<typename T>
+static T readValue(std::ifstream& file)
+{
+    T value{};
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+/**
+ * Check the timing of a pose table: the rate and the duration must be finite and not negative, and not 0 either when
+ * there is more than one frame (a single frame, as baked from a clip without duration, has neither rate nor duration).
+ *
+ * @return Whether the frames can be sampled with this rate and duration
+ */
+static bool isValidTiming(const float duration, const float frameRate, const std::size_t frameCount)
+{
+    return std::isfinite(frameRate) && std::isfinite(duration) && frameRate >= 0.0f && duration >= 0.0f
+           && (frameCount <= 1 || (frameRate > 0.0f && duration > 0.0f));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The duration of the clip in seconds
+ */
+float BakedClip::getDuration() const
+{
+    return _duration;
+}
+
+/**
+ * @return The number of frames per second
+ */
+float BakedClip::getFrameRate() const
+{
+    return _frameRate;
+}
+
+/**
+ * @return The number of frames
+ */
+std::size_t BakedClip::getFrameCount() const
+{
+    return _frameCount;
+}
+
+/**
+ * @return The number of joints of each frame
+ */
+std::size_t BakedClip::getJointCount() const
+{
+    return _jointCount;
+}
+
+/**
+ * @return The PoseChannel flags set on the joint (NO_CHANNEL if the clip does not know the joint)
+ */
+unsigned char BakedClip::getChannels(const std::size_t joint) const
+{
+    return joint < _jointCount ? _channels[joint] : static_cast<unsigned char>(NO_CHANNEL);
+}
+
+/**
+ * @return The FLOATS_PER_JOINT values of every joint at the frame
+ */
+std::span<const float> BakedClip::getFrame(const std::size_t frame) const
+{
+    return _samples.subspan(frame * _jointCount * FLOATS_PER_JOINT, _jointCount * FLOATS_PER_JOINT);
+}
+
+/**
+ * @return The memory used by the pose table, in bytes
+ */
+std::size_t BakedClip::getByteSize() const
+{
+    return _samples.size() * sizeof(float) + _channels.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Interpolate the two frames around a given time.<br>
+ * Rotations use nlerp, which is accurate enough between two close frames.
+ *
+ * @param time The time in seconds, clamped between 0 and the duration of the clip
+ * @param pose The pose to fill, reset first
+ * @param cursor Unused, a baked clip needs no search
+ */
+void BakedClip::sample(const float time, Pose& pose, [[maybe_unused]] ClipCursor* cursor) const
+{
+    pose.reset();
+    if (_frameCount == 0)
+    {
+        return;
+    }
+
+    const float position = std::clamp(time, 0.0f, _duration) * _frameRate;
+    const std::size_t lastFrame = _frameCount - 1;
+    const std::size_t frame = std::min(static_cast<std::size_t>(position), lastFrame);
+    const std::size_t nextFrame = std::min(frame + 1, lastFrame);
+    const float factor = position - static_cast<float>(frame);
+
+    const float* from = _samples.data() + frame * _jointCount * FLOATS_PER_JOINT;
+    const float* to = _samples.data() + nextFrame * _jointCount * FLOATS_PER_JOINT;
+    const std::size_t jointCount = std::min(_jointCount, pose.getJointCount());
+    for (std::size_t joint = 0; joint < jointCount; ++joint, from += FLOATS_PER_JOINT, to += FLOATS_PER_JOINT)
+    {
+        const unsigned char channels = _channels[joint];
+        JointPose& target = pose[joint];
+        if (channels & ROTATION_CHANNEL)
+        {
+            target.rotation = Quaternion::nlerp(Quaternion(from[0], from[1], from[2], from[3]),
+                                                Quaternion(to[0], to[1], to[2], to[3]),
+                                                factor);
+        }
+        if (channels & TRANSLATION_CHANNEL)
+        {
+            target.translation = Vector4(from[4] + (to[4] - from[4]) * factor,
+                                         from[5] + (to[5] - from[5]) * factor,
+                                         from[6] + (to[6] - from[6]) * factor,
+                                         0.0f);
+        }
+        if (channels & SCALE_CHANNEL)
+        {
+            target.scale = Vector4(from[7] + (to[7] - from[7]) * factor,
+                                   from[8] + (to[8] - from[8]) * factor,
+                                   from[9] + (to[9] - from[9]) * factor,
+                                   0.0f);
+        }
+        target.channels = channels;
+    }
+}
+
+/**
+ * Write the clip to a binary file.<br>
+ * Values are stored in the byte order of the machine, files are not meant to be exchanged between architectures.
+ *
+ * @param path The path of the file, overwritten if it exists
+ *
+ * @throw AnimationFileException If the file cannot be written
+ */
+void BakedClip::save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw AnimationFileException("Could not open file " + path);
+    }
+
+    file.write(BAKED_CLIP_MAGIC, sizeof(BAKED_CLIP_MAGIC));
+    writeValue(file, BAKED_CLIP_VERSION);
+    writeValue(file, static_cast<std::uint32_t>(_jointCount));
+    writeValue(file, static_cast<std::uint32_t>(_frameCount));
+    writeValue(file, _duration);
+    writeValue(file, _frameRate);
+    file.write(reinterpret_cast<const char*>(_channels.data()), static_cast<std::streamsize>(_channels.size()));
+    file.write(reinterpret_cast<const char*>(_samples.data()),
+               static_cast<std::streamsize>(_samples.size() * sizeof(float)));
+    if (!file)
+    {
+        throw AnimationFileException("Could not write file " + path);
+    }
+}
+
+/**
+ * Sample an animation at a fixed rate.<br>
+ * The frames span the duration evenly, the rate being raised slightly if needed, and the last frame is sampled at the
+ * duration so that looping clips stay seamless. Step keys are resolved to the frame rate.
+ *
+ * @param source The animation to bake
+ * @param jointCount The number of joints of the animated skeleton
+ * @param frameRate The minimal number of frames per second
+ *
+ * @return The baked clip, with the events of the source
+ */
+BakedClip BakedClip::bake(const AnimationSource& source, const std::size_t jointCount, const float frameRate)
+{
+    BakedClip clip;
+    clip._duration = source.getDuration();
+    clip.setEvents({source.getEvents().begin(), source.getEvents().end()});
+    clip._jointCount = jointCount;
+    clip._channelStorage.assign(jointCount, NO_CHANNEL);
+
+    const std::size_t intervals = clip._duration > 0.0f && frameRate > 0.0f
+                                      ? static_cast<std::size_t>(std::ceil(clip._duration * frameRate))
+                                      : 0;
+    clip._frameCount = intervals + 1;
+    clip._frameRate = intervals > 0 ? static_cast<float>(intervals) / clip._duration : 0.0f;
+    clip._sampleStorage.resize(clip._frameCount * jointCount * FLOATS_PER_JOINT);
+
+    Pose pose(jointCount);
+    ClipCursor cursor;
+    float* output = clip._sampleStorage.data();
+    for (std::size_t frame = 0; frame < clip._frameCount; ++frame)
+    {
+        const float time = frame == intervals ? clip._duration : static_cast<float>(frame) / clip._frameRate;
+        source.sample(intervals > 0 ? time : 0.0f, pose, &cursor);
+        for (std::size_t joint = 0; joint < jointCount; ++joint, output += FLOATS_PER_JOINT)
+        {
+            const JointPose& jointPose = pose[joint];
+            output[0] = jointPose.rotation.getW();
+            output[1] = jointPose.rotation.getX();
+            output[2] = jointPose.rotation.getY();
+            output[3] = jointPose.rotation.getZ();
+            output[4] = jointPose.translation.getX();
+            output[5] = jointPose.translation.getY();
+            output[6] = jointPose.translation.getZ();
+            output[7] = jointPose.scale.getX();
+            output[8] = jointPose.scale.getY();
+            output[9] = jointPose.scale.getZ();
+            clip._channelStorage[joint] |= jointPose.channels;
+        }
+    }
+    clip._channels = clip._channelStorage;
+    clip._samples = clip._sampleStorage;
+    return clip;
+}
+
+/**
+ * Read a clip written by save().
+ *
+ * @param path The path of the file
+ *
+ * @return The loaded clip
+ *
+ * @throw AnimationFileException If the file cannot be read, is not a baked clip of the current version or has an
+ * invalid frame rate or duration
+ */
+BakedClip BakedClip::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw AnimationFileException("Could not open file " + path);
+    }
+
+    char magic[sizeof(BAKED_CLIP_MAGIC)];
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(magic, magic + sizeof(magic), BAKED_CLIP_MAGIC))
+    {
+        throw AnimationFileException(path + " is not a baked clip");
+    }
+    if (const auto version = readValue<std::uint32_t>(file); version != BAKED_CLIP_VERSION)
+    {
+        throw AnimationFileException(path + ": unsupported baked clip version " + std::to_string(version));
+    }
+
+    BakedClip clip;
+    clip._jointCount = readValue<std::uint32_t>(file);
+    clip._frameCount = readValue<std::uint32_t>(file);
+    clip._duration = readValue<float>(file);
+    clip._frameRate = readValue<float>(file);
+    if (!file || clip._frameCount == 0)
+    {
+        throw AnimationFileException(path + ": truncated header");
+    }
+    if (!isValidTiming(clip._duration, clip._frameRate, clip._frameCount))
+    {
+        throw AnimationFileException(path + ": invalid frame rate or duration");
+    }
+
+    // Check the size announced by the header before allocating anything
+    const std::streamoff headerEnd = file.tellg();
+    file.seekg(0, std::ios::end);
+    const auto expectedBytes = static_cast<std::uintmax_t>(clip._jointCount)
+                               * (1 + clip._frameCount * FLOATS_PER_JOINT * sizeof(float));
+    if (static_cast<std::uintmax_t>(file.tellg() - headerEnd) != expectedBytes)
+    {
+        throw AnimationFileException(path + ": the pose table does not match the header");
+    }
+    file.seekg(headerEnd);
+
+    clip._channelStorage.resize(clip._jointCount);
+    clip._sampleStorage.resize(clip._frameCount * clip._jointCount * FLOATS_PER_JOINT);
+    file.read(reinterpret_cast<char*>(clip._channelStorage.data()),
+              static_cast<std::streamsize>(clip._channelStorage.size()));
+    file.read(reinterpret_cast<char*>(clip._sampleStorage.data()),
+              static_cast<std::streamsize>(clip._sampleStorage.size() * sizeof(float)));
+    if (!file)
+    {
+        throw AnimationFileException("Could not read file " + path);
+    }
+    clip._channels = clip._channelStorage;
+    clip._samples = clip._sampleStorage;
+    return clip;
+}
+
+/**
+ * Create a clip over a pose table stored elsewhere, without copying it.<br>
+ * The clip keeps the owner alive, so the memory stays valid as long as the clip is used.
+ *
+ * @param duration The duration of the clip in seconds
+ * @param frameRate The number of frames per second
+ * @param frameCount The number of frames, the first at time 0 and the last at the duration
+ * @param channels The PoseChannel flags of each joint, giving the number of joints
+ * @param samples The FLOATS_PER_JOINT values of every joint of every frame
+ * @param owner The owner of the memory viewed by channels and samples
+ *
+ * @return The clip viewing the pose table
+ *
+ * @throw AnimationFileException If the number of samples does not match the number of frames and joints, or if the
+ * frame rate or the duration is invalid
+ */
+BakedClip BakedClip::view(const float duration,
+                          const float frameRate,
+                          const std::size_t frameCount,
+                          const std::span<const unsigned char> channels,
+                          const std::span<const float> samples,
+                          std::shared_ptr<const void> owner)
+{
+    if (frameCount == 0 || samples.size() != frameCount * channels.size() * FLOATS_PER_JOINT)
+    {
+        throw AnimationFileException("The pose table does not match its frame and joint counts");
+    }
+    if (!isValidTiming(duration, frameRate, frameCount))
+    {
+        throw AnimationFileException("The pose table has an invalid frame rate or duration");
+    }
+
+    BakedClip clip;
+    clip._duration = duration;
+    clip._frameRate = frameRate;
+    clip._frameCount = frameCount;
+    clip._jointCount = channels.size();
+    clip._channels = channels;
+    clip._samples = samples;
+    clip._owner = std::move(owner);
+    return clip;
+}
@@ -0,0 +1,508 @@
+#include "CompressedClip.hpp"
+#include <algorithm>
+#include <cmath>
+#include <Logger.hpp>
+
+/**
+ * The largest absolute value of the three smallest components of a unit quaternion (1 / sqrt(2)).
+ */
+static constexpr float SMALLEST_THREE_RANGE = 0.70710678f;
+
+/**
+ * The largest quantized value of a smallest three component (15 bits, the 16th storing the dropped component).
+ */
+static constexpr std::uint16_t ROTATION_QUANTIZATION_MAX = 0x7FFF;
+
+/**
+ * The largest quantized value of a translation or scale component.
+ */
+static constexpr std::uint16_t VECTOR_QUANTIZATION_MAX = 0xFFFF;
+
+/**
+ * The number of times the key reduction tolerance is halved before giving up on the error bound.
+ */
+static constexpr int COMPRESSION_MAX_ATTEMPTS = 16;
+
+/**
+ * The offset of each channel in the values of a joint of a BakedClip frame.
+ */
+static constexpr std::size_t ROTATION_OFFSET = 0;
+static constexpr std::size_t TRANSLATION_OFFSET = 4;
+static constexpr std::size_t SCALE_OFFSET = 7;
+
+/**
+ * Quantize a rotation with the smallest three method: the largest component is dropped (it is rebuilt from the unit
+ * length) and made positive, the 3 others are stored on 15 bits. The index of the dropped component is stored in the
+ * high bits of the first two values.
+ *
+ * @param rotation The unit quaternion to quantize
+ *
+ * @return The 3 quantized values
+ */
+static std::array<std::uint16_t, 3> encodeRotation(const Quaternion& rotation)
+{
+    const float components[4] = {rotation.getW(), rotation.getX(), rotation.getY(), rotation.getZ()};
+    std::size_t largest = 0;
+    for (std::size_t i = 1; i < 4; ++i)
+    {
+        if (std::fabs(components[i]) > std::fabs(components[largest]))
+        {
+            largest = i;
+        }
+    }
+    // q and -q are the same rotation, the dropped component is rebuilt as positive
+    const float sign = components[largest] < 0 ? -1.0f : 1.0f;
+
+    std::array<std::uint16_t, 3> encoded{};
+    std::size_t output = 0;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+        {
+            continue;
+        }
+        const float normalized = (components[i] * sign + SMALLEST_THREE_RANGE) / (2 * SMALLEST_THREE_RANGE);
+        encoded[output++] = static_cast<std::uint16_t>(
+            std::lround(std::clamp(normalized, 0.0f, 1.0f) * ROTATION_QUANTIZATION_MAX));
+    }
+    encoded[0] |= static_cast<std::uint16_t>((largest >> 1) << 15);
+    encoded[1] |= static_cast<std::uint16_t>((largest & 1) << 15);
+    return encoded;
+}
+
+/**
+ * @return The rotation quantized by encodeRotation()
+ */
+static Quaternion decodeRotation(const std::array<std::uint16_t, 3>& encoded)
+{
+    const std::size_t largest = (encoded[0] >> 15) << 1 | encoded[1] >> 15;
+    float components[4];
+    float squaredSum = 0.0f;
+    std::size_t input = 0;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+        {
+            continue;
+        }
+        const float normalized = static_cast<float>(encoded[input++] & ROTATION_QUANTIZATION_MAX)
+                                 / ROTATION_QUANTIZATION_MAX;
+        components[i] = normalized * 2 * SMALLEST_THREE_RANGE - SMALLEST_THREE_RANGE;
+        squaredSum += components[i] * components[i];
+    }
+    components[largest] = std::sqrt(std::max(0.0f, 1.0f - squaredSum));
+    return {components[0], components[1], components[2], components[3]};
+}
+
+/**
+ * Quantize the x, y and z components of a vector on 16 bits over a range.
+ *
+ * @param vector The vector to quantize
+ * @param rangeMin The smallest value of each component
+ * @param rangeExtent The size of the range of each component
+ *
+ * @return The 3 quantized values
+ */
+static std::array<std::uint16_t, 3> encodeVector(const Vector4& vector,
+                                                 const std::array<float, 3>& rangeMin,
+                                                 const std::array<float, 3>& rangeExtent)
+{
+    std::array<std::uint16_t, 3> encoded{};
+    for (int i = 0; i < 3; ++i)
+    {
+        const float normalized = rangeExtent[i] > 0.0f ? (vector[i] - rangeMin[i]) / rangeExtent[i] : 0.0f;
+        encoded[i] = static_cast<std::uint16_t>(
+            std::lround(std::clamp(normalized, 0.0f, 1.0f) * VECTOR_QUANTIZATION_MAX));
+    }
+    return encoded;
+}
+
+/**
+ * @return The vector quantized by encodeVector(), with a w component of 0
+ */
+static Vector4 decodeVector(const std::array<std::uint16_t, 3>& encoded,
+                            const std::array<float, 3>& rangeMin,
+                            const std::array<float, 3>& rangeExtent)
+{
+    return {
+        rangeMin[0] + static_cast<float>(encoded[0]) / VECTOR_QUANTIZATION_MAX * rangeExtent[0],
+        rangeMin[1] + static_cast<float>(encoded[1]) / VECTOR_QUANTIZATION_MAX * rangeExtent[1],
+        rangeMin[2] + static_cast<float>(encoded[2]) / VECTOR_QUANTIZATION_MAX * rangeExtent[2],
+        0.0f
+    };
+}
+
+/**
+ * @return The angle in radians between two unit quaternions
+ */
+static float rotationDistance(const Quaternion& a, const Quaternion& b)
+{
+    return 2 * std::acos(std::min(1.0f, std::fabs(a.dot(b))));
+}
+
+/**
+ * @return The distance between the x, y and z components of two vectors
+ */
+static float vectorDistance(const Vector4& a, const Vector4& b)
+{
+    return (a - b).magnitude();
+}
+
+/**
+ * Select the frames to keep as keys: a frame is dropped when interpolating the keys around it rebuilds it within the
+ * tolerance. The first and last frames are always kept, and a track rebuilt by its first key alone keeps only it.
+ *
+ * @param exact The value of the track at every frame
+ * @param quantized The quantized value of the track at every frame
+ * @param tolerance The largest accepted distance to the exact values
+ * @param interpolate Interpolate two values
+ * @param distance The distance between two values
+ *
+ * @return The indices of the kept frames, sorted
+ */
+template<typename Value, typename Interpolate, typename Distance>
+static std::vector<std::size_t> reduceKeys(const std::vector<Value>& exact,
+                                           const std::vector<Value>& quantized,
+                                           const float tolerance,
+                                           Interpolate interpolate,
+                                           Distance distance)
+{
+    const bool constant = std::ranges::all_of(exact, [&](const Value& value)
+    {
+        return distance(quantized.front(), value) <= tolerance;
+    });
+    if (constant || exact.size() == 1)
+    {
+        return {0};
+    }
+
+    std::vector<std::size_t> kept = {0};
+    std::size_t anchor = 0;
+    for (std::size_t end = 2; end < exact.size(); ++end)
+    {
+        bool fits = true;
+        for (std::size_t frame = anchor + 1; frame < end && fits; ++frame)
+        {
+            const float factor = static_cast<float>(frame - anchor) / static_cast<float>(end - anchor);
+            fits = distance(interpolate(quantized[anchor], quantized[end], factor), exact[frame]) <= tolerance;
+        }
+        if (!fits)
+        {
+            anchor = end - 1;
+            kept.push_back(anchor);
+        }
+    }
+    kept.push_back(exact.size() - 1);
+    return kept;
+}
+
+/**
+ * Find the first key strictly after a frame position, checking the hint and its successor before binary searching.
+ *
+ * @param frames The frames of the keys of the track, sorted
+ * @param count The number of keys of the track
+ * @param position The frame position
+ * @param hint The result of the previous search, updated with the new result (nullptr if none)
+ *
+ * @return The index of the first key after position (count if there is none)
+ */
+static std::size_t findNextKey(const std::uint16_t* frames,
+                               const std::size_t count,
+                               const float position,
+                               std::uint32_t* hint)
+{
+    const auto isNextKey = [frames, count, position](const std::size_t index)
+    {
+        return index <= count
+               && (index == 0 || static_cast<float>(frames[index - 1]) <= position)
+               && (index == count || static_cast<float>(frames[index]) > position);
+    };
+
+    std::size_t next;
+    if (hint && isNextKey(*hint))
+    {
+        next = *hint;
+    }
+    else if (hint && isNextKey(*hint + 1))
+    {
+        next = *hint + 1;
+    }
+    else
+    {
+        next = std::upper_bound(frames, frames + count, position, [](const float value, const std::uint16_t frame)
+        {
+            return value < static_cast<float>(frame);
+        }) - frames;
+    }
+    if (hint)
+    {
+        *hint = static_cast<std::uint32_t>(next);
+    }
+    return next;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The duration of the clip in seconds
+ */
+float CompressedClip::getDuration() const
+{
+    return _duration;
+}
+
+/**
+ * @return The number of tracks, one per animated channel of each joint
+ */
+std::size_t CompressedClip::getTrackCount() const
+{
+    return _tracks.size();
+}
+
+/**
+ * @return The number of keys kept, all tracks included
+ */
+std::size_t CompressedClip::getKeyCount() const
+{
+    return _keyFrames.size();
+}
+
+/**
+ * @return The memory used by the tracks and keys, in bytes
+ */
+std::size_t CompressedClip::getByteSize() const
+{
+    return _tracks.size() * sizeof(Track)
+           + _keyFrames.size() * sizeof(std::uint16_t)
+           + _keyValues.size() * sizeof(std::array<std::uint16_t, 3>);
+}
+
+/**
+ * @return The largest error measured over every frame of the source when the clip was compressed
+ */
+float CompressedClip::getMaxError() const
+{
+    return _maxError;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Decode and interpolate the two keys around a given time on every track.
+ *
+ * @param time The time in seconds, clamped between 0 and the duration of the clip
+ * @param pose The pose to fill, reset first
+ * @param cursor The playback position of the caller, sized on first use (nullptr to always binary search)
+ */
+void CompressedClip::sample(const float time, Pose& pose, ClipCursor* cursor) const
+{
+    std::uint32_t* hints = nullptr;
+    if (cursor)
+    {
+        if (cursor->nextKeys.size() != _tracks.size())
+        {
+            cursor->nextKeys.assign(_tracks.size(), 0);
+        }
+        hints = cursor->nextKeys.data();
+    }
+
+    pose.reset();
+    const float position = std::clamp(time, 0.0f, _duration) * _frameRate;
+    for (std::size_t index = 0; index < _tracks.size(); ++index)
+    {
+        const Track& track = _tracks[index];
+        if (track.joint >= pose.getJointCount())
+        {
+            continue;
+        }
+        const std::uint16_t* frames = _keyFrames.data() + track.firstKey;
+        const std::array<std::uint16_t, 3>* values = _keyValues.data() + track.firstKey;
+        const std::size_t next = findNextKey(frames, track.keyCount, position, hints ? hints + index : nullptr);
+
+        // Hold the first and last keys, interpolate between the others
+        const std::size_t from = next == 0 ? 0 : next - 1;
+        const std::size_t to = std::min<std::size_t>(next, track.keyCount - 1);
+        const float factor = from == to
+                                 ? 0.0f
+                                 : (position - static_cast<float>(frames[from]))
+                                   / static_cast<float>(frames[to] - frames[from]);
+
+        JointPose& target = pose[track.joint];
+        if (track.channel == ROTATION_CHANNEL)
+        {
+            const Quaternion rotation = decodeRotation(values[from]);
+            target.rotation = from == to ? rotation : Quaternion::nlerp(rotation, decodeRotation(values[to]), factor);
+        }
+        else
+        {
+            const Vector4 fromValue = decodeVector(values[from], track.rangeMin, track.rangeExtent);
+            const Vector4 value = from == to
+                                      ? fromValue
+                                      : fromValue + (decodeVector(values[to], track.rangeMin, track.rangeExtent)
+                                                     - fromValue) * factor;
+            (track.channel == TRANSLATION_CHANNEL ? target.translation : target.scale) = value;
+        }
+        target.channels |= track.channel;
+    }
+}
+
+/**
+ * Compress a baked clip.<br>
+ * The key reduction starts with a tolerance equal to the error bound (in radians for rotations, world units for
+ * translations and scales) and halves it until the metric, measured on every frame of the source, is under the bound.
+ *
+ * @param source The clip to compress
+ * @param maxError The largest error accepted by the metric
+ * @param metric The distance between a pose of the source and the same pose rebuilt from the compressed clip
+ *
+ * @return The compressed clip, with the events of the source (empty if the source has more frames than the keys can
+ * address)
+ */
+CompressedClip CompressedClip::compress(const BakedClip& source, const float maxError, const PoseErrorMetric& metric)
+{
+    CompressedClip clip;
+    clip._duration = source.getDuration();
+    clip.setEvents({source.getEvents().begin(), source.getEvents().end()});
+    clip._frameRate = source.getFrameRate();
+    if (source.getFrameCount() > static_cast<std::size_t>(UINT16_MAX) + 1)
+    {
+        Logger::error("CompressedClip::compress(): %zu frames, at most %d can be compressed.",
+                      source.getFrameCount(), UINT16_MAX + 1);
+        return clip;
+    }
+
+    float tolerance = maxError;
+    for (int attempt = 0; attempt < COMPRESSION_MAX_ATTEMPTS; ++attempt)
+    {
+        clip._addTracks(source, tolerance);
+        clip._maxError = clip._measureError(source, metric);
+        if (clip._maxError <= maxError)
+        {
+            return clip;
+        }
+        tolerance /= 2;
+    }
+    Logger::warning("CompressedClip::compress(): error %f above the bound %f, the quantization is too coarse.",
+                    clip._maxError, maxError);
+    return clip;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Quantize and reduce every animated channel of the source, replacing the current tracks.
+ *
+ * @param source The clip to compress
+ * @param tolerance The key reduction tolerance (radians for rotations, world units for translations and scales)
+ */
+void CompressedClip::_addTracks(const BakedClip& source, const float tolerance)
+{
+    _tracks.clear();
+    _keyFrames.clear();
+    _keyValues.clear();
+
+    const std::size_t frameCount = source.getFrameCount();
+    for (std::size_t joint = 0; joint < source.getJointCount(); ++joint)
+    {
+        const unsigned char channels = source.getChannels(joint);
+        const std::size_t base = joint * BakedClip::FLOATS_PER_JOINT;
+
+        if (channels & ROTATION_CHANNEL)
+        {
+            std::vector<Quaternion> exact;
+            std::vector<Quaternion> quantized;
+            std::vector<std::array<std::uint16_t, 3>> encoded;
+            for (std::size_t frame = 0; frame < frameCount; ++frame)
+            {
+                const float* values = source.getFrame(frame).data() + base + ROTATION_OFFSET;
+                exact.emplace_back(values[0], values[1], values[2], values[3]);
+                encoded.push_back(encodeRotation(exact.back()));
+                quantized.push_back(decodeRotation(encoded.back()));
+            }
+            const std::vector<std::size_t> kept = reduceKeys(exact, quantized, tolerance, &Quaternion::nlerp,
+                                                             rotationDistance);
+
+            _tracks.push_back({static_cast<std::uint16_t>(joint), ROTATION_CHANNEL,
+                               static_cast<std::uint32_t>(_keyFrames.size()),
+                               static_cast<std::uint32_t>(kept.size()), {}, {}});
+            for (const std::size_t frame: kept)
+            {
+                _keyFrames.push_back(static_cast<std::uint16_t>(frame));
+                _keyValues.push_back(encoded[frame]);
+            }
+        }
+
+        for (const auto& [channel, offset]: {std::pair{TRANSLATION_CHANNEL, TRANSLATION_OFFSET},
+                                             std::pair{SCALE_CHANNEL, SCALE_OFFSET}})
+        {
+            if (!(channels & channel))
+            {
+                continue;
+            }
+            std::vector<Vector4> exact;
+            std::array<float, 3> rangeMin = {INFINITY, INFINITY, INFINITY};
+            std::array<float, 3> rangeMax = {-INFINITY, -INFINITY, -INFINITY};
+            for (std::size_t frame = 0; frame < frameCount; ++frame)
+            {
+                const float* values = source.getFrame(frame).data() + base + offset;
+                exact.emplace_back(values[0], values[1], values[2], 0.0f);
+                for (int i = 0; i < 3; ++i)
+                {
+                    rangeMin[i] = std::min(rangeMin[i], values[i]);
+                    rangeMax[i] = std::max(rangeMax[i], values[i]);
+                }
+            }
+            const std::array<float, 3> rangeExtent = {
+                rangeMax[0] - rangeMin[0], rangeMax[1] - rangeMin[1], rangeMax[2] - rangeMin[2]
+            };
+
+            std::vector<Vector4> quantized;
+            std::vector<std::array<std::uint16_t, 3>> encoded;
+            for (const Vector4& value: exact)
+            {
+                encoded.push_back(encodeVector(value, rangeMin, rangeExtent));
+                quantized.push_back(decodeVector(encoded.back(), rangeMin, rangeExtent));
+            }
+            const auto lerp = [](const Vector4& from, const Vector4& to, const float factor)
+            {
+                return from + (to - from) * factor;
+            };
+            const std::vector<std::size_t> kept = reduceKeys(exact, quantized, tolerance, lerp, vectorDistance);
+
+            _tracks.push_back({static_cast<std::uint16_t>(joint), static_cast<unsigned char>(channel),
+                               static_cast<std::uint32_t>(_keyFrames.size()),
+                               static_cast<std::uint32_t>(kept.size()), rangeMin, rangeExtent});
+            for (const std::size_t frame: kept)
+            {
+                _keyFrames.push_back(static_cast<std::uint16_t>(frame));
+                _keyValues.push_back(encoded[frame]);
+            }
+        }
+    }
+}
+
+/**
+ * @return The largest error of the metric between the source and this clip, over every frame of the source
+ */
+float CompressedClip::_measureError(const BakedClip& source, const PoseErrorMetric& metric) const
+{
+    Pose reference(source.getJointCount());
+    Pose approximation(source.getJointCount());
+    ClipCursor cursor;
+    float maxError = 0.0f;
+
+    for (std::size_t frame = 0; frame < source.getFrameCount(); ++frame)
+    {
+        const float time = _frameRate > 0.0f ? std::min(static_cast<float>(frame) / _frameRate, _duration) : 0.0f;
+        source.sample(time, reference);
+        sample(time, approximation, &cursor);
+        maxError = std::max(maxError, metric(reference, approximation));
+    }
+    return maxError;
+}
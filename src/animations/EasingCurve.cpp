@@ -0,0 +1,305 @@
+#include "EasingCurve.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * The number of halvings finding the parameter of a Bézier curve at a progress, far below float precision.
+ */
+static constexpr int BEZIER_BISECTIONS = 48;
+
+/**
+ * Find the segment of a progress and the position in the segment.
+ *
+ * @param progress The progress, clamped to [0, 1] (NaN counting as 0)
+ * @param segment The index of the segment
+ * @param position The progress scaled to the segments, from segment to segment + 1
+ */
+static void locate(const float progress, std::size_t& segment, float& position)
+{
+    // Clamped the way _mm_max_ps and _mm_min_ps do in the batch evaluate(), which turn NaN into 0
+    const float clamped = progress > 0.0f ? std::min(progress, 1.0f) : 0.0f;
+    position = clamped * static_cast<float>(EASING_CURVE_SEGMENTS);
+    segment = std::min(static_cast<std::size_t>(position), static_cast<std::size_t>(EASING_CURVE_SEGMENTS - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Compile a named easing function.
+ *
+ * @param function The function
+ */
+EasingCurve::EasingCurve(const EasingFunction function) : _samples(), _maxError(0.0f)
+{
+    _compile([function](const double progress)
+    {
+        return static_cast<double>(evaluateFunction(function, static_cast<float>(progress)));
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The eased progress at each end of the segments
+ */
+std::span<const float> EasingCurve::getSamples() const
+{
+    return _samples;
+}
+
+/**
+ * @return The largest difference between the table and the exact curve, measured in the middle of each segment
+ */
+float EasingCurve::getMaxError() const
+{
+    return _maxError;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Ease a progress.
+ *
+ * @param progress The progress, clamped to [0, 1] (NaN counting as 0)
+ *
+ * @return The eased progress, which may overshoot [0, 1] for curves such as BACK_OUT_EASING
+ */
+float EasingCurve::evaluate(const float progress) const
+{
+    std::size_t segment;
+    float position;
+    locate(progress, segment, position);
+    const float from = _samples[segment];
+    const float to = _samples[segment + 1];
+    return from + (to - from) * (position - static_cast<float>(segment));
+}
+
+/**
+ * Ease a batch of progresses, four at a time with SSE2. Each result is the one of evaluate().
+ *
+ * @param progresses The progresses, clamped to [0, 1] (NaN counting as 0)
+ * @param results The eased progresses, at least as many as the progresses
+ */
+void EasingCurve::evaluate(const std::span<const float> progresses, const std::span<float> results) const
+{
+    std::size_t index = 0;
+#if defined(__SSE2__)
+    // The segments and the positions in them are computed in the lanes, only the table lookups are scalar
+    const __m128 segmentCount = _mm_set1_ps(static_cast<float>(EASING_CURVE_SEGMENTS));
+    const __m128 lastSegment = _mm_set1_ps(static_cast<float>(EASING_CURVE_SEGMENTS - 1));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; index + 4 <= progresses.size(); index += 4)
+    {
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(progresses.data() + index), zero), one);
+        const __m128 position = _mm_mul_ps(clamped, segmentCount);
+        // The position is not negative, so truncating it rounds it down
+        const __m128 segment = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(position)), lastSegment);
+        const __m128 factor = _mm_sub_ps(position, segment);
+        alignas(16) std::int32_t segments[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(segments), _mm_cvttps_epi32(segment));
+        const __m128 from = _mm_setr_ps(_samples[segments[0]], _samples[segments[1]],
+                                        _samples[segments[2]], _samples[segments[3]]);
+        const __m128 to = _mm_setr_ps(_samples[segments[0] + 1], _samples[segments[1] + 1],
+                                      _samples[segments[2] + 1], _samples[segments[3] + 1]);
+        _mm_storeu_ps(results.data() + index, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), factor)));
+    }
+#endif
+    for (; index < progresses.size(); ++index)
+    {
+        results[index] = evaluate(progresses[index]);
+    }
+}
+
+/**
+ * @param function The function
+ *
+ * @return The curve of a named easing function, compiled once and shared
+ *
+ * @throw std::out_of_range If the function does not exist
+ */
+const EasingCurve& EasingCurve::get(const EasingFunction function)
+{
+    static const std::array<EasingCurve, EASING_FUNCTION_COUNT> curves = []
+    {
+        std::array<EasingCurve, EASING_FUNCTION_COUNT> compiled;
+        for (std::size_t index = 0; index < compiled.size(); ++index)
+        {
+            compiled[index] = EasingCurve(static_cast<EasingFunction>(index));
+        }
+        return compiled;
+    }();
+    return curves.at(function);
+}
+
+/**
+ * Compile a cubic Bézier curve from (0, 0) to (1, 1), as the cubic-bezier() timing function of CSS.
+ *
+ * @param x1 The progress of the first control point, clamped to [0, 1] so that the curve is a function
+ * @param y1 The eased progress of the first control point
+ * @param x2 The progress of the second control point, clamped to [0, 1]
+ * @param y2 The eased progress of the second control point
+ *
+ * @return The compiled curve
+ */
+EasingCurve EasingCurve::fromBezier(const float x1, const float y1, const float x2, const float y2)
+{
+    const double controlX1 = std::clamp(x1, 0.0f, 1.0f);
+    const double controlX2 = std::clamp(x2, 0.0f, 1.0f);
+    const auto bezier = [](const double first, const double second, const double parameter)
+    {
+        const double inverse = 1.0 - parameter;
+        return 3.0 * inverse * inverse * parameter * first
+               + 3.0 * inverse * parameter * parameter * second
+               + parameter * parameter * parameter;
+    };
+
+    EasingCurve curve;
+    curve._compile([&](const double progress)
+    {
+        // The progress grows with the parameter, so the parameter of a progress is found by bisection
+        double low = 0.0;
+        double high = 1.0;
+        for (int bisection = 0; bisection < BEZIER_BISECTIONS; ++bisection)
+        {
+            const double middle = (low + high) / 2.0;
+            (bezier(controlX1, controlX2, middle) < progress ? low : high) = middle;
+        }
+        return bezier(y1, y2, (low + high) / 2.0);
+    });
+    return curve;
+}
+
+/**
+ * Compile a cubic Hermite curve from (0, 0) to (1, 1).
+ *
+ * @param startTangent The slope at progress 0 (0 eases in, 1 starts linearly)
+ * @param endTangent The slope at progress 1 (0 eases out, 1 ends linearly)
+ *
+ * @return The compiled curve
+ */
+EasingCurve EasingCurve::fromHermite(const float startTangent, const float endTangent)
+{
+    EasingCurve curve;
+    curve._compile([startTangent, endTangent](const double progress)
+    {
+        const double squared = progress * progress;
+        const double cubed = squared * progress;
+        return (cubed - 2.0 * squared + progress) * startTangent
+               + (3.0 * squared - 2.0 * cubed)
+               + (cubed - squared) * endTangent;
+    });
+    return curve;
+}
+
+/**
+ * Evaluate a named easing function exactly, as done once per sample when compiling its curve.
+ *
+ * @param function The function
+ * @param progress The progress, clamped to [0, 1]
+ *
+ * @return The eased progress
+ */
+float EasingCurve::evaluateFunction(const EasingFunction function, const float progress)
+{
+    constexpr float backOvershoot = 1.70158f;
+    constexpr float bounceScale = 7.5625f;
+    constexpr float bounceStep = 2.75f;
+    const float t = std::clamp(progress, 0.0f, 1.0f);
+    const float inverse = 1.0f - t;
+    switch (function)
+    {
+        case LINEAR_EASING:
+            return t;
+        case SMOOTHSTEP_EASING:
+            return t * t * (3.0f - 2.0f * t);
+        case QUADRATIC_IN_EASING:
+            return t * t;
+        case QUADRATIC_OUT_EASING:
+            return 1.0f - inverse * inverse;
+        case QUADRATIC_IN_OUT_EASING:
+            return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * inverse * inverse;
+        case CUBIC_IN_EASING:
+            return t * t * t;
+        case CUBIC_OUT_EASING:
+            return 1.0f - inverse * inverse * inverse;
+        case CUBIC_IN_OUT_EASING:
+            return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * inverse * inverse * inverse;
+        case SINE_IN_EASING:
+            return 1.0f - std::cos(t * static_cast<float>(M_PI) / 2.0f);
+        case SINE_OUT_EASING:
+            return std::sin(t * static_cast<float>(M_PI) / 2.0f);
+        case SINE_IN_OUT_EASING:
+            return (1.0f - std::cos(t * static_cast<float>(M_PI))) / 2.0f;
+        case BACK_OUT_EASING:
+            return 1.0f - inverse * inverse * ((backOvershoot + 1.0f) * inverse - backOvershoot);
+        case ELASTIC_OUT_EASING:
+        {
+            if (t == 0.0f || t == 1.0f)
+            {
+                return t;
+            }
+            const float angle = (t * 10.0f - 0.75f) * 2.0f * static_cast<float>(M_PI) / 3.0f;
+            return std::pow(2.0f, -10.0f * t) * std::sin(angle) + 1.0f;
+        }
+        case BOUNCE_OUT_EASING:
+        {
+            // Four parabolas, each bounce a quarter of the height of the previous one
+            if (t < 1.0f / bounceStep)
+            {
+                return bounceScale * t * t;
+            }
+            if (t < 2.0f / bounceStep)
+            {
+                const float shifted = t - 1.5f / bounceStep;
+                return bounceScale * shifted * shifted + 0.75f;
+            }
+            if (t < 2.5f / bounceStep)
+            {
+                const float shifted = t - 2.25f / bounceStep;
+                return bounceScale * shifted * shifted + 0.9375f;
+            }
+            const float shifted = t - 2.625f / bounceStep;
+            return bounceScale * shifted * shifted + 0.984375f;
+        }
+        case EASING_FUNCTION_COUNT:
+            break;
+    }
+    return t;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fill the table with an exact curve and measure its error in the middle of each segment.
+ *
+ * @param function The exact eased progress of a progress from 0 to 1, in double precision
+ */
+template<typename Function>
+void EasingCurve::_compile(const Function& function)
+{
+    for (std::size_t sample = 0; sample < SAMPLE_COUNT; ++sample)
+    {
+        _samples[sample] = static_cast<float>(function(static_cast<double>(sample) / EASING_CURVE_SEGMENTS));
+    }
+    _maxError = 0.0f;
+    for (std::size_t segment = 0; segment < EASING_CURVE_SEGMENTS; ++segment)
+    {
+        const double middle = (static_cast<double>(segment) + 0.5) / EASING_CURVE_SEGMENTS;
+        const double error = std::fabs(function(middle) - evaluate(static_cast<float>(middle)));
+        _maxError = std::max(_maxError, static_cast<float>(error));
+    }
+}
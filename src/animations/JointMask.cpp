@@ -0,0 +1,71 @@
+#include "JointMask.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a mask giving the same weight to every joint.
+ *
+ * @param jointCount The number of joints of the skeleton
+ * @param weight The weight of every joint
+ */
+JointMask::JointMask(const std::size_t jointCount, const float weight) : _weights(jointCount, weight)
+{
+}
+
+/**
+ * Create a mask keeping only some joints.
+ *
+ * @param jointCount The number of joints of the skeleton
+ * @param joints The joints with a weight of 1, the others having a weight of 0
+ */
+JointMask::JointMask(const std::size_t jointCount, const std::initializer_list<std::size_t> joints)
+    : _weights(jointCount, 0.0f)
+{
+    for (const std::size_t joint: joints)
+    {
+        setWeight(joint, 1.0f);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of joints of the mask
+ */
+std::size_t JointMask::getJointCount() const
+{
+    return _weights.size();
+}
+
+/**
+ * @return The weight of the joint (0 if the mask does not know the joint)
+ */
+float JointMask::getWeight(const std::size_t joint) const
+{
+    return joint < _weights.size() ? _weights[joint] : 0.0f;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Set the weight of a joint.
+ *
+ * @param joint The index of the joint, ignored if out of the mask
+ * @param weight The new weight, between 0 and 1
+ *
+ * @return itself
+ */
+JointMask& JointMask::setWeight(const std::size_t joint, const float weight)
+{
+    if (joint < _weights.size())
+    {
+        _weights[joint] = weight;
+    }
+    return *this;
+}
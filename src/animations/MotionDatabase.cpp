@@ -0,0 +1,387 @@
+#include "MotionDatabase.hpp"
+#include <algorithm>
+#include <cmath>
+#include <Human.hpp>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+/**
+ * The value of the padding lanes of the last block of the index, far enough from any query to never match.
+ */
+static constexpr float PADDING_FEATURE = 1e15f;
+
+/**
+ * @return The position of the effector of a limb in the model space of the torso, in a pose
+ */
+static Vector4 getEffectorPosition(const TwoBoneChain& chain, const Pose& pose)
+{
+    const JointPose& upper = pose[chain.upperJoint];
+    const JointPose& lower = pose[chain.lowerJoint];
+    const Quaternion upperRotation = upper.channels & ROTATION_CHANNEL ? upper.rotation : Quaternion::identity();
+    const Quaternion lowerRotation = lower.channels & ROTATION_CHANNEL ? lower.rotation : Quaternion::identity();
+    Vector4 position = chain.root + upperRotation.rotate(chain.upperBone + lowerRotation.rotate(chain.lowerBone));
+    if (upper.channels & TRANSLATION_CHANNEL)
+    {
+        position += upper.translation;
+    }
+    return position;
+}
+
+/**
+ * @return The translation of the torso in a pose
+ */
+static Vector4 getTorsoTranslation(const Pose& pose)
+{
+    const JointPose& torso = pose[TORSO];
+    return torso.channels & TRANSLATION_CHANNEL ? torso.translation : Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create an empty database.
+ *
+ * @param sampleRate The number of frames sampled per second of clip
+ */
+MotionDatabase::MotionDatabase(const float sampleRate) : _sampleRate(sampleRate), _clipFrames{0}, _means(), _scales()
+{
+    _scales.fill(1.0f);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of frames sampled per second of clip
+ */
+float MotionDatabase::getSampleRate() const
+{
+    return _sampleRate;
+}
+
+/**
+ * @return The number of clips
+ */
+std::size_t MotionDatabase::getClipCount() const
+{
+    return _clips.size();
+}
+
+/**
+ * @param clip The index of the clip
+ *
+ * @return The clip
+ *
+ * @throw std::out_of_range If the clip does not exist
+ */
+const std::shared_ptr<const AnimationSource>& MotionDatabase::getClip(const std::size_t clip) const
+{
+    return _clips.at(clip);
+}
+
+/**
+ * @return The number of frames of every clip
+ */
+std::size_t MotionDatabase::getFrameCount() const
+{
+    return _features.size();
+}
+
+/**
+ * @param frame The index of the frame
+ *
+ * @return The clip and time of the frame
+ *
+ * @throw std::out_of_range If the frame does not exist
+ */
+MotionFrame MotionDatabase::getFrame(const std::size_t frame) const
+{
+    if (frame >= _features.size())
+    {
+        throw std::out_of_range("Frame index out of range");
+    }
+    const auto next = std::ranges::upper_bound(_clipFrames, frame);
+    const auto clip = static_cast<std::size_t>(next - _clipFrames.begin()) - 1;
+    return {clip, static_cast<float>(frame - _clipFrames[clip]) / _sampleRate};
+}
+
+/**
+ * @param frame The index of the frame
+ *
+ * @return The features of the frame, before normalization
+ *
+ * @throw std::out_of_range If the frame does not exist
+ */
+const MotionDatabase::Features& MotionDatabase::getFeatures(const std::size_t frame) const
+{
+    return _features.at(frame);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Sample the frames of a clip and extract their features.<br>
+ * The clip loops: the velocities and the trajectory of its last frames are taken from its first ones. The database
+ * must be built again before it is searched.
+ *
+ * @param clip The clip, shared with the players
+ *
+ * @return The index of the clip
+ */
+std::size_t MotionDatabase::addClip(std::shared_ptr<const AnimationSource> clip)
+{
+    const auto frameCount = std::max<std::size_t>(1, static_cast<std::size_t>(clip->getDuration() * _sampleRate));
+    for (std::size_t frame = 0; frame < frameCount; ++frame)
+    {
+        _features.push_back(_extractFeatures(*clip, static_cast<float>(frame) / _sampleRate));
+    }
+    _clips.push_back(std::move(clip));
+    _clipFrames.push_back(_features.size());
+    return _clips.size() - 1;
+}
+
+/**
+ * Compute the normalization of the features and index the normalized features of every frame.
+ */
+void MotionDatabase::build()
+{
+    constexpr std::size_t groups[][2] = {
+        {POSITION_FEATURES, VELOCITY_FEATURES},
+        {VELOCITY_FEATURES, TRAJECTORY_FEATURES},
+        {TRAJECTORY_FEATURES, FEATURE_COUNT}
+    };
+    constexpr float weights[] = {
+        MOTION_MATCHING_POSE_WEIGHT,
+        MOTION_MATCHING_VELOCITY_WEIGHT,
+        MOTION_MATCHING_TRAJECTORY_WEIGHT
+    };
+
+    // Every feature of a group shares its deviation, so that a group weighs the same whatever its spread
+    _means.fill(0.0f);
+    _scales.fill(1.0f);
+    if (_features.empty())
+    {
+        _index.clear();
+        return;
+    }
+    const auto frameCount = static_cast<float>(_features.size());
+    for (const Features& features: _features)
+    {
+        for (std::size_t feature = 0; feature < FEATURE_COUNT; ++feature)
+        {
+            _means[feature] += features[feature] / frameCount;
+        }
+    }
+    for (std::size_t group = 0; group < std::size(groups); ++group)
+    {
+        float variance = 0.0f;
+        for (const Features& features: _features)
+        {
+            for (std::size_t feature = groups[group][0]; feature < groups[group][1]; ++feature)
+            {
+                const float deviation = features[feature] - _means[feature];
+                variance += deviation * deviation;
+            }
+        }
+        variance /= frameCount * static_cast<float>(groups[group][1] - groups[group][0]);
+        const float scale = variance > 0.0f ? weights[group] / std::sqrt(variance) : weights[group];
+        std::fill(_scales.begin() + groups[group][0], _scales.begin() + groups[group][1], scale);
+    }
+
+    const std::size_t blockCount = (_features.size() + 3) / 4;
+    _index.assign(blockCount * FEATURE_COUNT * 4, PADDING_FEATURE);
+    for (std::size_t frame = 0; frame < _features.size(); ++frame)
+    {
+        const Features normalized = normalize(_features[frame]);
+        float* block = _index.data() + frame / 4 * FEATURE_COUNT * 4;
+        for (std::size_t feature = 0; feature < FEATURE_COUNT; ++feature)
+        {
+            block[feature * 4 + frame % 4] = normalized[feature];
+        }
+    }
+}
+
+/**
+ * Find the frame of a clip closest to a time.
+ *
+ * @param clip The index of the clip
+ * @param time The time in the clip in seconds, wrapped into the clip
+ *
+ * @return The index of the frame
+ *
+ * @throw std::out_of_range If the clip does not exist
+ */
+std::size_t MotionDatabase::findFrame(const std::size_t clip, const float time) const
+{
+    const float duration = _clips.at(clip)->getDuration();
+    const float wrapped = duration > 0.0f ? time - std::floor(time / duration) * duration : 0.0f;
+    const std::size_t frameCount = _clipFrames[clip + 1] - _clipFrames[clip];
+    const auto frame = static_cast<std::size_t>(std::lround(wrapped * _sampleRate)) % frameCount;
+    return _clipFrames[clip] + frame;
+}
+
+/**
+ * Normalize features, so that they can be compared to the frames of the database.
+ *
+ * @param features The features, before normalization
+ *
+ * @return The normalized features
+ */
+MotionDatabase::Features MotionDatabase::normalize(const Features& features) const
+{
+    Features normalized;
+    for (std::size_t feature = 0; feature < FEATURE_COUNT; ++feature)
+    {
+        normalized[feature] = (features[feature] - _means[feature]) * _scales[feature];
+    }
+    return normalized;
+}
+
+/**
+ * @param frame The index of the frame
+ * @param query The normalized features to compare the frame to
+ *
+ * @return The squared distance between the normalized features of the frame and the query
+ *
+ * @throw std::out_of_range If the frame does not exist or the database was not built since it was added
+ */
+float MotionDatabase::getCost(const std::size_t frame, const Features& query) const
+{
+    if (frame >= _index.size() / (FEATURE_COUNT * 4) * 4)
+    {
+        throw std::out_of_range("Frame index out of range");
+    }
+    const float* block = _index.data() + frame / 4 * FEATURE_COUNT * 4;
+    float cost = 0.0f;
+    for (std::size_t feature = 0; feature < FEATURE_COUNT; ++feature)
+    {
+        const float difference = block[feature * 4 + frame % 4] - query[feature];
+        cost += difference * difference;
+    }
+    return cost;
+}
+
+/**
+ * Find the frame whose normalized features are the closest to a query, by a brute-force scan of the index.<br>
+ * The scan reads the index once in order and keeps four best frames at once, so it is bound by the memory bandwidth
+ * rather than by the comparisons: a database of a few thousand frames is searched in microseconds.
+ *
+ * @param query The normalized features to match
+ *
+ * @return The best frame (NO_FRAME in an empty database)
+ */
+MotionMatch MotionDatabase::search(const Features& query) const
+{
+    const std::size_t blockCount = _index.size() / (FEATURE_COUNT * 4);
+    MotionMatch best = {NO_FRAME, std::numeric_limits<float>::infinity()};
+#if defined(__SSE__)
+    __m128 queryLanes[FEATURE_COUNT];
+    for (std::size_t feature = 0; feature < FEATURE_COUNT; ++feature)
+    {
+        queryLanes[feature] = _mm_set1_ps(query[feature]);
+    }
+    // The block of the best frame of each lane is tracked as a float, exact below 2^24 blocks
+    __m128 bestCosts = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128 bestBlocks = _mm_setzero_ps();
+    for (std::size_t block = 0; block < blockCount; ++block)
+    {
+        const float* lanes = _index.data() + block * FEATURE_COUNT * 4;
+        __m128 costs = _mm_setzero_ps();
+        for (std::size_t feature = 0; feature < FEATURE_COUNT; ++feature)
+        {
+            const __m128 difference = _mm_sub_ps(_mm_loadu_ps(lanes + feature * 4), queryLanes[feature]);
+            costs = _mm_add_ps(costs, _mm_mul_ps(difference, difference));
+        }
+        const __m128 better = _mm_cmplt_ps(costs, bestCosts);
+        bestCosts = _mm_min_ps(costs, bestCosts);
+        bestBlocks = _mm_or_ps(_mm_and_ps(better, _mm_set1_ps(static_cast<float>(block))),
+                               _mm_andnot_ps(better, bestBlocks));
+    }
+    float costs[4];
+    float blocks[4];
+    _mm_storeu_ps(costs, bestCosts);
+    _mm_storeu_ps(blocks, bestBlocks);
+    for (std::size_t lane = 0; lane < 4; ++lane)
+    {
+        const std::size_t frame = static_cast<std::size_t>(blocks[lane]) * 4 + lane;
+        if (costs[lane] < best.cost || (costs[lane] == best.cost && frame < best.frame))
+        {
+            best = {frame, costs[lane]};
+        }
+    }
+#else
+    for (std::size_t frame = 0; frame < blockCount * 4; ++frame)
+    {
+        const float cost = getCost(frame, query);
+        if (cost < best.cost)
+        {
+            best = {frame, cost};
+        }
+    }
+#endif
+    if (best.frame != NO_FRAME && best.frame >= _features.size())
+    {
+        best = {NO_FRAME, std::numeric_limits<float>::infinity()};
+    }
+    return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Extract the features of a clip at a time, before normalization.
+ *
+ * @param clip The clip
+ * @param time The time in seconds
+ *
+ * @return The features
+ */
+MotionDatabase::Features MotionDatabase::_extractFeatures(const AnimationSource& clip, const float time) const
+{
+    const float duration = clip.getDuration();
+    const auto sampleAt = [&clip, duration](const float at, Pose& pose)
+    {
+        clip.sample(duration > 0.0f ? at - std::floor(at / duration) * duration : 0.0f, pose, nullptr);
+    };
+    Pose current(HUMAN_JOINT_COUNT);
+    Pose next(HUMAN_JOINT_COUNT);
+    Pose near(HUMAN_JOINT_COUNT);
+    Pose far(HUMAN_JOINT_COUNT);
+    sampleAt(time, current);
+    sampleAt(time + 1.0f / _sampleRate, next);
+    sampleAt(time + MOTION_MATCHING_NEAR_TIME, near);
+    sampleAt(time + MOTION_MATCHING_FAR_TIME, far);
+
+    Features features{};
+    const std::span<const TwoBoneChain> chains = Human::getLimbChains();
+    for (std::size_t limb = 0; limb < HUMAN_LIMB_COUNT; ++limb)
+    {
+        const Vector4 position = getEffectorPosition(chains[limb], current);
+        const Vector4 velocity = (getEffectorPosition(chains[limb], next) - position) * _sampleRate;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            features[POSITION_FEATURES + limb * 3 + axis] = position[axis];
+            features[VELOCITY_FEATURES + limb * 3 + axis] = velocity[axis];
+        }
+    }
+    const Vector4 translation = getTorsoTranslation(current);
+    const Vector4 nearOffset = getTorsoTranslation(near) - translation;
+    const Vector4 farOffset = getTorsoTranslation(far) - translation;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        features[TRAJECTORY_FEATURES + axis] = nearOffset[axis];
+        features[TRAJECTORY_FEATURES + 3 + axis] = farOffset[axis];
+    }
+    return features;
+}
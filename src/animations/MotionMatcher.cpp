@@ -0,0 +1,178 @@
+#include "MotionMatcher.hpp"
+#include <cmath>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a matcher and play a frame at once, with a still desired trajectory.
+ *
+ * @param database The shared database to match, already built
+ * @param player The player of the character, which must outlive the matcher
+ * @param startFrame The frame of the database to start from
+ *
+ * @throw std::out_of_range If the start frame does not exist
+ */
+MotionMatcher::MotionMatcher(std::shared_ptr<const MotionDatabase> database,
+                             AnimationPlayer* player,
+                             const std::size_t startFrame)
+    : _database(std::move(database)),
+      _player(player),
+      _clip(0),
+      _nearTrajectory(0.0f, 0.0f, 0.0f, 0.0f),
+      _farTrajectory(0.0f, 0.0f, 0.0f, 0.0f),
+      _updates(0),
+      _searchCount(0)
+{
+    const MotionFrame frame = _database->getFrame(startFrame);
+    _clip = frame.clip;
+    _player->play(_database->getClip(frame.clip), frame.time);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The database matched by the matcher
+ */
+const std::shared_ptr<const MotionDatabase>& MotionMatcher::getDatabase() const
+{
+    return _database;
+}
+
+/**
+ * @return The player of the character
+ */
+AnimationPlayer* MotionMatcher::getPlayer() const
+{
+    return _player;
+}
+
+/**
+ * @return The index of the clip of the database being played
+ */
+std::size_t MotionMatcher::getClip() const
+{
+    return _clip;
+}
+
+/**
+ * @return The desired translation of the torso MOTION_MATCHING_NEAR_TIME ahead
+ */
+const Vector4& MotionMatcher::getNearTrajectory() const
+{
+    return _nearTrajectory;
+}
+
+/**
+ * @return The desired translation of the torso MOTION_MATCHING_FAR_TIME ahead
+ */
+const Vector4& MotionMatcher::getFarTrajectory() const
+{
+    return _farTrajectory;
+}
+
+/**
+ * @return The number of searches run so far
+ */
+std::size_t MotionMatcher::getSearchCount() const
+{
+    return _searchCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Change the desired trajectory, matched from the next search on.
+ *
+ * @param near The desired translation of the torso MOTION_MATCHING_NEAR_TIME ahead, from its current one
+ * @param far The desired translation of the torso MOTION_MATCHING_FAR_TIME ahead, from its current one
+ *
+ * @return itself
+ */
+MotionMatcher& MotionMatcher::setTrajectory(const Vector4& near, const Vector4& far)
+{
+    _nearTrajectory = near;
+    _farTrajectory = far;
+    return *this;
+}
+
+/**
+ * Shift the updates running a search, so that characters given different phases search on different updates.
+ *
+ * @param phase The number of updates to shift the searches by
+ *
+ * @return itself
+ */
+MotionMatcher& MotionMatcher::setSearchPhase(const unsigned int phase)
+{
+    _updates = phase % MOTION_MATCHING_SEARCH_INTERVAL;
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Count an update, searching the database once every MOTION_MATCHING_SEARCH_INTERVAL updates.<br>
+ * The pose itself is evaluated by the player, which must be updated afterward.
+ */
+void MotionMatcher::update()
+{
+    if (++_updates < MOTION_MATCHING_SEARCH_INTERVAL)
+    {
+        return;
+    }
+    _updates = 0;
+    _search();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Search the frame best matching the current pose and the desired trajectory, and crossfade to it unless it is the
+ * frame already playing or saves less than MOTION_MATCHING_MIN_IMPROVEMENT over carrying on.
+ */
+void MotionMatcher::_search()
+{
+    ++_searchCount;
+    const std::size_t current = _database->findFrame(_clip, _player->getTime());
+    MotionDatabase::Features query = _database->getFeatures(current);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        query[MotionDatabase::TRAJECTORY_FEATURES + axis] = _nearTrajectory[axis];
+        query[MotionDatabase::TRAJECTORY_FEATURES + 3 + axis] = _farTrajectory[axis];
+    }
+    query = _database->normalize(query);
+
+    const MotionMatch match = _database->search(query);
+    if (match.frame == MotionDatabase::NO_FRAME)
+    {
+        return;
+    }
+    const MotionFrame frame = _database->getFrame(match.frame);
+    if (frame.clip == _clip)
+    {
+        // The clip loops, so the frame playing may be just before or just after the match across its end
+        const float duration = _database->getClip(_clip)->getDuration();
+        const float ahead = std::fabs(frame.time - _database->getFrame(current).time);
+        if (std::fmin(ahead, duration - ahead) < MOTION_MATCHING_BLEND_DURATION)
+        {
+            return;
+        }
+    }
+    if (match.cost > _database->getCost(current, query) - MOTION_MATCHING_MIN_IMPROVEMENT)
+    {
+        return;
+    }
+    _clip = frame.clip;
+    _player->crossFade(_database->getClip(frame.clip), MOTION_MATCHING_BLEND_DURATION, frame.time);
+}
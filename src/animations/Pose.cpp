@@ -0,0 +1,155 @@
+#include "Pose.hpp"
+#include <algorithm>
+
+/**
+ * @return The weight of a joint, combining the weight of a layer with its mask
+ */
+static float jointWeight(const float weight, const JointMask* mask, const std::size_t joint)
+{
+    return mask ? weight * mask->getWeight(joint) : weight;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a pose setting no channel.
+ *
+ * @param jointCount The number of joints of the skeleton
+ */
+Pose::Pose(const std::size_t jointCount) : _joints(jointCount)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of joints of the pose
+ */
+std::size_t Pose::getJointCount() const
+{
+    return _joints.size();
+}
+
+/**
+ * @return The transformations, indexed by joint
+ */
+std::span<JointPose> Pose::getJoints()
+{
+    return _joints;
+}
+
+/**
+ * @return The transformations, indexed by joint
+ */
+std::span<const JointPose> Pose::getJoints() const
+{
+    return _joints;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Operator overloads
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+JointPose& Pose::operator[](const std::size_t joint)
+{
+    return _joints[joint];
+}
+
+const JointPose& Pose::operator[](const std::size_t joint) const
+{
+    return _joints[joint];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Put every joint back to the rest transformation, setting no channel.
+ */
+void Pose::reset()
+{
+    for (JointPose& joint: _joints)
+    {
+        joint = JointPose();
+    }
+}
+
+/**
+ * Blend another pose over this one: each channel set by the other pose moves toward its value.<br>
+ * The channels this pose does not set hold the rest transformation, so blending over an empty pose fades in from rest.
+ *
+ * @param other The pose to blend in, with at least as many joints
+ * @param weight The weight of the other pose, 0 keeping this pose and 1 replacing it
+ * @param mask The per-joint weights multiplying weight (nullptr for every joint)
+ */
+void Pose::blend(const Pose& other, const float weight, const JointMask* mask)
+{
+    for (std::size_t joint = 0; joint < _joints.size(); ++joint)
+    {
+        const JointPose& source = other._joints[joint];
+        const float factor = std::min(jointWeight(weight, mask, joint), 1.0f);
+        if (source.channels == NO_CHANNEL || factor <= 0.0f)
+        {
+            continue;
+        }
+
+        JointPose& target = _joints[joint];
+        if (source.channels & ROTATION_CHANNEL)
+        {
+            target.rotation = Quaternion::nlerp(target.rotation, source.rotation, factor);
+        }
+        if (source.channels & TRANSLATION_CHANNEL)
+        {
+            target.translation += (source.translation - target.translation) * factor;
+        }
+        if (source.channels & SCALE_CHANNEL)
+        {
+            target.scale += (source.scale - target.scale) * factor;
+        }
+        target.channels |= source.channels;
+    }
+}
+
+/**
+ * Add a pose on top of this one.<br>
+ * The additive pose holds differences from the rest transformation: its rotations are applied after the rotations of
+ * this pose, its translations are added and its scales multiplied.
+ *
+ * @param additive The differences to add, with at least as many joints
+ * @param weight The weight of the differences, 0 adding nothing
+ * @param mask The per-joint weights multiplying weight (nullptr for every joint)
+ */
+void Pose::add(const Pose& additive, const float weight, const JointMask* mask)
+{
+    const Vector4 unitScale(1.0f, 1.0f, 1.0f, 0.0f);
+
+    for (std::size_t joint = 0; joint < _joints.size(); ++joint)
+    {
+        const JointPose& source = additive._joints[joint];
+        const float factor = jointWeight(weight, mask, joint);
+        if (source.channels == NO_CHANNEL || factor <= 0.0f)
+        {
+            continue;
+        }
+
+        JointPose& target = _joints[joint];
+        if (source.channels & ROTATION_CHANNEL)
+        {
+            target.rotation = Quaternion::nlerp(Quaternion::identity(), source.rotation, factor) * target.rotation;
+        }
+        if (source.channels & TRANSLATION_CHANNEL)
+        {
+            target.translation += source.translation * factor;
+        }
+        if (source.channels & SCALE_CHANNEL)
+        {
+            target.scale *= unitScale + (source.scale - unitScale) * factor;
+        }
+        target.channels |= source.channels;
+    }
+}
@@ -0,0 +1,249 @@
+#include "ScriptScheduler.hpp"
+#include <algorithm>
+#include <utility>
+
+/**
+ * @return Whether a timer comes after another, so that the heap built on it keeps the earliest timer first
+ */
+static bool comesLater(const auto& left, const auto& right)
+{
+    return left.time != right.time ? left.time > right.time : left.sequence > right.sequence;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a scheduler at time 0, without any script.
+ */
+ScriptScheduler::ScriptScheduler() : _time(0.0), _sequence(0), _scriptCount(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Destroy the scripts still running.
+ */
+ScriptScheduler::~ScriptScheduler()
+{
+    clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The simulated time in seconds
+ */
+double ScriptScheduler::getTime() const
+{
+    return _time;
+}
+
+/**
+ * @return The number of scripts started and not returned yet
+ */
+std::size_t ScriptScheduler::getScriptCount() const
+{
+    return _scriptCount;
+}
+
+/**
+ * @return The number of scripts waiting for a time
+ */
+std::size_t ScriptScheduler::getWaitingCount() const
+{
+    return _timers.size();
+}
+
+/**
+ * @return The number of tweens in progress
+ */
+std::size_t ScriptScheduler::getTweenCount() const
+{
+    return _tweens.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reserve room for a number of scripts, so that waiting and tweening do not allocate.
+ *
+ * @param scriptCount The number of scripts
+ */
+void ScriptScheduler::reserve(const std::size_t scriptCount)
+{
+    _timers.reserve(scriptCount);
+    _tweens.reserve(scriptCount);
+    _ready.reserve(scriptCount);
+}
+
+/**
+ * Take a script and run it at once, until its first wait.
+ *
+ * @param script The script (nothing happens if it was already started)
+ *
+ * @throw Whatever the script throws before its first wait
+ */
+void ScriptScheduler::start(AnimationScript script)
+{
+    const AnimationScript::Handle handle = script.release();
+    if (!handle)
+    {
+        return;
+    }
+    handle.promise().scheduler = this;
+    ++_scriptCount;
+    _resume(handle, _time);
+}
+
+/**
+ * Move the time forward: the tweens in progress are updated, then the scripts whose time came are resumed.
+ *
+ * @param deltaTime The time in seconds elapsed since the previous update
+ *
+ * @throw The first exception a resumed script ended on, once every due script was resumed
+ */
+void ScriptScheduler::update(const float deltaTime)
+{
+    _time += deltaTime;
+
+    for (std::size_t index = 0; index < _tweens.size();)
+    {
+        const ActiveTween& active = _tweens[index];
+        const double end = active.start + active.tween.duration;
+        if (end > _time)
+        {
+            const float factor = active.tween.curve->evaluate(
+                static_cast<float>((_time - active.start) / active.tween.duration));
+            AnimationScript::setProperty(*active.tween.part,
+                                         active.tween.property,
+                                         active.from + (active.tween.target - active.from) * factor);
+            ++index;
+            continue;
+        }
+        AnimationScript::setProperty(*active.tween.part, active.tween.property, active.tween.target);
+        _ready.push_back({end, active.sequence, active.handle});
+        _tweens[index] = _tweens.back();
+        _tweens.pop_back();
+    }
+    while (!_timers.empty() && _timers.front().time <= _time)
+    {
+        std::ranges::pop_heap(_timers, comesLater<ScriptTimer, ScriptTimer>);
+        _ready.push_back(_timers.back());
+        _timers.pop_back();
+    }
+    if (_ready.empty())
+    {
+        return;
+    }
+
+    // The waits started while resuming go to the queue, they are only looked at by the next update
+    std::ranges::sort(_ready, [](const ScriptTimer& left, const ScriptTimer& right)
+    {
+        return comesLater(right, left);
+    });
+    std::exception_ptr exception;
+    for (const ScriptTimer& timer: _ready)
+    {
+        try
+        {
+            _resume(timer.handle, timer.time);
+        }
+        catch (...)
+        {
+            if (!exception)
+            {
+                exception = std::current_exception();
+            }
+        }
+    }
+    _ready.clear();
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+/**
+ * Destroy every script, leaving the body parts as they are. Must not be called from a script.
+ */
+void ScriptScheduler::clear()
+{
+    for (const ScriptTimer& timer: _timers)
+    {
+        timer.handle.destroy();
+    }
+    for (const ActiveTween& active: _tweens)
+    {
+        active.handle.destroy();
+    }
+    _timers.clear();
+    _tweens.clear();
+    _scriptCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Put a script in the timer queue.
+ *
+ * @param handle The script
+ * @param time The simulated time in seconds to resume it at
+ */
+void ScriptScheduler::_wait(const AnimationScript::Handle handle, const double time)
+{
+    _timers.push_back({time, _sequence++, handle});
+    std::ranges::push_heap(_timers, comesLater<ScriptTimer, ScriptTimer>);
+}
+
+/**
+ * Start a tween from the time the script reached, resuming the script once it ends.
+ *
+ * @param handle The script
+ * @param tween The tween
+ */
+void ScriptScheduler::_tween(const AnimationScript::Handle handle, const AnimationScript::Tween& tween)
+{
+    _tweens.push_back({
+        tween,
+        AnimationScript::getProperty(*tween.part, tween.property),
+        handle.promise().time,
+        _sequence++,
+        handle
+    });
+}
+
+/**
+ * Resume a script until its next wait, destroying it once it returns.
+ *
+ * @param handle The script
+ * @param time The simulated time in seconds its wait ended at
+ *
+ * @throw The exception the script ended on
+ */
+void ScriptScheduler::_resume(const AnimationScript::Handle handle, const double time)
+{
+    handle.promise().time = time;
+    handle.resume();
+    if (!handle.done())
+    {
+        return;
+    }
+    const std::exception_ptr exception = handle.promise().exception;
+    handle.destroy();
+    --_scriptCount;
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
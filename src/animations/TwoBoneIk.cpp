@@ -0,0 +1,617 @@
+#include "TwoBoneIk.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+/**
+ * The arrays of a batch, each holding one value per chain.
+ */
+enum TwoBoneIkField : std::size_t
+{
+    ROOT_X, ROOT_Y, ROOT_Z,
+    UPPER_BONE_X, UPPER_BONE_Y, UPPER_BONE_Z,
+    LOWER_BONE_X, LOWER_BONE_Y, LOWER_BONE_Z,
+    TARGET_X, TARGET_Y, TARGET_Z,
+    POLE_X, POLE_Y, POLE_Z,
+    WEIGHT,
+    MIN_COSINE,     // cosine of the largest angle between the bones
+    MAX_COSINE,     // cosine of the smallest angle between the bones
+    UPPER_W, UPPER_X, UPPER_Y, UPPER_Z,
+    LOWER_W, LOWER_X, LOWER_Y, LOWER_Z,
+    TWO_BONE_IK_FIELD_COUNT
+};
+
+/**
+ * Squared lengths below this value are degenerate: the direction they give is replaced by a fallback.
+ */
+static constexpr float SQUARED_EPSILON = 1e-12f;
+
+/**
+ * The floats in a page of the L1 cache: fields this far apart map onto the same cache sets and evict each other.
+ */
+static constexpr std::size_t CACHE_PAGE_FLOATS = 4096 / sizeof(float);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Lanes
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The solver is written once for a lane type: float solves one chain, FloatLanes four chains with SSE. A comparison
+// gives a mask (bool for float) that select() uses to pick lane by lane without branching.
+
+#if defined(__SSE__)
+/**
+ * Four floats processed together.
+ */
+struct FloatLanes
+{
+    __m128 value;
+
+    FloatLanes(const __m128 lanes) : value(lanes)
+    {
+    }
+
+    FloatLanes(const float scalar) : value(_mm_set1_ps(scalar))
+    {
+    }
+};
+
+static FloatLanes operator+(const FloatLanes a, const FloatLanes b)
+{
+    return _mm_add_ps(a.value, b.value);
+}
+
+static FloatLanes operator-(const FloatLanes a, const FloatLanes b)
+{
+    return _mm_sub_ps(a.value, b.value);
+}
+
+static FloatLanes operator-(const FloatLanes a)
+{
+    return _mm_xor_ps(a.value, _mm_set1_ps(-0.0f));
+}
+
+static FloatLanes operator*(const FloatLanes a, const FloatLanes b)
+{
+    return _mm_mul_ps(a.value, b.value);
+}
+
+static FloatLanes operator/(const FloatLanes a, const FloatLanes b)
+{
+    return _mm_div_ps(a.value, b.value);
+}
+
+static FloatLanes lanesSqrt(const FloatLanes a)
+{
+    return _mm_sqrt_ps(a.value);
+}
+
+static FloatLanes lanesMin(const FloatLanes a, const FloatLanes b)
+{
+    return _mm_min_ps(a.value, b.value);
+}
+
+static FloatLanes lanesMax(const FloatLanes a, const FloatLanes b)
+{
+    return _mm_max_ps(a.value, b.value);
+}
+
+static FloatLanes lanesLess(const FloatLanes a, const FloatLanes b)
+{
+    return _mm_cmplt_ps(a.value, b.value);
+}
+
+static FloatLanes lanesSelect(const FloatLanes mask, const FloatLanes a, const FloatLanes b)
+{
+    return _mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value));
+}
+
+static FloatLanes lanesLoad(const float* data, FloatLanes)
+{
+    return _mm_loadu_ps(data);
+}
+
+static void lanesStore(float* data, const FloatLanes lanes)
+{
+    _mm_storeu_ps(data, lanes.value);
+}
+#endif
+
+static float lanesSqrt(const float a)
+{
+    return std::sqrt(a);
+}
+
+static float lanesMin(const float a, const float b)
+{
+    return std::min(a, b);
+}
+
+static float lanesMax(const float a, const float b)
+{
+    return std::max(a, b);
+}
+
+static bool lanesLess(const float a, const float b)
+{
+    return a < b;
+}
+
+static float lanesSelect(const bool mask, const float a, const float b)
+{
+    return mask ? a : b;
+}
+
+static float lanesLoad(const float* data, float)
+{
+    return *data;
+}
+
+static void lanesStore(float* data, const float lanes)
+{
+    *data = lanes;
+}
+
+/**
+ * A 3D vector per lane.
+ */
+template <typename F>
+struct Vector3Lanes
+{
+    F x;
+    F y;
+    F z;
+};
+
+/**
+ * A quaternion (w, x, y, z) per lane.
+ */
+template <typename F>
+struct QuaternionLanes
+{
+    F w;
+    F x;
+    F y;
+    F z;
+};
+
+template <typename F>
+static Vector3Lanes<F> operator+(const Vector3Lanes<F>& a, const Vector3Lanes<F>& b)
+{
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+template <typename F>
+static Vector3Lanes<F> operator-(const Vector3Lanes<F>& a, const Vector3Lanes<F>& b)
+{
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+template <typename F>
+static Vector3Lanes<F> operator*(const Vector3Lanes<F>& a, const F factor)
+{
+    return {a.x * factor, a.y * factor, a.z * factor};
+}
+
+template <typename F>
+static F dot(const Vector3Lanes<F>& a, const Vector3Lanes<F>& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template <typename F>
+static Vector3Lanes<F> cross(const Vector3Lanes<F>& a, const Vector3Lanes<F>& b)
+{
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+template <typename F>
+static Vector3Lanes<F> select(const auto mask, const Vector3Lanes<F>& a, const Vector3Lanes<F>& b)
+{
+    return {lanesSelect(mask, a.x, b.x), lanesSelect(mask, a.y, b.y), lanesSelect(mask, a.z, b.z)};
+}
+
+/**
+ * @return The Hamilton product of two quaternions, as Quaternion::operator*
+ */
+template <typename F>
+static QuaternionLanes<F> multiply(const QuaternionLanes<F>& a, const QuaternionLanes<F>& b)
+{
+    return {
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w
+    };
+}
+
+template <typename F>
+static QuaternionLanes<F> conjugate(const QuaternionLanes<F>& q)
+{
+    return {q.w, -q.x, -q.y, -q.z};
+}
+
+/**
+ * @return The vector rotated by a unit quaternion, as Quaternion::rotate
+ */
+template <typename F>
+static Vector3Lanes<F> rotate(const QuaternionLanes<F>& q, const Vector3Lanes<F>& v)
+{
+    const Vector3Lanes<F> axis = {q.x, q.y, q.z};
+    const Vector3Lanes<F> twice = cross(axis, v) * F(2.0f);
+    return v + twice * q.w + cross(axis, twice);
+}
+
+/**
+ * @return The quaternion scaled to a length of 1 (the identity if its length is degenerate)
+ */
+template <typename F>
+static QuaternionLanes<F> normalize(const QuaternionLanes<F>& q)
+{
+    const F squaredLength = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+    const auto degenerate = lanesLess(squaredLength, F(SQUARED_EPSILON));
+    const F inverse = F(1.0f) / lanesSqrt(lanesMax(squaredLength, F(SQUARED_EPSILON)));
+    return {
+        lanesSelect(degenerate, F(1.0f), q.w * inverse),
+        lanesSelect(degenerate, F(0.0f), q.x * inverse),
+        lanesSelect(degenerate, F(0.0f), q.y * inverse),
+        lanesSelect(degenerate, F(0.0f), q.z * inverse)
+    };
+}
+
+/**
+ * @return The smallest rotation bringing the direction of a onto the direction of b
+ */
+template <typename F>
+static QuaternionLanes<F> rotationBetween(const Vector3Lanes<F>& a, const Vector3Lanes<F>& b)
+{
+    // (|a||b| + a.b, a x b) normalizes to the rotation around a x b by the angle between a and b, opposite
+    // directions having no such axis give the identity
+    const Vector3Lanes<F> axis = cross(a, b);
+    return normalize<F>({lanesSqrt(dot(a, a) * dot(b, b)) + dot(a, b), axis.x, axis.y, axis.z});
+}
+
+/**
+ * @return The normalized linear interpolation of two quaternions, as Quaternion::nlerp
+ */
+template <typename F>
+static QuaternionLanes<F> nlerp(const QuaternionLanes<F>& from, const QuaternionLanes<F>& to, const F factor)
+{
+    const F cosine = from.w * to.w + from.x * to.x + from.y * to.y + from.z * to.z;
+    const F toWeight = lanesSelect(lanesLess(cosine, F(0.0f)), -factor, factor);
+    const F fromWeight = F(1.0f) - factor;
+    return normalize<F>({
+        from.w * fromWeight + to.w * toWeight,
+        from.x * fromWeight + to.x * toWeight,
+        from.y * fromWeight + to.y * toWeight,
+        from.z * fromWeight + to.z * toWeight
+    });
+}
+
+/**
+ * Solve the chains of a batch from index to index + the number of lanes of F.
+ *
+ * @param fields The arrays of the batch, indexed by TwoBoneIkField
+ * @param index The first chain to solve
+ */
+template <typename F>
+static void solveLanes(float* const* fields, const std::size_t index)
+{
+    const auto load = [fields, index](const std::size_t field)
+    {
+        return lanesLoad(fields[field] + index, F(0.0f));
+    };
+    const auto loadVector = [&load](const std::size_t field)
+    {
+        return Vector3Lanes<F>{load(field), load(field + 1), load(field + 2)};
+    };
+    const auto loadQuaternion = [&load](const std::size_t field)
+    {
+        return QuaternionLanes<F>{load(field), load(field + 1), load(field + 2), load(field + 3)};
+    };
+    const Vector3Lanes<F> upperBone = loadVector(UPPER_BONE_X);
+    const Vector3Lanes<F> lowerBone = loadVector(LOWER_BONE_X);
+    const Vector3Lanes<F> pole = loadVector(POLE_X);
+    const QuaternionLanes<F> upperRotation = loadQuaternion(UPPER_W);
+    const QuaternionLanes<F> lowerRotation = loadQuaternion(LOWER_W);
+
+    // The animated bones in the space of the parent of the chain
+    const QuaternionLanes<F> lowerGlobal = multiply(upperRotation, lowerRotation);
+    const Vector3Lanes<F> upperAnimated = rotate(upperRotation, upperBone);
+    const Vector3Lanes<F> lowerAnimated = rotate(lowerGlobal, lowerBone);
+
+    // The distance to the target, brought within the joint limits by the law of cosines
+    const F upperSquared = dot(upperBone, upperBone);
+    const F lowerSquared = dot(lowerBone, lowerBone);
+    const F upperLength = lanesSqrt(upperSquared);
+    const F lowerLength = lanesSqrt(lowerSquared);
+    const Vector3Lanes<F> toTarget = loadVector(TARGET_X) - loadVector(ROOT_X);
+    const F targetSquared = dot(toTarget, toTarget);
+    const Vector3Lanes<F> direction = select(lanesLess(targetSquared, F(SQUARED_EPSILON)),
+                                             upperAnimated + lowerAnimated,
+                                             toTarget);
+    const Vector3Lanes<F> axis = direction * (F(1.0f) / lanesSqrt(lanesMax(dot(direction, direction),
+                                                                           F(SQUARED_EPSILON))));
+    const F bonesProduct = F(2.0f) * upperLength * lowerLength;
+    const F bendCosine = lanesMin(lanesMax((upperSquared + lowerSquared - targetSquared) / bonesProduct,
+                                           load(MIN_COSINE)),
+                                  load(MAX_COSINE));
+    const F reachSquared = lanesMax(upperSquared + lowerSquared - bonesProduct * bendCosine, F(SQUARED_EPSILON));
+    const F reach = lanesSqrt(reachSquared);
+
+    // The effector seen from the upper joint, along the target axis and along the bend: taken from the bend angle
+    // rather than from the angle at the upper joint, a straight chain stays exactly straight
+    const F bendSine = lanesSqrt(lanesMax(F(1.0f) - bendCosine * bendCosine, F(0.0f)));
+    const F alongAxis = upperLength - lowerLength * bendCosine;
+    const F alongBend = lowerLength * bendSine;
+
+    // The bend direction: the pole (or else the animated bend) without its part along the target axis
+    const Vector3Lanes<F> poleNormal = pole - axis * dot(pole, axis);
+    const Vector3Lanes<F> animatedNormal = upperAnimated - axis * dot(upperAnimated, axis);
+    const Vector3Lanes<F> bend = select(lanesLess(dot(poleNormal, poleNormal), F(SQUARED_EPSILON)),
+                                        animatedNormal,
+                                        poleNormal);
+    const Vector3Lanes<F> bendAxis = bend * (F(1.0f) / lanesSqrt(lanesMax(dot(bend, bend), F(SQUARED_EPSILON))));
+
+    // The solved bones, then the smallest rotations bringing the animated bones onto them
+    const Vector3Lanes<F> upperSolved = (axis * alongAxis + bendAxis * alongBend) * (upperLength / reach);
+    const Vector3Lanes<F> lowerSolved = axis * reach - upperSolved;
+    const QuaternionLanes<F> upperCorrection = rotationBetween(upperAnimated, upperSolved);
+    const QuaternionLanes<F> lowerCorrection = rotationBetween(rotate(upperCorrection, lowerAnimated), lowerSolved);
+    const QuaternionLanes<F> upperResult = normalize(multiply(upperCorrection, upperRotation));
+    const QuaternionLanes<F> lowerResult = normalize(multiply(conjugate(upperResult),
+                                                              multiply(lowerCorrection,
+                                                                       multiply(upperCorrection, lowerGlobal))));
+
+    const F weight = lanesMin(lanesMax(load(WEIGHT), F(0.0f)), F(1.0f));
+    const QuaternionLanes<F> upper = nlerp(upperRotation, upperResult, weight);
+    const QuaternionLanes<F> lower = nlerp(lowerRotation, lowerResult, weight);
+    lanesStore(fields[UPPER_W] + index, upper.w);
+    lanesStore(fields[UPPER_X] + index, upper.x);
+    lanesStore(fields[UPPER_Y] + index, upper.y);
+    lanesStore(fields[UPPER_Z] + index, upper.z);
+    lanesStore(fields[LOWER_W] + index, lower.w);
+    lanesStore(fields[LOWER_X] + index, lower.x);
+    lanesStore(fields[LOWER_Y] + index, lower.y);
+    lanesStore(fields[LOWER_Z] + index, lower.z);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create an empty batch.
+ *
+ * @param capacity The number of chains the batch can hold before it allocates
+ */
+TwoBoneIkBatch::TwoBoneIkBatch(const std::size_t capacity) : _size(0), _capacity(0), _stride(0)
+{
+    reserve(capacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of chains of the batch
+ */
+std::size_t TwoBoneIkBatch::getSize() const
+{
+    return _size;
+}
+
+/**
+ * @return The number of chains the batch can hold before it allocates
+ */
+std::size_t TwoBoneIkBatch::getCapacity() const
+{
+    return _capacity;
+}
+
+/**
+ * @param chain The index of the chain, as returned by add()
+ *
+ * @return The rotation of the upper joint of the chain, solved once solve() ran
+ *
+ * @throw std::out_of_range If the chain does not exist
+ */
+Quaternion TwoBoneIkBatch::getUpperRotation(const std::size_t chain) const
+{
+    if (chain >= _size)
+    {
+        throw std::out_of_range("Chain index out of range");
+    }
+    return {_field(UPPER_W)[chain], _field(UPPER_X)[chain], _field(UPPER_Y)[chain], _field(UPPER_Z)[chain]};
+}
+
+/**
+ * @param chain The index of the chain, as returned by add()
+ *
+ * @return The rotation of the lower joint of the chain, relative to the upper one, solved once solve() ran
+ *
+ * @throw std::out_of_range If the chain does not exist
+ */
+Quaternion TwoBoneIkBatch::getLowerRotation(const std::size_t chain) const
+{
+    if (chain >= _size)
+    {
+        throw std::out_of_range("Chain index out of range");
+    }
+    return {_field(LOWER_W)[chain], _field(LOWER_X)[chain], _field(LOWER_Y)[chain], _field(LOWER_Z)[chain]};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Grow the arrays so that the batch holds at least a number of chains without allocating.
+ *
+ * @param capacity The number of chains
+ */
+void TwoBoneIkBatch::reserve(const std::size_t capacity)
+{
+    if (capacity <= _capacity)
+    {
+        return;
+    }
+    const std::size_t newCapacity = (capacity + 3) / 4 * 4;
+    // Fields a whole number of cache pages apart would all compete for the same sets, so they are shifted by a line
+    std::size_t newStride = (newCapacity + 15) / 16 * 16;
+    if (newStride % CACHE_PAGE_FLOATS == 0)
+    {
+        newStride += 16;
+    }
+    std::vector<float> fields(TWO_BONE_IK_FIELD_COUNT * newStride, 0.0f);
+    for (std::size_t field = 0; field < TWO_BONE_IK_FIELD_COUNT; ++field)
+    {
+        std::copy_n(_field(field), _size, fields.data() + field * newStride);
+    }
+    _fields = std::move(fields);
+    _capacity = newCapacity;
+    _stride = newStride;
+}
+
+/**
+ * Remove every chain, keeping the capacity.
+ */
+void TwoBoneIkBatch::clear()
+{
+    _size = 0;
+}
+
+/**
+ * Add a chain to solve.
+ *
+ * @param chain The geometry of the chain
+ * @param root The rotation center of the upper joint in the space of its parent
+ * @param upperRotation The animated rotation of the upper joint
+ * @param lowerRotation The animated rotation of the lower joint, relative to the upper one
+ * @param target The target of the effector
+ *
+ * @return The index of the chain in the batch
+ */
+std::size_t TwoBoneIkBatch::add(const TwoBoneChain& chain,
+                                const Vector4& root,
+                                const Quaternion& upperRotation,
+                                const Quaternion& lowerRotation,
+                                const IkTarget& target)
+{
+    if (_size == _capacity)
+    {
+        reserve(std::max<std::size_t>(4, _capacity * 2));
+    }
+    const Vector4& pole = target.pole.getX() != 0.0f || target.pole.getY() != 0.0f || target.pole.getZ() != 0.0f
+                              ? target.pole
+                              : chain.pole;
+    const float values[TWO_BONE_IK_FIELD_COUNT] = {
+        root.getX(), root.getY(), root.getZ(),
+        chain.upperBone.getX(), chain.upperBone.getY(), chain.upperBone.getZ(),
+        chain.lowerBone.getX(), chain.lowerBone.getY(), chain.lowerBone.getZ(),
+        target.position.getX(), target.position.getY(), target.position.getZ(),
+        pole.getX(), pole.getY(), pole.getZ(),
+        target.weight,
+        std::cos(chain.maxAngle),
+        std::cos(chain.minAngle),
+        upperRotation.getW(), upperRotation.getX(), upperRotation.getY(), upperRotation.getZ(),
+        lowerRotation.getW(), lowerRotation.getX(), lowerRotation.getY(), lowerRotation.getZ()
+    };
+    for (std::size_t field = 0; field < TWO_BONE_IK_FIELD_COUNT; ++field)
+    {
+        _field(field)[_size] = values[field];
+    }
+    return _size++;
+}
+
+/**
+ * Add a chain to solve from an animated pose.<br>
+ * A joint whose rotation is not set by the pose is taken at rest, the translation of the upper joint moves the root.
+ *
+ * @param chain The geometry of the chain
+ * @param pose The animated pose
+ * @param target The target of the effector
+ *
+ * @return The index of the chain in the batch
+ */
+std::size_t TwoBoneIkBatch::add(const TwoBoneChain& chain, const Pose& pose, const IkTarget& target)
+{
+    const JointPose& upper = pose[chain.upperJoint];
+    const JointPose& lower = pose[chain.lowerJoint];
+    Vector4 root = chain.root;
+    if (upper.channels & TRANSLATION_CHANNEL)
+    {
+        root = root + upper.translation;
+    }
+    return add(chain,
+               root,
+               upper.channels & ROTATION_CHANNEL ? upper.rotation : Quaternion::identity(),
+               lower.channels & ROTATION_CHANNEL ? lower.rotation : Quaternion::identity(),
+               target);
+}
+
+/**
+ * Solve every chain of the batch, four at a time where SSE is available.
+ */
+void TwoBoneIkBatch::solve()
+{
+    float* fields[TWO_BONE_IK_FIELD_COUNT];
+    for (std::size_t field = 0; field < TWO_BONE_IK_FIELD_COUNT; ++field)
+    {
+        fields[field] = _field(field);
+    }
+    std::size_t index = 0;
+#if defined(__SSE__)
+    for (; index + 4 <= _size; index += 4)
+    {
+        solveLanes<FloatLanes>(fields, index);
+    }
+#endif
+    for (; index < _size; ++index)
+    {
+        solveLanes<float>(fields, index);
+    }
+}
+
+/**
+ * Write the solved rotations of a chain to a pose.
+ *
+ * @param chain The index of the chain, as returned by add()
+ * @param definition The geometry the chain was added with
+ * @param pose The pose to write to, usually the one the chain was added from
+ *
+ * @throw std::out_of_range If the chain does not exist
+ */
+void TwoBoneIkBatch::writeTo(const std::size_t chain, const TwoBoneChain& definition, Pose& pose) const
+{
+    JointPose& upper = pose[definition.upperJoint];
+    JointPose& lower = pose[definition.lowerJoint];
+    upper.rotation = getUpperRotation(chain);
+    upper.channels |= ROTATION_CHANNEL;
+    lower.rotation = getLowerRotation(chain);
+    lower.channels |= ROTATION_CHANNEL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The array of a field, holding one value per chain
+ */
+float* TwoBoneIkBatch::_field(const std::size_t field)
+{
+    return _fields.data() + field * _stride;
+}
+
+/**
+ * @return The array of a field, holding one value per chain
+ */
+const float* TwoBoneIkBatch::_field(const std::size_t field) const
+{
+    return _fields.data() + field * _stride;
+}
@@ -1,7 +1,9 @@
 #include "BodyPart.hpp"
 
+#include <algorithm>
 #include <BodyPartDefines.hpp>
 #include <BufferManager.hpp>
+#include <cmath>
 #include <Logger.hpp>
 
 int BodyPart::_faceCount = 6;
@@ -11,9 +13,16 @@ int BodyPart::_verticesPerBodyPart = _faceCount * _verticesPerFace;
 // Constructors
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-BodyPart::BodyPart() : _rotationMatrix(Matrix4::identity()),
-                       _translationMatrix(Matrix4::identity()),
-                       _scaleMatrix(Matrix4::identity())
+/**
+ * Create a body part.
+ *
+ * @param rendering How its cube is drawn: with VERTEX_RENDERING its vertices and colors take room in the BufferManager
+ * buffers, with INSTANCED_RENDERING it only has a world matrix
+ */
+BodyPart::BodyPart(const BodyPartRendering rendering) : _rotationMatrix(Matrix4::identity()),
+                                                        _translationMatrix(Matrix4::identity()),
+                                                        _scaleMatrix(Matrix4::identity()),
+                                                        _worldMatrix(Matrix4::identity())
 {
     _red = _defaultRed;
     _green = _defaultGreen;
@@ -21,11 +30,17 @@ BodyPart::BodyPart() : _rotationMatrix(Matrix4::identity()),
 
     _pivotPoint = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
 
-    _trianglesColorsBuffer = _getTrianglesColorsBuffer();
-    _trianglesVerticesBuffer = _getTrianglesVerticesBuffer();
-
-    _trianglesVerticesBufferIndex = BufferManager::add(TRIANGLES_VERTICES, _trianglesVerticesBuffer);
-    _trianglesColorsBufferIndex = BufferManager::add(TRIANGLES_COLORS, _trianglesColorsBuffer);
+    if (rendering == INSTANCED_RENDERING)
+    {
+        _trianglesVerticesBufferIndex = NO_BUFFER;
+        _trianglesColorsBufferIndex = NO_BUFFER;
+        return;
+    }
+    // The cube is written straight into the shared buffers, the body part only keeps its indices
+    _trianglesVerticesBufferIndex = BufferManager::allocate(TRIANGLES_VERTICES, _verticesPerBodyPart * 3);
+    _trianglesColorsBufferIndex = BufferManager::allocate(TRIANGLES_COLORS, _verticesPerBodyPart * 3);
+    _fillTrianglesVertices(BufferManager::getData(TRIANGLES_VERTICES, _trianglesVerticesBufferIndex));
+    _fillTrianglesColors(BufferManager::getData(TRIANGLES_COLORS, _trianglesColorsBufferIndex));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -33,11 +48,19 @@ BodyPart::BodyPart() : _rotationMatrix(Matrix4::identity()),
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * @return The matrix stack of the body part
+ * @return The number of vertices of the cube of a body part, two triangles per face
+ */
+int BodyPart::getVertexCount()
+{
+    return _verticesPerBodyPart;
+}
+
+/**
+ * @return The world matrix of the body part computed by the last call to applyTransformation()
  */
-[[nodiscard]] Matrix4 BodyPart::getMatrixStack() const
+[[nodiscard]] const Matrix4& BodyPart::getWorldMatrix() const
 {
-    return _matrixStack.top();
+    return _worldMatrix;
 }
 
 [[nodiscard]] Matrix4 BodyPart::getScaleMatrix() const
@@ -45,6 +68,94 @@ BodyPart::BodyPart() : _rotationMatrix(Matrix4::identity()),
     return _scaleMatrix;
 }
 
+/**
+ * @return The world coordinates (x, y, z) of the triangle vertices computed by the last call to applyTransformation()
+ * (empty if the body part is drawn by instancing)
+ */
+[[nodiscard]] std::span<const float> BodyPart::getVertices() const
+{
+    if (_trianglesVerticesBufferIndex == NO_BUFFER)
+    {
+        return {};
+    }
+    return {BufferManager::getData(TRIANGLES_VERTICES, _trianglesVerticesBufferIndex),
+            static_cast<std::size_t>(_verticesPerBodyPart) * 3};
+}
+
+/**
+ * @return The red, green and blue the body part is drawn with when it is not highlighted
+ */
+std::array<int, 3> BodyPart::getDefaultColor() const
+{
+    return {static_cast<int>(_defaultRed), static_cast<int>(_defaultGreen), static_cast<int>(_defaultBlue)};
+}
+
+/**
+ * @return The angle of rotation around the X axis
+ */
+float BodyPart::getXRotation() const
+{
+    if (!_anglesOutdated)
+    {
+        return _angleX;
+    }
+    float angleX, angleY, angleZ;
+    _computeAngles(angleX, angleY, angleZ);
+    return angleX;
+}
+
+/**
+ * @return The angle of rotation around the Y axis
+ */
+float BodyPart::getYRotation() const
+{
+    if (!_anglesOutdated)
+    {
+        return _angleY;
+    }
+    float angleX, angleY, angleZ;
+    _computeAngles(angleX, angleY, angleZ);
+    return angleY;
+}
+
+/**
+ * @return The angle of rotation around the Z axis
+ */
+float BodyPart::getZRotation() const
+{
+    if (!_anglesOutdated)
+    {
+        return _angleZ;
+    }
+    float angleX, angleY, angleZ;
+    _computeAngles(angleX, angleY, angleZ);
+    return angleZ;
+}
+
+/**
+ * @return The translate x value
+ */
+float BodyPart::getTranslateX() const
+{
+    return _translateX;
+}
+
+/**
+ * @return The translate y value
+ */
+float BodyPart::getTranslateY() const
+{
+    return _translateY;
+}
+
+/**
+ * @return The translate z value
+ */
+float BodyPart::getTranslateZ() const
+{
+    return _translateZ;
+}
+
 /**
  * @return The transformation matrix of the body part
  */
@@ -162,6 +273,7 @@ BodyPart& BodyPart::setPivotPoint(const Vector4& pivotPoint)
  */
 BodyPart& BodyPart::setXRotation(const float angle)
 {
+    _updateAngles();
     _angleX = angle;
     _rotationMatrix = Matrix4::createRotationMatrix(angle, _angleY, _angleZ);
     return *this;
@@ -176,6 +288,7 @@ BodyPart& BodyPart::setXRotation(const float angle)
  */
 BodyPart& BodyPart::setYRotation(const float angle)
 {
+    _updateAngles();
     _angleY = angle;
     _rotationMatrix = Matrix4::createRotationMatrix(_angleX, angle, _angleZ);
     return *this;
@@ -190,11 +303,27 @@ BodyPart& BodyPart::setYRotation(const float angle)
  */
 BodyPart& BodyPart::setZRotation(const float angle)
 {
+    _updateAngles();
     _angleZ = angle;
     _rotationMatrix = Matrix4::createRotationMatrix(_angleX, _angleY, angle);
     return *this;
 }
 
+/**
+ * Set the rotation of the body part.<br>
+ * The X, Y and Z angles are only recomputed when an angle is needed again.
+ *
+ * @param rotation The new rotation
+ *
+ * @return itself
+ */
+BodyPart& BodyPart::setRotation(const Quaternion& rotation)
+{
+    _rotationMatrix = rotation.toMatrix();
+    _anglesOutdated = true;
+    return *this;
+}
+
 /**
  * Set the X translation of the body part.
  *
@@ -237,6 +366,42 @@ BodyPart& BodyPart::setTranslateZ(const float z)
     return *this;
 }
 
+/**
+ * Set the translation of the body part.
+ *
+ * @param x The new x value
+ * @param y The new y value
+ * @param z The new z value
+ *
+ * @return itself
+ */
+BodyPart& BodyPart::setTranslation(const float x, const float y, const float z)
+{
+    _translateX = x;
+    _translateY = y;
+    _translateZ = z;
+    _translationMatrix = Matrix4::createTranslationMatrix(x, y, z);
+    return *this;
+}
+
+/**
+ * Set the scale applied by the animations.<br>
+ * Unlike scale(), it only resizes the cube of the body part and does not move its children.
+ *
+ * @param x The new x scale
+ * @param y The new y scale
+ * @param z The new z scale
+ *
+ * @return itself
+ */
+BodyPart& BodyPart::setPoseScale(const float x, const float y, const float z)
+{
+    _poseScaleX = x;
+    _poseScaleY = y;
+    _poseScaleZ = z;
+    return *this;
+}
+
 /**
  * Set the parent relative shift of the body part.
  *
@@ -284,6 +449,7 @@ BodyPart& BodyPart::setOwnRelativeShift(const float x, const float y, const floa
  */
 BodyPart& BodyPart::rotateX(const float angle)
 {
+    _updateAngles();
     _angleX += angle;
     _rotationMatrix = _rotationMatrix * Matrix4::createRotationXMatrix(angle);
     return *this;
@@ -298,6 +464,7 @@ BodyPart& BodyPart::rotateX(const float angle)
  */
 BodyPart& BodyPart::rotateY(const float angle)
 {
+    _updateAngles();
     _angleY += angle;
     _rotationMatrix = _rotationMatrix * Matrix4::createRotationYMatrix(angle);
     return *this;
@@ -312,6 +479,7 @@ BodyPart& BodyPart::rotateY(const float angle)
  */
 BodyPart& BodyPart::rotateZ(const float angle)
 {
+    _updateAngles();
     _angleZ += angle;
     _rotationMatrix = _rotationMatrix * Matrix4::createRotationZMatrix(angle);
     return *this;
@@ -358,18 +526,20 @@ BodyPart& BodyPart::scale(const float x, const float y, const float z)
                                              _pivotPoint.getZ() * z,
                                              1.0f);
     setPivotPoint(scaledPivotPoint);
-    for (const auto& child: _children)
+    for (BodyPart& child: _getChildren())
     {
         // Update translate to match the new scale
-        child->setParentRelativeShift(child->_parentRelativeShiftX * x,
-                                      child->_parentRelativeShiftY * y,
-                                      child->_parentRelativeShiftZ * z);
+        child.setParentRelativeShift(child._parentRelativeShiftX * x,
+                                     child._parentRelativeShiftY * y,
+                                     child._parentRelativeShiftZ * z);
     }
     return *this;
 }
 
 /**
- * Add a child to the body part.
+ * Add a child to the body part.<br>
+ * Children are stored as a range: the child must directly follow the previously added one in memory (see
+ * BodyPartPool::allocate()).
  *
  * @param child The child to add
  *
@@ -377,7 +547,16 @@ BodyPart& BodyPart::scale(const float x, const float y, const float z)
  */
 BodyPart& BodyPart::addChild(BodyPart* child)
 {
-    _children.push_back(child);
+    if (_childCount == 0)
+    {
+        _firstChildOffset = child - this;
+    }
+    else if (child != this + _firstChildOffset + _childCount)
+    {
+        Logger::error("BodyPart::addChild(): Children must be adjacent to each other.");
+        return *this;
+    }
+    _childCount++;
     child->setParent(this);
     return *this;
 }
@@ -388,57 +567,86 @@ BodyPart& BodyPart::addChild(BodyPart* child)
 void BodyPart::applyTransformation()
 {
     // If node does not have a parent, it is the target axis so it must not go through any additional transformation
-    const Matrix4 parentMatrix = this->_parent ? this->_parent->getMatrixStack() : Matrix4::identity();
-    const Matrix4 ownMatrix = parentMatrix * getTransformationMatrix();
-
-    _matrixStack.push(ownMatrix);
+    applyWorldMatrix(_parent ? _parent->_worldMatrix * getTransformationMatrix() : getTransformationMatrix());
 
-    for (BodyPart* child: _children)
+    for (BodyPart& child: _getChildren())
     {
-        child->applyTransformation();
+        child.applyTransformation();
     }
+}
+
+/**
+ * Apply all transformation to the body part alone, writing its cube to an instance instead of to its vertices.<br>
+ * The children are left untouched and the parent must have been transformed first: Human::applyTransformation() goes
+ * through the body parts of a human in storage order, where parents come before their children.
+ *
+ * @param instance The instance of the cube of the body part
+ */
+void BodyPart::applyTransformation(BodyPartInstance& instance)
+{
+    applyWorldMatrix(_parent ? _parent->_worldMatrix * getTransformationMatrix() : getTransformationMatrix(), instance);
+}
 
-    // Draw the cube
-    _trianglesVerticesBuffer = _getTrianglesVerticesBuffer();
-    for (int i = 0; i < _trianglesVerticesBuffer.size(); i += 3)
+/**
+ * Place the body part alone with a world matrix computed elsewhere, and draw its cube into the shared buffers (nothing
+ * is drawn if it is drawn by instancing). The children are left untouched.
+ *
+ * @param worldMatrix The world matrix, the one of the parent times getTransformationMatrix()
+ */
+void BodyPart::applyWorldMatrix(const Matrix4& worldMatrix)
+{
+    _worldMatrix = worldMatrix;
+    if (_trianglesVerticesBufferIndex == NO_BUFFER)
     {
-        const float x = _trianglesVerticesBuffer[i + 0];
-        const float y = _trianglesVerticesBuffer[i + 1];
-        const float z = _trianglesVerticesBuffer[i + 2];
-        Vector4 vertex = Vector4(x, y, z, 1.0f);
-        vertex = _matrixStack.top() * vertex;
-        _trianglesVerticesBuffer[i + 0] = vertex.getX();
-        _trianglesVerticesBuffer[i + 1] = vertex.getY();
-        _trianglesVerticesBuffer[i + 2] = vertex.getZ();
+        return;
     }
-    _trianglesColorsBuffer = _getTrianglesColorsBuffer();
+    float* vertices = BufferManager::getData(TRIANGLES_VERTICES, _trianglesVerticesBufferIndex);
+    _fillTrianglesVertices(vertices);
+    // In place: transformPoints() stores only x, y and z, so no point is overwritten before it is read
+    _worldMatrix.transformPoints(vertices, vertices, _verticesPerBodyPart);
+    _fillTrianglesColors(BufferManager::getData(TRIANGLES_COLORS, _trianglesColorsBufferIndex));
+}
 
-    _trianglesVerticesBufferIndex = BufferManager::modify(TRIANGLES_VERTICES,
-                                                          _trianglesVerticesBufferIndex,
-                                                          _trianglesVerticesBuffer);
-    _trianglesColorsBufferIndex = BufferManager::modify(TRIANGLES_COLORS,
-                                                        _trianglesColorsBufferIndex,
-                                                        _trianglesColorsBuffer);
+/**
+ * Place the body part alone with a world matrix computed elsewhere, and write its cube to an instance.
+ *
+ * @param worldMatrix The world matrix, the one of the parent times getTransformationMatrix()
+ * @param instance The instance of the cube of the body part
+ */
+void BodyPart::applyWorldMatrix(const Matrix4& worldMatrix, BodyPartInstance& instance)
+{
+    _worldMatrix = worldMatrix;
 
-    _matrixStack.pop();
+    // The unit cube is stretched to the size of the body part, which scales the columns of the world matrix
+    const Vector4 size = _getCubeSize();
+    const float columnScales[3] = {size.getX(), size.getY(), size.getZ()};
+    const float* world = _worldMatrix.getData();
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int column = 0; column < 3; ++column)
+        {
+            instance.rows[row * 4 + column] = world[row * 4 + column] * columnScales[column];
+        }
+        instance.rows[row * 4 + 3] = world[row * 4 + 3];
+    }
+    instance.color[0] = _red / 255.0f;
+    instance.color[1] = _green / 255.0f;
+    instance.color[2] = _blue / 255.0f;
+    instance.color[3] = 1.0f;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Private getters
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
 /**
- * @return The buffer containing all the triangles vertices
+ * Write the vertices of a cube centered on the origin, two triangles per face.
+ *
+ * @param vertices The destination, with room for the x, y and z of getVertexCount() vertices
+ * @param halfWidth Half the size of the cube along x
+ * @param halfHeight Half the size of the cube along y
+ * @param halfDepth Half the size of the cube along z
  */
-std::vector<float> BodyPart::_getTrianglesVerticesBuffer() const
+void BodyPart::fillCubeVertices(float* vertices, const float halfWidth, const float halfHeight, const float halfDepth)
 {
-    const Vector4 scaleVector = _scaleMatrix * Vector4(1.0f, 1.0f, 1.0f, 1.0f);
-    float halfWidth = LENGTH_BASE_UNIT * scaleVector.getX() / 2.0f;
-    float halfHeight = LENGTH_BASE_UNIT * scaleVector.getY() / 2.0f;
-    float halfDepth = LENGTH_BASE_UNIT * scaleVector.getZ() / 2.0f;
-
     //@formatter:off
-    return {
+    const float cubeVertices[] = {
         // Face avant
         -halfWidth, -halfHeight, halfDepth,
          halfWidth, -halfHeight, halfDepth,
@@ -488,19 +696,83 @@ std::vector<float> BodyPart::_getTrianglesVerticesBuffer() const
         -halfWidth, -halfHeight,  halfDepth
     };
     //@formatter:on
+    std::ranges::copy(cubeVertices, vertices);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The children of the body part
+ */
+std::span<BodyPart> BodyPart::_getChildren()
+{
+    return {this + _firstChildOffset, _childCount};
+}
+
+/**
+ * Compute the X, Y and Z angles of the rotation matrix.
+ *
+ * @param angleX The angle around the X axis
+ * @param angleY The angle around the Y axis
+ * @param angleZ The angle around the Z axis
+ */
+void BodyPart::_computeAngles(float& angleX, float& angleY, float& angleZ) const
+{
+    // The rotation matrix is X * Y * Z (see Quaternion::toEulerAngles())
+    const float* data = _rotationMatrix.getData();
+    angleY = std::asin(std::clamp(data[2], -1.0f, 1.0f));
+    angleX = std::atan2(-data[6], data[10]);
+    angleZ = std::atan2(-data[1], data[0]);
 }
 
 /**
- * @return The buffer containing all the triangles colors
+ * Recompute the X, Y and Z angles from the rotation matrix if setRotation() changed it.
+ */
+void BodyPart::_updateAngles()
+{
+    if (!_anglesOutdated)
+    {
+        return;
+    }
+    _computeAngles(_angleX, _angleY, _angleZ);
+    _anglesOutdated = false;
+}
+
+/**
+ * @return The width, height and depth of the cube, negative along the axes it is mirrored on
+ */
+Vector4 BodyPart::_getCubeSize() const
+{
+    const Vector4 scaleVector = _scaleMatrix * Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+    return Vector4(LENGTH_BASE_UNIT * scaleVector.getX() * _poseScaleX,
+                   LENGTH_BASE_UNIT * scaleVector.getY() * _poseScaleY,
+                   LENGTH_BASE_UNIT * scaleVector.getZ() * _poseScaleZ);
+}
+
+/**
+ * Write the vertices of the scaled cube.
+ *
+ * @param vertices The destination, with room for the x, y and z of every vertex of the body part
+ */
+void BodyPart::_fillTrianglesVertices(float* vertices) const
+{
+    const Vector4 size = _getCubeSize();
+    fillCubeVertices(vertices, size.getX() / 2.0f, size.getY() / 2.0f, size.getZ() / 2.0f);
+}
+
+/**
+ * Write the current color of every vertex.
+ *
+ * @param colors The destination, with room for the r, g and b of every vertex of the body part
  */
-std::vector<float> BodyPart::_getTrianglesColorsBuffer() const
+void BodyPart::_fillTrianglesColors(float* colors) const
 {
-    std::vector<float> colors;
     for (int i = 0; i < _verticesPerBodyPart; i++)
     {
-        colors.push_back(_red / 255.0f);
-        colors.push_back(_green / 255.0f);
-        colors.push_back(_blue / 255.0f);
+        colors[i * 3 + 0] = _red / 255.0f;
+        colors[i * 3 + 1] = _green / 255.0f;
+        colors[i * 3 + 2] = _blue / 255.0f;
     }
-    return colors;
 }
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "BodyPartPool.hpp"
+#include <algorithm>
+#include <BodyPartDefines.hpp>
+#include <Logger.hpp>
+#include <memory>
+#include <new>
+
+BodyPartPool* BodyPartPool::_instance = nullptr;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Free the chunks.<br>
+ * Every range must have been released beforehand, as the remaining body parts are not destroyed.
+ */
+BodyPartPool::~BodyPartPool()
+{
+    if (_size > 0)
+    {
+        Logger::warning("BodyPartPool::~BodyPartPool(): %zu body parts were never released.", _size);
+    }
+    for (const Chunk& chunk: _chunks)
+    {
+        std::allocator<BodyPart>().deallocate(chunk.data, chunk.capacity);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The unique instance of the pool
+ */
+BodyPartPool& BodyPartPool::getInstance()
+{
+    if (_instance == nullptr)
+    {
+        _instance = new BodyPartPool();
+    }
+    return *_instance;
+}
+
+/**
+ * @param handle The handle returned by allocate() (plus an offset inside its range)
+ *
+ * @return The body part
+ */
+BodyPart& BodyPartPool::get(const BodyPartHandle handle) const
+{
+    // Chunks are sorted by first handle, the body part lives in the last chunk starting before it
+    const auto chunk = std::ranges::upper_bound(_chunks, handle, {}, &Chunk::first) - 1;
+    return chunk->data[handle - chunk->first];
+}
+
+/**
+ * @return The number of live body parts
+ */
+std::size_t BodyPartPool::getSize() const
+{
+    return _size;
+}
+
+/**
+ * @return The number of body parts the chunks can hold
+ */
+std::size_t BodyPartPool::getCapacity() const
+{
+    std::size_t capacity = 0;
+    for (const Chunk& chunk: _chunks)
+    {
+        capacity += chunk.capacity;
+    }
+    return capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Make sure the next count body parts can be allocated without taking memory from the heap.<br>
+ * A single chunk is allocated when the last one is too small.
+ *
+ * @param count The number of body parts about to be allocated
+ */
+void BodyPartPool::reserve(const std::size_t count)
+{
+    if (_chunks.empty() || _chunks.back().capacity - _chunks.back().used < count)
+    {
+        _addChunk(count);
+    }
+}
+
+/**
+ * Allocate and construct count adjacent body parts.
+ *
+ * @param count The number of body parts of the range
+ * @param rendering How the cubes of the body parts are drawn
+ *
+ * @return The handle of the first body part, the others follow it
+ */
+BodyPartHandle BodyPartPool::allocate(const std::size_t count, const BodyPartRendering rendering)
+{
+    BodyPartHandle first;
+    const auto freeRange = std::ranges::find_if(_freeRanges, [count](const FreeRange& range)
+    {
+        return range.count >= count;
+    });
+
+    if (freeRange != _freeRanges.end())
+    {
+        first = freeRange->first;
+        freeRange->first += count;
+        freeRange->count -= count;
+        if (freeRange->count == 0)
+        {
+            _freeRanges.erase(freeRange);
+        }
+    }
+    else
+    {
+        reserve(count);
+        Chunk& chunk = _chunks.back();
+        first = chunk.first + chunk.used;
+        chunk.used += count;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        new(&get(first + i)) BodyPart(rendering);
+    }
+    _size += count;
+    return first;
+}
+
+/**
+ * Destroy a range of body parts and make it available again.
+ *
+ * @param first The handle returned by allocate()
+ * @param count The number of body parts of the range
+ */
+void BodyPartPool::release(const BodyPartHandle first, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::destroy_at(&get(first + i));
+    }
+    _freeRanges.push_back({first, count});
+    _size -= count;
+}
+
+/**
+ * Delete the instance of the pool.
+ */
+void BodyPartPool::deletePool()
+{
+    delete _instance;
+    _instance = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Allocate a new chunk, used by the next allocations.
+ *
+ * @param capacity The minimum number of body parts of the chunk
+ */
+void BodyPartPool::_addChunk(const std::size_t capacity)
+{
+    if (!_chunks.empty() && _chunks.back().used < _chunks.back().capacity)
+    {
+        // Keep the end of the previous chunk for smaller allocations
+        Chunk& last = _chunks.back();
+        _freeRanges.push_back({static_cast<BodyPartHandle>(last.first + last.used), last.capacity - last.used});
+        last.used = last.capacity;
+    }
+    const BodyPartHandle first = _chunks.empty() ? 0 : _chunks.back().first + _chunks.back().capacity;
+    const std::size_t chunkCapacity = std::max<std::size_t>(capacity, BODY_PART_POOL_CHUNK_SIZE);
+
+    _chunks.push_back({first, chunkCapacity, 0, std::allocator<BodyPart>().allocate(chunkCapacity)});
+}
@@ -0,0 +1,254 @@
+#include "Crowd.hpp"
+#include <algorithm>
+#include <BodyPartPool.hpp>
+#include <BufferManager.hpp>
+#include <cmath>
+#include <random>
+#include <RenderSystem.hpp>
+#include <SkeletonFileException.hpp>
+#include <TransformSystem.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create the humans of a crowd, placed row after row on a square grid centered on the x axis and going along z, and
+ * draw the animation and the phase of each one.
+ *
+ * @param size The number of humans (at most MAX_SIZE with INSTANCED_RENDERING)
+ * @param rendering How the humans are drawn
+ * @param seed The seed of the animations and phases, the same seed giving the same crowd
+ * @param skeletons The definitions the humans are built from in turn, with the joints of a human (the built-in human
+ * if empty)
+ *
+ * @throw SkeletonFileException If a definition does not have the joints of a human
+ */
+Crowd::Crowd(const std::size_t size,
+             const BodyPartRendering rendering,
+             const std::uint32_t seed,
+             const std::span<const SkeletonDefinition> skeletons)
+    : _rendering(rendering), _selected(nullptr)
+{
+    BodyPartPool::getInstance().reserve(BodyPartPool::getInstance().getSize() + size * HUMAN_JOINT_COUNT);
+    _registry.reserve(size, size * HUMAN_JOINT_COUNT, rendering == INSTANCED_RENDERING ? size * HUMAN_JOINT_COUNT : 0);
+    _animations.reserve(size);
+
+    for (const SkeletonDefinition& skeleton: skeletons)
+    {
+        if (!Human::isHumanSkeleton(skeleton))
+        {
+            throw SkeletonFileException("The skeleton does not have the joints of a human");
+        }
+    }
+
+    std::mt19937 random(seed);
+    const auto columns = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(size))));
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        const Entity entity = _registry.create();
+        const SkeletonDefinition& skeleton = skeletons.empty()
+                                                 ? Human::getDefaultSkeleton()
+                                                 : skeletons[index % skeletons.size()];
+        Human* human = _registry.getSkeletons().insert(entity, {new Human(skeleton, rendering)}).human;
+        _registry.addTransform(entity, Human::getJointParents());
+        if (rendering == INSTANCED_RENDERING)
+        {
+            _registry.addRender(entity, HUMAN_JOINT_COUNT);
+        }
+        const float column = static_cast<float>(index % columns) - static_cast<float>(columns - 1) / 2.0f;
+        const float row = static_cast<float>(index / columns);
+        human->setPosition(Vector4(column * CROWD_GRID_SPACING, 0.0f, row * CROWD_GRID_SPACING));
+
+        const auto type = static_cast<AnimationType>(random() % ANIMATION_TYPE_COUNT);
+        const float phase = static_cast<float>(random()) / 4294967296.0f;
+        _animations.push_back({type, phase * AnimationManager::getClip(type)->getDuration()});
+    }
+    // The keyboard controls the human of the first row in front of the camera
+    if (size > 0)
+    {
+        _selected = getHuman((std::min(columns, size) - 1) / 2);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Crowd::~Crowd()
+{
+    for (const SkeletonComponent& skeleton: _registry.getSkeletons().getComponents())
+    {
+        delete skeleton.human;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of humans
+ */
+std::size_t Crowd::getSize() const
+{
+    return _registry.getEntityCount();
+}
+
+/**
+ * @return The entities of the humans and their components
+ */
+CharacterRegistry& Crowd::getRegistry()
+{
+    return _registry;
+}
+
+/**
+ * @return How the humans are drawn
+ */
+BodyPartRendering Crowd::getRendering() const
+{
+    return _rendering;
+}
+
+/**
+ * @param index The index of the human, row after row of the grid
+ *
+ * @return The human
+ */
+Human* Crowd::getHuman(const std::size_t index) const
+{
+    return _registry.getSkeletons().find(static_cast<Entity>(index))->human;
+}
+
+/**
+ * @param index The index of the human
+ *
+ * @return The animation the human plays
+ */
+const CrowdAnimation& Crowd::getAnimation(const std::size_t index) const
+{
+    return _animations[index];
+}
+
+/**
+ * @return The instances of the body parts written by the last call to applyTransformation(), HUMAN_JOINT_COUNT per
+ * human (empty with VERTEX_RENDERING)
+ */
+std::span<const BodyPartInstance> Crowd::getInstances() const
+{
+    return _registry.getInstances();
+}
+
+/**
+ * @return The human controlled by the keyboard (nullptr if the crowd is empty)
+ */
+Human* Crowd::getSelected() const
+{
+    return _selected;
+}
+
+/**
+ * Find the human drawn on a pixel of the picking pass.
+ *
+ * @param color The red, green and blue of the pixel
+ *
+ * @return The human (nullptr for the background)
+ */
+Human* Crowd::findHuman(const std::array<int, 3>& color) const
+{
+    if (_rendering == VERTEX_RENDERING)
+    {
+        return _selected && _selected->findBodyPart(color) ? _selected : nullptr;
+    }
+    const PickedBodyPart picked = RenderSystem::pick(_registry, color);
+    return picked.entity == CharacterRegistry::NO_ENTITY ? nullptr : getHuman(picked.entity);
+}
+
+/**
+ * Find the body part drawn on a pixel of the picking pass.
+ *
+ * @param color The red, green and blue of the pixel
+ *
+ * @return The body part (nullptr for the background)
+ */
+BodyPart* Crowd::findBodyPart(const std::array<int, 3>& color) const
+{
+    if (_rendering == VERTEX_RENDERING)
+    {
+        return _selected ? _selected->findBodyPart(color) : nullptr;
+    }
+    const PickedBodyPart picked = RenderSystem::pick(_registry, color);
+    if (picked.entity == CharacterRegistry::NO_ENTITY)
+    {
+        return nullptr;
+    }
+    return getHuman(picked.entity)->getBodyPart(static_cast<HumanJoint>(picked.joint));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @param human The human controlled by the keyboard, one of the crowd
+ *
+ * @return itself
+ */
+Crowd& Crowd::setSelected(Human* human)
+{
+    _selected = human;
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Give every human a player of the AnimationManager, playing its animation from its start time, as its
+ * AnimationComponent.<br>
+ * The players of the same animation share its clip.
+ */
+void Crowd::animate()
+{
+    for (const Entity entity: _registry.getSkeletons().getEntities())
+    {
+        const CrowdAnimation& animation = _animations[entity];
+        AnimationPlayer* player = AnimationManager::addPlayer(getHuman(entity), animation.type, animation.startTime);
+        _registry.getAnimations().insert(entity, {player});
+    }
+}
+
+/**
+ * Transform a range of humans, to their instances or to their vertices depending on the rendering.<br>
+ * Ranges that do not overlap write to different memory and can be transformed in parallel.
+ *
+ * @param begin The index of the first human
+ * @param end The index after the last human
+ */
+void Crowd::applyTransformation(const std::size_t begin, const std::size_t end)
+{
+    TransformSystem::update(_registry, begin, end);
+}
+
+/**
+ * Transform every human, by chunks run on the JobSystem.
+ */
+void Crowd::applyTransformation()
+{
+    TransformSystem::update(_registry);
+}
+
+/**
+ * Draw the humans with the program of their rendering, whose projection must be set.
+ */
+void Crowd::draw() const
+{
+    if (_rendering == INSTANCED_RENDERING)
+    {
+        RenderSystem::draw(_registry);
+        return;
+    }
+    BufferManager::drawAll();
+}
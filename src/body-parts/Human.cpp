@@ -1,41 +1,199 @@
 #include "Human.hpp"
+#include "AnimationDefines.hpp"
+#include "BodyPartPool.hpp"
 #include "BodyPartDefines.hpp"
 #include "HumanDefines.hpp"
+#include <SkeletonFileException.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
 
-std::map<std::array<int, 3>, BodyPart*> Human::_colorToBodyPartMap;
+/**
+ * The parent of each joint, indexed by HumanJoint (-1 for the root).<br>
+ * Parents come before their children and siblings follow each other, as BodyPart::addChild() requires.
+ */
+static constexpr int JOINT_PARENTS[HUMAN_JOINT_COUNT] = {
+    -1,                     // TORSO
+    TORSO,                  // HEAD
+    TORSO,                  // RIGHT_ARM
+    TORSO,                  // LEFT_ARM
+    TORSO,                  // RIGHT_LEG
+    TORSO,                  // LEFT_LEG
+    HEAD,                   // HAT_BRIM
+    RIGHT_ARM,              // RIGHT_LOWER_ARM
+    LEFT_ARM,               // LEFT_LOWER_ARM
+    RIGHT_LEG,              // RIGHT_LOWER_LEG
+    LEFT_LEG,               // LEFT_LOWER_LEG
+    HAT_BRIM,               // HAT_BRIM_GREEN_BAND
+    RIGHT_LOWER_LEG,        // RIGHT_SHOE
+    LEFT_LOWER_LEG,         // LEFT_SHOE
+    HAT_BRIM_GREEN_BAND,    // HAT_BRIM_RED_BAND
+    HAT_BRIM_RED_BAND,      // HAT_BRIM_YELLOW_BAND
+    HAT_BRIM_YELLOW_BAND    // HAT_CROWN
+};
+
+/**
+ * The joints of the built-in human, indexed by HumanJoint, see JointDefinition.<br>
+ * The left limbs have a negative width: they are the right limbs mirrored.
+ */
+static constexpr JointDefinition HUMAN_JOINTS[HUMAN_JOINT_COUNT] = {
+    {
+        -1, {TORSO_SCALE_X, TORSO_SCALE_Y, TORSO_SCALE_Z},
+        {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {TORSO_COLOR}
+    },
+    {
+        TORSO, {HEAD_SCALE_X, HEAD_SCALE_Y, HEAD_SCALE_Z},
+        {0.0f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {HEAD_COLOR}
+    },
+    {
+        TORSO, {RIGHT_ARM_SCALE_X, RIGHT_ARM_SCALE_Y, RIGHT_ARM_SCALE_Z},
+        {-0.5f, 0.5f, 0.0f}, {-0.5f, 0.5f, 0.0f}, {0.5f, -0.5f, 0.0f}, {RIGHT_ARM_COLOR}
+    },
+    {
+        TORSO, {-LEFT_ARM_SCALE_X, LEFT_ARM_SCALE_Y, LEFT_ARM_SCALE_Z},
+        {0.5f, 0.5f, 0.0f}, {-0.5f, 0.5f, 0.0f}, {0.5f, -0.5f, 0.0f}, {LEFT_ARM_COLOR}
+    },
+    {
+        TORSO, {RIGHT_LEG_SCALE_X, RIGHT_LEG_SCALE_Y, RIGHT_LEG_SCALE_Z},
+        {-0.5f, -0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {RIGHT_LEG_COLOR}
+    },
+    {
+        TORSO, {LEFT_LEG_SCALE_X, LEFT_LEG_SCALE_Y, LEFT_LEG_SCALE_Z},
+        {0.5f, -0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {LEFT_LEG_COLOR}
+    },
+    {
+        HEAD, {HAT_BRIM_SCALE_X, HAT_BRIM_SCALE_Y, HAT_BRIM_SCALE_Z},
+        {0.0f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {HAT_BRIM_COLOR}
+    },
+    {
+        RIGHT_ARM, {RIGHT_LOWER_ARM_SCALE_X, RIGHT_LOWER_ARM_SCALE_Y, RIGHT_LOWER_ARM_SCALE_Z},
+        {-0.5f, 0.0f, 0.0f}, {-0.5f, 0.0f, 0.0f}, {0.5f, 0.0f, 0.0f}, {RIGHT_LOWER_ARM_COLOR}
+    },
+    {
+        LEFT_ARM, {-LEFT_LOWER_ARM_SCALE_X, LEFT_LOWER_ARM_SCALE_Y, LEFT_LOWER_ARM_SCALE_Z},
+        {-0.5f, 0.0f, 0.0f}, {-0.5f, 0.0f, 0.0f}, {0.5f, 0.0f, 0.0f}, {LEFT_LOWER_ARM_COLOR}
+    },
+    {
+        RIGHT_LEG, {RIGHT_LOWER_LEG_SCALE_X, RIGHT_LOWER_LEG_SCALE_Y, RIGHT_LOWER_LEG_SCALE_Z},
+        {0.0f, -0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {RIGHT_LOWER_LEG_COLOR}
+    },
+    {
+        LEFT_LEG, {LEFT_LOWER_LEG_SCALE_X, LEFT_LOWER_LEG_SCALE_Y, LEFT_LOWER_LEG_SCALE_Z},
+        {0.0f, -0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {LEFT_LOWER_LEG_COLOR}
+    },
+    {
+        HAT_BRIM, {HAT_BRIM_GREEN_SCALE_X, HAT_BRIM_GREEN_SCALE_Y, HAT_BRIM_GREEN_SCALE_Z},
+        {0.0f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {HAT_GREEN_BAND_COLOR}
+    },
+    {
+        RIGHT_LOWER_LEG, {RIGHT_SHOE_SCALE_X, RIGHT_SHOE_SCALE_Y, RIGHT_SHOE_SCALE_Z},
+        {0.0f, -0.5f, 0.5f}, {0.0f, -0.5f, -0.5f}, {0.0f, 0.5f, 0.5f}, {RIGHT_SHOE_COLOR}
+    },
+    {
+        LEFT_LOWER_LEG, {LEFT_SHOE_SCALE_X, LEFT_SHOE_SCALE_Y, LEFT_SHOE_SCALE_Z},
+        {0.0f, -0.5f, 0.5f}, {0.0f, -0.5f, -0.5f}, {0.0f, 0.5f, 0.5f}, {LEFT_SHOE_COLOR}
+    },
+    {
+        HAT_BRIM_GREEN_BAND, {HAT_BRIM_RED_SCALE_X, HAT_BRIM_RED_SCALE_Y, HAT_BRIM_RED_SCALE_Z},
+        {0.0f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {HAT_RED_BAND_COLOR}
+    },
+    {
+        HAT_BRIM_RED_BAND, {HAT_BRIM_YELLOW_SCALE_X, HAT_BRIM_YELLOW_SCALE_Y, HAT_BRIM_YELLOW_SCALE_Z},
+        {0.0f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {HAT_YELLOW_BAND_COLOR}
+    },
+    {
+        HAT_BRIM_YELLOW_BAND, {HAT_CROWN_SCALE_X, HAT_CROWN_SCALE_Y, HAT_CROWN_SCALE_Z},
+        {0.0f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}, {0.0f, -0.5f, 0.0f}, {HAT_CROWN_COLOR}
+    }
+};
+
+static_assert([]
+{
+    for (int joint = 0; joint < HUMAN_JOINT_COUNT; ++joint)
+    {
+        if (HUMAN_JOINTS[joint].parent != JOINT_PARENTS[joint])
+        {
+            return false;
+        }
+    }
+    return true;
+}(), "HUMAN_JOINTS must have the hierarchy of JOINT_PARENTS");
+
+/**
+ * The chain of each limb, indexed by HumanLimb, in the model space of the torso.<br>
+ * The roots are the shoulders and hips of HUMAN_JOINTS: each bone goes from the pivot
+ * of a body part to the pivot of its child, or to the far end of the lower limb. Knees bend forward, elbows backward.
+ */
+static const TwoBoneChain LIMB_CHAINS[HUMAN_LIMB_COUNT] = {
+    {
+        RIGHT_ARM, RIGHT_LOWER_ARM,
+        Vector4(-TORSO_SCALE_X / 2, TORSO_SCALE_Y / 2, 0.0f, 0.0f),
+        Vector4(-RIGHT_ARM_SCALE_X, RIGHT_ARM_SCALE_Y / 2, 0.0f, 0.0f),
+        Vector4(-RIGHT_LOWER_ARM_SCALE_X, 0.0f, 0.0f, 0.0f),
+        Vector4(0.0f, 0.0f, 1.0f, 0.0f),
+        IK_ELBOW_MIN_ANGLE, static_cast<float>(M_PI)
+    },
+    {
+        LEFT_ARM, LEFT_LOWER_ARM,
+        Vector4(TORSO_SCALE_X / 2, TORSO_SCALE_Y / 2, 0.0f, 0.0f),
+        Vector4(LEFT_ARM_SCALE_X, LEFT_ARM_SCALE_Y / 2, 0.0f, 0.0f),
+        Vector4(LEFT_LOWER_ARM_SCALE_X, 0.0f, 0.0f, 0.0f),
+        Vector4(0.0f, 0.0f, 1.0f, 0.0f),
+        IK_ELBOW_MIN_ANGLE, static_cast<float>(M_PI)
+    },
+    {
+        RIGHT_LEG, RIGHT_LOWER_LEG,
+        Vector4(-TORSO_SCALE_X / 2, -TORSO_SCALE_Y / 2, 0.0f, 0.0f),
+        Vector4(0.0f, -RIGHT_LEG_SCALE_Y, 0.0f, 0.0f),
+        Vector4(0.0f, -RIGHT_LOWER_LEG_SCALE_Y, 0.0f, 0.0f),
+        Vector4(0.0f, 0.0f, -1.0f, 0.0f),
+        IK_KNEE_MIN_ANGLE, static_cast<float>(M_PI)
+    },
+    {
+        LEFT_LEG, LEFT_LOWER_LEG,
+        Vector4(TORSO_SCALE_X / 2, -TORSO_SCALE_Y / 2, 0.0f, 0.0f),
+        Vector4(0.0f, -LEFT_LEG_SCALE_Y, 0.0f, 0.0f),
+        Vector4(0.0f, -LEFT_LOWER_LEG_SCALE_Y, 0.0f, 0.0f),
+        Vector4(0.0f, 0.0f, -1.0f, 0.0f),
+        IK_KNEE_MIN_ANGLE, static_cast<float>(M_PI)
+    }
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Constructors
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
-  * Constructor of the Human class.
+  * Constructor of the Human class, building the built-in human.
+  *
+  * @param rendering How the body parts are drawn, see BodyPartRendering
   */
-Human::Human()
+Human::Human(const BodyPartRendering rendering) : Human(getDefaultSkeleton(), rendering)
 {
-    _head = new BodyPart();
-    _torso = new BodyPart();
-    _rightArm = new BodyPart();
-    _rightLowerArm = new BodyPart();
-    _leftArm = new BodyPart();
-    _leftLowerArm = new BodyPart();
-    _rightLeg = new BodyPart();
-    _rightLowerLeg = new BodyPart();
-    _leftLeg = new BodyPart();
-    _leftLowerLeg = new BodyPart();
-
-    _rightShoe = new BodyPart();
-    _leftShoe = new BodyPart();
+}
 
-    _hatBrim = new BodyPart();
-    _hatBrimGreenBand = new BodyPart();
-    _hatBrimRedBand = new BodyPart();
-    _hatBrimYellowBand = new BodyPart();
+/**
+  * Constructor of the Human class, building a human from a definition with its own sizes, pivots and colors.
+  *
+  * @param skeleton The definition, with the joints of a human (see isHumanSkeleton())
+  * @param rendering How the body parts are drawn, see BodyPartRendering
+  *
+  * @throw SkeletonFileException If the definition does not have the joints of a human
+  */
+Human::Human(const SkeletonDefinition& skeleton, const BodyPartRendering rendering)
+{
+    if (!isHumanSkeleton(skeleton))
+    {
+        throw SkeletonFileException("The skeleton does not have the joints of a human");
+    }
+    BodyPartPool& pool = BodyPartPool::getInstance();
 
-    _hatCrown = new BodyPart();
+    _firstBodyPart = pool.allocate(HUMAN_JOINT_COUNT, rendering);
+    _bodyParts = &pool.get(_firstBodyPart);
 
-    _initBodyParts();
-    _linkChildren();
+    _initBodyParts(skeleton);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -47,26 +205,7 @@ Human::Human()
   */
 Human::~Human()
 {
-    delete _head;
-    delete _torso;
-    delete _rightArm;
-    delete _rightLowerArm;
-    delete _leftArm;
-    delete _leftLowerArm;
-    delete _rightLeg;
-    delete _rightLowerLeg;
-    delete _leftLeg;
-    delete _leftLowerLeg;
-
-    delete _rightShoe;
-    delete _leftShoe;
-
-    delete _hatBrim;
-    delete _hatBrimGreenBand;
-    delete _hatBrimRedBand;
-    delete _hatBrimYellowBand;
-
-    delete _hatCrown;
+    BodyPartPool::getInstance().release(_firstBodyPart, HUMAN_JOINT_COUNT);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -74,11 +213,62 @@ Human::~Human()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
-  * @return The root of the human.
+  * @return The definition of the built-in human, whose sizes are given by HumanDefines.hpp and colors by
+  * BodyPartDefines.hpp.
   */
-std::map<std::array<int, 3>, BodyPart*> Human::getColorToBodyPartMap()
+const SkeletonDefinition& Human::getDefaultSkeleton()
 {
-    return _colorToBodyPartMap;
+    static const SkeletonDefinition skeleton(std::vector(std::begin(HUMAN_JOINTS), std::end(HUMAN_JOINTS)), "human");
+    return skeleton;
+}
+
+/**
+  * @return The parent of each joint, indexed by HumanJoint (-1 for the torso).
+  */
+std::span<const int> Human::getJointParents()
+{
+    return JOINT_PARENTS;
+}
+
+/**
+  * @return The two-bone chain of each limb, indexed by HumanLimb, with targets in the model space of the torso.
+  */
+std::span<const TwoBoneChain> Human::getLimbChains()
+{
+    return LIMB_CHAINS;
+}
+
+/**
+  * @return The mask of the head, the hat and the arms, shared by every layer animating only the upper body.
+  */
+const std::shared_ptr<const JointMask>& Human::getUpperBodyMask()
+{
+    static const std::shared_ptr<const JointMask> mask = std::make_shared<const JointMask>(
+        HUMAN_JOINT_COUNT,
+        std::initializer_list<std::size_t>{
+            HEAD, HAT_BRIM, HAT_BRIM_GREEN_BAND, HAT_BRIM_RED_BAND, HAT_BRIM_YELLOW_BAND, HAT_CROWN,
+            RIGHT_ARM, RIGHT_LOWER_ARM, LEFT_ARM, LEFT_LOWER_ARM
+        });
+    return mask;
+}
+
+/**
+  * @return The mask of every joint but the shoes and the bands of the hat, too small to be seen from afar.
+  */
+const std::shared_ptr<const JointMask>& Human::getMajorJointMask()
+{
+    static const std::shared_ptr<const JointMask> mask = []
+    {
+        auto majorJoints = std::make_shared<JointMask>(HUMAN_JOINT_COUNT, 1.0f);
+        for (const HumanJoint joint: {
+                 RIGHT_SHOE, LEFT_SHOE, HAT_BRIM_GREEN_BAND, HAT_BRIM_RED_BAND, HAT_BRIM_YELLOW_BAND
+             })
+        {
+            majorJoints->setWeight(joint, 0.0f);
+        }
+        return std::shared_ptr<const JointMask>(std::move(majorJoints));
+    }();
+    return mask;
 }
 
 /**
@@ -89,6 +279,25 @@ BodyPart* Human::getRoot() const
     return _root;
 }
 
+/**
+  * @return The position of the torso in the world, as of the last transformation of the human.
+  */
+Vector4 Human::getPosition() const
+{
+    const float* world = _root->getWorldMatrix().getData();
+    return Vector4(world[3], world[7], world[11]);
+}
+
+/**
+  * @param joint The body part to get.
+  *
+  * @return The body part of the human.
+  */
+BodyPart* Human::getBodyPart(const HumanJoint joint) const
+{
+    return _bodyParts + joint;
+}
+
 /**
   * @return The targeted body part of the human.
   */
@@ -102,7 +311,7 @@ BodyPart* Human::getTarget() const
   */
 BodyPart* Human::getHead() const
 {
-    return _head;
+    return getBodyPart(HEAD);
 }
 
 /**
@@ -110,7 +319,7 @@ BodyPart* Human::getHead() const
   */
 BodyPart* Human::getTorso() const
 {
-    return _torso;
+    return getBodyPart(TORSO);
 }
 
 /**
@@ -118,7 +327,7 @@ BodyPart* Human::getTorso() const
   */
 BodyPart* Human::getRightArm() const
 {
-    return _rightArm;
+    return getBodyPart(RIGHT_ARM);
 }
 
 /**
@@ -126,7 +335,7 @@ BodyPart* Human::getRightArm() const
   */
 BodyPart* Human::getRightLowerArm() const
 {
-    return _rightLowerArm;
+    return getBodyPart(RIGHT_LOWER_ARM);
 }
 
 /**
@@ -134,7 +343,7 @@ BodyPart* Human::getRightLowerArm() const
   */
 BodyPart* Human::getLeftArm() const
 {
-    return _leftArm;
+    return getBodyPart(LEFT_ARM);
 }
 
 /**
@@ -142,7 +351,7 @@ BodyPart* Human::getLeftArm() const
   */
 BodyPart* Human::getLeftLowerArm() const
 {
-    return _leftLowerArm;
+    return getBodyPart(LEFT_LOWER_ARM);
 }
 
 /**
@@ -150,7 +359,7 @@ BodyPart* Human::getLeftLowerArm() const
   */
 BodyPart* Human::getRightLeg() const
 {
-    return _rightLeg;
+    return getBodyPart(RIGHT_LEG);
 }
 
 /**
@@ -158,7 +367,7 @@ BodyPart* Human::getRightLeg() const
   */
 BodyPart* Human::getRightLowerLeg() const
 {
-    return _rightLowerLeg;
+    return getBodyPart(RIGHT_LOWER_LEG);
 }
 
 /**
@@ -166,7 +375,7 @@ BodyPart* Human::getRightLowerLeg() const
   */
 BodyPart* Human::getLeftLeg() const
 {
-    return _leftLeg;
+    return getBodyPart(LEFT_LEG);
 }
 
 /**
@@ -174,7 +383,7 @@ BodyPart* Human::getLeftLeg() const
   */
 BodyPart* Human::getLeftLowerLeg() const
 {
-    return _leftLowerLeg;
+    return getBodyPart(LEFT_LOWER_LEG);
 }
 
 /**
@@ -182,7 +391,7 @@ BodyPart* Human::getLeftLowerLeg() const
   */
 BodyPart* Human::getRightShoe() const
 {
-    return _rightShoe;
+    return getBodyPart(RIGHT_SHOE);
 }
 
 /**
@@ -190,7 +399,7 @@ BodyPart* Human::getRightShoe() const
   */
 BodyPart* Human::getLeftShoe() const
 {
-    return _leftShoe;
+    return getBodyPart(LEFT_SHOE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -202,13 +411,139 @@ void Human::setTarget(BodyPart* target)
     _target = target;
 }
 
+/**
+ * Move the human in the world, the animations moving the torso around this position.
+ *
+ * @param position The position of the torso at rest
+ */
+void Human::setPosition(const Vector4& position) const
+{
+    // The root has no parent, so its shift is relative to the world
+    _root->setParentRelativeShift(position.getX(), position.getY(), position.getZ());
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Methods
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void Human::addToColorToBodyPartMap(const std::array<int, 3> colors, BodyPart* bodyPart)
+/**
+ * Tell whether a definition can build a human: its joints must be the joints of HumanJoint, in the same order and
+ * with the same hierarchy, as the clips, the masks and the limbs of the humans are indexed by HumanJoint.
+ *
+ * @param skeleton The definition
+ *
+ * @return Whether the definition has the joints of a human
+ */
+bool Human::isHumanSkeleton(const SkeletonDefinition& skeleton)
 {
-    _colorToBodyPartMap[colors] = bodyPart;
+    return std::ranges::equal(skeleton.getJoints(), JOINT_PARENTS, {}, &JointDefinition::parent);
+}
+
+/**
+ * Find the body part drawn with a color, every body part of a human having a different default color.
+ *
+ * @param color The red, green and blue of the body part
+ *
+ * @return The body part (nullptr if no body part has this default color)
+ */
+BodyPart* Human::findBodyPart(const std::array<int, 3>& color) const
+{
+    for (std::size_t joint = 0; joint < HUMAN_JOINT_COUNT; ++joint)
+    {
+        if (_bodyParts[joint].getDefaultColor() == color)
+        {
+            return _bodyParts + joint;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Transform the body parts in a single pass over their storage, where parents come before their children, writing
+ * the cube of each one to an instance instead of to its vertices.
+ *
+ * @param instances The instances of the body parts, indexed by HumanJoint
+ */
+void Human::applyTransformation(const std::span<BodyPartInstance> instances) const
+{
+    for (std::size_t joint = 0; joint < HUMAN_JOINT_COUNT; ++joint)
+    {
+        _bodyParts[joint].applyTransformation(instances[joint]);
+    }
+}
+
+/**
+ * Apply the channels set by a pose to the body parts, the other channels are left untouched.
+ *
+ * @param pose The pose to apply, indexed by HumanJoint
+ * @param mask The joints to apply, the joints of weight 0 being left untouched (nullptr for every joint)
+ */
+void Human::applyPose(const Pose& pose, const JointMask* mask) const
+{
+    const std::size_t jointCount = std::min<std::size_t>(pose.getJointCount(), HUMAN_JOINT_COUNT);
+    for (std::size_t joint = 0; joint < jointCount; ++joint)
+    {
+        if (mask != nullptr && mask->getWeight(joint) <= 0.0f)
+        {
+            continue;
+        }
+        const JointPose& jointPose = pose[joint];
+        BodyPart& bodyPart = _bodyParts[joint];
+
+        if (jointPose.channels & ROTATION_CHANNEL)
+        {
+            bodyPart.setRotation(jointPose.rotation);
+        }
+        if (jointPose.channels & TRANSLATION_CHANNEL)
+        {
+            bodyPart.setTranslation(jointPose.translation.getX(),
+                                    jointPose.translation.getY(),
+                                    jointPose.translation.getZ());
+        }
+        if (jointPose.channels & SCALE_CHANNEL)
+        {
+            bodyPart.setPoseScale(jointPose.scale.getX(), jointPose.scale.getY(), jointPose.scale.getZ());
+        }
+    }
+}
+
+/**
+ * Measure how far a pose is from a reference, in world units over the whole hierarchy.<br>
+ * Both poses are applied in turn and the vertices of every body part are compared, so an error on a joint is weighted
+ * by the size of the limbs it moves. The human is left in the approximated pose.
+ *
+ * @param reference The exact pose
+ * @param approximation The pose to measure, setting the same channels as the reference
+ *
+ * @return The largest distance between a vertex in the reference pose and the same vertex in the approximation
+ */
+float Human::measurePoseError(const Pose& reference, const Pose& approximation) const
+{
+    applyPose(reference);
+    _root->applyTransformation();
+    std::vector<float> referenceVertices;
+    for (std::size_t joint = 0; joint < HUMAN_JOINT_COUNT; ++joint)
+    {
+        const std::span<const float> vertices = _bodyParts[joint].getVertices();
+        referenceVertices.insert(referenceVertices.end(), vertices.begin(), vertices.end());
+    }
+
+    applyPose(approximation);
+    _root->applyTransformation();
+    float maxError = 0.0f;
+    const float* expected = referenceVertices.data();
+    for (std::size_t joint = 0; joint < HUMAN_JOINT_COUNT; ++joint)
+    {
+        const std::span<const float> vertices = _bodyParts[joint].getVertices();
+        for (std::size_t i = 0; i < vertices.size(); i += 3, expected += 3)
+        {
+            const float dx = vertices[i + 0] - expected[0];
+            const float dy = vertices[i + 1] - expected[1];
+            const float dz = vertices[i + 2] - expected[2];
+            maxError = std::max(maxError, std::sqrt(dx * dx + dy * dy + dz * dz));
+        }
+    }
+    return maxError;
 }
 
 /**
@@ -238,17 +573,17 @@ void Human::resetMembersScaling() const
   */
 void Human::resetMembersRotations() const
 {
-    resetRotation(_head);
-    resetRotation(_rightArm);
-    resetRotation(_rightLowerArm);
-    resetRotation(_leftArm);
-    resetRotation(_leftLowerArm);
-    resetRotation(_rightLeg);
-    resetRotation(_rightLowerLeg);
-    resetRotation(_leftLeg);
-    resetRotation(_leftLowerLeg);
-    resetRotation(_rightShoe);
-    resetRotation(_leftShoe);
+    resetRotation(getBodyPart(HEAD));
+    resetRotation(getBodyPart(RIGHT_ARM));
+    resetRotation(getBodyPart(RIGHT_LOWER_ARM));
+    resetRotation(getBodyPart(LEFT_ARM));
+    resetRotation(getBodyPart(LEFT_LOWER_ARM));
+    resetRotation(getBodyPart(RIGHT_LEG));
+    resetRotation(getBodyPart(RIGHT_LOWER_LEG));
+    resetRotation(getBodyPart(LEFT_LEG));
+    resetRotation(getBodyPart(LEFT_LOWER_LEG));
+    resetRotation(getBodyPart(RIGHT_SHOE));
+    resetRotation(getBodyPart(LEFT_SHOE));
 }
 
 /**
@@ -269,289 +604,51 @@ void Human::resetRotation(BodyPart* bodyPart)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
-  * Initialize the body parts of the human.
+  * Build the body parts of the human in a single pass over the joints of its definition, where parents come before
+  * their children: each body part is sized, placed on its parent, then added to the children of its parent.
+  *
+  * @param skeleton The definition, with the joints of a human
   */
-void Human::_initBodyParts()
-{
-    _initHead();
-    _initTorso();
-    _initRightArm();
-    _initRightLowerArm();
-    _initLeftArm();
-    _initLeftLowerArm();
-    _initRightLeg();
-    _initRightLowerLeg();
-    _initLeftLeg();
-    _initLeftLowerLeg();
-
-    _initRightShoe();
-    _initLeftShoe();
-
-    _initHatBrim();
-    _initHatBrimGreenBand();
-    _initHatBrimRedBand();
-    _initHatBrimYellowBand();
-
-    _initHatCrown();
+void Human::_initBodyParts(const SkeletonDefinition& skeleton)
+{
+    for (std::size_t joint = 0; joint < HUMAN_JOINT_COUNT; ++joint)
+    {
+        const JointDefinition& definition = skeleton[joint];
+        const float* size = definition.size;
+        BodyPart& bodyPart = _bodyParts[joint];
+
+        // Scaled alone, before any shift is set and before it has children, so only its cube is resized
+        bodyPart.scale(size[0], size[1], size[2]);
+        bodyPart.setOwnRelativeShift(definition.offset[0] * size[0],
+                                     definition.offset[1] * size[1],
+                                     definition.offset[2] * size[2]);
+        bodyPart.setPivotPoint(Vector4(definition.pivot[0] * size[0],
+                                       definition.pivot[1] * size[1],
+                                       definition.pivot[2] * size[2],
+                                       1.0f));
+        bodyPart.setDefaultColor(definition.color[0], definition.color[1], definition.color[2]);
+
+        // The root is placed in the world by setPosition()
+        if (definition.parent >= 0)
+        {
+            const float* parentSize = skeleton[definition.parent].size;
+            bodyPart.setParentRelativeShift(definition.anchor[0] * parentSize[0],
+                                            definition.anchor[1] * parentSize[1],
+                                            definition.anchor[2] * parentSize[2]);
+            _bodyParts[definition.parent].addChild(&bodyPart);
+        }
+    }
 
     _initRoot();
     _initTarget();
 }
 
-/**
-  * Initialize the head of the human.
-  */
-void Human::_initHead() const
-{
-    _head->scale(HEAD_SCALE_X, HEAD_SCALE_Y, HEAD_SCALE_Z);
-    _head->setOwnRelativeShift(0, HEAD_SCALE_Y / 2, 0);
-    _head->setParentRelativeShift(0, TORSO_SCALE_Y / 2, 0);
-
-    _head->setPivotPoint(Vector4(0.0f, -HEAD_SCALE_Y / 2, 0.0f, 1.0f));
-
-    _head->setDefaultColor(HEAD_COLOR);
-    _colorToBodyPartMap[{HEAD_COLOR}] = _head;
-}
-
-/**
-  * Initialize the torso of the human.
-  */
-void Human::_initTorso() const
-{
-    _torso->scale(TORSO_SCALE_X, TORSO_SCALE_Y, TORSO_SCALE_Z);
-    _torso->setDefaultColor(TORSO_COLOR);
-    _colorToBodyPartMap[{TORSO_COLOR}] = _torso;
-}
-
-/**
-  * Initialize the right arm of the human.
-  */
-void Human::_initRightArm() const
-{
-    _rightArm->scale(RIGHT_ARM_SCALE_X, RIGHT_ARM_SCALE_Y, RIGHT_ARM_SCALE_Z);
-    _rightArm->setOwnRelativeShift(-RIGHT_ARM_SCALE_X / 2, RIGHT_ARM_SCALE_Y / 2, 0);
-    _rightArm->setParentRelativeShift(-TORSO_SCALE_X / 2, TORSO_SCALE_Y / 2, 0);
-
-    _rightArm->setPivotPoint(Vector4(RIGHT_ARM_SCALE_X / 2, -RIGHT_ARM_SCALE_Y / 2, 0, 1));
-
-    _rightArm->setDefaultColor(RIGHT_ARM_COLOR);
-    _colorToBodyPartMap[{RIGHT_ARM_COLOR}] = _rightArm;
-}
-
-/**
-  * Initialize the right lower arm of the human.
-  */
-void Human::_initRightLowerArm() const
-{
-    _rightLowerArm->scale(RIGHT_LOWER_ARM_SCALE_X, RIGHT_LOWER_ARM_SCALE_Y, RIGHT_LOWER_ARM_SCALE_Z);
-    _rightLowerArm->setOwnRelativeShift(-RIGHT_LOWER_ARM_SCALE_X / 2, 0, 0);
-    _rightLowerArm->setParentRelativeShift(-RIGHT_ARM_SCALE_X / 2, 0, 0);
-
-    _rightLowerArm->setPivotPoint(Vector4(RIGHT_LOWER_ARM_SCALE_X / 2, 0, 0, 1));
-    _rightLowerArm->setDefaultColor(RIGHT_LOWER_ARM_COLOR);
-    _colorToBodyPartMap[{RIGHT_LOWER_ARM_COLOR}] = _rightLowerArm;
-}
-
-/**
-  * Initialize the left arm of the human.
-  */
-void Human::_initLeftArm() const
-{
-    _leftArm->scale(-LEFT_ARM_SCALE_X, LEFT_ARM_SCALE_Y, LEFT_ARM_SCALE_Z);
-    _leftArm->setOwnRelativeShift(LEFT_ARM_SCALE_X / 2, LEFT_ARM_SCALE_Y / 2, 0);
-    _leftArm->setParentRelativeShift(TORSO_SCALE_X / 2, TORSO_SCALE_Y / 2, 0);
-
-    _leftArm->setPivotPoint(Vector4(-LEFT_ARM_SCALE_X / 2, -LEFT_ARM_SCALE_Y / 2, 0, 1));
-
-    _leftArm->setDefaultColor(LEFT_ARM_COLOR);
-    _colorToBodyPartMap[{LEFT_ARM_COLOR}] = _leftArm;
-}
-
-/**
- * Initialize the left lower arm of the human.
- */
-void Human::_initLeftLowerArm() const
-{
-    _leftLowerArm->scale(-LEFT_LOWER_ARM_SCALE_X, LEFT_LOWER_ARM_SCALE_Y, LEFT_LOWER_ARM_SCALE_Z);
-    _leftLowerArm->setOwnRelativeShift(LEFT_LOWER_ARM_SCALE_X / 2, 0, 0);
-    _leftLowerArm->setParentRelativeShift(LEFT_ARM_SCALE_X / 2, 0, 0);
-
-    _leftLowerArm->setPivotPoint(Vector4(-LEFT_LOWER_ARM_SCALE_X / 2, 0, 0, 1));
-    _leftLowerArm->setDefaultColor(LEFT_LOWER_ARM_COLOR);
-    _colorToBodyPartMap[{LEFT_LOWER_ARM_COLOR}] = _leftLowerArm;
-}
-
-/**
- * Initialize the right leg of the human.
- */
-void Human::_initRightLeg() const
-{
-    _rightLeg->scale(RIGHT_LEG_SCALE_X, RIGHT_LEG_SCALE_Y, RIGHT_LEG_SCALE_Z);
-    _rightLeg->setOwnRelativeShift(0, -RIGHT_LEG_SCALE_Y / 2, 0);
-    _rightLeg->setParentRelativeShift(-TORSO_SCALE_X / 2, -TORSO_SCALE_Y / 2, 0);
-
-    _rightLeg->setPivotPoint(Vector4(0, RIGHT_LEG_SCALE_Y / 2, 0, 1));
-
-    _rightLeg->setDefaultColor(RIGHT_LEG_COLOR);
-    _colorToBodyPartMap[{RIGHT_LEG_COLOR}] = _rightLeg;
-}
-
-/**
- * Initialize the right lower leg of the human.
- */
-void Human::_initRightLowerLeg() const
-{
-    _rightLowerLeg->scale(RIGHT_LOWER_LEG_SCALE_X, RIGHT_LOWER_LEG_SCALE_Y, RIGHT_LOWER_LEG_SCALE_Z);
-    _rightLowerLeg->setOwnRelativeShift(0, -RIGHT_LOWER_LEG_SCALE_Y / 2, 0);
-    _rightLowerLeg->setParentRelativeShift(0, -RIGHT_LEG_SCALE_Y / 2, 0);
-
-    _rightLowerLeg->setPivotPoint(Vector4(0, RIGHT_LOWER_LEG_SCALE_Y / 2, 0, 1));
-
-    _rightLowerLeg->setDefaultColor(RIGHT_LOWER_LEG_COLOR);
-    _colorToBodyPartMap[{RIGHT_LOWER_LEG_COLOR}] = _rightLowerLeg;
-}
-
-/**
- * Initialize the left leg of the human.
- */
-void Human::_initLeftLeg() const
-{
-    _leftLeg->scale(LEFT_LEG_SCALE_X, LEFT_LEG_SCALE_Y, LEFT_LEG_SCALE_Z);
-    _leftLeg->setOwnRelativeShift(0, -LEFT_LEG_SCALE_Y / 2, 0);
-    _leftLeg->setParentRelativeShift(TORSO_SCALE_X / 2, -TORSO_SCALE_Y / 2, 0);
-
-    _leftLeg->setPivotPoint(Vector4(0, LEFT_LEG_SCALE_Y / 2, 0, 1));
-
-    _leftLeg->setDefaultColor(LEFT_LEG_COLOR);
-    _colorToBodyPartMap[{LEFT_LEG_COLOR}] = _leftLeg;
-}
-
-/**
- * Initialize the left lower leg of the human.
- */
-void Human::_initLeftLowerLeg() const
-{
-    _leftLowerLeg->scale(LEFT_LOWER_LEG_SCALE_X, LEFT_LOWER_LEG_SCALE_Y, LEFT_LOWER_LEG_SCALE_Z);
-    _leftLowerLeg->setOwnRelativeShift(0, -LEFT_LOWER_LEG_SCALE_Y / 2, 0);
-    _leftLowerLeg->setParentRelativeShift(0, -LEFT_LEG_SCALE_Y / 2, 0);
-
-    _leftLowerLeg->setPivotPoint(Vector4(0, LEFT_LOWER_LEG_SCALE_Y / 2, 0, 1));
-
-    _leftLowerLeg->setDefaultColor(LEFT_LOWER_LEG_COLOR);
-    _colorToBodyPartMap[{LEFT_LOWER_LEG_COLOR}] = _leftLowerLeg;
-}
-
-/**
- * Initialize the right shoe of the human.
- */
-void Human::_initRightShoe() const
-{
-    _rightShoe->scale(RIGHT_SHOE_SCALE_X, RIGHT_SHOE_SCALE_Y, RIGHT_SHOE_SCALE_Z);
-    _rightShoe->setOwnRelativeShift(0, -RIGHT_SHOE_SCALE_Y / 2, -RIGHT_SHOE_SCALE_Z / 2);
-    _rightShoe->setParentRelativeShift(0, -RIGHT_LOWER_LEG_SCALE_Y / 2, RIGHT_LOWER_LEG_SCALE_Z / 2);
-
-    _rightShoe->setPivotPoint(Vector4(0, RIGHT_SHOE_SCALE_Y / 2, RIGHT_SHOE_SCALE_Z / 2, 1));
-
-    _rightShoe->setDefaultColor(RIGHT_SHOE_COLOR);
-    _colorToBodyPartMap[{RIGHT_SHOE_COLOR}] = _rightShoe;
-}
-
-/**
- * Initialize the left shoe of the human.
- */
-void Human::_initLeftShoe() const
-{
-    _leftShoe->scale(LEFT_SHOE_SCALE_X, LEFT_SHOE_SCALE_Y, LEFT_SHOE_SCALE_Z);
-    _leftShoe->setOwnRelativeShift(0, -LEFT_SHOE_SCALE_Y / 2, -LEFT_SHOE_SCALE_Z / 2);
-    _leftShoe->setParentRelativeShift(0, -LEFT_LOWER_LEG_SCALE_Y / 2, LEFT_LOWER_LEG_SCALE_Z / 2);
-
-    _leftShoe->setPivotPoint(Vector4(0, LEFT_SHOE_SCALE_Y / 2, LEFT_SHOE_SCALE_Z / 2, 1));
-
-    _leftShoe->setDefaultColor(LEFT_SHOE_COLOR);
-    _colorToBodyPartMap[{LEFT_SHOE_COLOR}] = _leftShoe;
-}
-
-/**
- * Initialize the brim of the hat.
- */
-void Human::_initHatBrim() const
-{
-    _hatBrim->scale(HAT_BRIM_SCALE_X, HAT_BRIM_SCALE_Y, HAT_BRIM_SCALE_Z);
-    _hatBrim->setOwnRelativeShift(0, HAT_BRIM_SCALE_Y / 2, 0);
-    _hatBrim->setParentRelativeShift(0, HEAD_SCALE_Y / 2, 0);
-
-    _hatBrim->setPivotPoint(Vector4(0.0f, -HAT_BRIM_SCALE_Y / 2, 0.0f, 1.0f));
-
-    _hatBrim->setDefaultColor(HAT_BRIM_COLOR);
-    _colorToBodyPartMap[{HAT_BRIM_COLOR}] = _hatBrim;
-}
-
-/**
- * Initialize the green band of the hat's brim.
- */
-void Human::_initHatBrimGreenBand() const
-{
-    _hatBrimGreenBand->scale(HAT_BRIM_GREEN_SCALE_X, HAT_BRIM_GREEN_SCALE_Y, HAT_BRIM_GREEN_SCALE_Z);
-    _hatBrimGreenBand->setOwnRelativeShift(0, HAT_BRIM_GREEN_SCALE_Y / 2, 0);
-    _hatBrimGreenBand->setParentRelativeShift(0, HAT_BRIM_SCALE_Y / 2, 0);
-
-    _hatBrimGreenBand->setPivotPoint(Vector4(0.0f, -HAT_BRIM_GREEN_SCALE_Y / 2, 0.0f, 1.0f));
-
-    _hatBrimGreenBand->setDefaultColor(HAT_GREEN_BAND_COLOR);
-    _colorToBodyPartMap[{HAT_GREEN_BAND_COLOR}] = _hatBrimGreenBand;
-}
-
-/**
- * Initialize the red band of the hat's brim.
- */
-void Human::_initHatBrimRedBand() const
-{
-    _hatBrimRedBand->scale(HAT_BRIM_RED_SCALE_X, HAT_BRIM_RED_SCALE_Y, HAT_BRIM_RED_SCALE_Z);
-    _hatBrimRedBand->setOwnRelativeShift(0, HAT_BRIM_RED_SCALE_Y / 2, 0);
-    _hatBrimRedBand->setParentRelativeShift(0, HAT_BRIM_GREEN_SCALE_Y / 2, 0);
-
-    _hatBrimRedBand->setPivotPoint(Vector4(0.0f, -HAT_BRIM_RED_SCALE_Y / 2, 0.0f, 1.0f));
-
-    _hatBrimRedBand->setDefaultColor(HAT_RED_BAND_COLOR);
-    _colorToBodyPartMap[{HAT_RED_BAND_COLOR}] = _hatBrimRedBand;
-}
-
-/**
- * Initialize the yellow band of the hat's brim.
- */
-void Human::_initHatBrimYellowBand() const
-{
-    _hatBrimYellowBand->scale(HAT_BRIM_YELLOW_SCALE_X, HAT_BRIM_YELLOW_SCALE_Y, HAT_BRIM_YELLOW_SCALE_Z);
-    _hatBrimYellowBand->setOwnRelativeShift(0, HAT_BRIM_YELLOW_SCALE_Y / 2, 0);
-    _hatBrimYellowBand->setParentRelativeShift(0, HAT_BRIM_GREEN_SCALE_Y / 2, 0);
-
-    _hatBrimYellowBand->setPivotPoint(Vector4(0.0f, -HAT_BRIM_YELLOW_SCALE_Y / 2, 0.0f, 1.0f));
-
-    _hatBrimYellowBand->setDefaultColor(HAT_YELLOW_BAND_COLOR);
-    _colorToBodyPartMap[{HAT_YELLOW_BAND_COLOR}] = _hatBrimYellowBand;
-}
-
-/**
- * Initialize the crown of the hat.
- */
-void Human::_initHatCrown() const
-{
-    _hatCrown->scale(HAT_CROWN_SCALE_X, HAT_CROWN_SCALE_Y, HAT_CROWN_SCALE_Z);
-    _hatCrown->setOwnRelativeShift(0, HAT_CROWN_SCALE_Y / 2, 0);
-    _hatCrown->setParentRelativeShift(0, HAT_BRIM_YELLOW_SCALE_Y / 2, 0);
-
-    _hatCrown->setPivotPoint(Vector4(0.0f, -HAT_CROWN_SCALE_Y / 2, 0.0f, 1.0f));
-
-    _hatCrown->setDefaultColor(HAT_CROWN_COLOR);
-    _colorToBodyPartMap[{HAT_CROWN_COLOR}] = _hatCrown;
-}
-
 /**
  * Initialize the root of the human.
  */
 void Human::_initRoot()
 {
-    _root = _torso;
+    _root = getBodyPart(TORSO);
 }
 
 /**
@@ -559,32 +656,5 @@ void Human::_initRoot()
  */
 void Human::_initTarget()
 {
-    _target = _torso;
+    _target = getBodyPart(TORSO);
 }
-
-/**
- * Link the children of the body parts.
- */
-void Human::_linkChildren() const
-{
-    _torso->addChild(_head);
-    _torso->addChild(_rightArm);
-    _torso->addChild(_leftArm);
-    _torso->addChild(_rightLeg);
-    _torso->addChild(_leftLeg);
-
-    _rightArm->addChild(_rightLowerArm);
-    _leftArm->addChild(_leftLowerArm);
-    _rightLeg->addChild(_rightLowerLeg);
-    _leftLeg->addChild(_leftLowerLeg);
-
-    _rightLowerLeg->addChild(_rightShoe);
-    _leftLowerLeg->addChild(_leftShoe);
-
-    _head->addChild(_hatBrim);
-
-    _hatBrim->addChild(_hatBrimGreenBand);
-    _hatBrimGreenBand->addChild(_hatBrimRedBand);
-    _hatBrimRedBand->addChild(_hatBrimYellowBand);
-    _hatBrimYellowBand->addChild(_hatCrown);
-}
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include "SkeletonDefinition.hpp"
+#include <SkeletonFileException.hpp>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <utility>
+
+/**
+ * The first bytes of a compiled skeleton file.
+ */
+static constexpr char SKELETON_MAGIC[4] = {'H', 'G', 'L', 'S'};
+
+/**
+ * The version of the compiled skeleton file format, increased on every incompatible change.
+ */
+static constexpr std::uint32_t SKELETON_VERSION = 1;
+
+/**
+ * The number of fields of a joint line of a text definition: its name, its parent, then 4 points and a color.
+ */
+static constexpr std::size_t JOINT_FIELD_COUNT = 17;
+
+/**
+ * The name of the parent of a root in a text definition.
+ */
+static constexpr std::string_view NO_PARENT = "-";
+
+static_assert(sizeof(JointDefinition) == 56, "JointDefinition is written as is to compiled skeleton files");
+
+/**
+ * Write the bytes of a value (in the byte order of the machine).
+ */
+template<typename T>
+static void writeValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * Parse a number of a text definition.
+ *
+ * @param field The field holding the number
+ * @param value The parsed number
+ *
+ * @return Whether the whole field is a number
+ */
+template<typename T>
+static bool parseNumber(const std::string& field, T& value)
+{
+    const char* end = field.data() + field.size();
+    const auto [last, error] = std::from_chars(field.data(), end, value);
+    return error == std::errc() && last == end;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Constructor of the SkeletonDefinition class.
+ *
+ * @param joints The joints, parents first, the children of a joint following each other
+ * @param source The name of the definition in the error messages
+ *
+ * @throw SkeletonFileException If there is no joint, a joint comes before its parent, the children of a joint do not
+ * follow each other or two joints have the same color
+ */
+SkeletonDefinition::SkeletonDefinition(std::vector<JointDefinition> joints, const std::string& source)
+    : _joints(std::move(joints))
+{
+    if (_joints.empty())
+    {
+        throw SkeletonFileException(source + ": the skeleton has no joint");
+    }
+    std::vector<std::int32_t> lastChildren(_joints.size(), -1);
+    std::set<std::array<std::uint8_t, 3>> colors;
+    for (std::size_t index = 0; index < _joints.size(); ++index)
+    {
+        const JointDefinition& joint = _joints[index];
+        const auto self = static_cast<std::int32_t>(index);
+        if (joint.parent < -1 || joint.parent >= self)
+        {
+            throw SkeletonFileException(source + ": joint " + std::to_string(index) + " comes before its parent");
+        }
+        if (joint.parent >= 0)
+        {
+            if (lastChildren[joint.parent] >= 0 && lastChildren[joint.parent] != self - 1)
+            {
+                throw SkeletonFileException(source + ": the children of joint " + std::to_string(joint.parent)
+                                            + " do not follow each other");
+            }
+            lastChildren[joint.parent] = self;
+        }
+        if (!colors.insert({joint.color[0], joint.color[1], joint.color[2]}).second)
+        {
+            throw SkeletonFileException(source + ": joint " + std::to_string(index)
+                                        + " has the color of another joint");
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of joints
+ */
+std::size_t SkeletonDefinition::getJointCount() const
+{
+    return _joints.size();
+}
+
+/**
+ * @return The joints, parents first
+ */
+std::span<const JointDefinition> SkeletonDefinition::getJoints() const
+{
+    return _joints;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Compile the definition to a binary file: a header, then the joints as they are stored in memory.<br>
+ * Values are stored in the byte order of the machine, compiled files are not meant to be exchanged between
+ * architectures: the text definitions are.
+ *
+ * @param path The path of the file, overwritten if it exists
+ *
+ * @throw SkeletonFileException If the file cannot be written
+ */
+void SkeletonDefinition::save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw SkeletonFileException("Could not open file " + path);
+    }
+
+    file.write(SKELETON_MAGIC, sizeof(SKELETON_MAGIC));
+    writeValue(file, SKELETON_VERSION);
+    writeValue(file, static_cast<std::uint32_t>(_joints.size()));
+    file.write(reinterpret_cast<const char*>(_joints.data()),
+               static_cast<std::streamsize>(_joints.size() * sizeof(JointDefinition)));
+    if (!file)
+    {
+        throw SkeletonFileException("Could not write file " + path);
+    }
+}
+
+/**
+ * Parse a text definition, one joint per line, parents first:
+ * <pre>
+ * # name  parent  size x y z  anchor x y z  offset x y z  pivot x y z  color r g b
+ * TORSO   -       0.2 0.4 0.1 0 0 0         0 0 0         0 0 0        21 191 188
+ * HEAD    TORSO   0.1 0.1 0.1 0 0.5 0       0 0.5 0       0 -0.5 0     218 152 102
+ * </pre>
+ * A root has "-" as parent, see JointDefinition for the meaning of the points. Everything after a '#' is a comment.
+ *
+ * @param text The text
+ * @param source The name of the text in the error messages, usually the path of its file
+ *
+ * @return The definition
+ *
+ * @throw SkeletonFileException If the text is not a valid definition
+ */
+SkeletonDefinition SkeletonDefinition::parse(const std::string_view text, const std::string& source)
+{
+    std::vector<JointDefinition> joints;
+    std::vector<std::string> names;
+    std::istringstream lines{std::string(text)};
+    std::string line;
+    for (std::size_t lineNumber = 1; std::getline(lines, line); ++lineNumber)
+    {
+        const std::string where = source + ":" + std::to_string(lineNumber);
+        std::istringstream fieldStream(line.substr(0, line.find('#')));
+        const std::vector<std::string> fields{std::istream_iterator<std::string>(fieldStream), {}};
+        if (fields.empty())
+        {
+            continue;
+        }
+        if (fields.size() != JOINT_FIELD_COUNT)
+        {
+            throw SkeletonFileException(where + ": expected " + std::to_string(JOINT_FIELD_COUNT) + " fields, got "
+                                        + std::to_string(fields.size()));
+        }
+        if (std::ranges::find(names, fields[0]) != names.end())
+        {
+            throw SkeletonFileException(where + ": joint " + fields[0] + " is defined twice");
+        }
+
+        JointDefinition joint{};
+        joint.parent = -1;
+        if (fields[1] != NO_PARENT)
+        {
+            const auto parent = std::ranges::find(names, fields[1]);
+            if (parent == names.end())
+            {
+                throw SkeletonFileException(where + ": parent " + fields[1] + " is not defined before " + fields[0]);
+            }
+            joint.parent = static_cast<std::int32_t>(parent - names.begin());
+        }
+        float* points[] = {joint.size, joint.anchor, joint.offset, joint.pivot};
+        for (std::size_t field = 2; field < 14; ++field)
+        {
+            if (!parseNumber(fields[field], points[(field - 2) / 3][(field - 2) % 3]))
+            {
+                throw SkeletonFileException(where + ": " + fields[field] + " is not a number");
+            }
+        }
+        for (std::size_t channel = 0; channel < 3; ++channel)
+        {
+            if (!parseNumber(fields[14 + channel], joint.color[channel]))
+            {
+                throw SkeletonFileException(where + ": " + fields[14 + channel] + " is not a color in [0, 255]");
+            }
+        }
+        joints.push_back(joint);
+        names.push_back(fields[0]);
+    }
+    return SkeletonDefinition(std::move(joints), source);
+}
+
+/**
+ * Load a definition compiled by save(), or a text definition, see parse(). Compiled files are told apart by their
+ * first bytes.
+ *
+ * @param path The path of the file
+ *
+ * @return The definition
+ *
+ * @throw SkeletonFileException If the file cannot be read or is not a valid definition
+ */
+SkeletonDefinition SkeletonDefinition::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw SkeletonFileException("Could not open file " + path);
+    }
+    const std::string content{std::istreambuf_iterator<char>(file), {}};
+    if (file.bad())
+    {
+        throw SkeletonFileException("Could not read file " + path);
+    }
+    if (!content.starts_with(std::string_view(SKELETON_MAGIC, sizeof(SKELETON_MAGIC))))
+    {
+        return parse(content, path);
+    }
+
+    constexpr std::size_t headerSize = sizeof(SKELETON_MAGIC) + 2 * sizeof(std::uint32_t);
+    if (content.size() < headerSize)
+    {
+        throw SkeletonFileException(path + ": truncated header");
+    }
+    std::uint32_t header[2];
+    std::copy_n(content.data() + sizeof(SKELETON_MAGIC), sizeof(header), reinterpret_cast<char*>(header));
+    if (const std::uint32_t version = header[0]; version != SKELETON_VERSION)
+    {
+        throw SkeletonFileException(path + ": unsupported skeleton version " + std::to_string(version));
+    }
+    const std::uint32_t jointCount = header[1];
+    if (content.size() != headerSize + static_cast<std::size_t>(jointCount) * sizeof(JointDefinition))
+    {
+        throw SkeletonFileException(path + ": the joints do not match the header");
+    }
+
+    std::vector<JointDefinition> joints(jointCount);
+    std::copy_n(content.data() + headerSize, joints.size() * sizeof(JointDefinition),
+                reinterpret_cast<char*>(joints.data()));
+    return SkeletonDefinition(std::move(joints), path);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Operator overloads
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @param joint The index of the joint
+ *
+ * @return The joint
+ */
+const JointDefinition& SkeletonDefinition::operator[](const std::size_t joint) const
+{
+    return _joints[joint];
+}
@@ -24,7 +24,7 @@ Camera::Camera(const Vector4& position): _cameraPosition(position),
                                          })),
                                          // @formatter:on
                                          _pitch(0.0f),
-                                         _speed(0.15f),
+                                         _speed(CAMERA_SPEED),
                                          _yaw(-90.0f)
 {
     _updateCameraVectors();
@@ -79,28 +79,31 @@ const Matrix4& Camera::getProjectionMatrix() const
  * Update the position of the camera depending on the provided direction.
  *
  * @param dir The direction towards which the camera is going
+ * @param deltaTime The time in seconds the camera moves for
  */
-void Camera::updateCameraPos(const CameraDirection dir)
+void Camera::updateCameraPos(const CameraDirection dir, const float deltaTime)
 {
+    const float distance = _speed * deltaTime;
+
     switch (dir)
     {
         case FORWARD:
-            _cameraPosition += _cameraFront * _speed;
+            _cameraPosition += _cameraFront * distance;
             break;
         case BACKWARD:
-            _cameraPosition -= _cameraFront * _speed;
+            _cameraPosition -= _cameraFront * distance;
             break;
         case RIGHT:
-            _cameraPosition += _cameraRight * _speed;
+            _cameraPosition += _cameraRight * distance;
             break;
         case LEFT:
-            _cameraPosition -= _cameraRight * _speed;
+            _cameraPosition -= _cameraRight * distance;
             break;
         case UP:
-            _cameraPosition += _cameraUp * _speed;
+            _cameraPosition += _cameraUp * distance;
             break;
         case DOWN:
-            _cameraPosition -= _cameraUp * _speed;
+            _cameraPosition -= _cameraUp * distance;
             break;
         case NONE:
             break;
@@ -136,7 +139,7 @@ void Camera::resetCamera()
     });
     //@formatter:on
     getInstance()._pitch = 0.0f;
-    getInstance()._speed = 0.15f;
+    getInstance()._speed = CAMERA_SPEED;
     getInstance()._yaw = -90.0f;
 }
 
@@ -0,0 +1,343 @@
+#include "CharacterRegistry.hpp"
+#include <ranges>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The number of alive entities
+ */
+std::size_t CharacterRegistry::getEntityCount() const
+{
+    return _entityCount;
+}
+
+/**
+ * @param entity The entity
+ *
+ * @return Whether the entity was created and not destroyed since
+ */
+bool CharacterRegistry::isAlive(const Entity entity) const
+{
+    return entity < _alive.size() && _alive[entity];
+}
+
+/**
+ * @return The skeletons of the characters
+ */
+ComponentStore<SkeletonComponent>& CharacterRegistry::getSkeletons()
+{
+    return _skeletons;
+}
+
+/**
+ * @return The skeletons of the characters
+ */
+const ComponentStore<SkeletonComponent>& CharacterRegistry::getSkeletons() const
+{
+    return _skeletons;
+}
+
+/**
+ * @return The joint ranges of the transformed characters, given by addTransform()
+ */
+ComponentStore<TransformComponent>& CharacterRegistry::getTransforms()
+{
+    return _transforms;
+}
+
+/**
+ * @return The joint ranges of the transformed characters, given by addTransform()
+ */
+const ComponentStore<TransformComponent>& CharacterRegistry::getTransforms() const
+{
+    return _transforms;
+}
+
+/**
+ * @return The index in the joint arrays of the parent of each joint (-1 for a root)
+ */
+std::span<const std::int32_t> CharacterRegistry::getJointParents() const
+{
+    return _jointParents;
+}
+
+/**
+ * @return The matrix of each joint in the space of its parent
+ */
+std::span<Matrix4> CharacterRegistry::getLocalMatrices()
+{
+    return _localMatrices;
+}
+
+/**
+ * @return The matrix of each joint in the world, computed by the last TransformSystem::update()
+ */
+std::span<Matrix4> CharacterRegistry::getWorldMatrices()
+{
+    return _worldMatrices;
+}
+
+/**
+ * @return The matrix of each joint in the world, computed by the last TransformSystem::update()
+ */
+std::span<const Matrix4> CharacterRegistry::getWorldMatrices() const
+{
+    return _worldMatrices;
+}
+
+/**
+ * @return The players of the animated characters
+ */
+ComponentStore<AnimationComponent>& CharacterRegistry::getAnimations()
+{
+    return _animations;
+}
+
+/**
+ * @return The players of the animated characters
+ */
+const ComponentStore<AnimationComponent>& CharacterRegistry::getAnimations() const
+{
+    return _animations;
+}
+
+/**
+ * @return The instance ranges of the drawn characters, given by addRender()
+ */
+ComponentStore<RenderComponent>& CharacterRegistry::getRenders()
+{
+    return _renders;
+}
+
+/**
+ * @return The instance ranges of the drawn characters, given by addRender()
+ */
+const ComponentStore<RenderComponent>& CharacterRegistry::getRenders() const
+{
+    return _renders;
+}
+
+/**
+ * @return The instances of every drawn character
+ */
+std::span<BodyPartInstance> CharacterRegistry::getInstances()
+{
+    return _instances;
+}
+
+/**
+ * @return The instances of every drawn character
+ */
+std::span<const BodyPartInstance> CharacterRegistry::getInstances() const
+{
+    return _instances;
+}
+
+/**
+ * @param render A RenderComponent of the registry
+ *
+ * @return The instances of the range of the component
+ */
+std::span<BodyPartInstance> CharacterRegistry::getInstances(const RenderComponent& render)
+{
+    return std::span(_instances).subspan(render.firstInstance, render.instanceCount);
+}
+
+/**
+ * @param instance The index of an instance
+ *
+ * @return The entity whose RenderComponent holds the instance (NO_ENTITY if the index is out of range)
+ */
+Entity CharacterRegistry::findInstanceOwner(const std::size_t instance) const
+{
+    return instance < _instanceOwners.size() ? _instanceOwners[instance] : NO_ENTITY;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reserve room for a number of entities with every component, so that creating them does not allocate.
+ *
+ * @param entityCount The number of entities
+ * @param jointCount The number of joints of their TransformComponents
+ * @param instanceCount The number of instances of their RenderComponents
+ */
+void CharacterRegistry::reserve(const std::size_t entityCount,
+                                const std::size_t jointCount,
+                                const std::size_t instanceCount)
+{
+    _alive.reserve(entityCount);
+    _skeletons.reserve(entityCount);
+    _transforms.reserve(entityCount);
+    _jointParents.reserve(jointCount);
+    _localMatrices.reserve(jointCount);
+    _worldMatrices.reserve(jointCount);
+    _animations.reserve(entityCount);
+    _renders.reserve(entityCount);
+    _instances.reserve(instanceCount);
+    _instanceOwners.reserve(instanceCount);
+}
+
+/**
+ * Create an entity without any component.
+ *
+ * @return The entity, the last destroyed one if any
+ */
+Entity CharacterRegistry::create()
+{
+    Entity entity;
+    if (_freeEntities.empty())
+    {
+        entity = static_cast<Entity>(_alive.size());
+        _alive.push_back(true);
+    }
+    else
+    {
+        entity = _freeEntities.back();
+        _freeEntities.pop_back();
+        _alive[entity] = true;
+    }
+    ++_entityCount;
+    return entity;
+}
+
+/**
+ * Destroy an entity and its components.
+ *
+ * @param entity The entity (nothing happens if it is not alive)
+ */
+void CharacterRegistry::destroy(const Entity entity)
+{
+    if (!isAlive(entity))
+    {
+        return;
+    }
+    removeTransform(entity);
+    removeRender(entity);
+    _skeletons.erase(entity);
+    _animations.erase(entity);
+    _alive[entity] = false;
+    _freeEntities.push_back(entity);
+    --_entityCount;
+}
+
+/**
+ * Give an entity a TransformComponent, its range of joints being appended to the joint arrays of the registry.
+ *
+ * @param entity The entity, whose previous TransformComponent is removed
+ * @param parents The parent of each joint in the range (-1 for a root), parents first
+ *
+ * @return The TransformComponent, whose matrices are computed by the next TransformSystem::update()
+ */
+TransformComponent& CharacterRegistry::addTransform(const Entity entity, const std::span<const int> parents)
+{
+    removeTransform(entity);
+    const auto firstJoint = static_cast<std::uint32_t>(_jointParents.size());
+    for (const int parent: parents)
+    {
+        _jointParents.push_back(parent < 0 ? -1 : static_cast<std::int32_t>(firstJoint) + parent);
+    }
+    _localMatrices.resize(_jointParents.size(), Matrix4::identity());
+    _worldMatrices.resize(_jointParents.size(), Matrix4::identity());
+    return _transforms.insert(entity, {firstJoint, static_cast<std::uint32_t>(parents.size())});
+}
+
+/**
+ * Remove the TransformComponent of an entity. The joints after its range move down to keep the joints packed.
+ *
+ * @param entity The entity (nothing happens if it has no TransformComponent)
+ */
+void CharacterRegistry::removeTransform(const Entity entity)
+{
+    const TransformComponent* transform = _transforms.find(entity);
+    if (transform == nullptr)
+    {
+        return;
+    }
+    const std::uint32_t first = transform->firstJoint;
+    const std::uint32_t count = transform->jointCount;
+    _jointParents.erase(_jointParents.begin() + first, _jointParents.begin() + first + count);
+    _localMatrices.erase(_localMatrices.begin() + first, _localMatrices.begin() + first + count);
+    _worldMatrices.erase(_worldMatrices.begin() + first, _worldMatrices.begin() + first + count);
+    for (std::int32_t& parent: _jointParents | std::views::drop(first))
+    {
+        if (parent >= static_cast<std::int32_t>(first))
+        {
+            parent -= static_cast<std::int32_t>(count);
+        }
+    }
+    _transforms.erase(entity);
+    for (TransformComponent& moved: _transforms.getComponents())
+    {
+        if (moved.firstJoint > first)
+        {
+            moved.firstJoint -= count;
+        }
+    }
+}
+
+/**
+ * Give an entity a RenderComponent, its range of instances being appended to the instances of the registry.
+ *
+ * @param entity The entity, whose previous RenderComponent is removed
+ * @param instanceCount The number of instances, one per body part of its skeleton
+ *
+ * @return The RenderComponent, whose instances are written by the next TransformSystem::update()
+ */
+RenderComponent& CharacterRegistry::addRender(const Entity entity, const std::size_t instanceCount)
+{
+    removeRender(entity);
+    const auto firstInstance = static_cast<std::uint32_t>(_instances.size());
+    _instances.resize(_instances.size() + instanceCount);
+    _instanceOwners.resize(_instanceOwners.size() + instanceCount, entity);
+    return _renders.insert(entity, {firstInstance, static_cast<std::uint32_t>(instanceCount), true});
+}
+
+/**
+ * Remove the RenderComponent of an entity. The instances after its range move down to keep the instances packed.
+ *
+ * @param entity The entity (nothing happens if it has no RenderComponent)
+ */
+void CharacterRegistry::removeRender(const Entity entity)
+{
+    const RenderComponent* render = _renders.find(entity);
+    if (render == nullptr)
+    {
+        return;
+    }
+    const std::uint32_t first = render->firstInstance;
+    const std::uint32_t count = render->instanceCount;
+    _instances.erase(_instances.begin() + first, _instances.begin() + first + count);
+    _instanceOwners.erase(_instanceOwners.begin() + first, _instanceOwners.begin() + first + count);
+    _renders.erase(entity);
+    for (RenderComponent& moved: _renders.getComponents())
+    {
+        if (moved.firstInstance > first)
+        {
+            moved.firstInstance -= count;
+        }
+    }
+}
+
+/**
+ * Destroy every entity.
+ */
+void CharacterRegistry::clear()
+{
+    _alive.clear();
+    _freeEntities.clear();
+    _entityCount = 0;
+    _skeletons.clear();
+    _transforms.clear();
+    _jointParents.clear();
+    _localMatrices.clear();
+    _worldMatrices.clear();
+    _animations.clear();
+    _renders.clear();
+    _instances.clear();
+    _instanceOwners.clear();
+}
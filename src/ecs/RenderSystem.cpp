@@ -0,0 +1,36 @@
+#include "RenderSystem.hpp"
+#include <BufferManager.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Draw every instance in a single call, with the instanced program whose projection must be set.
+ *
+ * @param registry The registry
+ */
+void RenderSystem::draw(const CharacterRegistry& registry)
+{
+    BufferManager::drawInstances(registry.getInstances());
+}
+
+/**
+ * Find the body part drawn on a pixel of the picking pass, where each instance is drawn with its index + 1 as color,
+ * see instancedVertexShader.glsl.
+ *
+ * @param registry The registry
+ * @param color The red, green and blue of the pixel
+ *
+ * @return The character and its body part (CharacterRegistry::NO_ENTITY for the background)
+ */
+PickedBodyPart RenderSystem::pick(const CharacterRegistry& registry, const std::array<int, 3>& color)
+{
+    const auto id = static_cast<std::size_t>(color[0] | color[1] << 8 | color[2] << 16);
+    const Entity entity = id == 0 ? CharacterRegistry::NO_ENTITY : registry.findInstanceOwner(id - 1);
+    if (entity == CharacterRegistry::NO_ENTITY)
+    {
+        return {CharacterRegistry::NO_ENTITY, 0};
+    }
+    return {entity, id - 1 - registry.getRenders().find(entity)->firstInstance};
+}
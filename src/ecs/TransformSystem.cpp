@@ -0,0 +1,95 @@
+#include "TransformSystem.hpp"
+#include <JobDefines.hpp>
+#include <JobSystem.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Transform a range of the skeletons, in the order of getSkeletons().<br>
+ * Ranges that do not overlap write to different memory and can be transformed in parallel.
+ *
+ * @param registry The registry
+ * @param begin The index of the first skeleton
+ * @param end The index after the last skeleton
+ */
+void TransformSystem::update(CharacterRegistry& registry, const std::size_t begin, const std::size_t end)
+{
+    const std::span<const SkeletonComponent> skeletons = registry.getSkeletons().getComponents();
+    const std::span<const Entity> entities = registry.getSkeletons().getEntities();
+    const std::span<const std::int32_t> parents = registry.getJointParents();
+    const std::span<Matrix4> localMatrices = registry.getLocalMatrices();
+    const std::span<Matrix4> worldMatrices = registry.getWorldMatrices();
+    for (std::size_t index = begin; index < end; ++index)
+    {
+        const Human* human = skeletons[index].human;
+        const TransformComponent* transform = registry.getTransforms().find(entities[index]);
+        RenderComponent* render = registry.getRenders().find(entities[index]);
+        if (transform == nullptr)
+        {
+            if (render == nullptr)
+            {
+                human->getRoot()->applyTransformation();
+            }
+            else
+            {
+                human->applyTransformation(registry.getInstances(*render));
+                render->outdated = false;
+            }
+            continue;
+        }
+        if (render != nullptr && !render->outdated)
+        {
+            const AnimationComponent* animation = registry.getAnimations().find(entities[index]);
+            if (animation && animation->player->getLod() == CULLED_LOD)
+            {
+                continue;
+            }
+        }
+
+        const std::size_t first = transform->firstJoint;
+        const std::size_t last = first + transform->jointCount;
+        for (std::size_t joint = first; joint < last; ++joint)
+        {
+            localMatrices[joint] = human->getBodyPart(static_cast<HumanJoint>(joint - first))->getTransformationMatrix();
+        }
+        for (std::size_t joint = first; joint < last; ++joint)
+        {
+            worldMatrices[joint] = parents[joint] < 0
+                                       ? localMatrices[joint]
+                                       : worldMatrices[parents[joint]] * localMatrices[joint];
+        }
+
+        if (render == nullptr)
+        {
+            for (std::size_t joint = first; joint < last; ++joint)
+            {
+                human->getBodyPart(static_cast<HumanJoint>(joint - first))->applyWorldMatrix(worldMatrices[joint]);
+            }
+            continue;
+        }
+        const std::span<BodyPartInstance> instances = registry.getInstances(*render);
+        for (std::size_t joint = first; joint < last; ++joint)
+        {
+            human->getBodyPart(static_cast<HumanJoint>(joint - first))->applyWorldMatrix(worldMatrices[joint],
+                                                                                        instances[joint - first]);
+        }
+        render->outdated = false;
+    }
+}
+
+/**
+ * Transform every skeleton, by chunks run on the JobSystem.
+ *
+ * @param registry The registry
+ */
+void TransformSystem::update(CharacterRegistry& registry)
+{
+    JobSystem::getInstance().parallelFor(registry.getSkeletons().getSize(),
+                                         ANIMATION_JOB_CHUNK_SIZE,
+                                         [&registry](const std::size_t begin, const std::size_t end)
+                                         {
+                                             update(registry, begin, end);
+                                         });
+}
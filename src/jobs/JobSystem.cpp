@@ -0,0 +1,249 @@
+#include "JobSystem.hpp"
+#include <JobDefines.hpp>
+
+JobSystem* JobSystem::_instance = nullptr;
+
+/**
+ * The pool the current thread works for (nullptr outside of any pool).
+ */
+static thread_local const JobSystem* currentSystem = nullptr;
+
+/**
+ * The queue owned by the current thread in currentSystem.
+ */
+static thread_local std::size_t currentQueue = 0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Start the worker threads.
+ *
+ * @param workerCount The number of threads created, the caller of wait() being one more (0 to run every job on it)
+ */
+JobSystem::JobSystem(const unsigned int workerCount) : _queuedJobs(0), _stopping(false)
+{
+    _queues.reserve(workerCount + 1);
+    for (unsigned int index = 0; index <= workerCount; ++index)
+    {
+        auto& queue = _queues.emplace_back(std::make_unique<JobQueue>());
+        queue->jobs.resize(JOB_QUEUE_CAPACITY);
+    }
+    _workers.reserve(workerCount);
+    for (unsigned int index = 1; index <= workerCount; ++index)
+    {
+        _workers.emplace_back(&JobSystem::_workerLoop, this, index);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Let the workers finish the queued jobs, then join them.
+ */
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(_sleepMutex);
+        _stopping = true;
+    }
+    _wakeUp.notify_all();
+    for (std::thread& worker: _workers)
+    {
+        worker.join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The pool shared by the engine, with one thread per core (the caller included)
+ */
+JobSystem& JobSystem::getInstance()
+{
+    if (_instance == nullptr)
+    {
+        _instance = new JobSystem(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    }
+    return *_instance;
+}
+
+/**
+ * @return The number of worker threads
+ */
+unsigned int JobSystem::getWorkerCount() const
+{
+    return static_cast<unsigned int>(_workers.size());
+}
+
+/**
+ * @return The number of threads running jobs during a wait(), the waiting thread included
+ */
+unsigned int JobSystem::getThreadCount() const
+{
+    return getWorkerCount() + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Delete the pool shared by the engine, joining its workers.
+ */
+void JobSystem::deleteInstance()
+{
+    delete _instance;
+    _instance = nullptr;
+}
+
+/**
+ * Fork: queue a job on the queue of the calling thread.<br>
+ * The counter of the job is incremented now and decremented once the job has run. When the queue is full, the job
+ * runs at once on the caller.
+ *
+ * @param job The job to run
+ */
+void JobSystem::run(const Job& job)
+{
+    job.counter->fetch_add(1, std::memory_order_relaxed);
+
+    JobQueue& queue = *_queues[_currentQueue()];
+    bool queued = false;
+    {
+        std::lock_guard lock(queue.mutex);
+        if (queue.size < queue.jobs.size())
+        {
+            queue.jobs[(queue.front + queue.size) % queue.jobs.size()] = job;
+            ++queue.size;
+            _queuedJobs.fetch_add(1, std::memory_order_release);
+            queued = true;
+        }
+    }
+    if (!queued)
+    {
+        _execute(job);
+        return;
+    }
+    // Taking the lock orders the notification after the check of a worker about to sleep
+    {
+        std::lock_guard lock(_sleepMutex);
+    }
+    _wakeUp.notify_one();
+}
+
+/**
+ * Join: run queued jobs until every job of a counter has run.
+ *
+ * @param counter The counter given to the jobs to wait for
+ */
+void JobSystem::wait(JobCounter& counter)
+{
+    const std::size_t queueIndex = _currentQueue();
+    while (counter.load(std::memory_order_acquire) > 0)
+    {
+        if (!_tryRunJob(queueIndex))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The queue of the calling thread (the shared queue for a thread outside of the pool)
+ */
+std::size_t JobSystem::_currentQueue() const
+{
+    return currentSystem == this ? currentQueue : 0;
+}
+
+/**
+ * Run one job: the newest of a queue, or else the oldest one stolen from another queue.
+ *
+ * @param queueIndex The queue of the calling thread
+ *
+ * @return Whether a job was run
+ */
+bool JobSystem::_tryRunJob(const std::size_t queueIndex)
+{
+    if (_queuedJobs.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    Job job{};
+    bool found = false;
+    for (std::size_t offset = 0; offset < _queues.size() && !found; ++offset)
+    {
+        const bool own = offset == 0;
+        JobQueue& queue = *_queues[(queueIndex + offset) % _queues.size()];
+        std::lock_guard lock(queue.mutex);
+        if (queue.size == 0)
+        {
+            continue;
+        }
+        if (own)
+        {
+            job = queue.jobs[(queue.front + queue.size - 1) % queue.jobs.size()];
+        }
+        else
+        {
+            job = queue.jobs[queue.front];
+            queue.front = (queue.front + 1) % queue.jobs.size();
+        }
+        --queue.size;
+        found = true;
+    }
+    if (!found)
+    {
+        return false;
+    }
+    _queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    _execute(job);
+    return true;
+}
+
+/**
+ * Run jobs until the pool is deleted, sleeping while there is none.
+ *
+ * @param queueIndex The queue owned by the worker
+ */
+void JobSystem::_workerLoop(const std::size_t queueIndex)
+{
+    currentSystem = this;
+    currentQueue = queueIndex;
+    while (true)
+    {
+        if (_tryRunJob(queueIndex))
+        {
+            continue;
+        }
+        std::unique_lock lock(_sleepMutex);
+        _wakeUp.wait(lock, [this]
+        {
+            return _stopping || _queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+        if (_stopping && _queuedJobs.load(std::memory_order_acquire) == 0)
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * Run a job and mark it as finished.
+ */
+void JobSystem::_execute(const Job& job)
+{
+    job.function(job.context, job.begin, job.end);
+    job.counter->fetch_sub(1, std::memory_order_release);
+}
@@ -6,134 +6,139 @@
 #include <Camera.hpp>
 #include <Human.hpp>
 #include <keybindings.hpp>
+#include <cmath>
 #include <GLFW/glfw3.h>
 
-void handleAnimationKeys(GLFWwindow* window)
+void handleAnimationKey(const int key)
 {
-    if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS)
-    {
-        AnimationManager::select(NO_ANIMATION);
-    }
-    if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS)
-    {
-        AnimationManager::select(STAYING_PUT);
-    }
-    if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS)
-    {
-        AnimationManager::select(WALKING);
-    }
-    if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS)
-    {
-        AnimationManager::select(JUMPING);
-    }
-    if (glfwGetKey(window, GLFW_KEY_4) == GLFW_PRESS)
-    {
-        AnimationManager::select(SNOW_ANGEL);
+    // Keys are events: holding one sends a single event, which leaves the current animation playing
+    switch (key)
+    {
+        case GLFW_KEY_0:
+            AnimationManager::select(NO_ANIMATION);
+            break;
+        case GLFW_KEY_1:
+            AnimationManager::select(STAYING_PUT);
+            break;
+        case GLFW_KEY_2:
+            AnimationManager::select(WALKING);
+            break;
+        case GLFW_KEY_3:
+            AnimationManager::select(JUMPING);
+            break;
+        case GLFW_KEY_4:
+            AnimationManager::select(SNOW_ANGEL);
+            break;
+        default:
+            break;
     }
 }
 
-void handleBodyPartKeys(GLFWwindow* window, const Human* selectedHuman)
+void handleBodyPartKeys(GLFWwindow* window, const Human* selectedHuman, const float deltaTime)
 {
     if (selectedHuman->getTarget() == nullptr)
     {
         return;
     }
+    // Rates are per second, so holding a key has the same effect whatever the timestep
+    const float grow = std::pow(SCALING_RATE, deltaTime);
+    const float shrink = 1.0f / grow;
+    const float rotation = ROTATION_SPEED * deltaTime;
+
     if (glfwGetKey(window, GLFW_KEY_KP_4) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->scale(1.01f, 1.0f, 1.0f);
+        selectedHuman->getTarget()->scale(grow, 1.0f, 1.0f);
     }
     if (glfwGetKey(window, GLFW_KEY_KP_1) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->scale(0.99f, 1.0f, 1.0f);
+        selectedHuman->getTarget()->scale(shrink, 1.0f, 1.0f);
     }
     if (glfwGetKey(window, GLFW_KEY_KP_5) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->scale(1.0f, 1.01f, 1.0f);
+        selectedHuman->getTarget()->scale(1.0f, grow, 1.0f);
     }
     if (glfwGetKey(window, GLFW_KEY_KP_2) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->scale(1.0f, 0.99f, 1.0f);
+        selectedHuman->getTarget()->scale(1.0f, shrink, 1.0f);
     }
     if (glfwGetKey(window, GLFW_KEY_KP_6) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->scale(1.0f, 1.0f, 1.01f);
+        selectedHuman->getTarget()->scale(1.0f, 1.0f, grow);
     }
     if (glfwGetKey(window, GLFW_KEY_KP_3) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->scale(1.0f, 1.0f, 0.99f);
+        selectedHuman->getTarget()->scale(1.0f, 1.0f, shrink);
     }
     // Rotate the target body part on the positive x-axis
     if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->rotateX(ROTATION_SPEED);
+        selectedHuman->getTarget()->rotateX(rotation);
     }
     // Rotate the target body part on the negative x-axis
     if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->rotateX(-ROTATION_SPEED);
+        selectedHuman->getTarget()->rotateX(-rotation);
     }
     // Rotate the target body part on the positive y-axis
     if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->rotateY(-ROTATION_SPEED);
+        selectedHuman->getTarget()->rotateY(-rotation);
     }
     // Rotate the target body part on the negative y-axis
     if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
     {
-        selectedHuman->getTarget()->rotateY(ROTATION_SPEED);
+        selectedHuman->getTarget()->rotateY(rotation);
     }
     // Rotate the target body part on the z-axis
     if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS)
     {
         float speed = 0;
-        speed = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS ? -ROTATION_SPEED : ROTATION_SPEED;
+        speed = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS ? -rotation : rotation;
         selectedHuman->getTarget()->rotateZ(speed);
     }
 }
 
-void handleCameraKeys(GLFWwindow* window)
+void handleCameraKeys(GLFWwindow* window, const float deltaTime)
 {
     // Move the camera forward
     if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
     {
-        Camera::getInstance().updateCameraPos(FORWARD);
+        Camera::getInstance().updateCameraPos(FORWARD, deltaTime);
     }
     // Move the camera backward
     if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
     {
-        Camera::getInstance().updateCameraPos(BACKWARD);
+        Camera::getInstance().updateCameraPos(BACKWARD, deltaTime);
     }
     // Move the camera to the left
     if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
     {
-        Camera::getInstance().updateCameraPos(LEFT);
+        Camera::getInstance().updateCameraPos(LEFT, deltaTime);
     }
     // Move the camera to the right
     if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
     {
-        Camera::getInstance().updateCameraPos(RIGHT);
+        Camera::getInstance().updateCameraPos(RIGHT, deltaTime);
     }
     // Move the camera downward
     if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
     {
-        Camera::getInstance().updateCameraPos(DOWN);
+        Camera::getInstance().updateCameraPos(DOWN, deltaTime);
     }
     // Move the camera upward
     if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
     {
-        Camera::getInstance().updateCameraPos(UP);
+        Camera::getInstance().updateCameraPos(UP, deltaTime);
     }
 }
 
-void handleKeys(GLFWwindow* window, const Human* selectedHuman)
+void handleKeys(GLFWwindow* window, const Human* selectedHuman, const float deltaTime)
 {
     if (selectedHuman == nullptr)
     {
         return;
     }
-    handleAnimationKeys(window);
-    handleBodyPartKeys(window, selectedHuman);
-    handleCameraKeys(window);
+    handleBodyPartKeys(window, selectedHuman, deltaTime);
 
     if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS)
     {
@@ -1,22 +1,66 @@
+#include <AllocationTracker.hpp>
+#include <AnimationFileException.hpp>
 #include <AnimationManager.hpp>
 #include <BodyPart.hpp>
 #include <BodyPartDefines.hpp>
+#include <BodyPartPool.hpp>
 #include <BufferManager.hpp>
 #include <Camera.hpp>
+#include <Crowd.hpp>
+#include <FrameArena.hpp>
 #include <Human.hpp>
+#include <JobSystem.hpp>
 #include <keybindings.hpp>
 #include <Logger.hpp>
 #include <ShaderManager.hpp>
+#include <SkeletonDefinition.hpp>
+#include <SkeletonFileException.hpp>
+#include <SimulationClock.hpp>
 #include <WindowDefines.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
 #include <GLFW/glfw3.h>
 
+/**
+ * The clock of the animations and of the body part controls.
+ */
+static SimulationClock simulationClock;
+
+/**
+ * Use the program drawing the humans of a crowd and give it the projection of the camera.
+ *
+ * @param crowd The crowd
+ * @param picking Whether each body part is drawn with the color encoding it, ignored by the vertex rendering
+ */
+static void useShaderProgram(const Crowd* crowd, const bool picking)
+{
+    const GLuint programId = crowd->getRendering() == INSTANCED_RENDERING
+                                 ? ShaderManager::getInstancedProgramId()
+                                 : ShaderManager::getProgramId();
+    glUseProgram(programId);
+
+    const GLint projection = glGetUniformLocation(programId, "projection");
+    if (projection == -1)
+    {
+        Logger::error("Uniform 'projection' not found in the shader program.");
+    }
+    glUniformMatrix4fv(projection, 1, GL_TRUE, Camera::getFinalMatrix().getData());
+    if (crowd->getRendering() == INSTANCED_RENDERING)
+    {
+        glUniform1i(glGetUniformLocation(programId, "picking"), picking);
+    }
+}
+
 static void mouse_button_callback(GLFWwindow* window, const int button, const int action, const int mods)
 {
-    auto* selectedHuman = static_cast<Human*>(glfwGetWindowUserPointer(window));
+    auto* crowd = static_cast<Crowd*>(glfwGetWindowUserPointer(window));
 
-    if (selectedHuman == nullptr)
+    if (crowd == nullptr || crowd->getSelected() == nullptr)
     {
-        Logger::error("main.cpp::mouse_button_callback(): Steve is null.");
+        Logger::error("main.cpp::mouse_button_callback(): The crowd is null or empty.");
         return;
     }
 
@@ -25,6 +69,16 @@ static void mouse_button_callback(GLFWwindow* window, const int button, const in
         double mouseX, mouseY;
         unsigned char pixel[3];
 
+        // The instanced humans are drawn again, each body part with the color encoding its instance
+        if (crowd->getRendering() == INSTANCED_RENDERING)
+        {
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            useShaderProgram(crowd, true);
+            crowd->draw();
+            glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
+        }
+
         // Get the window based coordinates of the mouse in which (0,0) is the top left corner
         glfwGetCursorPos(window, &mouseX, &mouseY);
 
@@ -32,13 +86,16 @@ static void mouse_button_callback(GLFWwindow* window, const int button, const in
         mouseY = WINDOW_HEIGHT - mouseY;
         glReadPixels(static_cast<int>(mouseX), static_cast<int>(mouseY), 1, 1, GL_RGB, GL_UNSIGNED_BYTE, &pixel);
 
-        if (Human::getColorToBodyPartMap().contains({pixel[0], pixel[1], pixel[2]}))
-        {
-            BodyPart* newTarget = Human::getColorToBodyPartMap().find({pixel[0], pixel[1], pixel[2]})->second;
-            // Reset the color of the previously targeted body part
-            selectedHuman->getTarget()->resetColor();
+        // Reset the color of the previously targeted body part
+        Human* selectedHuman = crowd->getSelected();
+        selectedHuman->getTarget()->resetColor();
 
-            // Update the targeted body part
+        const std::array<int, 3> color = {pixel[0], pixel[1], pixel[2]};
+        if (BodyPart* newTarget = crowd->findBodyPart(color))
+        {
+            // Update the selected human and its targeted body part
+            selectedHuman = crowd->findHuman(color);
+            crowd->setSelected(selectedHuman);
             selectedHuman->setTarget(newTarget);
 
             // Set the color of the new targeted body part
@@ -46,7 +103,6 @@ static void mouse_button_callback(GLFWwindow* window, const int button, const in
         }
         else // If the user clicked on the background
         {
-            selectedHuman->getTarget()->resetColor();
             selectedHuman->setTarget(selectedHuman->getTorso());
         }
     }
@@ -58,36 +114,58 @@ static void key_callback(GLFWwindow* window, const int key, const int scancode,
     {
         glfwSetWindowShouldClose(window, GLFW_TRUE);
     }
-}
-
-void render(GLFWwindow* window, const Human* selectedHuman)
-{
-    handleKeys(window, selectedHuman);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    if (selectedHuman)
+    if (action != GLFW_PRESS)
     {
-        selectedHuman->getRoot()->applyTransformation();
+        return;
+    }
+    handleAnimationKey(key);
+    // Pause, single-step and time scale of the simulation clock
+    if (key == GLFW_KEY_P)
+    {
+        simulationClock.setPaused(!simulationClock.isPaused());
+        Logger::info("Simulation %s", simulationClock.isPaused() ? "paused" : "resumed");
+    }
+    if (key == GLFW_KEY_N)
+    {
+        simulationClock.requestStep();
     }
+    if (key == GLFW_KEY_KP_ADD || key == GLFW_KEY_KP_SUBTRACT)
+    {
+        const float factor = key == GLFW_KEY_KP_ADD ? 2.0f : 0.5f;
+        simulationClock.setTimeScale(std::clamp(simulationClock.getTimeScale() * factor,
+                                                SIMULATION_MIN_TIME_SCALE,
+                                                SIMULATION_MAX_TIME_SCALE));
+        Logger::info("Simulation time scale : %.3f", simulationClock.getTimeScale());
+    }
+}
 
-    const Matrix4 finalMatrix = Camera::getFinalMatrix();
+void render(GLFWwindow* window, Crowd* crowd, const float deltaTime)
+{
+    AllocationTracker::beginFrame();
+    // Everything allocated from the frame arenas during the previous frame is released at once
+    FrameArena::beginFrame();
 
-    const GLint projection = glGetUniformLocation(ShaderManager::getProgramId(), "projection");
-    if (projection == -1)
+    // The camera follows real time, so it still moves while the simulation is paused
+    handleCameraKeys(window, deltaTime);
+    const unsigned int steps = simulationClock.advance(deltaTime);
+    for (unsigned int step = 0; step < steps; ++step)
     {
-        Logger::error("Uniform 'projection' not found in the shader program.");
+        handleKeys(window, crowd->getSelected(), simulationClock.getTimestep());
+        AnimationManager::update(simulationClock.getTimestep());
     }
-    glUniformMatrix4fv(projection, 1, GL_TRUE, finalMatrix.getData());
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    AnimationManager::update();
+    crowd->applyTransformation();
+    useShaderProgram(crowd, false);
 
     // Render here
-    BufferManager::drawAll();
+    crowd->draw();
 
     glfwSwapBuffers(window);
 
     // Poll for and process events
     glfwPollEvents();
+    AllocationTracker::endFrame();
 }
 
 static void handleDebugMode(const int argc, char** argv)
@@ -98,12 +176,128 @@ static void handleDebugMode(const int argc, char** argv)
         {
             Logger::setDebug(true);
         }
+        // Fail as soon as a steady-state frame allocates
+        if (std::string(argv[i]) == "--strict-allocations")
+        {
+            AllocationTracker::setStrict(true);
+        }
     }
 }
 
+/**
+ * @return The number of humans given with --crowd, clamped to [1, Crowd::MAX_SIZE] (0 without --crowd)
+ */
+static std::size_t handleCrowdSize(const int argc, char** argv)
+{
+    std::size_t size = 0;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--crowd")
+        {
+            size = std::clamp<std::size_t>(std::strtoull(argv[i + 1], nullptr, 10), 1, Crowd::MAX_SIZE);
+        }
+    }
+    return size;
+}
+
+/**
+ * Play the built-in animations from the library given with --animation-library, written first if it cannot be loaded.
+ */
+static void handleAnimationLibrary(const int argc, char** argv)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) != "--animation-library")
+        {
+            continue;
+        }
+        const std::string path = argv[i + 1];
+        try
+        {
+            AnimationManager::loadLibrary(path);
+        }
+        catch (const AnimationFileException& loadError)
+        {
+            Logger::warning("main.cpp::handleAnimationLibrary(): %s, writing it.", loadError.what());
+            try
+            {
+                AnimationManager::saveLibrary(path);
+                AnimationManager::loadLibrary(path);
+            }
+            catch (const AnimationFileException& saveError)
+            {
+                Logger::error("main.cpp::handleAnimationLibrary(): %s.", saveError.what());
+            }
+        }
+    }
+}
+
+/**
+ * Compile the text skeleton definition given with --compile-skeleton TEXT BINARY.
+ *
+ * @return The exit status of the compilation, the program then stopping without opening a window (-1 without
+ * --compile-skeleton)
+ */
+static int handleSkeletonCompilation(const int argc, char** argv)
+{
+    for (int i = 1; i + 2 < argc; ++i)
+    {
+        if (std::string(argv[i]) != "--compile-skeleton")
+        {
+            continue;
+        }
+        try
+        {
+            SkeletonDefinition::load(argv[i + 1]).save(argv[i + 2]);
+            Logger::info("Compiled %s to %s.", argv[i + 1], argv[i + 2]);
+            return EXIT_SUCCESS;
+        }
+        catch (const SkeletonFileException& error)
+        {
+            Logger::error("main.cpp::handleSkeletonCompilation(): %s.", error.what());
+            return EXIT_FAILURE;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @return The definitions given with --skeleton, text or compiled, which must have the joints of a human (empty
+ * without --skeleton)
+ */
+static std::vector<SkeletonDefinition> handleSkeletons(const int argc, char** argv)
+{
+    std::vector<SkeletonDefinition> skeletons;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) != "--skeleton")
+        {
+            continue;
+        }
+        try
+        {
+            SkeletonDefinition skeleton = SkeletonDefinition::load(argv[i + 1]);
+            if (!Human::isHumanSkeleton(skeleton))
+            {
+                throw SkeletonFileException(std::string(argv[i + 1]) + " does not have the joints of a human");
+            }
+            skeletons.push_back(std::move(skeleton));
+        }
+        catch (const SkeletonFileException& error)
+        {
+            Logger::error("main.cpp::handleSkeletons(): %s.", error.what());
+        }
+    }
+    return skeletons;
+}
+
 int main(const int argc, char** argv)
 {
     handleDebugMode(argc, argv);
+    if (const int status = handleSkeletonCompilation(argc, argv); status >= 0)
+    {
+        return status;
+    }
 
     // Initialize the library
     if (!glfwInit())
@@ -142,18 +336,33 @@ int main(const int argc, char** argv)
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
 
-    auto* steve = new Human();
-    AnimationManager::init(steve);
+    // The phases of the crowd are drawn from the clips, which must be loaded first
+    handleAnimationLibrary(argc, argv);
+    const std::vector<SkeletonDefinition> skeletons = handleSkeletons(argc, argv);
+    Crowd* crowd;
+    if (const std::size_t crowdSize = handleCrowdSize(argc, argv); crowdSize > 0)
+    {
+        crowd = new Crowd(crowdSize, INSTANCED_RENDERING, CROWD_SEED, skeletons);
+        AnimationManager::init(nullptr);
+        crowd->animate();
+        Logger::info("Crowd of %zu humans.", crowdSize);
+    }
+    else
+    {
+        crowd = new Crowd(1, VERTEX_RENDERING, CROWD_SEED, skeletons);
+        AnimationManager::init(crowd->getHuman(0));
+    }
     BufferManager::init();
     ShaderManager::init();
 
     glfwSetKeyCallback(window, key_callback);
-    glfwSetWindowUserPointer(window, steve);
+    glfwSetWindowUserPointer(window, crowd);
     glfwSetMouseButtonCallback(window, mouse_button_callback);
 
     double lastRenderTime = glfwGetTime();
     double lastFpsCountTime = glfwGetTime();
     unsigned int frameCount = 0;
+    size_t frameAllocations = 0;
 
     // Loop until the user closes the window
     while (!glfwWindowShouldClose(window))
@@ -163,23 +372,30 @@ int main(const int argc, char** argv)
         // Limit the frame rate to FPS_LIMIT
         if (now - lastRenderTime >= 1.0 / FPS_LIMIT)
         {
-            render(window, steve);
+            render(window, crowd, static_cast<float>(now - lastRenderTime));
             frameCount++;
+            frameAllocations += AllocationTracker::getLastFrameStats().allocations;
             lastRenderTime = now;
         }
         if (now - lastFpsCountTime > 1.0)
         {
-            Logger::info("FPS : %.3f", frameCount / (now - lastFpsCountTime));
+            Logger::info("FPS : %.3f | Allocations/frame : %.1f",
+                         frameCount / (now - lastFpsCountTime),
+                         frameCount > 0 ? static_cast<double>(frameAllocations) / frameCount : 0.0);
             frameCount = 0;
+            frameAllocations = 0;
             lastFpsCountTime = now;
         }
     }
     glfwTerminate();
     glfwDestroyWindow(window);
-    delete steve;
+    delete crowd;
+    BodyPartPool::deletePool();
     glDeleteProgram(ShaderManager::getProgramId());
+    glDeleteProgram(ShaderManager::getInstancedProgramId());
     BufferManager::clean();
     Camera::deleteCamera();
     AnimationManager::clean();
+    JobSystem::deleteInstance();
     return 0;
 }
@@ -1,58 +1,383 @@
 #include "AnimationManager.hpp"
+#include <AnimationDefines.hpp>
+#include <AnimationFileException.hpp>
+#include <AnimationLibrary.hpp>
+#include <AnimationLod.hpp>
+#include <BakedClip.hpp>
+#include <JobDefines.hpp>
+#include <JobSystem.hpp>
+#include <Logger.hpp>
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <utility>
+#include <vector>
 
-std::vector<Animation*> AnimationManager::_animations;
-Animation* AnimationManager::_selectedAnimation = nullptr;
+/**
+ * The z angle keeping the arms along the body.
+ */
+static constexpr float ARM_DOWN_ANGLE = M_PI / 2 - M_PI / 50;
+
+/**
+ * The name of the skeleton of the human in an AnimationLibrary.
+ */
+static constexpr char HUMAN_SKELETON_NAME[] = "human";
+
+/**
+ * The joints put back to their rest rotation by every built-in animation when they do not animate them.
+ */
+static constexpr HumanJoint RESET_JOINTS[] = {
+    HEAD,
+    RIGHT_ARM, RIGHT_LOWER_ARM, LEFT_ARM, LEFT_LOWER_ARM,
+    RIGHT_LEG, RIGHT_LOWER_LEG, LEFT_LEG, LEFT_LOWER_LEG,
+    RIGHT_SHOE, LEFT_SHOE
+};
+
+/**
+ * A rotation key expressed with the angles of BodyPart::setXRotation(), setYRotation() and setZRotation().
+ */
+struct EulerKey
+{
+    float time;
+    float angleX;
+    float angleY;
+    float angleZ;
+};
+
+/**
+ * Add a linear rotation track to a clip.
+ *
+ * @param clip The clip to fill
+ * @param joint The animated joint
+ * @param keys The keys of the track
+ */
+static void addEulerTrack(AnimationClip& clip, const HumanJoint joint, const std::initializer_list<EulerKey> keys)
+{
+    std::vector<RotationKey> rotationKeys;
+    rotationKeys.reserve(keys.size());
+    for (const EulerKey& key: keys)
+    {
+        rotationKeys.push_back({key.time, Quaternion::fromEulerAngles(key.angleX, key.angleY, key.angleZ)});
+    }
+    clip.addRotationTrack(joint).setKeys(std::move(rotationKeys));
+}
+
+/**
+ * Hold the rest pose on the joints the clip does not animate, as the built-in animations reset the limbs and the
+ * root translation.
+ *
+ * @param clip The clip to complete
+ */
+static void addRestTracks(AnimationClip& clip)
+{
+    for (const HumanJoint joint: RESET_JOINTS)
+    {
+        if (!clip.hasRotationTrack(joint))
+        {
+            clip.addRotationTrack(joint, STEP_INTERPOLATION).addKey({0.0f, Quaternion::identity()});
+        }
+    }
+    if (!clip.hasTranslationTrack(TORSO))
+    {
+        clip.addTranslationTrack(TORSO, STEP_INTERPOLATION).addKey({0.0f, Vector4(0, 0, 0, 0)});
+    }
+}
+
+std::vector<std::shared_ptr<const AnimationSource>> AnimationManager::_clips;
+std::vector<AnimationPlayer*> AnimationManager::_players;
+std::vector<AnimationController> AnimationManager::_controllers;
+std::shared_ptr<const AnimationStateMachine> AnimationManager::_stateMachine;
+AnimationEventDispatcher AnimationManager::_eventDispatcher;
+ScriptScheduler AnimationManager::_scriptScheduler;
+
+/**
+ * Get the shared clip of a built-in animation.<br>
+ * The clips are built and baked at ANIMATION_BAKE_RATE on first use (unless loadLibrary() provided them), every later
+ * call returns the same clip: playing them costs the same whatever the number of keys and tracks of their authored
+ * version.
+ *
+ * @param type Type of the animation
+ *
+ * @return The clip (or nullptr if the type has no animation)
+ */
+std::shared_ptr<const AnimationSource> AnimationManager::getClip(const AnimationType type)
+{
+    if (type < 0 || type >= ANIMATION_TYPE_COUNT)
+    {
+        return nullptr;
+    }
+    if (_clips.empty())
+    {
+        _clips.reserve(ANIMATION_TYPE_COUNT);
+        for (int index = 0; index < ANIMATION_TYPE_COUNT; ++index)
+        {
+            const AnimationClip clip = createClip(static_cast<AnimationType>(index));
+            _clips.push_back(std::make_shared<const BakedClip>(BakedClip::bake(clip, HUMAN_JOINT_COUNT,
+                                                                               ANIMATION_BAKE_RATE)));
+        }
+    }
+    return _clips[type];
+}
+
+/**
+ * @return The name of a built-in animation, used to find it in an AnimationLibrary (empty if the type has no animation)
+ */
+std::string_view AnimationManager::getName(const AnimationType type)
+{
+    switch (type)
+    {
+        case STAYING_PUT:
+            return "staying_put";
+        case WALKING:
+            return "walking";
+        case JUMPING:
+            return "jumping";
+        case SNOW_ANGEL:
+            return "snow_angel";
+        default:
+            return {};
+    }
+}
+
+/**
+ * Get the state machine of the built-in animations.<br>
+ * It has a state per animation plus a "none" state (index ANIMATION_TYPE_COUNT) stopping the players, and an event of
+ * the same name and index firing a crossfade of ANIMATION_CROSSFADE_DURATION to each state from any other state.
+ *
+ * @return The shared state machine
+ */
+const std::shared_ptr<const AnimationStateMachine>& AnimationManager::getStateMachine()
+{
+    if (_stateMachine == nullptr)
+    {
+        auto stateMachine = std::make_shared<AnimationStateMachine>();
+        for (int index = 0; index <= ANIMATION_TYPE_COUNT; ++index)
+        {
+            const auto type = index < ANIMATION_TYPE_COUNT ? static_cast<AnimationType>(index) : NO_ANIMATION;
+            const std::string name = type == NO_ANIMATION ? "none" : std::string(getName(type));
+            const std::size_t state = stateMachine->addState(name, getClip(type));
+            AnimationTransition transition;
+            transition.to = state;
+            transition.event = stateMachine->addEvent(name);
+            transition.blendDuration = ANIMATION_CROSSFADE_DURATION;
+            stateMachine->addTransition(AnimationStateMachine::ANY_STATE, std::move(transition));
+        }
+        _stateMachine = std::move(stateMachine);
+    }
+    return _stateMachine;
+}
+
+/**
+ * @return The scheduler running the animation scripts on the simulation clock, see AnimationScript
+ */
+ScriptScheduler& AnimationManager::getScriptScheduler()
+{
+    return _scriptScheduler;
+}
+
+/**
+ * @return The dispatcher reporting the events of the players of the AnimationManager, such as their footsteps (see
+ * AnimationEventId)
+ */
+AnimationEventDispatcher& AnimationManager::getEventDispatcher()
+{
+    return _eventDispatcher;
+}
 
 /**
  * Initialize the AnimationManager.
  *
- * @param human Human to animate
+ * @param human Human to animate (nullptr to only build the clips)
  */
 void AnimationManager::init(Human* human)
 {
+    getStateMachine();
     if (human == nullptr)
     {
         return;
     }
-    _generateAndAddStayingPutKeyframes(human);
-    _generateAndAddWalkingKeyframes(human);
-    _generateAndAddJumpingKeyframes(human);
-    _generateAndAddSnowAngelKeyframes(human);
-    _selectedAnimation = _animations[0];
+    addPlayer(human);
+    _controllers.back().trigger(_getState(STAYING_PUT));
 }
 
 /**
- * Update the selected animation.
+ * Create a player for a human, driven by update() and select() through a controller in the state of an animation.<br>
+ * Its events are reported by getEventDispatcher().
+ *
+ * @param human Human to animate
+ * @param type The animation played from the start (NO_ANIMATION for a stopped player)
+ * @param startTime The time in seconds of the animation to start at, so that humans playing it are out of step
+ *
+ * @return The created player, owned by the AnimationManager (or nullptr if the human is null)
  */
-void AnimationManager::update()
+AnimationPlayer* AnimationManager::addPlayer(Human* human, const AnimationType type, const float startTime)
 {
-    if (_selectedAnimation == nullptr)
+    if (human == nullptr)
     {
-        return;
+        return nullptr;
     }
-    _selectedAnimation->update();
+    AnimationPlayer* player = new AnimationPlayer(human);
+    // Throttled players are evaluated in turn instead of all on the same update
+    player->setLodPhase(static_cast<unsigned int>(_players.size()));
+    _controllers.emplace_back(getStateMachine(), player, _getState(type));
+    if (type != NO_ANIMATION)
+    {
+        player->setTime(startTime);
+    }
+    _eventDispatcher.watch(player);
+    return _players.emplace_back(player);
 }
 
 /**
- * Select an animation
+ * Create the clip of a built-in animation.
  *
- * @param index Index of new selected animation
+ * @param type Type of the animation
+ *
+ * @return The clip (empty if the type has no animation)
  */
-void AnimationManager::select(const int index)
+AnimationClip AnimationManager::createClip(const AnimationType type)
 {
-    if (index == NO_ANIMATION)
+    switch (type)
     {
-        _selectedAnimation = nullptr;
-        return;
+        case STAYING_PUT:
+            return _generateStayingPutClip();
+        case WALKING:
+            return _generateWalkingClip();
+        case JUMPING:
+            return _generateJumpingClip();
+        case SNOW_ANGEL:
+            return _generateSnowAngelClip();
+        default:
+            return AnimationClip();
+    }
+}
+
+/**
+ * Compress the clip of a built-in animation.<br>
+ * The error is measured on the vertices of a human, which is left in the last measured pose.
+ *
+ * @param type Type of the animation
+ * @param skeleton Human used to measure the error, of the skeleton the clip is played on
+ *
+ * @return The clip compressed within ANIMATION_COMPRESSION_MAX_ERROR (or nullptr if the type has no animation)
+ */
+std::shared_ptr<const CompressedClip> AnimationManager::compressClip(const AnimationType type, const Human& skeleton)
+{
+    if (type < 0 || type >= ANIMATION_TYPE_COUNT)
+    {
+        return nullptr;
     }
-    if (index > _animations.size() - 1)
+    const BakedClip baked = BakedClip::bake(createClip(type), HUMAN_JOINT_COUNT, ANIMATION_BAKE_RATE);
+    const PoseErrorMetric metric = [&skeleton](const Pose& reference, const Pose& approximation)
+    {
+        return skeleton.measurePoseError(reference, approximation);
+    };
+    return std::make_shared<const CompressedClip>(CompressedClip::compress(baked, ANIMATION_COMPRESSION_MAX_ERROR,
+                                                                            metric));
+}
+
+/**
+ * Write the baked clips of the built-in animations to an AnimationLibrary, with the skeleton of the human.
+ *
+ * @param path The path of the library, overwritten if it exists
+ *
+ * @throw AnimationFileException If the library cannot be written
+ */
+void AnimationManager::saveLibrary(const std::string& path)
+{
+    std::vector<BakedClip> baked;
+    std::vector<LibraryClip> clips;
+    baked.reserve(ANIMATION_TYPE_COUNT);
+    clips.reserve(ANIMATION_TYPE_COUNT);
+    for (int index = 0; index < ANIMATION_TYPE_COUNT; ++index)
+    {
+        const auto type = static_cast<AnimationType>(index);
+        baked.push_back(BakedClip::bake(createClip(type), HUMAN_JOINT_COUNT, ANIMATION_BAKE_RATE));
+        clips.push_back({std::string(getName(type)), &baked.back()});
+    }
+    AnimationLibrary::write(path, clips, {{HUMAN_SKELETON_NAME, Human::getJointParents()}});
+}
+
+/**
+ * Play the built-in animations from the clips of an AnimationLibrary instead of baking them.<br>
+ * The clips are used in place in the mapped library, which stays mapped as long as a clip is used. A built-in
+ * animation missing from the library is baked as usual. The clips report the events stored with them, the foot contacts
+ * of the built-in animations.
+ *
+ * @param path The path of the library
+ *
+ * @throw AnimationFileException If the library cannot be opened or was written for another skeleton
+ */
+void AnimationManager::loadLibrary(const std::string& path)
+{
+    const std::shared_ptr<const AnimationLibrary> library = AnimationLibrary::open(path);
+    if (!std::ranges::equal(library->getSkeleton(HUMAN_SKELETON_NAME), Human::getJointParents()))
+    {
+        throw AnimationFileException(path + ": the library was not written for the skeleton of the human");
+    }
+
+    std::vector<std::shared_ptr<const AnimationSource>> clips;
+    clips.reserve(ANIMATION_TYPE_COUNT);
+    for (int index = 0; index < ANIMATION_TYPE_COUNT; ++index)
+    {
+        const auto type = static_cast<AnimationType>(index);
+        std::shared_ptr<const AnimationSource> clip = library->getClip(getName(type));
+        if (clip == nullptr)
+        {
+            Logger::warning("AnimationManager::loadLibrary(): %s has no clip %s, baking it.",
+                            path.c_str(), std::string(getName(type)).c_str());
+            clip = std::make_shared<const BakedClip>(BakedClip::bake(createClip(type), HUMAN_JOINT_COUNT,
+                                                                     ANIMATION_BAKE_RATE));
+        }
+        clips.push_back(std::move(clip));
+    }
+    _clips = std::move(clips);
+    // The next controllers play the clips of the library
+    _stateMachine = nullptr;
+}
+
+/**
+ * Advance every controller and its player, at the level of detail of its human seen from the camera.<br>
+ * Each player only writes to its own human, so the players are updated in parallel, ANIMATION_JOB_CHUNK_SIZE per job.
+ * The events they reached are then reported and the animation scripts run, on the calling thread.
+ *
+ * @param deltaTime Time in seconds elapsed since the previous update
+ */
+void AnimationManager::update(const float deltaTime)
+{
+    const AnimationLod lod = AnimationLod::fromCamera();
+    const auto updatePlayers = [deltaTime, &lod](const std::size_t begin, const std::size_t end)
+    {
+        for (std::size_t index = begin; index < end; ++index)
+        {
+            AnimationPlayer* player = _players[index];
+            _controllers[index].update(deltaTime);
+            player->setLod(lod.classify(player->getHuman()->getPosition(), HUMAN_BOUNDING_RADIUS));
+            player->update(deltaTime);
+        }
+    };
+    JobSystem::getInstance().parallelFor(_players.size(), ANIMATION_JOB_CHUNK_SIZE, updatePlayers);
+    _eventDispatcher.update(deltaTime);
+    _scriptScheduler.update(deltaTime);
+}
+
+/**
+ * Select an animation, sending its event to every controller.<br>
+ * The players crossfade from their current animation, so switching is never abrupt, and selecting the current
+ * animation again fires no transition: it keeps playing instead of restarting.
+ *
+ * @param index Index of new selected animation
+ */
+void AnimationManager::select(const int index)
+{
+    if (index != NO_ANIMATION && (index < 0 || index >= ANIMATION_TYPE_COUNT))
     {
         return;
     }
-    _selectedAnimation = _animations[index];
-    if (_selectedAnimation)
+    const std::size_t event = _getState(static_cast<AnimationType>(index));
+    for (AnimationController& controller: _controllers)
     {
-        _selectedAnimation->resetAnimation();
+        controller.trigger(event);
     }
 }
 
@@ -61,247 +386,177 @@ void AnimationManager::select(const int index)
  */
 void AnimationManager::clean()
 {
-    for (auto animation: _animations)
+    _scriptScheduler.clear();
+    _eventDispatcher.clear();
+    _controllers.clear();
+    for (const AnimationPlayer* player: _players)
     {
-        delete animation;
+        delete player;
     }
-    _animations.clear();
+    _players.clear();
+    _clips.clear();
+    _stateMachine = nullptr;
 }
 
 /**
- * Generate keyframes for the staying put animation.
- *
- * @param human Human to animate
+ * @return The state and event of an animation in the built-in state machine (ANIMATION_TYPE_COUNT for NO_ANIMATION)
  */
-void AnimationManager::_generateAndAddStayingPutKeyframes(Human* human)
+std::size_t AnimationManager::_getState(const AnimationType type)
 {
-    auto* stayingPutAnimation = new Animation();
-    stayingPutAnimation->addKeyframe(0.0f,
-                                     [human](const double factor)
-                                     {
-                                         const auto angle = 0.0f + factor * M_PI / 64;
-                                         human->resetMembersTranslations();
-                                         human->resetMembersRotations();
-                                         human->getRightArm()->setXRotation(angle)
-                                                 .setZRotation(M_PI / 2 - M_PI / 50);
-                                         human->getLeftArm()->setXRotation(-angle)
-                                                 .setZRotation(-M_PI / 2 + M_PI / 50);
-                                     });
-
-    stayingPutAnimation->addKeyframe(1.0f,
-                                     [human](const double factor)
-                                     {
-                                         const auto angle = M_PI / 64 - 2 * factor * M_PI / 64;
-                                         human->getRightArm()->setXRotation(angle);
-                                         human->getLeftArm()->setXRotation(-angle);
-                                     });
-    stayingPutAnimation->addKeyframe(3.0f,
-                                     [human](const double factor)
-                                     {
-                                         const auto angle = -M_PI / 64 + factor * M_PI / 64;
-                                         human->getRightArm()->setXRotation(angle);
-                                         human->getLeftArm()->setXRotation(-angle);
-                                     });
-    stayingPutAnimation->addKeyframe(4.0f,
-                                     [](const double)
-                                     {
-                                     });
-    _animations.push_back(stayingPutAnimation);
+    return type == NO_ANIMATION ? static_cast<std::size_t>(ANIMATION_TYPE_COUNT) : static_cast<std::size_t>(type);
 }
 
 /**
- * Generate keyframes for the walking animation.
+ * Generate the clip of the staying put animation.
  *
- * @param human Human to animate
+ * @return The generated clip
  */
-void AnimationManager::_generateAndAddWalkingKeyframes(Human* human)
+AnimationClip AnimationManager::_generateStayingPutClip()
 {
-    auto* walkingAnimation = new Animation();
-    walkingAnimation->addKeyframe(0.0f,
-                                  [human](const double factor)
-                                  {
-                                      const auto angle = static_cast<float>(factor * M_PI / 8);
-                                      human->resetMembersRotations();
-                                      human->resetMembersTranslations();
-                                      human->getRightLeg()->setXRotation(angle);
-                                      human->getLeftLeg()->setXRotation(-angle);
-
-                                      human->getRightLowerLeg()->setXRotation(-angle / 2);
-                                      human->getLeftLowerLeg()->setXRotation(angle / 2);
-
-                                      human->getRightArm()->setZRotation(M_PI / 2 - M_PI / 50)
-                                              .setXRotation(-angle);
-                                      human->getLeftArm()->setZRotation(-M_PI / 2 + M_PI / 50)
-                                              .setXRotation(angle);
-
-                                      human->getRightLowerArm()->setXRotation(-angle);
-                                      human->getLeftLowerArm()->setXRotation(angle);
-
-                                      human->getHead()->setYRotation(factor * M_PI / 16);
-                                  });
-
-    walkingAnimation->addKeyframe(0.5f,
-                                  [human](const double factor)
-                                  {
-                                      const auto angle = static_cast<float>(M_PI / 8 - 2 * factor * M_PI / 8);
-                                      human->getRightLeg()->setXRotation(angle);
-                                      human->getLeftLeg()->setXRotation(-angle);
-
-                                      human->getRightLowerLeg()->setXRotation(-angle / 2);
-                                      human->getLeftLowerLeg()->setXRotation(angle / 2);
-
-                                      human->getRightArm()->setXRotation(-angle);
-                                      human->getLeftArm()->setXRotation(angle);
-
-                                      human->getRightLowerArm()->setXRotation(-angle);
-                                      human->getLeftLowerArm()->setXRotation(angle);
-
-                                      human->getHead()->setYRotation(M_PI / 16 - 2 * factor * M_PI / 16);
-                                  });
-
-    walkingAnimation->addKeyframe(1.5f,
-                                  [human](const double factor)
-                                  {
-                                      const auto angle = static_cast<float>(-M_PI / 8 + factor * M_PI / 8);
-                                      human->getRightLeg()->setXRotation(angle);
-                                      human->getLeftLeg()->setXRotation(-angle);
-
-                                      human->getRightLowerLeg()->setXRotation(-angle / 2);
-                                      human->getLeftLowerLeg()->setXRotation(angle / 2);
-
-                                      human->getRightArm()->setXRotation(-angle);
-                                      human->getLeftArm()->setXRotation(angle);
-
-                                      human->getRightLowerArm()->setXRotation(-angle);
-                                      human->getLeftLowerArm()->setXRotation(angle);
-
-                                      human->getHead()->setYRotation(-M_PI / 16 + factor * M_PI / 16);
-                                  });
-
-    walkingAnimation->addKeyframe(2.0f,
-                                  [](const double)
-                                  {
-                                  });
-    _animations.push_back(walkingAnimation);
+    constexpr float swing = M_PI / 64;
+    AnimationClip clip(4.0f);
+
+    addEulerTrack(clip, RIGHT_ARM, {
+                      {0.0f, 0, 0, ARM_DOWN_ANGLE},
+                      {1.0f, swing, 0, ARM_DOWN_ANGLE},
+                      {3.0f, -swing, 0, ARM_DOWN_ANGLE},
+                      {4.0f, 0, 0, ARM_DOWN_ANGLE}
+                  });
+    addEulerTrack(clip, LEFT_ARM, {
+                      {0.0f, 0, 0, -ARM_DOWN_ANGLE},
+                      {1.0f, -swing, 0, -ARM_DOWN_ANGLE},
+                      {3.0f, swing, 0, -ARM_DOWN_ANGLE},
+                      {4.0f, 0, 0, -ARM_DOWN_ANGLE}
+                  });
+    addRestTracks(clip);
+    return clip;
 }
 
 /**
- * Generate keyframes for the jumping animation.
+ * Generate the clip of the walking animation.<br>
+ * Legs, arms and forearms swing by the same angle while the head turns. Each foot touches the ground at the end of
+ * the forward swing of its leg.
  *
- * @param human Human to animate
+ * @return The generated clip
  */
-void AnimationManager::_generateAndAddJumpingKeyframes(Human* human)
+AnimationClip AnimationManager::_generateWalkingClip()
 {
-    auto* jumpingAnimation = new Animation();
-    jumpingAnimation->addKeyframe(0.0f,
-                                  [human](const float factor)
-                                  {
-                                      human->resetMembersRotations();
-                                      human->resetMembersTranslations();
-                                      human->getRightLeg()->setXRotation(factor * M_PI / 4);
-                                      human->getLeftLeg()->setXRotation(factor * M_PI / 4);
-
-                                      human->getRightLowerLeg()->setXRotation(factor * -M_PI / 2);
-                                      human->getLeftLowerLeg()->setXRotation(factor * -M_PI / 2);
-
-                                      human->getRightArm()->setYRotation(-M_PI / 2)
-                                              .setZRotation(3 * M_PI / 8);
-                                      human->getRightLowerArm()->setZRotation(-3 * M_PI / 8);
-
-                                      human->getLeftArm()->setYRotation(M_PI / 2)
-                                              .setZRotation(-3 * M_PI / 8);
-                                      human->getLeftLowerArm()->setZRotation(3 * M_PI / 8);
-
-                                      human->getRightShoe()->setXRotation(factor * M_PI / 4);
-                                      human->getLeftShoe()->setXRotation(factor * M_PI / 4);
-
-                                      human->getRoot()->setTranslateY(factor * -0.17f);
-                                  });
-    jumpingAnimation->addKeyframe(0.5f,
-                                  [human](const float factor)
-                                  {
-                                      human->getRightLeg()->setXRotation(M_PI / 4 - factor * M_PI / 4);
-                                      human->getLeftLeg()->setXRotation(M_PI / 4 - factor * M_PI / 4);
-
-                                      human->getRightLowerLeg()->setXRotation(-M_PI / 2 + factor * M_PI / 2);
-                                      human->getLeftLowerLeg()->setXRotation(-M_PI / 2 + factor * M_PI / 2);
-
-                                      human->getRightArm()->setZRotation(3 * M_PI / 8 - factor * 6 * M_PI / 8);
-                                      human->getRightLowerArm()->setZRotation(-3 * M_PI / 8 + factor * 3 * M_PI / 8);
-
-                                      human->getLeftArm()->setZRotation(-3 * M_PI / 8 + factor * 6 * M_PI / 8);
-                                      human->getLeftLowerArm()->setZRotation(3 * M_PI / 8 - factor * 3 * M_PI / 8);
-
-                                      human->getRightShoe()->setXRotation(M_PI / 4 - factor * M_PI / 2);
-                                      human->getLeftShoe()->setXRotation(M_PI / 4 - factor * M_PI / 2);
-
-                                      human->getRoot()->setTranslateY(-0.17 + factor * 0.3);
-                                  });
-    jumpingAnimation->addKeyframe(0.75f,
-                                  [human](const float factor)
-                                  {
-                                      human->getRoot()->setTranslateY(0.13f + factor * 0.3f);
-                                  });
-    jumpingAnimation->addKeyframe(1.0f,
-                                  [human](const float factor)
-                                  {
-                                      human->getRoot()->setTranslateY(0.43f - factor * 0.43f);
-
-                                      human->getRightArm()->setZRotation(-3 * M_PI / 8 + factor * 6 * M_PI / 8);
-                                      human->getRightLowerArm()->setZRotation(factor * -3 * M_PI / 8);
-
-                                      human->getLeftArm()->setZRotation(3 * M_PI / 8 - factor * 6 * M_PI / 8);
-                                      human->getLeftLowerArm()->setZRotation(factor * 3 * M_PI / 8);
-
-                                      human->getRightShoe()->setXRotation(-M_PI / 4 + factor * M_PI / 4);
-                                      human->getLeftShoe()->setXRotation(-M_PI / 4 + factor * M_PI / 4);
-                                  });
-    jumpingAnimation->addKeyframe(1.5f,
-                                  [](const double)
-                                  {
-                                  });
-    _animations.push_back(jumpingAnimation);
+    constexpr float times[] = {0.0f, 0.5f, 1.5f, 2.0f};
+    constexpr float swings[] = {0, M_PI / 8, -M_PI / 8, 0};
+    constexpr float headTurns[] = {0, M_PI / 16, -M_PI / 16, 0};
+    AnimationClip clip(2.0f);
+
+    // Every joint follows the swing, scaled by a per-joint factor
+    const auto addSwingTrack = [&](const HumanJoint joint, const float factor, const float angleZ)
+    {
+        RotationTrack& track = clip.addRotationTrack(joint);
+        for (int i = 0; i < 4; ++i)
+        {
+            track.addKey({times[i], Quaternion::fromEulerAngles(factor * swings[i], 0, angleZ)});
+        }
+    };
+    addSwingTrack(RIGHT_LEG, 1, 0);
+    addSwingTrack(LEFT_LEG, -1, 0);
+    addSwingTrack(RIGHT_LOWER_LEG, -0.5f, 0);
+    addSwingTrack(LEFT_LOWER_LEG, 0.5f, 0);
+    addSwingTrack(RIGHT_ARM, -1, ARM_DOWN_ANGLE);
+    addSwingTrack(LEFT_ARM, 1, -ARM_DOWN_ANGLE);
+    addSwingTrack(RIGHT_LOWER_ARM, -1, 0);
+    addSwingTrack(LEFT_LOWER_ARM, 1, 0);
+
+    RotationTrack& headTrack = clip.addRotationTrack(HEAD);
+    for (int i = 0; i < 4; ++i)
+    {
+        headTrack.addKey({times[i], Quaternion::fromEulerAngles(0, headTurns[i], 0)});
+    }
+    addRestTracks(clip);
+    clip.setEvents({{times[1], RIGHT_FOOTSTEP_EVENT}, {times[2], LEFT_FOOTSTEP_EVENT}});
+    return clip;
 }
 
 /**
- * Generate keyframes for the snow angel animation.
+ * Generate the clip of the jumping animation.<br>
+ * Crouch (0 to 0.5), push (0.5 to 0.75), rise (0.75 to 1) and land (1 to 1.5), the feet leaving the ground at the
+ * end of the push and touching it again at the end of the clip.
  *
- * @param human Human to animate
+ * @return The generated clip
  */
-void AnimationManager::_generateAndAddSnowAngelKeyframes(Human* human)
+AnimationClip AnimationManager::_generateJumpingClip()
 {
-    auto* snowAngelAnimation = new Animation();
-    snowAngelAnimation->addKeyframe(0.0f,
-                                    [human](const float factor)
-                                    {
-                                        human->resetMembersRotations();
-                                        human->resetMembersTranslations();
-
-                                        human->getRightArm()->setZRotation(M_PI / 3 - factor * 2 * M_PI / 3);
-                                        human->getRightLowerArm()->setZRotation(M_PI / 3 - factor * 2 * M_PI / 3);
-
-                                        human->getLeftArm()->setZRotation(-M_PI / 3 + factor * 2 * M_PI / 3);
-                                        human->getLeftLowerArm()->setZRotation(-M_PI / 3 + factor * 2 * M_PI / 3);
-
-                                        human->getRightLeg()->setZRotation(-M_PI / 6 + factor * M_PI / 6);
-                                        human->getLeftLeg()->setZRotation(M_PI / 6 - factor * M_PI / 6);
-                                    });
-    snowAngelAnimation->addKeyframe(0.5f,
-                                    [human](const float factor)
-                                    {
-                                        human->getRightArm()->setZRotation(-M_PI / 3 + 2 * factor * M_PI / 3);
-                                        human->getRightLowerArm()->setZRotation(-M_PI / 3 + 2 * factor * M_PI / 3);
-
-                                        human->getLeftArm()->setZRotation(M_PI / 3 - factor * 2 * M_PI / 3);
-                                        human->getLeftLowerArm()->setZRotation(M_PI / 3 - factor * 2 * M_PI / 3);
-
-                                        human->getRightLeg()->setZRotation(factor * -M_PI / 6);
-                                        human->getLeftLeg()->setZRotation(factor * M_PI / 6);
-                                    });
-    snowAngelAnimation->addKeyframe(1.0f,
-                                    [](const float)
-                                    {
-                                    });
-    _animations.push_back(snowAngelAnimation);
+    constexpr float armAngle = 3 * M_PI / 8;
+    AnimationClip clip(1.5f);
+
+    for (const HumanJoint leg: {RIGHT_LEG, LEFT_LEG})
+    {
+        addEulerTrack(clip, leg, {{0.0f, 0, 0, 0}, {0.5f, M_PI / 4, 0, 0}, {0.75f, 0, 0, 0}});
+    }
+    for (const HumanJoint lowerLeg: {RIGHT_LOWER_LEG, LEFT_LOWER_LEG})
+    {
+        addEulerTrack(clip, lowerLeg, {{0.0f, 0, 0, 0}, {0.5f, -M_PI / 2, 0, 0}, {0.75f, 0, 0, 0}});
+    }
+    for (const HumanJoint shoe: {RIGHT_SHOE, LEFT_SHOE})
+    {
+        addEulerTrack(clip, shoe, {
+                          {0.0f, 0, 0, 0},
+                          {0.5f, M_PI / 4, 0, 0},
+                          {0.75f, -M_PI / 4, 0, 0},
+                          {1.0f, -M_PI / 4, 0, 0},
+                          {1.5f, 0, 0, 0}
+                      });
+    }
+
+    // The left side mirrors the right side
+    for (const float side: {1.0f, -1.0f})
+    {
+        const float twist = -side * static_cast<float>(M_PI / 2);
+        addEulerTrack(clip, side > 0 ? RIGHT_ARM : LEFT_ARM, {
+                          {0.0f, 0, twist, side * armAngle},
+                          {0.5f, 0, twist, side * armAngle},
+                          {0.75f, 0, twist, -side * armAngle},
+                          {1.0f, 0, twist, -side * armAngle},
+                          {1.5f, 0, twist, side * armAngle}
+                      });
+        addEulerTrack(clip, side > 0 ? RIGHT_LOWER_ARM : LEFT_LOWER_ARM, {
+                          {0.0f, 0, 0, -side * armAngle},
+                          {0.5f, 0, 0, -side * armAngle},
+                          {0.75f, 0, 0, 0},
+                          {1.0f, 0, 0, 0},
+                          {1.5f, 0, 0, -side * armAngle}
+                      });
+    }
+
+    clip.addTranslationTrack(TORSO)
+            .addKey({0.0f, Vector4(0, 0, 0, 0)})
+            .addKey({0.5f, Vector4(0, -0.17f, 0, 0)})
+            .addKey({0.75f, Vector4(0, 0.13f, 0, 0)})
+            .addKey({1.0f, Vector4(0, 0.43f, 0, 0)})
+            .addKey({1.5f, Vector4(0, 0, 0, 0)});
+    addRestTracks(clip);
+    clip.setEvents({{0.75f, JUMP_TAKEOFF_EVENT}, {1.5f, JUMP_LANDING_EVENT}});
+    return clip;
 }
 
+/**
+ * Generate the clip of the snow angel animation.
+ *
+ * @return The generated clip
+ */
+AnimationClip AnimationManager::_generateSnowAngelClip()
+{
+    constexpr float armAngle = M_PI / 3;
+    constexpr float legAngle = M_PI / 6;
+    AnimationClip clip(1.0f);
+
+    for (const HumanJoint joint: {RIGHT_ARM, RIGHT_LOWER_ARM})
+    {
+        addEulerTrack(clip, joint, {{0.0f, 0, 0, armAngle}, {0.5f, 0, 0, -armAngle}, {1.0f, 0, 0, armAngle}});
+    }
+    for (const HumanJoint joint: {LEFT_ARM, LEFT_LOWER_ARM})
+    {
+        addEulerTrack(clip, joint, {{0.0f, 0, 0, -armAngle}, {0.5f, 0, 0, armAngle}, {1.0f, 0, 0, -armAngle}});
+    }
+    addEulerTrack(clip, RIGHT_LEG, {{0.0f, 0, 0, -legAngle}, {0.5f, 0, 0, 0}, {1.0f, 0, 0, -legAngle}});
+    addEulerTrack(clip, LEFT_LEG, {{0.0f, 0, 0, legAngle}, {0.5f, 0, 0, 0}, {1.0f, 0, 0, legAngle}});
+    addRestTracks(clip);
+    return clip;
+}
@@ -1,5 +1,6 @@
 #include "BufferManager.hpp"
 #include <algorithm>
+#include <cstddef>
 #include <Logger.hpp>
 #include <GL/glew.h>
 
@@ -10,8 +11,34 @@ std::vector<float> BufferManager::_trianglesColorsBuffer = {};
 
 GLuint BufferManager::_glTrianglesVerticesBuffer = 0;
 GLuint BufferManager::_glTrianglesColorsBuffer = 0;
+GLuint BufferManager::_glCubeBuffer = 0;
+GLuint BufferManager::_glInstancesBuffer = 0;
 
 GLuint BufferManager::_vertexArrayID = -1;
+GLuint BufferManager::_instancedVertexArrayID = -1;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Get direct access to the data of a buffer, to fill it in place.<br>
+ * The pointer is invalidated by the next call to allocate(), add() or modify().
+ *
+ * @param bufferToGet The buffer to access
+ * @param startIndex The start index returned by allocate() or add()
+ *
+ * @return The data starting at startIndex (or nullptr if the buffer is invalid)
+ */
+float* BufferManager::getData(const ManipulableBuffer bufferToGet, const unsigned int startIndex)
+{
+    std::vector<float>* buffer = _getBuffer(bufferToGet);
+    if (buffer == nullptr)
+    {
+        return nullptr;
+    }
+    return buffer->data() + startIndex;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Methods
@@ -19,12 +46,39 @@ GLuint BufferManager::_vertexArrayID = -1;
 
 /**
  * Initialize the buffer manager.<br>
- * Create the 2 OpenGL buffers (triangles vertices, triangles colors).
+ * Create the 2 OpenGL buffers (triangles vertices, triangles colors), then the vertex array of the instanced cubes:
+ * the unit cube at location 0, and per instance the rows of its matrix at locations 1 to 3 and its color at location 4.
  */
 void BufferManager::init()
 {
     Logger::debug("BufferManager::init(): Initializing buffer manager.");
 
+    // Init the VAO of the instanced cubes
+    glGenVertexArrays(1, &_instancedVertexArrayID);
+    glBindVertexArray(_instancedVertexArrayID);
+
+    std::vector<float> cube(BodyPart::getVertexCount() * 3);
+    BodyPart::fillCubeVertices(cube.data(), 0.5f, 0.5f, 0.5f);
+    glGenBuffers(1, &_glCubeBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _glCubeBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<long>(cube.size() * sizeof(float)), cube.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glGenBuffers(1, &_glInstancesBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _glInstancesBuffer);
+    for (GLuint row = 0; row < 3; ++row)
+    {
+        glEnableVertexAttribArray(1 + row);
+        glVertexAttribPointer(1 + row, 4, GL_FLOAT, GL_FALSE, sizeof(BodyPartInstance),
+                              reinterpret_cast<void*>(offsetof(BodyPartInstance, rows) + row * 4 * sizeof(float)));
+        glVertexAttribDivisor(1 + row, 1);
+    }
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(BodyPartInstance),
+                          reinterpret_cast<void*>(offsetof(BodyPartInstance, color)));
+    glVertexAttribDivisor(4, 1);
+
     // Init VAO
     glGenVertexArrays(1, &_vertexArrayID);
     glBindVertexArray(_vertexArrayID);
@@ -37,8 +91,22 @@ void BufferManager::init()
 void BufferManager::clean()
 {
     glDeleteVertexArrays(1, &_vertexArrayID);
+    glDeleteVertexArrays(1, &_instancedVertexArrayID);
     glDeleteBuffers(1, &_glTrianglesVerticesBuffer);
     glDeleteBuffers(1, &_glTrianglesColorsBuffer);
+    glDeleteBuffers(1, &_glCubeBuffer);
+    glDeleteBuffers(1, &_glInstancesBuffer);
+}
+
+/**
+ * Empty the CPU side buffers without touching any OpenGL object.<br>
+ * Every body part registered in the buffers must have been destroyed beforehand, as their start indices become
+ * invalid.
+ */
+void BufferManager::reset()
+{
+    _trianglesVerticesBuffer.clear();
+    _trianglesColorsBuffer.clear();
 }
 
 /**
@@ -57,15 +125,37 @@ void BufferManager::drawAll()
     drawTriangles();
 }
 
+/**
+ * Append zeroed data to the buffer that is being manipulated, to be filled in place through getData().
+ *
+ * @param bufferToManipulate The buffer to manipulate
+ * @param count The number of floats to append
+ *
+ * @return the start index of the data in the buffer (or -1 if the buffer is invalid)
+ */
+unsigned int BufferManager::allocate(const ManipulableBuffer bufferToManipulate, const std::size_t count)
+{
+    std::vector<float>* buffer = _getBuffer(bufferToManipulate);
+    if (buffer == nullptr)
+    {
+        return -1;
+    }
+    const unsigned int startIndex = buffer->size();
+    buffer->resize(buffer->size() + count);
+
+    return startIndex;
+}
+
 /**
  * Add data to the buffer that is being manipulated.
  *
  * @param bufferToManipulate The buffer to manipulate
- * @param data The data to add
+ * @param data The data to add (any contiguous storage, frame arena vectors included)
  *
  * @return the start index of the data in the buffer (or -1 if the buffer is invalid)
  */
-unsigned int BufferManager::add(const ManipulableBuffer bufferToManipulate, const std::vector<float>& data)
+unsigned int BufferManager::add(const ManipulableBuffer bufferToManipulate,
+                                const std::span<const float> data)
 {
     std::vector<float>* buffer = _getBuffer(bufferToManipulate);
     if (buffer == nullptr)
@@ -89,7 +179,7 @@ unsigned int BufferManager::add(const ManipulableBuffer bufferToManipulate, cons
  */
 unsigned int BufferManager::modify(const ManipulableBuffer bufferToManipulate,
                                    const unsigned int startIndex,
-                                   const std::vector<float>& data)
+                                   const std::span<const float> data)
 {
     std::vector<float>* buffer = _getBuffer(bufferToManipulate);
     if (buffer == nullptr)
@@ -149,6 +239,30 @@ void BufferManager::drawTriangles()
     glDisableVertexAttribArray(1);
 }
 
+/**
+ * Draw a unit cube per instance, in a single call.<br>
+ * The instances are uploaded each frame, the cube was uploaded once by init().<br>
+ * Don't draw if the buffer manager is not initialized.
+ *
+ * @param instances The instances, see Human::applyTransformation()
+ */
+void BufferManager::drawInstances(const std::span<const BodyPartInstance> instances)
+{
+    if (!_initialized)
+    {
+        Logger::error("BufferManager::drawInstances(): Buffer manager not initialized.");
+        return;
+    }
+    glBindVertexArray(_instancedVertexArrayID);
+    glBindBuffer(GL_ARRAY_BUFFER, _glInstancesBuffer);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<long>(instances.size_bytes()),
+                 instances.data(),
+                 GL_STREAM_DRAW);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, BodyPart::getVertexCount(), static_cast<int>(instances.size()));
+    glBindVertexArray(_vertexArrayID);
+}
+
 std::vector<float>* BufferManager::_getBuffer(const ManipulableBuffer bufferToGet)
 {
     switch (bufferToGet)
@@ -7,6 +7,7 @@
 #include "ShaderException.hpp"
 
 GLuint ShaderManager::_programId = 0;
+GLuint ShaderManager::_instancedProgramId = 0;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Getters
@@ -16,33 +17,63 @@ GLuint ShaderManager::getProgramId()
     return _programId;
 }
 
+GLuint ShaderManager::getInstancedProgramId()
+{
+    return _instancedProgramId;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Methods
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Create the shader programs, the instanced one sharing the fragment shader.
+ * Use the program of the BufferManager buffers.
+ *
+ * @return The ID of the shader program of the BufferManager buffers (0 if an error occurred)
+ */
+GLuint ShaderManager::init()
+{
+    _instancedProgramId = _createProgram(INSTANCED_VERTEX_SHADER_SOURCE_PATH, FRAGMENT_SHADER_SOURCE_PATH);
+    _programId = _createProgram(VERTEX_SHADER_SOURCE_PATH, FRAGMENT_SHADER_SOURCE_PATH);
+    if (_programId == 0)
+    {
+        return 0;
+    }
+    glUseProgram(_programId);
+    glUniform2f(glGetUniformLocation(_programId, "screenSize"), 1000.0f, 700.0f);
+    return _programId;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
  * Load and compile the shaders (Vertex and Fragment).
  * Attach the shaders to a program.
- * Use the program.
  * Detach and delete the shaders.
  *
+ * @param vertexShaderFileName The name of the file of the vertex shader
+ * @param fragmentShaderFileName The name of the file of the fragment shader
+ *
  * @return The ID of the shader program (0 if an error occurred)
  */
-GLuint ShaderManager::init()
+GLuint ShaderManager::_createProgram(const std::string& vertexShaderFileName,
+                                     const std::string& fragmentShaderFileName)
 {
-    const GLuint vertexShader = _compileShader(VERTEX_SHADER_SOURCE_PATH, GL_VERTEX_SHADER);
-    const GLuint fragmentShader = _compileShader(FRAGMENT_SHADER_SOURCE_PATH, GL_FRAGMENT_SHADER);
+    const GLuint vertexShader = _compileShader(vertexShaderFileName, GL_VERTEX_SHADER);
+    const GLuint fragmentShader = _compileShader(fragmentShaderFileName, GL_FRAGMENT_SHADER);
 
     // Create a shader program
     const GLuint programId = glCreateProgram();
     if (programId == 0)
     {
-        Logger::warning("ShaderManager::init(): Shader program creation failed.");
+        Logger::warning("ShaderManager::createProgram(): Shader program creation failed.");
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
         return 0;
     }
-    _programId = programId;
 
     // Attach the shaders to the program
     if (vertexShader != 0)
@@ -66,22 +97,16 @@ GLuint ShaderManager::init()
         std::vector<GLchar> errorLog(maxLength);
         glGetProgramInfoLog(programId, maxLength, &maxLength, &errorLog[0]);
 
-        Logger::error("ShaderManager::init(): Program linking failed: %s",
+        Logger::error("ShaderManager::createProgram(): Program linking failed: %s",
                       errorLog.data());
     }
     glDetachShader(programId, vertexShader);
     glDetachShader(programId, fragmentShader);
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
-    glUseProgram(programId);
-    glUniform2f(glGetUniformLocation(programId, "screenSize"), 1000.0f, 700.0f);
     return programId;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Private methods
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
 /**
  * Compile the shader from the given file.
  *
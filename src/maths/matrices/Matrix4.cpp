@@ -3,7 +3,10 @@
 #include <Logger.hpp>
 #include <Matrix4.hpp>
 #include <sstream>
-#include <vector>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Constructors
@@ -98,7 +101,9 @@ Matrix4& Matrix4::operator=(const Matrix4& other)
 
 /**
  * Multiplication operator overload.<br>
- * Create a new Matrix4 initialized with the product of the left and right matrices.
+ * Create a new Matrix4 initialized with the product of the left and right matrices.<br>
+ * Each row of the result is accumulated as a linear combination of the rows of the right matrix, in the same order as
+ * the row by column dot product, so the SSE and scalar paths give the same results.
  *
  * @param other The matrix to multiply by
  *
@@ -106,26 +111,35 @@ Matrix4& Matrix4::operator=(const Matrix4& other)
  */
 Matrix4 Matrix4::operator*(const Matrix4& other) const
 {
-    const std::array rows = {getRow(0), getRow(1), getRow(2), getRow(3)};
-    const std::array columns = {
-        other.getColumn(0),
-        other.getColumn(1),
-        other.getColumn(2),
-        other.getColumn(3)
-    };
-    std::vector<float> resVector;
-
-    for (const Vector4& row: rows)
+    std::array<float, 16> resultArray{};
+    const float* otherData = other._data;
+
+#if defined(__SSE__)
+    const __m128 otherRow0 = _mm_loadu_ps(otherData + 0);
+    const __m128 otherRow1 = _mm_loadu_ps(otherData + 4);
+    const __m128 otherRow2 = _mm_loadu_ps(otherData + 8);
+    const __m128 otherRow3 = _mm_loadu_ps(otherData + 12);
+
+    for (int row = 0; row < 4; ++row)
+    {
+        __m128 result = _mm_mul_ps(_mm_set1_ps(_data[row * 4 + 0]), otherRow0);
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(_data[row * 4 + 1]), otherRow1));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(_data[row * 4 + 2]), otherRow2));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(_data[row * 4 + 3]), otherRow3));
+        _mm_storeu_ps(resultArray.data() + row * 4, result);
+    }
+#else
+    for (int row = 0; row < 4; ++row)
     {
-        for (const Vector4& col: columns)
+        for (int column = 0; column < 4; ++column)
         {
-            resVector.push_back(row[0] * col[0] + row[1] * col[1] + row[2] * col[2] + row[3] * col[3]);
+            resultArray[row * 4 + column] = _data[row * 4 + 0] * otherData[0 + column]
+                                            + _data[row * 4 + 1] * otherData[4 + column]
+                                            + _data[row * 4 + 2] * otherData[8 + column]
+                                            + _data[row * 4 + 3] * otherData[12 + column];
         }
     }
-
-    // Convert the std::vector<float> to std::array<float, 16>
-    std::array<float, 16> resultArray{};
-    std::copy(resVector.begin(), resVector.end(), resultArray.begin());
+#endif
 
     return Matrix4(resultArray);
 }
@@ -182,7 +196,52 @@ std::ostream& operator<<(std::ostream& os, const Matrix4& matrix)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * Create a rotation matrix for the X, Y and Z axis.
+ * Transform a batch of points (x, y, z with an implicit w of 1) by the matrix.<br>
+ * Only the x, y and z components of the results are written. points and result may be the same buffer.
+ *
+ * @param points The 3 * count input coordinates
+ * @param result The 3 * count output coordinates
+ * @param count The number of points
+ */
+void Matrix4::transformPoints(const float* points, float* result, const std::size_t count) const
+{
+#if defined(__SSE__)
+    const __m128 column0 = _mm_setr_ps(_data[0], _data[4], _data[8], _data[12]);
+    const __m128 column1 = _mm_setr_ps(_data[1], _data[5], _data[9], _data[13]);
+    const __m128 column2 = _mm_setr_ps(_data[2], _data[6], _data[10], _data[14]);
+    const __m128 column3 = _mm_setr_ps(_data[3], _data[7], _data[11], _data[15]);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float* point = points + i * 3;
+        __m128 transformed = _mm_mul_ps(column0, _mm_set1_ps(point[0]));
+        transformed = _mm_add_ps(transformed, _mm_mul_ps(column1, _mm_set1_ps(point[1])));
+        transformed = _mm_add_ps(transformed, _mm_mul_ps(column2, _mm_set1_ps(point[2])));
+        transformed = _mm_add_ps(transformed, column3);
+
+        // Only x, y and z are stored: a 4-wide store would write w over the x of the next point, not read yet when
+        // points and result are the same buffer
+        float* output = result + i * 3;
+        _mm_storel_pi(reinterpret_cast<__m64*>(output), transformed);
+        _mm_store_ss(output + 2, _mm_movehl_ps(transformed, transformed));
+    }
+#else
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float x = points[i * 3 + 0];
+        const float y = points[i * 3 + 1];
+        const float z = points[i * 3 + 2];
+
+        result[i * 3 + 0] = _data[0] * x + _data[1] * y + _data[2] * z + _data[3];
+        result[i * 3 + 1] = _data[4] * x + _data[5] * y + _data[6] * z + _data[7];
+        result[i * 3 + 2] = _data[8] * x + _data[9] * y + _data[10] * z + _data[11];
+    }
+#endif
+}
+
+/**
+ * Create a rotation matrix for the X, Y and Z axis.<br>
+ * Equivalent to createRotationXMatrix(angleX) * createRotationYMatrix(angleY) * createRotationZMatrix(angleZ).
  *
  * @param angleX The angle in radians to apply on the x-axis
  * @param angleY The angle in radians to apply on the y-axis
@@ -192,7 +251,7 @@ std::ostream& operator<<(std::ostream& os, const Matrix4& matrix)
  */
 Matrix4 Matrix4::createRotationMatrix(const double angleX, const double angleY, const double angleZ)
 {
-    return createRotationXMatrix(angleX) * createRotationYMatrix(angleY) * createRotationZMatrix(angleZ);
+    return createTRSMatrix(0, 0, 0, angleX, angleY, angleZ, 1, 1, 1);
 }
 
 /**
@@ -323,6 +382,51 @@ Matrix4 Matrix4::createTranslationMatrix(const float tx, const float ty, const f
     //@formatter:on
 }
 
+/**
+ * Create a translation * rotation * scaling matrix in a single pass such as :<br>
+ *  [r00 * sx, r01 * sy, r02 * sz, tx]<br>
+ *  [r10 * sx, r11 * sy, r12 * sz, ty]<br>
+ *  [r20 * sx, r21 * sy, r22 * sz, tz]<br>
+ *  [0, 0, 0, 1]<br>
+ * where r is the X * Y * Z rotation matrix.<br>
+ * The products are ordered as in the chained multiplication so both give the same results.
+ *
+ * @param tx The x translation
+ * @param ty The y translation
+ * @param tz The z translation
+ * @param angleX The angle in radians to apply on the x-axis
+ * @param angleY The angle in radians to apply on the y-axis
+ * @param angleZ The angle in radians to apply on the z-axis
+ * @param sx The x scale
+ * @param sy The y scale
+ * @param sz The z scale
+ *
+ * @return The created matrix
+ */
+Matrix4 Matrix4::createTRSMatrix(const float tx, const float ty, const float tz,
+                                 const double angleX, const double angleY, const double angleZ,
+                                 const float sx, const float sy, const float sz)
+{
+    const auto cosX = static_cast<float>(cos(angleX));
+    const auto sinX = static_cast<float>(sin(angleX));
+    const auto cosY = static_cast<float>(cos(angleY));
+    const auto sinY = static_cast<float>(sin(angleY));
+    const auto cosZ = static_cast<float>(cos(angleZ));
+    const auto sinZ = static_cast<float>(sin(angleZ));
+
+    const float sinXSinY = sinX * sinY;
+    const float cosXSinY = -cosX * sinY;
+
+    //@formatter:off
+    return Matrix4({
+                      cosY * cosZ * sx,                 cosY * -sinZ * sy,          sinY * sz, tx,
+        (sinXSinY * cosZ + cosX * sinZ) * sx, (sinXSinY * -sinZ + cosX * cosZ) * sy, -sinX * cosY * sz, ty,
+        (cosXSinY * cosZ + sinX * sinZ) * sx, (cosXSinY * -sinZ + sinX * cosZ) * sy,  cosX * cosY * sz, tz,
+                                         0,                                     0,                  0,  1
+    });
+    //@formatter:on
+}
+
 /**
  * Create an identity matrix such as :<br>
  *  [1, 0, 0, 0]<br>
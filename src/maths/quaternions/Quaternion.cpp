@@ -0,0 +1,327 @@
+#include "Quaternion.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Default constructor, the identity rotation.
+ */
+Quaternion::Quaternion() : Quaternion(1.0f, 0.0f, 0.0f, 0.0f)
+{
+}
+
+/**
+ * Constructor.
+ *
+ * @param w The scalar part
+ * @param x The x component of the vector part
+ * @param y The y component of the vector part
+ * @param z The z component of the vector part
+ */
+Quaternion::Quaternion(const float w, const float x, const float y, const float z) : _w(w), _x(x), _y(y), _z(z)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The scalar part of the quaternion
+ */
+float Quaternion::getW() const
+{
+    return _w;
+}
+
+/**
+ * @return The x component of the vector part of the quaternion
+ */
+float Quaternion::getX() const
+{
+    return _x;
+}
+
+/**
+ * @return The y component of the vector part of the quaternion
+ */
+float Quaternion::getY() const
+{
+    return _y;
+}
+
+/**
+ * @return The z component of the vector part of the quaternion
+ */
+float Quaternion::getZ() const
+{
+    return _z;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Operator overloads
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Hamilton product of two quaternions.
+ *
+ * @param other The right quaternion, applied first
+ *
+ * @return The combined rotation
+ */
+Quaternion Quaternion::operator*(const Quaternion& other) const
+{
+    return {
+        _w * other._w - _x * other._x - _y * other._y - _z * other._z,
+        _w * other._x + _x * other._w + _y * other._z - _z * other._y,
+        _w * other._y - _x * other._z + _y * other._w + _z * other._x,
+        _w * other._z + _x * other._y - _y * other._x + _z * other._w
+    };
+}
+
+bool Quaternion::operator==(const Quaternion& other) const
+{
+    return _w == other._w && _x == other._x && _y == other._y && _z == other._z;
+}
+
+bool Quaternion::operator!=(const Quaternion& other) const
+{
+    return !(*this == other);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The conjugate of the quaternion, its inverse rotation when normalized
+ */
+Quaternion Quaternion::conjugate() const
+{
+    return {_w, -_x, -_y, -_z};
+}
+
+/**
+ * @return The 4D dot product of the two quaternions
+ */
+float Quaternion::dot(const Quaternion& other) const
+{
+    return _w * other._w + _x * other._x + _y * other._y + _z * other._z;
+}
+
+/**
+ * @return The quaternion scaled to a length of 1 (or the identity if its length is 0)
+ */
+Quaternion Quaternion::normalize() const
+{
+    const float length = std::sqrt(dot(*this));
+    if (length == 0.0f)
+    {
+        return identity();
+    }
+    return {_w / length, _x / length, _y / length, _z / length};
+}
+
+/**
+ * Rotate the x, y and z components of a vector.
+ *
+ * @param vector The vector to rotate
+ *
+ * @return The rotated vector, with the w component of the input
+ */
+Vector4 Quaternion::rotate(const Vector4& vector) const
+{
+    const Quaternion rotated = *this * Quaternion(0.0f, vector.getX(), vector.getY(), vector.getZ()) * conjugate();
+    return {rotated._x, rotated._y, rotated._z, vector.getW()};
+}
+
+/**
+ * @return The rotation matrix of the quaternion
+ */
+Matrix4 Quaternion::toMatrix() const
+{
+    const float xx = _x * _x;
+    const float yy = _y * _y;
+    const float zz = _z * _z;
+    const float xy = _x * _y;
+    const float xz = _x * _z;
+    const float yz = _y * _z;
+    const float wx = _w * _x;
+    const float wy = _w * _y;
+    const float wz = _w * _z;
+
+    //@formatter:off
+    return Matrix4({
+        1 - 2 * (yy + zz),     2 * (xy - wz),     2 * (xz + wy), 0,
+            2 * (xy + wz), 1 - 2 * (xx + zz),     2 * (yz - wx), 0,
+            2 * (xz - wy),     2 * (yz + wx), 1 - 2 * (xx + yy), 0,
+                        0,                 0,                 0, 1
+    });
+    //@formatter:on
+}
+
+/**
+ * Decompose the rotation into the angles used by Matrix4::createRotationMatrix() (X * Y * Z).
+ *
+ * @param angleX The angle around the x-axis, in radians
+ * @param angleY The angle around the y-axis, in radians
+ * @param angleZ The angle around the z-axis, in radians
+ */
+void Quaternion::toEulerAngles(float& angleX, float& angleY, float& angleZ) const
+{
+    const float m02 = 2 * (_x * _z + _w * _y);
+    const float m12 = 2 * (_y * _z - _w * _x);
+    const float m22 = 1 - 2 * (_x * _x + _y * _y);
+    const float m01 = 2 * (_x * _y - _w * _z);
+    const float m00 = 1 - 2 * (_y * _y + _z * _z);
+
+    angleY = std::asin(std::clamp(m02, -1.0f, 1.0f));
+    angleX = std::atan2(-m12, m22);
+    angleZ = std::atan2(-m01, m00);
+}
+
+/**
+ * @return The string representation of the quaternion
+ */
+std::string Quaternion::toString() const
+{
+    std::ostringstream oss;
+    oss << "Quaternion(" << _w << ", " << _x << ", " << _y << ", " << _z << ")";
+    return oss.str();
+}
+
+/**
+ * @return The quaternion of the null rotation
+ */
+Quaternion Quaternion::identity()
+{
+    return {};
+}
+
+/**
+ * Create the rotation of an angle around an axis.
+ *
+ * @param axisX The x component of the normalized axis
+ * @param axisY The y component of the normalized axis
+ * @param axisZ The z component of the normalized axis
+ * @param angle The angle in radians
+ *
+ * @return The rotation
+ */
+Quaternion Quaternion::fromAxisAngle(const float axisX, const float axisY, const float axisZ, const float angle)
+{
+    const float halfSin = std::sin(angle / 2);
+    return {std::cos(angle / 2), axisX * halfSin, axisY * halfSin, axisZ * halfSin};
+}
+
+/**
+ * Create the rotation built by Matrix4::createRotationMatrix() (X * Y * Z).
+ *
+ * @param angleX The angle around the x-axis, in radians
+ * @param angleY The angle around the y-axis, in radians
+ * @param angleZ The angle around the z-axis, in radians
+ *
+ * @return The rotation
+ */
+Quaternion Quaternion::fromEulerAngles(const float angleX, const float angleY, const float angleZ)
+{
+    return fromAxisAngle(1, 0, 0, angleX) * fromAxisAngle(0, 1, 0, angleY) * fromAxisAngle(0, 0, 1, angleZ);
+}
+
+/**
+ * Normalized linear interpolation, along the shortest path.<br>
+ * Cheaper than slerp() but its angular speed is not constant. This is the kernel of pose blending, so the four
+ * components are interpolated at once with SSE when available.
+ *
+ * @param from The rotation at factor 0
+ * @param to The rotation at factor 1
+ * @param factor The interpolation factor
+ *
+ * @return The interpolated rotation
+ */
+Quaternion Quaternion::nlerp(const Quaternion& from, const Quaternion& to, const float factor)
+{
+#if defined(__SSE__)
+    static_assert(sizeof(Quaternion) == 4 * sizeof(float), "The components must be tightly packed");
+    const __m128 fromValues = _mm_loadu_ps(&from._w);
+    const __m128 toValues = _mm_loadu_ps(&to._w);
+    // Broadcast the sum of the four lanes to every lane
+    const auto horizontalSum = [](const __m128 values)
+    {
+        const __m128 pairs = _mm_add_ps(values, _mm_shuffle_ps(values, values, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+    };
+
+    // Flip the sign of the target weight when the dot product is negative, without branching
+    const __m128 signBit = _mm_and_ps(horizontalSum(_mm_mul_ps(fromValues, toValues)), _mm_set1_ps(-0.0f));
+    const __m128 toWeight = _mm_xor_ps(_mm_set1_ps(factor), signBit);
+    const __m128 blended = _mm_add_ps(_mm_mul_ps(fromValues, _mm_set1_ps(1 - factor)), _mm_mul_ps(toValues, toWeight));
+    const __m128 squaredLength = horizontalSum(_mm_mul_ps(blended, blended));
+    if (_mm_cvtss_f32(squaredLength) == 0.0f)
+    {
+        return identity();
+    }
+    Quaternion result;
+    _mm_storeu_ps(&result._w, _mm_div_ps(blended, _mm_sqrt_ps(squaredLength)));
+    return result;
+#else
+    const float sign = from.dot(to) < 0 ? -1.0f : 1.0f;
+    const float fromWeight = 1 - factor;
+    const float toWeight = factor * sign;
+
+    return Quaternion(fromWeight * from._w + toWeight * to._w,
+                      fromWeight * from._x + toWeight * to._x,
+                      fromWeight * from._y + toWeight * to._y,
+                      fromWeight * from._z + toWeight * to._z).normalize();
+#endif
+}
+
+/**
+ * Spherical linear interpolation, along the shortest path.
+ *
+ * @param from The rotation at factor 0
+ * @param to The rotation at factor 1
+ * @param factor The interpolation factor
+ *
+ * @return The interpolated rotation
+ */
+Quaternion Quaternion::slerp(const Quaternion& from, const Quaternion& to, const float factor)
+{
+    float cosAngle = from.dot(to);
+    const float sign = cosAngle < 0 ? -1.0f : 1.0f;
+    cosAngle *= sign;
+
+    // Nearly identical rotations: the sine below would vanish
+    if (cosAngle > 0.9995f)
+    {
+        return nlerp(from, to, factor);
+    }
+    const float angle = std::acos(cosAngle);
+    const float sinAngle = std::sin(angle);
+    const float fromWeight = std::sin((1 - factor) * angle) / sinAngle;
+    const float toWeight = std::sin(factor * angle) / sinAngle * sign;
+
+    return {
+        fromWeight * from._w + toWeight * to._w,
+        fromWeight * from._x + toWeight * to._x,
+        fromWeight * from._y + toWeight * to._y,
+        fromWeight * from._z + toWeight * to._z
+    };
+}
+
+/**
+ * Overload of the << operator to print a quaternion.
+ */
+std::ostream& operator<<(std::ostream& os, const Quaternion& quaternion)
+{
+    os << quaternion.toString();
+    return os;
+}
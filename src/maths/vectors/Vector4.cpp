@@ -548,7 +548,7 @@ Vector4 Vector4::cross(const Vector4& other) const
  */
 [[nodiscard]] float Vector4::magnitude() const
 {
-    return sqrtf(powf(_data[0], 2) + powf(_data[1], 2) + powf(_data[2], 2));
+    return sqrtf(_data[0] * _data[0] + _data[1] * _data[1] + _data[2] * _data[2]);
 }
 
 /**
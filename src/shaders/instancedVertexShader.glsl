@@ -0,0 +1,26 @@
+#version 450 core
+
+layout (location = 0) in vec3 vertexPosition;   // Vertex of the unit cube
+layout (location = 1) in vec4 instanceRow0;     // First row of the matrix from the unit cube to the world
+layout (location = 2) in vec4 instanceRow1;     // Second row of the matrix
+layout (location = 3) in vec4 instanceRow2;     // Third row of the matrix
+layout (location = 4) in vec4 instanceColor;    // Color of the body part
+
+out vec3 fragmentColor;     // Output to the fragment shader
+
+uniform mat4 projection;    // Projection matrix
+uniform bool picking;       // Whether each instance is drawn with the color encoding its index
+
+void main(void) {
+    vec4 position = vec4(vertexPosition, 1);
+    vec3 world = vec3(dot(instanceRow0, position), dot(instanceRow1, position), dot(instanceRow2, position));
+
+    if (picking) {
+        // The index + 1, in bytes from the lowest, 0 being left to the background
+        int id = gl_InstanceID + 1;
+        fragmentColor = vec3(id & 0xFF, (id >> 8) & 0xFF, (id >> 16) & 0xFF) / 255.0;
+    } else {
+        fragmentColor = instanceColor.rgb;
+    }
+    gl_Position = projection * vec4(world, 1);
+}
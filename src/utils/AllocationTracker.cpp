@@ -0,0 +1,211 @@
+#include "AllocationTracker.hpp"
+#include <AllocationException.hpp>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+std::atomic<std::size_t> AllocationTracker::_allocations = 0;
+std::atomic<std::size_t> AllocationTracker::_deallocations = 0;
+std::atomic<std::size_t> AllocationTracker::_allocatedBytes = 0;
+thread_local AllocationStats AllocationTracker::_threadStats;
+AllocationStats AllocationTracker::_frameStartStats;
+AllocationStats AllocationTracker::_lastFrameStats;
+unsigned int AllocationTracker::_frameCount = 0;
+bool AllocationTracker::_strict = false;
+unsigned int AllocationTracker::_warmupFrames = 0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The counters of all threads since the start of the program
+ */
+AllocationStats AllocationTracker::getGlobalStats()
+{
+    return {
+        _allocations.load(std::memory_order_relaxed),
+        _deallocations.load(std::memory_order_relaxed),
+        _allocatedBytes.load(std::memory_order_relaxed)
+    };
+}
+
+/**
+ * @return The counters of the calling thread since its start
+ */
+AllocationStats AllocationTracker::getThreadStats()
+{
+    return _threadStats;
+}
+
+/**
+ * @return The allocations done by all threads during the last completed frame
+ */
+const AllocationStats& AllocationTracker::getLastFrameStats()
+{
+    return _lastFrameStats;
+}
+
+/**
+ * @return Whether the strict mode is enabled
+ */
+bool AllocationTracker::isStrict()
+{
+    return _strict;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Enable or disable the strict mode.
+ *
+ * @param strict Whether a steady-state frame is allowed to allocate
+ * @param warmupFrames The number of frames, counted from now, allowed to allocate while caches and buffers grow
+ */
+void AllocationTracker::setStrict(const bool strict, const unsigned int warmupFrames)
+{
+    _strict = strict;
+    _warmupFrames = _frameCount + warmupFrames;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Mark the beginning of a frame.
+ */
+void AllocationTracker::beginFrame()
+{
+    _frameStartStats = getGlobalStats();
+}
+
+/**
+ * Mark the end of the frame started by beginFrame().
+ *
+ * @throw AllocationException If the strict mode is enabled and this steady-state frame allocated
+ *
+ * @return The allocations done during the frame
+ */
+const AllocationStats& AllocationTracker::endFrame()
+{
+    const AllocationStats now = getGlobalStats();
+
+    _lastFrameStats.allocations = now.allocations - _frameStartStats.allocations;
+    _lastFrameStats.deallocations = now.deallocations - _frameStartStats.deallocations;
+    _lastFrameStats.allocatedBytes = now.allocatedBytes - _frameStartStats.allocatedBytes;
+    _frameCount++;
+
+    if (_strict && _frameCount > _warmupFrames && _lastFrameStats.allocations > 0)
+    {
+        throw AllocationException("Frame " + std::to_string(_frameCount) + " allocated "
+                                  + std::to_string(_lastFrameStats.allocations) + " times ("
+                                  + std::to_string(_lastFrameStats.allocatedBytes) + " bytes) in steady state.");
+    }
+    return _lastFrameStats;
+}
+
+/**
+ * Record a heap allocation.
+ *
+ * @param size The number of bytes requested
+ */
+void AllocationTracker::recordAllocation(const std::size_t size)
+{
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    _allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    _threadStats.allocations++;
+    _threadStats.allocatedBytes += size;
+}
+
+/**
+ * Record a heap deallocation.
+ */
+void AllocationTracker::recordDeallocation()
+{
+    _deallocations.fetch_add(1, std::memory_order_relaxed);
+    _threadStats.deallocations++;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Global allocation functions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void* operator new(const std::size_t size)
+{
+    AllocationTracker::recordAllocation(size);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    AllocationTracker::recordAllocation(size);
+    const auto alignmentValue = static_cast<std::size_t>(alignment);
+    // std::aligned_alloc requires the size to be a multiple of the alignment
+    const std::size_t alignedSize = (size + alignmentValue - 1) / alignmentValue * alignmentValue;
+    if (void* pointer = std::aligned_alloc(alignmentValue, alignedSize == 0 ? alignmentValue : alignedSize))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer)
+    {
+        AllocationTracker::recordDeallocation();
+    }
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    operator delete(pointer);
+}
@@ -0,0 +1,189 @@
+#include "FrameArena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <MemoryDefines.hpp>
+
+std::atomic<std::uint64_t> FrameArena::_currentFrame = 0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create an arena.
+ *
+ * @param capacity The initial size in bytes of the main block
+ */
+FrameArena::FrameArena(const std::size_t capacity) : _block(_allocateBlock(std::max<std::size_t>(capacity, 1)))
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Destructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+FrameArena::~FrameArena()
+{
+    for (const Block& block: _overflowBlocks)
+    {
+        _freeBlock(block);
+    }
+    _freeBlock(_block);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The arena of the calling thread, created on first use and reset on first use in each frame
+ */
+FrameArena& FrameArena::getThreadArena()
+{
+    thread_local FrameArena arena(FRAME_ARENA_CAPACITY);
+    if (const std::uint64_t frame = _currentFrame.load(std::memory_order_relaxed); arena._frame != frame)
+    {
+        arena.reset();
+        arena._frame = frame;
+    }
+    return arena;
+}
+
+/**
+ * @return The size in bytes of the main block
+ */
+std::size_t FrameArena::getCapacity() const
+{
+    return _block.size;
+}
+
+/**
+ * @return The number of bytes handed out since the last reset()
+ */
+std::size_t FrameArena::getUsedBytes() const
+{
+    return _usedBytes;
+}
+
+/**
+ * @return The highest number of bytes handed out during a single frame
+ */
+std::size_t FrameArena::getPeakBytes() const
+{
+    return std::max(_peakBytes, _usedBytes);
+}
+
+/**
+ * @return An allocator usable by any std::pmr container
+ */
+std::pmr::polymorphic_allocator<std::byte> FrameArena::getAllocator()
+{
+    return {this};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Start a new frame: everything allocated from the arena of any thread during the previous frames is released, each
+ * arena being reset when its thread next gets it.<br>
+ * Must be called while no job runs, by the thread running the frame.
+ */
+void FrameArena::beginFrame()
+{
+    _currentFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Release everything allocated since the last reset().<br>
+ * If the frame overflowed, the main block is replaced by one big enough to hold the whole frame.
+ */
+void FrameArena::reset()
+{
+    _peakBytes = std::max(_peakBytes, _usedBytes);
+    if (!_overflowBlocks.empty())
+    {
+        std::size_t capacity = _block.size;
+        for (const Block& block: _overflowBlocks)
+        {
+            capacity += block.size;
+            _freeBlock(block);
+        }
+        _overflowBlocks.clear();
+        _freeBlock(_block);
+        _block = _allocateBlock(capacity);
+    }
+    _offset = 0;
+    _usedBytes = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Memory resource interface
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Bump the offset of the main block, or fall back on an overflow block when it is full.
+ *
+ * @param bytes The number of bytes requested
+ * @param alignment The alignment requested
+ *
+ * @return The allocated memory
+ */
+void* FrameArena::do_allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    const auto base = reinterpret_cast<std::uintptr_t>(_block.data);
+    const std::uintptr_t aligned = (base + _offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    const std::size_t end = aligned - base + bytes;
+
+    _usedBytes += bytes;
+    if (end <= _block.size)
+    {
+        _offset = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // The overflow block only holds this allocation, the next reset() folds it into the main block
+    const Block block = _allocateBlock(bytes + alignment);
+    _overflowBlocks.push_back(block);
+    const auto overflowBase = reinterpret_cast<std::uintptr_t>(block.data);
+    return reinterpret_cast<void*>((overflowBase + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+}
+
+/**
+ * Do nothing: the memory is released by reset().
+ */
+void FrameArena::do_deallocate(void*, std::size_t, std::size_t)
+{
+}
+
+/**
+ * @return Whether memory allocated by other can be deallocated by this arena
+ */
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return A new heap block of the given size
+ */
+FrameArena::Block FrameArena::_allocateBlock(const std::size_t size)
+{
+    return {
+        static_cast<std::byte*>(::operator new(size, std::align_val_t(FRAME_ARENA_BLOCK_ALIGNMENT))),
+        size
+    };
+}
+
+/**
+ * Free a block returned by _allocateBlock().
+ */
+void FrameArena::_freeBlock(const Block& block)
+{
+    ::operator delete(block.data, std::align_val_t(FRAME_ARENA_BLOCK_ALIGNMENT));
+}
@@ -0,0 +1,165 @@
+#include "SimulationClock.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * The fraction of a step still counted as a whole step, so that the rounding of the timestep to a float does not
+ * postpone a step by a frame when the frame time is a multiple of the timestep.
+ */
+static constexpr double STEP_TOLERANCE = 1e-4;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create a running clock at time 0.
+ *
+ * @param timestep The seconds simulated by each step
+ */
+SimulationClock::SimulationClock(const float timestep) : _timestep(timestep),
+                                                         _timeScale(1.0f),
+                                                         _paused(false),
+                                                         _requestedSteps(0),
+                                                         _accumulator(0.0),
+                                                         _stepCount(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The seconds simulated by each step
+ */
+float SimulationClock::getTimestep() const
+{
+    return _timestep;
+}
+
+/**
+ * @return The factor applied to real time
+ */
+float SimulationClock::getTimeScale() const
+{
+    return _timeScale;
+}
+
+/**
+ * @return The simulated time in seconds, a whole number of steps
+ */
+double SimulationClock::getTime() const
+{
+    return static_cast<double>(_stepCount) * _timestep;
+}
+
+/**
+ * @return The number of steps run since the creation or the last reset of the clock
+ */
+std::uint64_t SimulationClock::getStepCount() const
+{
+    return _stepCount;
+}
+
+/**
+ * @return How far the clock is between the last step and the next one, from 0 to 1, to interpolate rendered states
+ */
+float SimulationClock::getInterpolation() const
+{
+    return static_cast<float>(_accumulator / _timestep);
+}
+
+/**
+ * @return Whether the clock only advances by the steps requested with requestStep()
+ */
+bool SimulationClock::isPaused() const
+{
+    return _paused;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Set the factor applied to real time.
+ *
+ * @param timeScale The new factor, 1 for real time (negative values are clamped to 0)
+ *
+ * @return itself
+ */
+SimulationClock& SimulationClock::setTimeScale(const float timeScale)
+{
+    _timeScale = std::max(timeScale, 0.0f);
+    return *this;
+}
+
+/**
+ * Pause or resume the clock.<br>
+ * The time accumulated before the pause is kept, so resuming does not skip or replay any step.
+ *
+ * @param paused Whether the clock only advances by the requested steps
+ *
+ * @return itself
+ */
+SimulationClock& SimulationClock::setPaused(const bool paused)
+{
+    _paused = paused;
+    _requestedSteps = 0;
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Advance the clock by the real time elapsed since the previous call.<br>
+ * The caller then runs the returned number of steps, each of getTimestep() seconds. At most SIMULATION_MAX_STEPS
+ * steps are run at once: after a long hitch, the late time is dropped instead of slowing every following frame down.
+ *
+ * @param realDeltaTime The real time in seconds elapsed since the previous call
+ *
+ * @return The number of steps to run
+ */
+unsigned int SimulationClock::advance(const double realDeltaTime)
+{
+    unsigned int steps;
+    if (_paused)
+    {
+        steps = std::min(_requestedSteps, static_cast<unsigned int>(SIMULATION_MAX_STEPS));
+        _requestedSteps = 0;
+    }
+    else
+    {
+        _accumulator += std::max(realDeltaTime, 0.0) * _timeScale;
+        const double dueSteps = std::floor(_accumulator / _timestep + STEP_TOLERANCE);
+        steps = static_cast<unsigned int>(std::min(dueSteps, static_cast<double>(SIMULATION_MAX_STEPS)));
+        // The steps beyond the limit are consumed without being run
+        _accumulator = std::max(_accumulator - dueSteps * _timestep, 0.0);
+    }
+    _stepCount += steps;
+    return steps;
+}
+
+/**
+ * Request a single step, run by the next advance() if the clock is paused (ignored otherwise).
+ */
+void SimulationClock::requestStep()
+{
+    if (_paused)
+    {
+        ++_requestedSteps;
+    }
+}
+
+/**
+ * Put the clock back to time 0, keeping its timestep, time scale and pause state.
+ */
+void SimulationClock::reset()
+{
+    _requestedSteps = 0;
+    _accumulator = 0.0;
+    _stepCount = 0;
+}
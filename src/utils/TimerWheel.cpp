@@ -0,0 +1,234 @@
+#include "TimerWheel.hpp"
+#include <algorithm>
+#include <bit>
+
+/**
+ * The mask of the digit of a tick indexing the slots of a level.
+ */
+static constexpr std::uint64_t SLOT_MASK = TimerWheel::SLOT_COUNT - 1;
+
+/**
+ * The mask of the ticks covered by every level, the overflow list being looked at when they are all 0.
+ */
+static constexpr std::uint64_t WHEEL_MASK = (std::uint64_t{1} << (TimerWheel::SLOT_BITS * TimerWheel::LEVEL_COUNT)) - 1;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructors
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Create an empty wheel at tick 0.
+ */
+TimerWheel::TimerWheel() : _tick(0), _size(0), _firstFree(NO_TIMER), _lists()
+{
+    _lists.fill(NO_TIMER);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return The last tick reached by advance()
+ */
+std::uint64_t TimerWheel::getTick() const
+{
+    return _tick;
+}
+
+/**
+ * @return The number of scheduled timers
+ */
+std::size_t TimerWheel::getSize() const
+{
+    return _size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Grow the pool to a number of timers, so that scheduling them does not allocate.
+ *
+ * @param timerCount The number of timers
+ */
+void TimerWheel::reserve(const std::size_t timerCount)
+{
+    while (_timers.size() < timerCount)
+    {
+        _timers.push_back({0, 0, NO_TIMER, NO_TIMER, _firstFree});
+        _firstFree = static_cast<std::uint32_t>(_timers.size() - 1);
+    }
+}
+
+/**
+ * Schedule a timer.
+ *
+ * @param tick The tick to fire at, a tick already reached firing at the next one
+ * @param payload The value given back by advance() when the timer fires
+ *
+ * @return The handle of the timer, valid until it fires or is cancelled
+ */
+std::uint32_t TimerWheel::schedule(const std::uint64_t tick, const std::uint32_t payload)
+{
+    if (_firstFree == NO_TIMER)
+    {
+        reserve(std::max<std::size_t>(_timers.size() * 2, SLOT_COUNT));
+    }
+    const std::uint32_t timer = _firstFree;
+    _firstFree = _timers[timer].next;
+    _timers[timer].tick = std::max(tick, _tick + 1);
+    _timers[timer].payload = payload;
+    _insert(timer);
+    ++_size;
+    return timer;
+}
+
+/**
+ * Cancel a scheduled timer.
+ *
+ * @param timer The handle of the timer (nothing happens for NO_TIMER or a timer already fired)
+ */
+void TimerWheel::cancel(const std::uint32_t timer)
+{
+    if (timer >= _timers.size() || _timers[timer].list == NO_TIMER)
+    {
+        return;
+    }
+    _unlink(timer);
+    _timers[timer].next = _firstFree;
+    _firstFree = timer;
+    --_size;
+}
+
+/**
+ * Move the wheel forward tick by tick, firing the timers reached.
+ *
+ * @param tick The tick to reach (nothing happens if it was already reached)
+ * @param payloads The payloads of the fired timers, appended tick after tick
+ */
+void TimerWheel::advance(const std::uint64_t tick, FrameVector<std::uint32_t>& payloads)
+{
+    while (_tick < tick)
+    {
+        if (_size == 0)
+        {
+            _tick = tick;
+            return;
+        }
+        ++_tick;
+
+        // The upper slots reached are moved down first, their timers may be due at this very tick
+        if ((_tick & WHEEL_MASK) == 0)
+        {
+            _cascade(OVERFLOW_LIST);
+        }
+        for (std::size_t level = LEVEL_COUNT - 1; level > 0; --level)
+        {
+            if ((_tick & ((std::uint64_t{1} << (SLOT_BITS * level)) - 1)) == 0)
+            {
+                _cascade(static_cast<std::uint32_t>(level * SLOT_COUNT + ((_tick >> (SLOT_BITS * level)) & SLOT_MASK)));
+            }
+        }
+
+        const auto slot = static_cast<std::uint32_t>(_tick & SLOT_MASK);
+        std::uint32_t timer = _lists[slot];
+        _lists[slot] = NO_TIMER;
+        while (timer != NO_TIMER)
+        {
+            Timer& fired = _timers[timer];
+            const std::uint32_t next = fired.next;
+            payloads.push_back(fired.payload);
+            fired.list = NO_TIMER;
+            fired.next = _firstFree;
+            _firstFree = timer;
+            --_size;
+            timer = next;
+        }
+    }
+}
+
+/**
+ * Cancel every timer, the tick is kept.
+ */
+void TimerWheel::clear()
+{
+    _lists.fill(NO_TIMER);
+    _firstFree = NO_TIMER;
+    for (std::size_t timer = _timers.size(); timer-- > 0;)
+    {
+        _timers[timer].list = NO_TIMER;
+        _timers[timer].next = _firstFree;
+        _firstFree = static_cast<std::uint32_t>(timer);
+    }
+    _size = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Private methods
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Put a timer at the head of the slot of the highest digit its tick does not share with the current tick.
+ *
+ * @param timer The timer, whose tick is not before the current tick
+ */
+void TimerWheel::_insert(const std::uint32_t timer)
+{
+    Timer& inserted = _timers[timer];
+    const std::uint64_t differences = inserted.tick ^ _tick;
+    const std::size_t level = differences == 0 ? 0 : (std::bit_width(differences) - 1) / SLOT_BITS;
+    const std::uint32_t list = level < LEVEL_COUNT
+                                   ? static_cast<std::uint32_t>(level * SLOT_COUNT
+                                                                + ((inserted.tick >> (SLOT_BITS * level)) & SLOT_MASK))
+                                   : OVERFLOW_LIST;
+    inserted.list = list;
+    inserted.previous = NO_TIMER;
+    inserted.next = _lists[list];
+    if (inserted.next != NO_TIMER)
+    {
+        _timers[inserted.next].previous = timer;
+    }
+    _lists[list] = timer;
+}
+
+/**
+ * Remove a timer from its list.
+ *
+ * @param timer The scheduled timer
+ */
+void TimerWheel::_unlink(const std::uint32_t timer)
+{
+    Timer& unlinked = _timers[timer];
+    if (unlinked.previous == NO_TIMER)
+    {
+        _lists[unlinked.list] = unlinked.next;
+    }
+    else
+    {
+        _timers[unlinked.previous].next = unlinked.next;
+    }
+    if (unlinked.next != NO_TIMER)
+    {
+        _timers[unlinked.next].previous = unlinked.previous;
+    }
+    unlinked.list = NO_TIMER;
+}
+
+/**
+ * Put again every timer of a list, each one landing in a lower level now that the wheel reached its slot.
+ *
+ * @param list The list
+ */
+void TimerWheel::_cascade(const std::uint32_t list)
+{
+    std::uint32_t timer = _lists[list];
+    _lists[list] = NO_TIMER;
+    while (timer != NO_TIMER)
+    {
+        const std::uint32_t next = _timers[timer].next;
+        _insert(timer);
+        timer = next;
+    }
+}